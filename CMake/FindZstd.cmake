@@ -0,0 +1,38 @@
+find_path(Zstd_INCLUDE_DIR
+  NAMES zstd.h
+  DOC "zstd include directory")
+mark_as_advanced(Zstd_INCLUDE_DIR)
+find_library(Zstd_LIBRARY
+  NAMES zstd libzstd
+  DOC "zstd library")
+mark_as_advanced(Zstd_LIBRARY)
+
+if (Zstd_INCLUDE_DIR)
+  file(STRINGS "${Zstd_INCLUDE_DIR}/zstd.h" _zstd_version_lines
+    REGEX "#define[ \t]+ZSTD_VERSION_(MAJOR|MINOR|RELEASE)")
+  string(REGEX REPLACE ".*ZSTD_VERSION_MAJOR *\([0-9]*\).*" "\\1" _zstd_version_major "${_zstd_version_lines}")
+  string(REGEX REPLACE ".*ZSTD_VERSION_MINOR *\([0-9]*\).*" "\\1" _zstd_version_minor "${_zstd_version_lines}")
+  string(REGEX REPLACE ".*ZSTD_VERSION_RELEASE *\([0-9]*\).*" "\\1" _zstd_version_release "${_zstd_version_lines}")
+  set(Zstd_VERSION "${_zstd_version_major}.${_zstd_version_minor}.${_zstd_version_release}")
+  unset(_zstd_version_major)
+  unset(_zstd_version_minor)
+  unset(_zstd_version_release)
+  unset(_zstd_version_lines)
+endif ()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd
+  REQUIRED_VARS Zstd_LIBRARY Zstd_INCLUDE_DIR
+  VERSION_VAR Zstd_VERSION)
+
+if (Zstd_FOUND)
+  set(Zstd_INCLUDE_DIRS "${Zstd_INCLUDE_DIR}")
+  set(Zstd_LIBRARIES "${Zstd_LIBRARY}")
+
+  if (NOT TARGET Zstd::Zstd)
+    add_library(Zstd::Zstd UNKNOWN IMPORTED)
+    set_target_properties(Zstd::Zstd PROPERTIES
+      IMPORTED_LOCATION "${Zstd_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${Zstd_INCLUDE_DIR}")
+  endif ()
+endif ()
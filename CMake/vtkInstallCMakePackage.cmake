@@ -79,6 +79,7 @@ set(vtk_cmake_module_files
   FindTBB.cmake
   FindTHEORA.cmake
   Findutf8cpp.cmake
+  FindZstd.cmake
 
   vtkCMakeBackports.cmake
   vtkDetectLibraryType.cmake
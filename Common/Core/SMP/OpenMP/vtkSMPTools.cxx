@@ -41,19 +41,28 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
 
 int vtk::detail::smp::GetNumberOfThreads()
 {
-  return vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads : omp_get_max_threads();
+  return vtk::detail::smp::LimitNumberOfThreads(
+    vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads : omp_get_max_threads());
 }
 
 void vtk::detail::smp::vtkSMPTools_Impl_For_OpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
   ExecuteFunctorPtrType functorExecuter, void* functor)
 {
+  int numThreads = vtk::detail::smp::GetNumberOfThreads();
   if (grain <= 0)
   {
-    vtkIdType estimateGrain = (last - first) / (omp_get_max_threads() * 4);
+    vtkIdType estimateGrain = (last - first) / (numThreads * 4);
     grain = (estimateGrain > 0) ? estimateGrain : 1;
   }
 
-#pragma omp parallel for schedule(runtime)
+  // Nested loops only reach this point when nested parallelism is enabled,
+  // the outermost loop sets the number of active levels accordingly.
+  if (!omp_in_parallel())
+  {
+    omp_set_max_active_levels(vtkSMPTools::GetNestedParallelism() ? VTK_INT_MAX : 1);
+  }
+
+#pragma omp parallel for schedule(runtime) num_threads(numThreads)
   for (vtkIdType from = first; from < last; from += grain)
   {
     functorExecuter(functor, from, grain, last);
@@ -0,0 +1,234 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// The loops are run by a pool of persistent threads helping the thread that
+// started the loop. The chunks of a loop are split in one contiguous range
+// per thread of the loop. A thread takes the chunks of its own range first,
+// then steals the remaining chunks of the other ranges, so that unbalanced
+// loops still keep all the threads busy. Several loops can be run at once,
+// started by different threads or nested in each other: the idle pool
+// threads help the most recent loop that still accepts helpers, and a thread
+// waiting for its loop to end never holds chunks that others wait for.
+
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+int vtkSMPNumberOfSpecifiedThreads = 0;
+
+int vtkSMPGetHardwareConcurrency()
+{
+  int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+  return numThreads > 0 ? numThreads : 1;
+}
+
+// The chunks [Next, End) not yet taken from the range of a thread. The
+// padding keeps the counters of the threads on separate cache lines.
+struct vtkSMPChunkRange
+{
+  std::atomic<vtkIdType> Next;
+  vtkIdType End;
+  char Padding[64 - sizeof(std::atomic<vtkIdType>) - sizeof(vtkIdType)];
+};
+
+// A loop being run by the thread that started it and up to MaxHelpers pool
+// threads. The helper counters are protected by the mutex of the pool.
+struct vtkSMPJob
+{
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+  vtk::detail::smp::ExecuteFunctorPtrType FunctorExecuter;
+  void* Functor;
+  std::unique_ptr<vtkSMPChunkRange[]> Ranges;
+  int NumberOfRanges;
+  int MaxHelpers;
+  int NumberOfHelpers;
+  int NumberOfActiveHelpers;
+
+  void ExecuteChunks(int rangeId)
+  {
+    for (int i = 0; i < this->NumberOfRanges; ++i)
+    {
+      vtkSMPChunkRange& range = this->Ranges[(rangeId + i) % this->NumberOfRanges];
+      for (vtkIdType chunk = range.Next++; chunk < range.End; chunk = range.Next++)
+      {
+        this->FunctorExecuter(
+          this->Functor, this->First + chunk * this->Grain, this->Grain, this->Last);
+      }
+    }
+  }
+};
+
+class vtkSMPThreadPool
+{
+public:
+  static vtkSMPThreadPool& GetInstance()
+  {
+    static vtkSMPThreadPool pool;
+    return pool;
+  }
+
+  ~vtkSMPThreadPool();
+
+  void Run(vtkIdType first, vtkIdType last, vtkIdType grain, int numThreads,
+    vtk::detail::smp::ExecuteFunctorPtrType functorExecuter, void* functor);
+
+private:
+  vtkSMPThreadPool() = default;
+  vtkSMPThreadPool(const vtkSMPThreadPool&) = delete;
+  void operator=(const vtkSMPThreadPool&) = delete;
+
+  void WorkerLoop();
+
+  std::mutex Mutex;
+  std::condition_variable WakeUp;
+  std::condition_variable Done;
+  std::vector<std::thread> Threads;
+  // The loops accepting more helpers.
+  std::vector<vtkSMPJob*> Jobs;
+  bool Stop = false;
+};
+
+vtkSMPThreadPool::~vtkSMPThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Stop = true;
+  }
+  this->WakeUp.notify_all();
+  for (std::thread& thread : this->Threads)
+  {
+    thread.join();
+  }
+}
+
+void vtkSMPThreadPool::WorkerLoop()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;)
+  {
+    this->WakeUp.wait(lock, [this] { return this->Stop || !this->Jobs.empty(); });
+    if (this->Stop)
+    {
+      return;
+    }
+
+    vtkSMPJob* job = this->Jobs.back();
+    int rangeId = ++job->NumberOfHelpers;
+    if (job->NumberOfHelpers == job->MaxHelpers)
+    {
+      this->Jobs.pop_back();
+    }
+    ++job->NumberOfActiveHelpers;
+    lock.unlock();
+
+    job->ExecuteChunks(rangeId % job->NumberOfRanges);
+
+    lock.lock();
+    if (--job->NumberOfActiveHelpers == 0)
+    {
+      this->Done.notify_all();
+    }
+  }
+}
+
+void vtkSMPThreadPool::Run(vtkIdType first, vtkIdType last, vtkIdType grain, int numThreads,
+  vtk::detail::smp::ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  vtkSMPJob job;
+  job.First = first;
+  job.Last = last;
+  job.Grain = grain;
+  job.FunctorExecuter = functorExecuter;
+  job.Functor = functor;
+
+  vtkIdType numChunks = (last - first + grain - 1) / grain;
+  job.NumberOfRanges = static_cast<int>(std::min(static_cast<vtkIdType>(numThreads), numChunks));
+  job.Ranges.reset(new vtkSMPChunkRange[job.NumberOfRanges]);
+  for (int rangeId = 0; rangeId < job.NumberOfRanges; ++rangeId)
+  {
+    job.Ranges[rangeId].Next = numChunks * rangeId / job.NumberOfRanges;
+    job.Ranges[rangeId].End = numChunks * (rangeId + 1) / job.NumberOfRanges;
+  }
+  job.MaxHelpers = job.NumberOfRanges - 1;
+  job.NumberOfHelpers = 0;
+  job.NumberOfActiveHelpers = 0;
+
+  if (job.MaxHelpers > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      // The pool grows with the largest thread count requested.
+      while (static_cast<int>(this->Threads.size()) < numThreads - 1)
+      {
+        this->Threads.emplace_back(&vtkSMPThreadPool::WorkerLoop, this);
+      }
+      this->Jobs.push_back(&job);
+    }
+    this->WakeUp.notify_all();
+  }
+
+  job.ExecuteChunks(0);
+
+  if (job.MaxHelpers > 0)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Jobs.erase(std::remove(this->Jobs.begin(), this->Jobs.end(), &job), this->Jobs.end());
+    this->Done.wait(lock, [&job] { return job.NumberOfActiveHelpers == 0; });
+  }
+}
+}
+
+void vtkSMPTools::Initialize(int numThreads)
+{
+  if (numThreads > 0)
+  {
+    vtkSMPNumberOfSpecifiedThreads = numThreads;
+  }
+}
+
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtk::detail::smp::GetNumberOfThreads();
+}
+
+int vtk::detail::smp::GetNumberOfThreads()
+{
+  return vtk::detail::smp::LimitNumberOfThreads(
+    vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads
+                                   : vtkSMPGetHardwareConcurrency());
+}
+
+void vtk::detail::smp::vtkSMPTools_Impl_For_STDThread(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  int numThreads = vtk::detail::smp::GetNumberOfThreads();
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = (last - first) / (numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  vtkSMPThreadPool::GetInstance().Run(first, last, grain, numThreads, functorExecuter, functor);
+}
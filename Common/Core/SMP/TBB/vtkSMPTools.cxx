@@ -63,6 +63,7 @@ void vtkSMPTools::Initialize(int numThreads)
 //--------------------------------------------------------------------------------
 int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
-  return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
-                                   : tbb::task_scheduler_init::default_num_threads();
+  return vtk::detail::smp::LimitNumberOfThreads(vtkTBBNumSpecifiedThreads
+      ? vtkTBBNumSpecifiedThreads
+      : tbb::task_scheduler_init::default_num_threads());
 }
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayPoolAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the arrays using a vtkArrayPoolAllocator recycle their memory,
+// keep their values when they are resized, and release it to the pool.
+
+#include "vtkArrayPoolAllocator.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool Check(bool condition, const char* what)
+{
+  if (!condition)
+  {
+    std::cerr << what << " failed\n";
+  }
+  return condition;
+}
+
+bool TestSizeClasses()
+{
+  bool success = true;
+  for (size_t size : { 1, 64, 65, 100, 4096, 5000, 1000000, 123456789 })
+  {
+    size_t sizeClass = vtkArrayPoolAllocator::GetSizeClass(size);
+    success &= Check(sizeClass >= size && sizeClass <= size + size / 4 + 64, "Size class");
+    success &= Check(vtkArrayPoolAllocator::GetSizeClass(sizeClass) == sizeClass, "Size class");
+  }
+  return success;
+}
+
+bool TestReuse(vtkArrayPoolAllocator* pool)
+{
+  bool success = true;
+  void* previous = nullptr;
+  for (int execution = 0; execution < 3; ++execution)
+  {
+    vtkNew<vtkFloatArray> array;
+    array->SetAllocator(pool);
+    array->SetNumberOfComponents(3);
+    array->SetNumberOfTuples(10000);
+    success &= Check(execution == 0 || array->GetVoidPointer(0) == previous, "Block reuse");
+    previous = array->GetVoidPointer(0);
+  }
+  success &= Check(pool->GetNumberOfAllocations() == 3, "Number of allocations");
+  success &= Check(pool->GetNumberOfHits() == 2, "Number of hits");
+  success &= Check(pool->GetBytesInUse() == 0, "Bytes in use");
+  success &=
+    Check(pool->GetBytesHeld() == vtkArrayPoolAllocator::GetSizeClass(30000 * sizeof(float)),
+      "Bytes held");
+
+  // Small blocks are not kept.
+  {
+    vtkNew<vtkFloatArray> array;
+    array->SetAllocator(pool);
+    array->SetNumberOfValues(10);
+  }
+  success &=
+    Check(pool->GetBytesHeld() == vtkArrayPoolAllocator::GetSizeClass(30000 * sizeof(float)),
+      "Small block");
+
+  pool->ReleaseMemory();
+  success &= Check(pool->GetBytesHeld() == 0, "ReleaseMemory");
+  return success;
+}
+
+bool TestResize(vtkArrayPoolAllocator* pool)
+{
+  vtkNew<vtkIntArray> array;
+  array->SetAllocator(pool);
+  for (int i = 0; i < 100000; ++i)
+  {
+    array->InsertNextValue(i);
+  }
+  array->Resize(50000);
+  bool values = true;
+  for (int i = 0; i < 50000; ++i)
+  {
+    values &= array->GetValue(i) == i;
+  }
+  bool success = Check(values, "Resize");
+  success &=
+    Check(pool->GetBytesInUse() == vtkArrayPoolAllocator::GetSizeClass(50000 * sizeof(int)),
+      "Bytes in use after Resize");
+
+  // A buffer set by the caller is not released to the pool.
+  int* external = new int[10];
+  array->SetArray(external, 10, 0, vtkIntArray::VTK_DATA_ARRAY_DELETE);
+  success &= Check(pool->GetBytesInUse() == 0, "SetArray");
+  return success;
+}
+
+bool TestSOA(vtkArrayPoolAllocator* pool)
+{
+  pool->ReleaseMemory();
+  pool->ResetStatistics();
+  for (int execution = 0; execution < 2; ++execution)
+  {
+    vtkNew<vtkSOADataArrayTemplate<double> > array;
+    array->SetAllocator(pool);
+    array->SetNumberOfComponents(2);
+    array->SetNumberOfTuples(1000);
+  }
+  return Check(pool->GetNumberOfAllocations() == 4 && pool->GetNumberOfHits() == 2, "SOA reuse");
+}
+
+bool TestDefaultAllocator(vtkArrayPoolAllocator* pool)
+{
+  vtkArrayAllocator::SetDefaultAllocator(pool);
+  vtkNew<vtkFloatArray> array;
+  vtkArrayAllocator::SetDefaultAllocator(nullptr);
+  vtkNew<vtkFloatArray> other;
+  return Check(array->GetAllocator() == pool && other->GetAllocator() == nullptr,
+    "Default allocator");
+}
+}
+
+int TestArrayPoolAllocator(int, char*[])
+{
+  vtkNew<vtkArrayPoolAllocator> pool;
+  bool success = true;
+  success &= TestSizeClasses();
+  success &= TestReuse(pool);
+  success &= TestResize(pool);
+  success &= TestSOA(pool);
+  success &= TestDefaultAllocator(pool);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,219 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayRange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the ranges of bit and struct-of-arrays arrays, and the values kept
+// by vtkDataArray::ModifiedByAppend().
+
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkVariantArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool CheckRange(vtkDataArray* array, int comp, double min, double max, const char* what)
+{
+  double range[2];
+  array->GetRange(range, comp);
+  if (range[0] != min || range[1] != max)
+  {
+    std::cerr << what << ": range of component " << comp << " is [" << range[0] << ", "
+              << range[1] << "] instead of [" << min << ", " << max << "]\n";
+    return false;
+  }
+  return true;
+}
+
+bool TestBitArray()
+{
+  bool success = true;
+  for (vtkIdType size : { 1, 7, 8, 9, 1000, 100003 })
+  {
+    vtkNew<vtkBitArray> bits;
+    bits->SetNumberOfValues(size);
+    for (vtkIdType i = 0; i < size; ++i)
+    {
+      bits->SetValue(i, 0);
+    }
+    bits->Modified();
+    success &= CheckRange(bits, 0, 0, 0, "Zero bits");
+
+    bits->SetValue(size - 1, 1);
+    bits->Modified();
+    success &= CheckRange(bits, 0, size > 1 ? 0 : 1, 1, "Last bit set");
+
+    for (vtkIdType i = 0; i < size; ++i)
+    {
+      bits->SetValue(i, 1);
+    }
+    bits->Modified();
+    success &= CheckRange(bits, 0, 1, 1, "One bits");
+    success &= CheckRange(bits, -1, 1, 1, "One bits magnitude");
+  }
+
+  vtkNew<vtkBitArray> bits;
+  bits->SetNumberOfComponents(3);
+  for (int i = 0; i < 1000; ++i)
+  {
+    bits->InsertNextTuple3(1, i % 2, 0);
+  }
+  success &= CheckRange(bits, 0, 1, 1, "Bit tuples");
+  success &= CheckRange(bits, 1, 0, 1, "Bit tuples");
+  success &= CheckRange(bits, 2, 0, 0, "Bit tuples");
+  success &= CheckRange(bits, -1, 1, std::sqrt(2.0), "Bit tuples magnitude");
+  return success;
+}
+
+bool TestSOAArray()
+{
+  vtkNew<vtkSOADataArrayTemplate<float> > soa;
+  soa->SetNumberOfComponents(2);
+  soa->SetNumberOfTuples(10000);
+  for (vtkIdType i = 0; i < 10000; ++i)
+  {
+    soa->SetTypedComponent(i, 0, static_cast<float>(i));
+    soa->SetTypedComponent(i, 1, static_cast<float>(-i));
+  }
+  soa->SetTypedComponent(5000, 1, vtkMath::Inf());
+  bool success = true;
+  success &= CheckRange(soa, 0, 0, 9999, "Struct-of-arrays");
+  success &= CheckRange(soa, 1, -9999, vtkMath::Inf(), "Struct-of-arrays");
+  double range[2];
+  soa->GetFiniteRange(range, 1);
+  if (range[0] != -9999 || range[1] != 0)
+  {
+    std::cerr << "Wrong finite range of a struct-of-arrays array\n";
+    success = false;
+  }
+  return success;
+}
+
+bool TestModifiedByAppend()
+{
+  vtkNew<vtkDoubleArray> array;
+  array->SetNumberOfComponents(2);
+  for (int i = 0; i < 100; ++i)
+  {
+    array->InsertNextTuple2(i, -i);
+  }
+  bool success = true;
+  success &= CheckRange(array, 0, 0, 99, "Initial");
+  success &= CheckRange(array, -1, 0, std::sqrt(2.0 * 99 * 99), "Initial magnitude");
+  double range[2];
+  array->GetFiniteRange(range, 1);
+
+  // The appended tuples extend the cached ranges.
+  array->InsertNextTuple2(200, 5);
+  array->InsertNextTuple2(-3, vtkMath::NegInf());
+  array->ModifiedByAppend();
+  success &= CheckRange(array, 0, -3, 200, "Appended");
+  success &= CheckRange(array, 1, vtkMath::NegInf(), 5, "Appended");
+  success &= CheckRange(array, -1, 0, vtkMath::Inf(), "Appended magnitude");
+  array->GetFiniteRange(range, 1);
+  if (range[0] != -99 || range[1] != 5)
+  {
+    std::cerr << "Wrong finite range after an append: [" << range[0] << ", " << range[1] << "]\n";
+    success = false;
+  }
+
+  // Nothing appended keeps the ranges, Modified() drops them.
+  array->ModifiedByAppend();
+  success &= CheckRange(array, 0, -3, 200, "Nothing appended");
+  array->SetComponent(0, 0, -10);
+  array->Modified();
+  array->InsertNextTuple2(300, 0);
+  array->ModifiedByAppend();
+  success &= CheckRange(array, 0, -10, 300, "Modified");
+  return success;
+}
+
+// The ranges are extended from the number of tuples each of them was
+// computed for.
+bool TestModifiedByAppendComputedRanges()
+{
+  vtkNew<vtkDoubleArray> array;
+  array->SetNumberOfComponents(2);
+  for (int i = 0; i < 10; ++i)
+  {
+    array->InsertNextTuple2(i, i);
+  }
+  bool success = CheckRange(array, 0, 0, 9, "Before the append");
+  array->InsertNextTuple2(100, 0);
+  // Computed with the appended tuple, before ModifiedByAppend().
+  success &= CheckRange(array, -1, 0, 100, "Magnitude of the appended tuple");
+  array->InsertNextTuple2(-5, 0);
+  array->ModifiedByAppend();
+  success &= CheckRange(array, 0, -5, 100, "Appended");
+  success &= CheckRange(array, -1, 0, 100, "Appended magnitude");
+  return success;
+}
+
+bool HasProminentValue(vtkDataArray* array, int comp, double value)
+{
+  vtkNew<vtkVariantArray> values;
+  array->GetProminentComponentValues(comp, values);
+  for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+  {
+    if (values->GetValue(i).ToDouble() == value)
+    {
+      return true;
+    }
+  }
+  std::cerr << "Prominent value " << value << " of component " << comp << " not found\n";
+  return false;
+}
+
+// The prominent component values are not kept by an append.
+bool TestModifiedByAppendProminentValues()
+{
+  vtkNew<vtkDoubleArray> array;
+  array->SetNumberOfComponents(2);
+  for (int i = 0; i < 10; ++i)
+  {
+    array->InsertNextTuple2(i % 2, 0);
+  }
+  bool success = HasProminentValue(array, 0, 1);
+  array->InsertNextTuple2(7, 0);
+  array->ModifiedByAppend();
+  success &= CheckRange(array, 0, 0, 7, "Appended after prominent values");
+  success &= HasProminentValue(array, 0, 7);
+
+  // Along with cached ranges.
+  array->InsertNextTuple2(8, 0);
+  array->ModifiedByAppend();
+  success &= HasProminentValue(array, 0, 8);
+  array->InsertNextTuple2(-1, 0);
+  array->ModifiedByAppend();
+  success &= CheckRange(array, 0, -1, 8, "Appended after a range and prominent values");
+  success &= HasProminentValue(array, 0, -1);
+  return success;
+}
+}
+
+int TestDataArrayRange(int, char*[])
+{
+  bool success = true;
+  success &= TestBitArray();
+  success &= TestSOAArray();
+  success &= TestModifiedByAppend();
+  success &= TestModifiedByAppendComputedRanges();
+  success &= TestModifiedByAppendProminentValues();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,97 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLargeArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the alignment of the arrays allocated by vtkLargeArrayAllocator, and
+// that they keep their values when they are resized, with and without huge
+// pages and parallel first touch.
+
+#include "vtkDoubleArray.h"
+#include "vtkLargeArrayAllocator.h"
+#include "vtkNew.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool IsAligned(void* ptr, std::uintptr_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+bool TestAllocator(vtkLargeArrayAllocator* allocator)
+{
+  bool success = true;
+
+  vtkNew<vtkDoubleArray> small;
+  small->SetAllocator(allocator);
+  small->SetNumberOfValues(100);
+  if (!IsAligned(small->GetVoidPointer(0), 64))
+  {
+    std::cerr << "Small array not aligned\n";
+    success = false;
+  }
+
+  // 3 MiB, above the minimum size of the test.
+  const vtkIdType numValues = 3 << 17;
+  vtkNew<vtkDoubleArray> large;
+  large->SetAllocator(allocator);
+  large->SetNumberOfValues(numValues);
+  if (!IsAligned(large->GetVoidPointer(0), 2 << 20))
+  {
+    std::cerr << "Large array not aligned on a huge page\n";
+    success = false;
+  }
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    large->SetValue(i, static_cast<double>(i));
+  }
+  large->Resize(2 * numValues);
+  large->SetNumberOfValues(2 * numValues);
+  bool kept = IsAligned(large->GetVoidPointer(0), 2 << 20);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    kept &= large->GetValue(i) == static_cast<double>(i);
+  }
+  if (!kept)
+  {
+    std::cerr << "Values lost by Resize\n";
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestLargeArrayAllocator(int, char*[])
+{
+  vtkNew<vtkLargeArrayAllocator> allocator;
+  allocator->SetMinimumSize(1 << 20);
+  bool success = true;
+  for (bool hugePages : { true, false })
+  {
+    for (bool firstTouch : { true, false })
+    {
+      allocator->SetUseHugePages(hugePages);
+      allocator->SetParallelFirstTouch(firstTouch);
+      if (!TestAllocator(allocator))
+      {
+        std::cerr << "with huge pages " << hugePages << " and parallel first touch " << firstTouch
+                  << "\n";
+        success = false;
+      }
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
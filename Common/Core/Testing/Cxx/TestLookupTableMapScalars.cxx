@@ -0,0 +1,121 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLookupTableMapScalars.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the colors of vtkLookupTable::MapScalarsThroughTable2() with the
+// ones of MapValue(), for the linear and log scales, the special colors and
+// all the output formats.
+
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+unsigned char Luminance(const unsigned char* rgba)
+{
+  return static_cast<unsigned char>(rgba[0] * 0.30 + rgba[1] * 0.59 + rgba[2] * 0.11 + 0.5);
+}
+
+template <typename T>
+bool TestMapping(vtkLookupTable* lut, const std::vector<T>& values, int dataType)
+{
+  const int numValues = static_cast<int>(values.size());
+  const double alpha = lut->GetAlpha();
+  for (int format = VTK_LUMINANCE; format <= VTK_RGBA; ++format)
+  {
+    std::vector<unsigned char> colors(numValues * format);
+    lut->MapScalarsThroughTable2(
+      const_cast<T*>(values.data()), colors.data(), dataType, numValues, 1, format);
+    for (int i = 0; i < numValues; ++i)
+    {
+      const unsigned char* rgba = lut->MapValue(static_cast<double>(values[i]));
+      unsigned char expected[4] = { rgba[0], rgba[1], rgba[2], rgba[3] };
+      if (alpha < 1.0)
+      {
+        expected[3] = static_cast<unsigned char>(rgba[3] * alpha + 0.5);
+      }
+      if (format <= VTK_LUMINANCE_ALPHA)
+      {
+        expected[0] = Luminance(rgba);
+        expected[1] = expected[3];
+      }
+      for (int c = 0; c < format; ++c)
+      {
+        if (colors[i * format + c] != expected[c])
+        {
+          std::cerr << "Wrong color for value " << static_cast<double>(values[i])
+                    << " with the output format " << format << ", scale " << lut->GetScale()
+                    << " and alpha " << alpha << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool TestType(vtkLookupTable* lut, int dataType, int numValues, double min, double max)
+{
+  std::vector<T> values(numValues);
+  for (int i = 0; i < numValues; ++i)
+  {
+    values[i] = static_cast<T>(min + (max - min) * i / (numValues - 1));
+  }
+  if (std::numeric_limits<T>::has_quiet_NaN)
+  {
+    values[numValues / 2] = std::numeric_limits<T>::quiet_NaN();
+  }
+
+  bool success = true;
+  for (int scale : { VTK_SCALE_LINEAR, VTK_SCALE_LOG10 })
+  {
+    for (double alpha : { 1.0, 0.5 })
+    {
+      lut->SetScale(scale);
+      lut->SetAlpha(alpha);
+      success &= TestMapping(lut, values, dataType);
+    }
+  }
+  return success;
+}
+}
+
+int TestLookupTableMapScalars(int, char*[])
+{
+  vtkNew<vtkLookupTable> lut;
+  lut->SetNumberOfTableValues(200);
+  lut->SetTableRange(10.0, 1000.0);
+  lut->UseBelowRangeColorOn();
+  lut->SetBelowRangeColor(0.0, 0.0, 1.0, 1.0);
+  lut->UseAboveRangeColorOn();
+  lut->SetAboveRangeColor(1.0, 0.0, 0.0, 0.75);
+  lut->SetNanColor(0.5, 0.5, 0.5, 0.25);
+  lut->Build();
+
+  // MapValue() uses the below range color for the values that are not
+  // positive with the log scale, the values start above 0.
+  bool success = true;
+  success &= TestType<float>(lut, VTK_FLOAT, 100001, 0.5, 2000.0);
+  success &= TestType<double>(lut, VTK_DOUBLE, 100001, 0.5, 2000.0);
+  success &= TestType<unsigned char>(lut, VTK_UNSIGNED_CHAR, 1000, 1.0, 255.0);
+  // Enough values to map them through a table of all the 16 bit values.
+  success &= TestType<unsigned short>(lut, VTK_UNSIGNED_SHORT, 100001, 1.0, 65535.0);
+  success &= TestType<int>(lut, VTK_INT, 10001, 1.0, 5000.0);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
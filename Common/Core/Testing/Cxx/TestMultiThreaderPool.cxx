@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiThreaderPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the executions of vtkMultiThreader on its thread pool: repeated,
+// nested in another execution, started while the pool is busy, and in a
+// child process created by fork().
+
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#if defined(VTK_USE_PTHREADS)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+const int NumberOfThreads = 4;
+
+// The calls made by an execution, one bit per thread id.
+struct Calls
+{
+  std::atomic<int> ThreadIds{ 0 };
+  std::atomic<int> NumberOfCalls{ 0 };
+  std::atomic<bool> WrongNumberOfThreads{ false };
+  // Executions started from each call, if any.
+  int NestedDepth = 0;
+  std::chrono::milliseconds Duration{ 0 };
+  std::atomic<bool> NestedFailure{ false };
+
+  bool Check(const char* name) const
+  {
+    if (this->ThreadIds != (1 << NumberOfThreads) - 1 ||
+      this->NumberOfCalls != NumberOfThreads || this->WrongNumberOfThreads ||
+      this->NestedFailure)
+    {
+      std::cerr << name << ": wrong calls, thread ids " << this->ThreadIds << ", "
+                << this->NumberOfCalls << " calls\n";
+      return false;
+    }
+    return true;
+  }
+};
+
+bool Execute(Calls& calls, bool single);
+
+VTK_THREAD_RETURN_TYPE Record(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  Calls* calls = static_cast<Calls*>(info->UserData);
+  calls->ThreadIds |= 1 << info->ThreadID;
+  ++calls->NumberOfCalls;
+  if (info->NumberOfThreads != NumberOfThreads)
+  {
+    calls->WrongNumberOfThreads = true;
+  }
+  std::this_thread::sleep_for(calls->Duration);
+  if (calls->NestedDepth > 0)
+  {
+    Calls nested;
+    nested.NestedDepth = calls->NestedDepth - 1;
+    if (!Execute(nested, info->ThreadID % 2 == 0))
+    {
+      calls->NestedFailure = true;
+    }
+  }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+bool Execute(Calls& calls, bool single)
+{
+  vtkNew<vtkMultiThreader> threader;
+  threader->UseThreadPoolOn();
+  threader->SetNumberOfThreads(NumberOfThreads);
+  if (single)
+  {
+    threader->SetSingleMethod(Record, &calls);
+    threader->SingleMethodExecute();
+  }
+  else
+  {
+    for (int i = 0; i < NumberOfThreads; ++i)
+    {
+      threader->SetMultipleMethod(i, Record, &calls);
+    }
+    threader->MultipleMethodExecute();
+  }
+  return calls.Check(single ? "SingleMethodExecute" : "MultipleMethodExecute");
+}
+
+bool TestRepeated()
+{
+  bool success = true;
+  for (int i = 0; i < 100 && success; ++i)
+  {
+    Calls calls;
+    success &= Execute(calls, i % 2 == 0);
+  }
+  return success;
+}
+
+bool TestNested()
+{
+  Calls calls;
+  calls.NestedDepth = 2;
+  return Execute(calls, true);
+}
+
+// Executions started by several threads at once, the pool runs one of them
+// at a time and the others create their threads.
+bool TestBusyPool()
+{
+  std::atomic<bool> success(true);
+  std::thread threads[4];
+  for (int t = 0; t < 4; ++t)
+  {
+    threads[t] = std::thread([&success, t]() {
+      for (int i = 0; i < 10; ++i)
+      {
+        Calls calls;
+        calls.Duration = std::chrono::milliseconds(1);
+        if (!Execute(calls, (i + t) % 2 == 0))
+        {
+          success = false;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  return success;
+}
+
+#if defined(VTK_USE_PTHREADS)
+// The pool threads of the parent do not exist in the child process.
+bool TestFork()
+{
+  pid_t pid = fork();
+  if (pid < 0)
+  {
+    std::cerr << "fork() failed\n";
+    return false;
+  }
+  if (pid == 0)
+  {
+    // Do not wait forever if the execution hangs.
+    alarm(60);
+    Calls calls;
+    _exit(Execute(calls, true) && TestRepeated() ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  int status = 0;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+    WEXITSTATUS(status) != EXIT_SUCCESS)
+  {
+    std::cerr << "Executions on the pool failed in a child process\n";
+    return false;
+  }
+  return true;
+}
+#endif
+}
+
+int TestMultiThreaderPool(int, char*[])
+{
+  bool success = true;
+  success &= TestRepeated();
+  success &= TestNested();
+  success &= TestBusyPool();
+#if defined(VTK_USE_PTHREADS)
+  success &= TestFork();
+#endif
+  success &= TestRepeated();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
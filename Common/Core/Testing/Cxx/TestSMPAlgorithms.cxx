@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPAlgorithms.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the parallel algorithms of vtkSMPTools with their serial
+// equivalents, on data array ranges and on std::vector.
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* what)
+{
+  if (!condition)
+  {
+    std::cerr << what << " failed\n";
+  }
+  return condition;
+}
+
+bool TestSize(vtkIdType size)
+{
+  bool success = true;
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(static_cast<int>(size) + 1);
+  vtkNew<vtkIdTypeArray> counts;
+  counts->SetNumberOfValues(size);
+  vtkNew<vtkDoubleArray> values;
+  values->SetNumberOfValues(size);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    random->Next();
+    counts->SetValue(i, static_cast<vtkIdType>(random->GetRangeValue(0, 10)));
+    random->Next();
+    values->SetValue(i, random->GetRangeValue(-1.0, 1.0));
+  }
+  auto countRange = vtk::DataArrayValueRange<1>(counts);
+  auto valueRange = vtk::DataArrayValueRange<1>(values);
+
+  // Fill
+  std::vector<int> filled(size, 0);
+  vtkSMPTools::Fill(filled.begin(), filled.end(), 7);
+  success &= Check(std::count(filled.begin(), filled.end(), 7) == size, "Fill");
+
+  // Transform
+  vtkNew<vtkDoubleArray> squares;
+  squares->SetNumberOfValues(size);
+  auto squareRange = vtk::DataArrayValueRange<1>(squares);
+  vtkSMPTools::Transform(
+    valueRange.cbegin(), valueRange.cend(), squareRange.begin(), [](double x) { return x * x; });
+  std::vector<double> sums(size);
+  vtkSMPTools::Transform(valueRange.cbegin(), valueRange.cend(), squareRange.cbegin(),
+    sums.begin(), [](double x, double y) { return x + y; });
+  bool transformed = true;
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    transformed &= squares->GetValue(i) == values->GetValue(i) * values->GetValue(i) &&
+      sums[i] == values->GetValue(i) + squares->GetValue(i);
+  }
+  success &= Check(transformed, "Transform");
+
+  // Reduce and TransformReduce
+  vtkIdType total = 0;
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    total += counts->GetValue(i);
+  }
+  success &= Check(
+    vtkSMPTools::Reduce(countRange.cbegin(), countRange.cend(), vtkIdType(0)) == total, "Reduce");
+  double maxValue = vtkSMPTools::Reduce(valueRange.cbegin(), valueRange.cend(), -2.0,
+    [](double x, double y) { return std::max(x, y); });
+  success &= Check(size == 0 ||
+      maxValue == *std::max_element(valueRange.cbegin(), valueRange.cend()),
+    "Reduce with max");
+  vtkIdType numLarge = vtkSMPTools::TransformReduce(countRange.cbegin(), countRange.cend(),
+    vtkIdType(0), std::plus<vtkIdType>(), [](vtkIdType n) { return n > 5 ? 1 : 0; });
+  success &= Check(numLarge ==
+      std::count_if(countRange.cbegin(), countRange.cend(), [](vtkIdType n) { return n > 5; }),
+    "TransformReduce");
+
+  // The floating point sums do not depend on the number of threads.
+  double sum = vtkSMPTools::Reduce(valueRange.cbegin(), valueRange.cend(), 0.0);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() {
+    success &= Check(
+      vtkSMPTools::Reduce(valueRange.cbegin(), valueRange.cend(), 0.0) == sum, "Deterministic sum");
+  });
+
+  // InclusiveScan
+  std::vector<vtkIdType> inclusive(size);
+  vtkSMPTools::InclusiveScan(countRange.cbegin(), countRange.cend(), inclusive.begin());
+  bool scanned = true;
+  vtkIdType partial = 0;
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    partial += counts->GetValue(i);
+    scanned &= inclusive[i] == partial;
+  }
+  success &= Check(scanned, "InclusiveScan");
+
+  // A count pass followed by an in place ExclusiveScan gives the offsets.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->DeepCopy(counts);
+  auto offsetRange = vtk::DataArrayValueRange<1>(offsets);
+  vtkSMPTools::ExclusiveScan(
+    offsetRange.cbegin(), offsetRange.cend(), offsetRange.begin(), vtkIdType(3));
+  scanned = true;
+  partial = 3;
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    scanned &= offsets->GetValue(i) == partial;
+    partial += counts->GetValue(i);
+  }
+  success &= Check(scanned, "ExclusiveScan");
+
+  if (!success)
+  {
+    std::cerr << "with " << size << " values\n";
+  }
+  return success;
+}
+}
+
+int TestSMPAlgorithms(int, char*[])
+{
+  bool success = true;
+  for (vtkIdType size : { 0, 1, 1000, 1025, 100000, 3000001 })
+  {
+    success &= TestSize(size);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,214 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPScope.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the runtime back-end selection, the nested loops and the thread
+// count limit of vtkSMPTools::LocalScope().
+
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Record the threads running a loop, and the loops nested in it.
+struct ThreadRecorder
+{
+  std::mutex Mutex;
+  std::set<std::thread::id> Threads;
+  std::atomic<vtkIdType> Count;
+  std::atomic<bool> OutsideScope;
+
+  ThreadRecorder()
+    : Count(0)
+    , OutsideScope(false)
+  {
+  }
+
+  void Record(vtkIdType begin, vtkIdType end)
+  {
+    if (!vtkSMPTools::IsParallelScope())
+    {
+      this->OutsideScope = true;
+    }
+    this->Count += end - begin;
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Threads.insert(std::this_thread::get_id());
+  }
+};
+
+bool RunLoop(ThreadRecorder& recorder)
+{
+  vtkSMPTools::For(0, 100000, 100, [&](vtkIdType begin, vtkIdType end) {
+    recorder.Record(begin, end);
+    // Keep the threads busy long enough for all of them to take chunks.
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+  });
+  if (recorder.Count != 100000 || recorder.OutsideScope)
+  {
+    std::cerr << "Wrong loop: " << recorder.Count << " iterations\n";
+    return false;
+  }
+  return true;
+}
+
+bool TestBackend()
+{
+  const char* backend = vtkSMPTools::GetBackend();
+  if (vtkSMPTools::SetBackend("NoSuchBackend") || strcmp(vtkSMPTools::GetBackend(), backend) != 0)
+  {
+    std::cerr << "An unavailable back-end was selected\n";
+    return false;
+  }
+
+  if (!vtkSMPTools::SetBackend("Sequential") ||
+    strcmp(vtkSMPTools::GetBackend(), "Sequential") != 0)
+  {
+    std::cerr << "The Sequential back-end is not available\n";
+    return false;
+  }
+  ThreadRecorder recorder;
+  bool success = RunLoop(recorder);
+  if (recorder.Threads.size() != 1 || *recorder.Threads.begin() != std::this_thread::get_id())
+  {
+    std::cerr << "The Sequential back-end used " << recorder.Threads.size() << " threads\n";
+    success = false;
+  }
+  vtkSMPTools::SetBackend(backend);
+  return success;
+}
+
+bool TestScopeBackend()
+{
+  bool success = true;
+  const std::string backend = vtkSMPTools::GetBackend();
+  const bool nested = vtkSMPTools::GetNestedParallelism();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ "Sequential" }, [&]() {
+    if (strcmp(vtkSMPTools::GetBackend(), "Sequential") != 0)
+    {
+      std::cerr << "LocalScope did not select the Sequential back-end\n";
+      success = false;
+    }
+    ThreadRecorder recorder;
+    success &= RunLoop(recorder);
+    if (recorder.Threads.size() != 1 || *recorder.Threads.begin() != std::this_thread::get_id())
+    {
+      std::cerr << "The Sequential scope used " << recorder.Threads.size() << " threads\n";
+      success = false;
+    }
+    // The string literal must not select the nested parallelism constructor.
+    if (vtkSMPTools::GetNestedParallelism() != nested)
+    {
+      std::cerr << "LocalScope with a back-end name changed the nested parallelism\n";
+      success = false;
+    }
+    vtkSMPTools::LocalScope(vtkSMPTools::Config(backend.c_str()), [&]() {
+      if (backend != vtkSMPTools::GetBackend())
+      {
+        std::cerr << "LocalScope did not select the " << backend << " back-end\n";
+        success = false;
+      }
+    });
+  });
+  if (backend != vtkSMPTools::GetBackend())
+  {
+    std::cerr << "The back-end was not restored after LocalScope\n";
+    success = false;
+  }
+  return success;
+}
+
+bool TestNestedParallelism()
+{
+  bool success = true;
+  for (bool nested : { false, true })
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ nested }, [&]() {
+      std::atomic<vtkIdType> count(0);
+      std::atomic<int> numSerialLoops(0);
+      std::atomic<int> numFailures(0);
+      vtkSMPTools::For(0, 100, 1, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          ThreadRecorder recorder;
+          numFailures += RunLoop(recorder) ? 0 : 1;
+          count += recorder.Count;
+          if (recorder.Threads.size() == 1 &&
+            *recorder.Threads.begin() == std::this_thread::get_id())
+          {
+            ++numSerialLoops;
+          }
+        }
+      });
+      if (numFailures > 0 || count != 100 * 100000)
+      {
+        std::cerr << "Wrong nested loops: " << count << " iterations\n";
+        success = false;
+      }
+      if (!nested && numSerialLoops != 100)
+      {
+        std::cerr << "Nested loops ran in parallel with nested parallelism off\n";
+        success = false;
+      }
+    });
+  }
+  return success;
+}
+
+bool TestMaxNumberOfThreads()
+{
+  bool success = true;
+  for (int maxNumberOfThreads : { 1, 2 })
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ maxNumberOfThreads }, [&]() {
+      if (vtkSMPTools::GetEstimatedNumberOfThreads() > maxNumberOfThreads)
+      {
+        std::cerr << "The estimated number of threads exceeds the limit\n";
+        success = false;
+      }
+      ThreadRecorder recorder;
+      success &= RunLoop(recorder);
+      if (static_cast<int>(recorder.Threads.size()) > maxNumberOfThreads)
+      {
+        std::cerr << recorder.Threads.size() << " threads used instead of at most "
+                  << maxNumberOfThreads << "\n";
+        success = false;
+      }
+    });
+  }
+  return success;
+}
+}
+
+int TestSMPScope(int, char*[])
+{
+  bool success = true;
+  success &= TestBackend();
+  success &= TestScopeBackend();
+  success &= TestNestedParallelism();
+  success &= TestMaxNumberOfThreads();
+  if (vtkSMPTools::IsParallelScope())
+  {
+    std::cerr << "The parallel scope was not restored\n";
+    success = false;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
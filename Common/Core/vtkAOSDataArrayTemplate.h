@@ -188,6 +188,16 @@ public:
    **/
   void SetArrayFreeFunction(void (*callback)(void*)) override;
 
+  //@{
+  /**
+   * Set/Get the allocator of the memory of the array, see vtkArrayAllocator.
+   * The default is the default allocator when the array is created. When
+   * there is none, the memory is allocated with malloc.
+   */
+  void SetAllocator(vtkArrayAllocator* allocator) { this->Buffer->SetAllocator(allocator); }
+  vtkArrayAllocator* GetAllocator() { return this->Buffer->GetAllocator(); }
+  //@}
+
   // Overridden for optimized implementations:
   void SetTuple(vtkIdType tupleIdx, const float* tuple) override;
   void SetTuple(vtkIdType tupleIdx, const double* tuple) override;
@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayAllocator.h"
+#include "vtkObjectFactory.h"
+
+#include <cstdlib>
+
+vtkStandardNewMacro(vtkArrayAllocator);
+
+namespace
+{
+vtkArrayAllocator* DefaultAllocator = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void* vtkArrayAllocator::Allocate(size_t size)
+{
+  return malloc(size);
+}
+
+//------------------------------------------------------------------------------
+void* vtkArrayAllocator::Reallocate(void* ptr, size_t, size_t newSize)
+{
+  return realloc(ptr, newSize);
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::Free(void* ptr, size_t)
+{
+  free(ptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::SetDefaultAllocator(vtkArrayAllocator* allocator)
+{
+  if (DefaultAllocator == allocator)
+  {
+    return;
+  }
+  if (allocator)
+  {
+    allocator->Register(nullptr);
+  }
+  if (DefaultAllocator)
+  {
+    DefaultAllocator->UnRegister(nullptr);
+  }
+  DefaultAllocator = allocator;
+}
+
+//------------------------------------------------------------------------------
+vtkArrayAllocator* vtkArrayAllocator::GetDefaultAllocator()
+{
+  return DefaultAllocator;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Default Allocator: " << DefaultAllocator << "\n";
+}
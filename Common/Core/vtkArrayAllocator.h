@@ -0,0 +1,84 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkArrayAllocator
+ * @brief   allocates the memory of data arrays
+ *
+ * vtkArrayAllocator is the interface used by vtkBuffer, and through it by
+ * vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate, to allocate the
+ * memory of the arrays. Unlike the malloc and free functions, the size of a
+ * block is given when it is released, so that subclasses can recycle the
+ * blocks without keeping track of their sizes. This implementation uses
+ * malloc, realloc and free.
+ *
+ * An allocator can be set on an array with SetAllocator(), or as the default
+ * allocator of the arrays created afterwards with SetDefaultAllocator(). The
+ * arrays keep a reference to the allocator of their memory.
+ *
+ * @sa
+ * vtkArrayPoolAllocator vtkLargeArrayAllocator vtkBuffer
+ */
+
+#ifndef vtkArrayAllocator_h
+#define vtkArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKCOMMONCORE_EXPORT vtkArrayAllocator : public vtkObject
+{
+public:
+  static vtkArrayAllocator* New();
+  vtkTypeMacro(vtkArrayAllocator, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Allocate a block of @a size bytes. Return nullptr on failure.
+   */
+  virtual void* Allocate(size_t size);
+
+  /**
+   * Resize a block of @a oldSize bytes to @a newSize bytes, keeping its
+   * content up to the smallest of the two sizes. The block may move, the
+   * returned pointer replaces @a ptr. Return nullptr on failure, in which
+   * case @a ptr is left untouched.
+   */
+  virtual void* Reallocate(void* ptr, size_t oldSize, size_t newSize);
+
+  /**
+   * Release a block of @a size bytes returned by this allocator.
+   */
+  virtual void Free(void* ptr, size_t size);
+
+  //@{
+  /**
+   * Set/Get the allocator used by the arrays created afterwards. The default
+   * is nullptr, in which case the arrays use malloc or memkind. The allocator
+   * should be set before other threads create arrays.
+   */
+  static void SetDefaultAllocator(vtkArrayAllocator* allocator);
+  static vtkArrayAllocator* GetDefaultAllocator();
+  //@}
+
+protected:
+  vtkArrayAllocator() = default;
+  ~vtkArrayAllocator() override = default;
+
+private:
+  vtkArrayAllocator(const vtkArrayAllocator&) = delete;
+  void operator=(const vtkArrayAllocator&) = delete;
+};
+
+#endif
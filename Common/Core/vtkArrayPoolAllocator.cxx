@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayPoolAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayPoolAllocator.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+vtkStandardNewMacro(vtkArrayPoolAllocator);
+
+//------------------------------------------------------------------------------
+class vtkArrayPoolAllocator::vtkInternals
+{
+public:
+  std::mutex Mutex;
+  // The released blocks, by size class.
+  std::map<size_t, std::vector<void*> > Blocks;
+  vtkIdType NumberOfAllocations = 0;
+  vtkIdType NumberOfHits = 0;
+  size_t BytesHeld = 0;
+  size_t BytesInUse = 0;
+};
+
+//------------------------------------------------------------------------------
+vtkArrayPoolAllocator::vtkArrayPoolAllocator()
+  : MinimumBlockSize(4096)
+  , MaximumBytesHeld(size_t(256) << 20)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkArrayPoolAllocator::~vtkArrayPoolAllocator()
+{
+  this->ReleaseMemory();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkArrayPoolAllocator::GetSizeClass(size_t size)
+{
+  // Four classes per power of two, from 64 bytes.
+  if (size <= 64)
+  {
+    return 64;
+  }
+  size_t power = 64;
+  while (power < size / 2 + size % 2)
+  {
+    power *= 2;
+  }
+  size_t step = power / 4;
+  size_t sizeClass = (size / step + (size % step ? 1 : 0)) * step;
+  return sizeClass >= size ? sizeClass : size;
+}
+
+//------------------------------------------------------------------------------
+void* vtkArrayPoolAllocator::Allocate(size_t size)
+{
+  size_t sizeClass = vtkArrayPoolAllocator::GetSizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    ++this->Internals->NumberOfAllocations;
+    auto blocks = this->Internals->Blocks.find(sizeClass);
+    if (blocks != this->Internals->Blocks.end() && !blocks->second.empty())
+    {
+      void* ptr = blocks->second.back();
+      blocks->second.pop_back();
+      ++this->Internals->NumberOfHits;
+      this->Internals->BytesHeld -= sizeClass;
+      this->Internals->BytesInUse += sizeClass;
+      return ptr;
+    }
+  }
+
+  void* ptr = malloc(sizeClass);
+  if (ptr)
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    this->Internals->BytesInUse += sizeClass;
+  }
+  return ptr;
+}
+
+//------------------------------------------------------------------------------
+void* vtkArrayPoolAllocator::Reallocate(void* ptr, size_t oldSize, size_t newSize)
+{
+  if (!ptr)
+  {
+    return this->Allocate(newSize);
+  }
+  if (vtkArrayPoolAllocator::GetSizeClass(oldSize) ==
+    vtkArrayPoolAllocator::GetSizeClass(newSize))
+  {
+    return ptr;
+  }
+  void* newPtr = this->Allocate(newSize);
+  if (newPtr)
+  {
+    memcpy(newPtr, ptr, std::min(oldSize, newSize));
+    this->Free(ptr, oldSize);
+  }
+  return newPtr;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayPoolAllocator::Free(void* ptr, size_t size)
+{
+  if (!ptr)
+  {
+    return;
+  }
+  size_t sizeClass = vtkArrayPoolAllocator::GetSizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    this->Internals->BytesInUse -= sizeClass;
+    if (sizeClass >= this->MinimumBlockSize &&
+      this->Internals->BytesHeld + sizeClass <= this->MaximumBytesHeld)
+    {
+      this->Internals->Blocks[sizeClass].push_back(ptr);
+      this->Internals->BytesHeld += sizeClass;
+      return;
+    }
+  }
+  free(ptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayPoolAllocator::ReleaseMemory()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  for (auto& blocks : this->Internals->Blocks)
+  {
+    for (void* ptr : blocks.second)
+    {
+      free(ptr);
+    }
+  }
+  this->Internals->Blocks.clear();
+  this->Internals->BytesHeld = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkArrayPoolAllocator::GetNumberOfAllocations()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfAllocations;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkArrayPoolAllocator::GetNumberOfHits()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfHits;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkArrayPoolAllocator::GetBytesHeld()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->BytesHeld;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkArrayPoolAllocator::GetBytesInUse()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->BytesInUse;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayPoolAllocator::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->NumberOfAllocations = 0;
+  this->Internals->NumberOfHits = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayPoolAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Minimum Block Size: " << this->MinimumBlockSize << "\n";
+  os << indent << "Maximum Bytes Held: " << this->MaximumBytesHeld << "\n";
+  os << indent << "Number Of Allocations: " << this->GetNumberOfAllocations() << "\n";
+  os << indent << "Number Of Hits: " << this->GetNumberOfHits() << "\n";
+  os << indent << "Bytes Held: " << this->GetBytesHeld() << "\n";
+  os << indent << "Bytes In Use: " << this->GetBytesInUse() << "\n";
+}
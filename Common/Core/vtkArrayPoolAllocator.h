@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayPoolAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkArrayPoolAllocator
+ * @brief   array allocator recycling the released blocks
+ *
+ * vtkArrayPoolAllocator keeps the blocks released by the arrays, and gives
+ * them back to the arrays allocating blocks of the same size class. A
+ * pipeline executing again allocates arrays of the same sizes as before,
+ * which then reuse memory that is already mapped instead of going through
+ * malloc and page faults.
+ *
+ * The sizes are rounded up to size classes, four per power of two, so a
+ * block wastes at most a quarter of its size. The blocks smaller than
+ * MinimumBlockSize are released with free. The pool holds at most
+ * MaximumBytesHeld bytes of released blocks, the blocks released beyond that
+ * are freed. The allocator is thread safe.
+ *
+ * @sa
+ * vtkArrayAllocator
+ */
+
+#ifndef vtkArrayPoolAllocator_h
+#define vtkArrayPoolAllocator_h
+
+#include "vtkArrayAllocator.h"
+#include "vtkCommonCoreModule.h" // For export macro
+
+class VTKCOMMONCORE_EXPORT vtkArrayPoolAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkArrayPoolAllocator* New();
+  vtkTypeMacro(vtkArrayPoolAllocator, vtkArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void* Allocate(size_t size) override;
+  void* Reallocate(void* ptr, size_t oldSize, size_t newSize) override;
+  void Free(void* ptr, size_t size) override;
+
+  //@{
+  /**
+   * Set/Get the size in bytes of the smallest block kept by the pool. The
+   * default is 4096.
+   */
+  vtkSetMacro(MinimumBlockSize, size_t);
+  vtkGetMacro(MinimumBlockSize, size_t);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the maximum number of bytes of released blocks held by the pool.
+   * The default is 256 MiB.
+   */
+  vtkSetMacro(MaximumBytesHeld, size_t);
+  vtkGetMacro(MaximumBytesHeld, size_t);
+  //@}
+
+  /**
+   * Free the blocks held by the pool.
+   */
+  void ReleaseMemory();
+
+  //@{
+  /**
+   * Statistics of the pool: the number of allocations, the number of them
+   * that reused a held block, the bytes of the released blocks held, and the
+   * bytes of the blocks allocated and not released yet.
+   */
+  vtkIdType GetNumberOfAllocations();
+  vtkIdType GetNumberOfHits();
+  size_t GetBytesHeld();
+  size_t GetBytesInUse();
+  //@}
+
+  /**
+   * Reset the numbers of allocations and hits.
+   */
+  void ResetStatistics();
+
+  /**
+   * Return the size class of a block of @a size bytes, i.e. the number of
+   * bytes allocated for it.
+   */
+  static size_t GetSizeClass(size_t size);
+
+protected:
+  vtkArrayPoolAllocator();
+  ~vtkArrayPoolAllocator() override;
+
+  size_t MinimumBlockSize;
+  size_t MaximumBytesHeld;
+
+private:
+  vtkArrayPoolAllocator(const vtkArrayPoolAllocator&) = delete;
+  void operator=(const vtkArrayPoolAllocator&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -17,6 +17,11 @@
 #include "vtkBitArrayIterator.h"
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <functional>
+#include <vector>
 
 //----------------------------------------------------------------------------
 class vtkBitArrayLookup
@@ -663,6 +668,88 @@ void vtkBitArray::RemoveLastTuple()
   this->DataChanged();
 }
 
+//----------------------------------------------------------------------------
+// Bit b of the mask of a component is set when the value b is found in it.
+bool vtkBitArray::ComputeScalarRange(double* ranges)
+{
+  const int numComps = this->NumberOfComponents;
+  const vtkIdType numValues = this->MaxId + 1;
+  for (int i = 0; i < numComps; ++i)
+  {
+    ranges[2 * i] = VTK_DOUBLE_MAX;
+    ranges[2 * i + 1] = VTK_DOUBLE_MIN;
+  }
+  if (numValues <= 0)
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> masks(numComps, 0);
+  if (numComps == 1)
+  {
+    const vtkIdType numBytes = numValues / 8;
+    masks[0] = vtkSMPTools::TransformReduce(this->Array, this->Array + numBytes,
+      static_cast<unsigned char>(0), std::bit_or<unsigned char>(), [](unsigned char byte) {
+        return static_cast<unsigned char>((byte != 0xff ? 1 : 0) | (byte != 0 ? 2 : 0));
+      });
+    for (vtkIdType id = numBytes * 8; id < numValues; ++id)
+    {
+      masks[0] |= 1 << this->GetValue(id);
+    }
+  }
+  else
+  {
+    vtkSMPThreadLocal<std::vector<unsigned char> > localMasks(masks);
+    vtkSMPTools::For(0, this->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      std::vector<unsigned char>& local = localMasks.Local();
+      for (vtkIdType id = begin * numComps; id < end * numComps; id += numComps)
+      {
+        for (int i = 0; i < numComps; ++i)
+        {
+          local[i] |= 1 << this->GetValue(id + i);
+        }
+      }
+    });
+    for (const std::vector<unsigned char>& local : localMasks)
+    {
+      for (int i = 0; i < numComps; ++i)
+      {
+        masks[i] |= local[i];
+      }
+    }
+  }
+
+  for (int i = 0; i < numComps; ++i)
+  {
+    ranges[2 * i] = (masks[i] & 1) ? 0.0 : 1.0;
+    ranges[2 * i + 1] = (masks[i] & 2) ? 1.0 : 0.0;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitArray::ComputeVectorRange(double range[2])
+{
+  // The magnitude of a single bit is the bit.
+  if (this->NumberOfComponents == 1)
+  {
+    return this->ComputeScalarRange(range);
+  }
+  return this->Superclass::ComputeVectorRange(range);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitArray::ComputeFiniteScalarRange(double* ranges)
+{
+  return this->ComputeScalarRange(ranges);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBitArray::ComputeFiniteVectorRange(double range[2])
+{
+  return this->ComputeVectorRange(range);
+}
+
 //----------------------------------------------------------------------------
 vtkArrayIterator* vtkBitArray::NewIterator()
 {
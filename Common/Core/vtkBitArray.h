@@ -295,6 +295,18 @@ protected:
   vtkBitArray();
   ~vtkBitArray() override;
 
+  //@{
+  /**
+   * Compute the range of the bits in parallel. Single component arrays are
+   * scanned a byte at a time. Bits are always finite, so the finite ranges
+   * are the same as the ranges.
+   */
+  bool ComputeScalarRange(double* ranges) override;
+  bool ComputeVectorRange(double range[2]) override;
+  bool ComputeFiniteScalarRange(double* ranges) override;
+  bool ComputeFiniteVectorRange(double range[2]) override;
+  //@}
+
   unsigned char* Array; // pointer to data
   unsigned char* ResizeAndExtend(vtkIdType sz);
   // function to resize data
@@ -25,8 +25,10 @@
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkArrayAllocator.h" // For allocators
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
+#include "vtkSmartPointer.h"  // For allocators
 
 #include <algorithm> // for std::min and std::copy
 
@@ -71,6 +73,17 @@ public:
    **/
   void SetFreeFunction(bool noFreeFunction, vtkFreeingFunction deleteFunction = free);
 
+  //@{
+  /**
+   * Set/Get the allocator of the buffers allocated by Allocate() and
+   * Reallocate(). When it is set, it is used instead of the malloc, realloc
+   * and free functions. The default is vtkArrayAllocator::GetDefaultAllocator().
+   * The buffer held is released by the allocator that allocated it.
+   **/
+  void SetAllocator(vtkArrayAllocator* allocator) { this->Allocator = allocator; }
+  vtkArrayAllocator* GetAllocator() const { return this->Allocator; }
+  //@}
+
   /**
    * Return the number of elements the current buffer can hold.
    */
@@ -91,6 +104,7 @@ protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
+    , Allocator(vtkArrayAllocator::GetDefaultAllocator())
   {
     this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
     this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
@@ -104,6 +118,9 @@ protected:
   vtkMallocingFunction MallocFunction;
   vtkReallocingFunction ReallocFunction;
   vtkFreeingFunction DeleteFunction;
+  vtkSmartPointer<vtkArrayAllocator> Allocator;
+  // The allocator of the buffer held, if it was allocated by one.
+  vtkSmartPointer<vtkArrayAllocator> BufferAllocator;
 
 private:
   vtkBuffer(const vtkBuffer&) = delete;
@@ -129,7 +146,12 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
 {
   if (this->Pointer != array)
   {
-    if (this->DeleteFunction)
+    if (this->BufferAllocator)
+    {
+      this->BufferAllocator->Free(this->Pointer, this->Size * sizeof(ScalarType));
+      this->BufferAllocator = nullptr;
+    }
+    else if (this->DeleteFunction)
     {
       this->DeleteFunction(this->Pointer);
     }
@@ -170,7 +192,19 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
 {
   // release old memory.
   this->SetBuffer(nullptr, 0);
-  if (size > 0)
+  if (size > 0 && this->Allocator)
+  {
+    ScalarType* newArray =
+      static_cast<ScalarType*>(this->Allocator->Allocate(size * sizeof(ScalarType)));
+    if (newArray)
+    {
+      this->SetBuffer(newArray, size);
+      this->BufferAllocator = this->Allocator;
+      return true;
+    }
+    return false;
+  }
+  else if (size > 0)
   {
     ScalarType* newArray;
     if (this->MallocFunction)
@@ -204,7 +238,47 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     return this->Allocate(0);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  if (this->Allocator && this->BufferAllocator == this->Allocator)
+  {
+    // The allocator may resize the buffer in place.
+    ScalarType* newArray = static_cast<ScalarType*>(this->Allocator->Reallocate(
+      this->Pointer, this->Size * sizeof(ScalarType), newsize * sizeof(ScalarType)));
+    if (!newArray)
+    {
+      return false;
+    }
+    this->Pointer = newArray;
+    this->Size = newsize;
+  }
+  else if (this->Allocator || this->BufferAllocator)
+  {
+    // Copy the buffer to a buffer of the current allocator, or to a malloced
+    // buffer when the allocator was unset.
+    ScalarType* newArray;
+    if (this->Allocator)
+    {
+      newArray = static_cast<ScalarType*>(this->Allocator->Allocate(newsize * sizeof(ScalarType)));
+    }
+    else
+    {
+      newArray = static_cast<ScalarType*>(malloc(newsize * sizeof(ScalarType)));
+    }
+    if (!newArray)
+    {
+      return false;
+    }
+    std::copy(this->Pointer, this->Pointer + std::min(this->Size, newsize), newArray);
+    this->SetBuffer(newArray, newsize);
+    if (this->Allocator)
+    {
+      this->BufferAllocator = this->Allocator;
+    }
+    else
+    {
+      this->DeleteFunction = free;
+    }
+  }
+  else if (this->Pointer && this->DeleteFunction != free)
   {
     ScalarType* newArray;
     if (this->MallocFunction)
@@ -40,6 +40,7 @@
 #endif
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
+#include "vtkSmartPointer.h"
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
@@ -47,6 +48,7 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm> // for min(), max()
+#include <vector>
 
 namespace
 {
@@ -383,6 +385,48 @@ bool hasValidKey(InfoType info, KeyType key, ComponentKeyType ckey, double range
   return false;
 }
 
+// Copy the cached component ranges, without the other values cached per
+// component. Returns nullptr if a component has no cached range.
+vtkSmartPointer<vtkInformationVector> copyComponentRanges(
+  vtkInformationVector* infoVec, int numComps)
+{
+  if (!infoVec || infoVec->GetNumberOfInformationObjects() != numComps)
+  {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkInformationVector> ranges = vtkSmartPointer<vtkInformationVector>::New();
+  ranges->SetNumberOfInformationObjects(numComps);
+  for (int i = 0; i < numComps; ++i)
+  {
+    vtkInformation* compInfo = infoVec->GetInformationObject(i);
+    if (!compInfo->Has(vtkDataArray::COMPONENT_RANGE()))
+    {
+      return nullptr;
+    }
+    ranges->GetInformationObject(i)->CopyEntry(compInfo, vtkDataArray::COMPONENT_RANGE());
+  }
+  return ranges;
+}
+
+// Extend the cached component ranges with the ranges of appended tuples.
+void extendComponentRanges(vtkInformationVector* infoVec, const double* ranges)
+{
+  for (int i = 0; i < infoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkInformation* compInfo = infoVec->GetInformationObject(i);
+    const double* range = compInfo->Get(vtkDataArray::COMPONENT_RANGE());
+    double extended[2] = { std::min(range[0], ranges[2 * i]),
+      std::max(range[1], ranges[2 * i + 1]) };
+    compInfo->Set(vtkDataArray::COMPONENT_RANGE(), extended, 2);
+  }
+}
+
+void extendRange(double range[2], const double appended[2])
+{
+  range[0] = std::min(range[0], appended[0]);
+  range[1] = std::max(range[1], appended[1]);
+}
+
 } // end anon namespace
 
 vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_RANGE, DoubleVector, 2);
@@ -399,6 +443,10 @@ vtkDataArray::vtkDataArray()
   this->Range[1] = 0;
   this->FiniteRange[0] = 0;
   this->FiniteRange[1] = 0;
+  this->ComponentRangeNumberOfTuples = 0;
+  this->FiniteComponentRangeNumberOfTuples = 0;
+  this->L2NormRangeNumberOfTuples = 0;
+  this->L2NormFiniteRangeNumberOfTuples = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -1498,6 +1546,7 @@ void vtkDataArray::ComputeFiniteRange(double range[2], int comp)
 
       this->ComputeFiniteVectorRange(range);
       info->Set(rkey, range, 2);
+      this->L2NormFiniteRangeNumberOfTuples = this->GetNumberOfTuples();
     }
     return;
   }
@@ -1522,6 +1571,7 @@ void vtkDataArray::ComputeFiniteRange(double range[2], int comp)
           infoVec->GetInformationObject(i)->Set(rkey, allCompRanges + (i * 2), 2);
         }
         infoVec->FastDelete();
+        this->FiniteComponentRangeNumberOfTuples = this->GetNumberOfTuples();
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -1560,6 +1610,7 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
     {
       this->ComputeVectorRange(range);
       info->Set(rkey, range, 2);
+      this->L2NormRangeNumberOfTuples = this->GetNumberOfTuples();
     }
     return;
   }
@@ -1584,6 +1635,7 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
           infoVec->GetInformationObject(i)->Set(rkey, allCompRanges + (i * 2), 2);
         }
         infoVec->FastDelete();
+        this->ComponentRangeNumberOfTuples = this->GetNumberOfTuples();
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -1608,6 +1660,97 @@ void vtkDataArray::Modified()
   this->Superclass::Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkDataArray::ModifiedByAppend()
+{
+  if (!this->HasInformation())
+  {
+    this->Modified();
+    return;
+  }
+
+  // Keep the cached ranges across Modified(), unless they were computed for
+  // more tuples than the array has now.
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  vtkInformation* info = this->GetInformation();
+  vtkSmartPointer<vtkInformationVector> componentRanges;
+  if (this->ComponentRangeNumberOfTuples <= numTuples)
+  {
+    componentRanges = copyComponentRanges(info->Get(PER_COMPONENT()), this->NumberOfComponents);
+  }
+  vtkSmartPointer<vtkInformationVector> finiteComponentRanges;
+  if (this->FiniteComponentRangeNumberOfTuples <= numTuples)
+  {
+    finiteComponentRanges =
+      copyComponentRanges(info->Get(PER_FINITE_COMPONENT()), this->NumberOfComponents);
+  }
+  double normRange[2];
+  double finiteNormRange[2];
+  const bool hasNormRange =
+    this->L2NormRangeNumberOfTuples <= numTuples && hasValidKey(info, L2_NORM_RANGE(), normRange);
+  const bool hasFiniteNormRange = this->L2NormFiniteRangeNumberOfTuples <= numTuples &&
+    hasValidKey(info, L2_NORM_FINITE_RANGE(), finiteNormRange);
+  this->Modified();
+
+  // Only the tuples appended since each range was computed are scanned, on a
+  // copy using the fast paths of their array type.
+  vtkSmartPointer<vtkDataArray> appended;
+  vtkIdType appendedFirst = numTuples;
+  auto getAppended = [&](vtkIdType first) {
+    if (!appended || appendedFirst != first)
+    {
+      appended = vtk::TakeSmartPointer(this->NewInstance());
+      appended->SetNumberOfComponents(this->NumberOfComponents);
+      appended->InsertTuples(0, numTuples - first, first, this);
+      appendedFirst = first;
+    }
+    return appended.GetPointer();
+  };
+  std::vector<double> ranges(2 * this->NumberOfComponents);
+
+  if (componentRanges)
+  {
+    if (this->ComponentRangeNumberOfTuples < numTuples)
+    {
+      getAppended(this->ComponentRangeNumberOfTuples)->ComputeScalarRange(ranges.data());
+      extendComponentRanges(componentRanges, ranges.data());
+    }
+    info->Set(PER_COMPONENT(), componentRanges);
+    this->ComponentRangeNumberOfTuples = numTuples;
+  }
+  if (finiteComponentRanges)
+  {
+    if (this->FiniteComponentRangeNumberOfTuples < numTuples)
+    {
+      getAppended(this->FiniteComponentRangeNumberOfTuples)
+        ->ComputeFiniteScalarRange(ranges.data());
+      extendComponentRanges(finiteComponentRanges, ranges.data());
+    }
+    info->Set(PER_FINITE_COMPONENT(), finiteComponentRanges);
+    this->FiniteComponentRangeNumberOfTuples = numTuples;
+  }
+  if (hasNormRange)
+  {
+    if (this->L2NormRangeNumberOfTuples < numTuples)
+    {
+      getAppended(this->L2NormRangeNumberOfTuples)->ComputeVectorRange(ranges.data());
+      extendRange(normRange, ranges.data());
+    }
+    info->Set(L2_NORM_RANGE(), normRange, 2);
+    this->L2NormRangeNumberOfTuples = numTuples;
+  }
+  if (hasFiniteNormRange)
+  {
+    if (this->L2NormFiniteRangeNumberOfTuples < numTuples)
+    {
+      getAppended(this->L2NormFiniteRangeNumberOfTuples)->ComputeFiniteVectorRange(ranges.data());
+      extendRange(finiteNormRange, ranges.data());
+    }
+    info->Set(L2_NORM_FINITE_RANGE(), finiteNormRange, 2);
+    this->L2NormFiniteRangeNumberOfTuples = numTuples;
+  }
+}
+
 namespace
 {
 
@@ -1689,50 +1832,63 @@ struct FiniteVectorRangeDispatchWrapper
   }
 };
 
+// The struct-of-arrays layouts are not in the default dispatch list, but
+// their ranges are still computed through their typed API.
+template <template <typename> class ArrayT>
+using RangeArrays = vtkTypeList::Create<ArrayT<char>, ArrayT<double>, ArrayT<float>, ArrayT<int>,
+  ArrayT<long>, ArrayT<long long>, ArrayT<short>, ArrayT<signed char>, ArrayT<unsigned char>,
+  ArrayT<unsigned int>, ArrayT<unsigned long>, ArrayT<unsigned long long>, ArrayT<unsigned short> >;
+
+// Run a range worker on the array, falling back to the vtkDataArray API for
+// the array types without a compiled fast path.
+template <typename Worker>
+bool DispatchRange(vtkDataArray* array, Worker& worker)
+{
+  if (vtkArrayDispatch::Dispatch::Execute(array, worker) ||
+    vtkArrayDispatch::DispatchByArray<RangeArrays<vtkSOADataArrayTemplate> >::Execute(
+      array, worker))
+  {
+    return worker.Success;
+  }
+#ifdef VTK_USE_SCALED_SOA_ARRAYS
+  if (vtkArrayDispatch::DispatchByArray<RangeArrays<vtkScaledSOADataArrayTemplate> >::Execute(
+        array, worker))
+  {
+    return worker.Success;
+  }
+#endif
+  worker(array);
+  return worker.Success;
+}
+
 } // end anon namespace
 
 //----------------------------------------------------------------------------
 bool vtkDataArray::ComputeScalarRange(double* ranges)
 {
   ScalarRangeDispatchWrapper worker(ranges);
-  if (!vtkArrayDispatch::Dispatch::Execute(this, worker))
-  {
-    worker(this);
-  }
-  return worker.Success;
+  return DispatchRange(this, worker);
 }
 
 //-----------------------------------------------------------------------------
 bool vtkDataArray::ComputeVectorRange(double range[2])
 {
   VectorRangeDispatchWrapper worker(range);
-  if (!vtkArrayDispatch::Dispatch::Execute(this, worker))
-  {
-    worker(this);
-  }
-  return worker.Success;
+  return DispatchRange(this, worker);
 }
 
 //----------------------------------------------------------------------------
 bool vtkDataArray::ComputeFiniteScalarRange(double* ranges)
 {
   FiniteScalarRangeDispatchWrapper worker(ranges);
-  if (!vtkArrayDispatch::Dispatch::Execute(this, worker))
-  {
-    worker(this);
-  }
-  return worker.Success;
+  return DispatchRange(this, worker);
 }
 
 //-----------------------------------------------------------------------------
 bool vtkDataArray::ComputeFiniteVectorRange(double range[2])
 {
   FiniteVectorRangeDispatchWrapper worker(range);
-  if (!vtkArrayDispatch::Dispatch::Execute(this, worker))
-  {
-    worker(this);
-  }
-  return worker.Success;
+  return DispatchRange(this, worker);
 }
 
 //----------------------------------------------------------------------------
@@ -489,6 +489,17 @@ public:
    */
   void Modified() override;
 
+  /**
+   * Call this instead of Modified() when tuples were only appended to the
+   * array since the last modification, e.g. with InsertNextTuple(), the
+   * previous tuples being unchanged. The cached ranges are kept and extended
+   * with the range of the new tuples, so that arrays growing at each frame
+   * don't rescan all their tuples when their range is requested. The other
+   * cached values, such as the prominent component values, are removed as
+   * with Modified().
+   */
+  void ModifiedByAppend();
+
   /**
    * A human-readable string indicating the units for the array data.
    */
@@ -565,6 +576,13 @@ protected:
   double Range[2];
   double FiniteRange[2];
 
+  // The number of tuples each cached range was computed for, the tuples
+  // appended after them are scanned by ModifiedByAppend().
+  vtkIdType ComponentRangeNumberOfTuples;
+  vtkIdType FiniteComponentRangeNumberOfTuples;
+  vtkIdType L2NormRangeNumberOfTuples;
+  vtkIdType L2NormFiniteRangeNumberOfTuples;
+
 private:
   double* GetTupleN(vtkIdType i, int n);
 
@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLargeArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLargeArrayAllocator.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+vtkStandardNewMacro(vtkLargeArrayAllocator);
+
+namespace
+{
+// The size of the huge pages on x86-64 and of the pages on all the systems.
+const size_t HugePageSize = size_t(2) << 20;
+const size_t PageSize = 4096;
+
+// All the blocks are aligned, so that they are released in the same way
+// whatever their size.
+void* AlignedAllocate(size_t size, size_t alignment)
+{
+#if defined(_WIN32)
+  return _aligned_malloc(size, alignment);
+#else
+  void* ptr = nullptr;
+  return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void AlignedFree(void* ptr)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+}
+
+//------------------------------------------------------------------------------
+vtkLargeArrayAllocator::vtkLargeArrayAllocator()
+  : MinimumSize(size_t(16) << 20)
+  , UseHugePages(true)
+  , ParallelFirstTouch(true)
+{
+}
+
+//------------------------------------------------------------------------------
+void* vtkLargeArrayAllocator::Allocate(size_t size)
+{
+  if (size < this->MinimumSize)
+  {
+    return AlignedAllocate(size, 64);
+  }
+
+  char* ptr = static_cast<char*>(AlignedAllocate(size, HugePageSize));
+  if (!ptr)
+  {
+    return nullptr;
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (this->UseHugePages)
+  {
+    // Only the huge pages fully inside the block can be used, the advice
+    // fails harmlessly when they are disabled.
+    size_t hugeSize = size / HugePageSize * HugePageSize;
+    if (hugeSize > 0)
+    {
+      madvise(ptr, hugeSize, MADV_HUGEPAGE);
+    }
+  }
+#endif
+  if (this->ParallelFirstTouch)
+  {
+    // Nothing is mapped until a page is written, write a byte of each page
+    // from the thread that will likely process it.
+    const vtkIdType numPages = static_cast<vtkIdType>((size + PageSize - 1) / PageSize);
+    vtkSMPTools::For(0, numPages, [ptr](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType page = begin; page < end; ++page)
+      {
+        ptr[page * PageSize] = 0;
+      }
+    });
+  }
+  return ptr;
+}
+
+//------------------------------------------------------------------------------
+void* vtkLargeArrayAllocator::Reallocate(void* ptr, size_t oldSize, size_t newSize)
+{
+  // realloc would not keep the alignment nor the placement of the pages.
+  void* newPtr = this->Allocate(newSize);
+  if (newPtr && ptr)
+  {
+    memcpy(newPtr, ptr, std::min(oldSize, newSize));
+    this->Free(ptr, oldSize);
+  }
+  return newPtr;
+}
+
+//------------------------------------------------------------------------------
+void vtkLargeArrayAllocator::Free(void* ptr, size_t)
+{
+  AlignedFree(ptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkLargeArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Minimum Size: " << this->MinimumSize << "\n";
+  os << indent << "Use Huge Pages: " << (this->UseHugePages ? "On" : "Off") << "\n";
+  os << indent << "Parallel First Touch: " << (this->ParallelFirstTouch ? "On" : "Off") << "\n";
+}
@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLargeArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLargeArrayAllocator
+ * @brief   array allocator placing large arrays for parallel loops
+ *
+ * vtkLargeArrayAllocator allocates the blocks of at least MinimumSize bytes
+ * aligned on huge page boundaries. When UseHugePages is on, it asks the
+ * system to back them with transparent huge pages, reducing the TLB misses
+ * of the loops going through them. When ParallelFirstTouch is on, the pages
+ * of the new blocks are written a first time in a vtkSMPTools::For() loop.
+ * On NUMA systems the operating system places a page on the node of the
+ * thread writing it first, so the pages end up spread over the nodes of the
+ * threads like the iterations of the vtkSMPTools loops going through the
+ * array later, instead of all on the node of the thread allocating it.
+ *
+ * The allocator is set on the arrays like any vtkArrayAllocator, one array
+ * at a time with SetAllocator(), or for all the arrays with
+ * vtkArrayAllocator::SetDefaultAllocator().
+ *
+ * @warning
+ * Huge pages are only requested on Linux, where the transparent huge pages
+ * must be enabled in the "madvise" or "always" mode. The placement of the
+ * pages matches the later loops when the back-end of vtkSMPTools partitions
+ * the iterations in the same way, which the Sequential back-end does not.
+ *
+ * @sa
+ * vtkArrayAllocator vtkArrayPoolAllocator
+ */
+
+#ifndef vtkLargeArrayAllocator_h
+#define vtkLargeArrayAllocator_h
+
+#include "vtkArrayAllocator.h"
+#include "vtkCommonCoreModule.h" // For export macro
+
+class VTKCOMMONCORE_EXPORT vtkLargeArrayAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkLargeArrayAllocator* New();
+  vtkTypeMacro(vtkLargeArrayAllocator, vtkArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void* Allocate(size_t size) override;
+  void* Reallocate(void* ptr, size_t oldSize, size_t newSize) override;
+  void Free(void* ptr, size_t size) override;
+
+  //@{
+  /**
+   * Set/Get the size in bytes of the smallest block handled as a large one.
+   * The default is 16 MiB.
+   */
+  vtkSetMacro(MinimumSize, size_t);
+  vtkGetMacro(MinimumSize, size_t);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the large blocks are backed by transparent huge pages.
+   * The default is on.
+   */
+  vtkSetMacro(UseHugePages, bool);
+  vtkGetMacro(UseHugePages, bool);
+  vtkBooleanMacro(UseHugePages, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the pages of the large blocks are first written by the
+   * threads of vtkSMPTools. The default is on.
+   */
+  vtkSetMacro(ParallelFirstTouch, bool);
+  vtkGetMacro(ParallelFirstTouch, bool);
+  vtkBooleanMacro(ParallelFirstTouch, bool);
+  //@}
+
+protected:
+  vtkLargeArrayAllocator();
+  ~vtkLargeArrayAllocator() override = default;
+
+  size_t MinimumSize;
+  bool UseHugePages;
+  bool ParallelFirstTouch;
+
+private:
+  vtkLargeArrayAllocator(const vtkLargeArrayAllocator&) = delete;
+  void operator=(const vtkLargeArrayAllocator&) = delete;
+};
+
+#endif
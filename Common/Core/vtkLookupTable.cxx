@@ -19,10 +19,13 @@
 #include "vtkMath.h"
 #include "vtkMathConfigure.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
 #include <cassert>
+#include <type_traits>
+#include <vector>
 
 const vtkIdType vtkLookupTable::REPEATED_LAST_COLOR_INDEX = 0;
 const vtkIdType vtkLookupTable::BELOW_RANGE_COLOR_INDEX = 1;
@@ -795,264 +798,134 @@ namespace
 {
 
 //----------------------------------------------------------------------------
+// Write the colors of n values in the output format, blending the alpha
+// component with the alpha of the table. The lookup gives the index of the
+// color of a value in the table.
+template <class T, class Lookup>
+void vtkLookupTableMapColors(const T* input, int inIncr, vtkIdType n, Lookup lookup,
+  const unsigned char* table, int outFormat, double alpha, unsigned char* output)
+{
+  const unsigned char* cptr;
+  if (outFormat == VTK_RGBA && alpha >= 1.0)
+  {
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      memcpy(output, table + 4 * lookup(*input), 4);
+      input += inIncr;
+      output += 4;
+    }
+  }
+  else if (outFormat == VTK_RGBA)
+  {
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      cptr = table + 4 * lookup(*input);
+      memcpy(output, cptr, 3);
+      output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
+      input += inIncr;
+      output += 4;
+    }
+  }
+  else if (outFormat == VTK_RGB)
+  {
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      memcpy(output, table + 4 * lookup(*input), 3);
+      input += inIncr;
+      output += 3;
+    }
+  }
+  else if (outFormat == VTK_LUMINANCE_ALPHA)
+  {
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      cptr = table + 4 * lookup(*input);
+      output[0] =
+        static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
+      output[1] = alpha < 1.0 ? static_cast<unsigned char>(cptr[3] * alpha + 0.5) : cptr[3];
+      input += inIncr;
+      output += 2;
+    }
+  }
+  else // outFormat == VTK_LUMINANCE
+  {
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      cptr = table + 4 * lookup(*input);
+      *output++ =
+        static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
+      input += inIncr;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// The values are split in chunks mapped by different threads. For 8 and 16
+// bit unsigned integers, the color indices of all the possible values are
+// computed once when there are more values than that, and looked up.
 template <class T>
 void vtkLookupTableMapData(vtkLookupTable* self, T* input, unsigned char* output, int length,
   int inIncr, int outFormat, TableParameters& p)
 {
-  int i = length;
   const double* range = self->GetTableRange();
-  const unsigned char* cptr;
-
-  // Resize the internal table to hold the special colors at the
-  // end. When this function is called repeatedly with the same size
-  // lookup table, memory reallocation will be done only one the first
-  // call if at all.
-
-  vtkUnsignedCharArray* lookupTable = self->GetTable();
-
-  const unsigned char* table = lookupTable->GetPointer(0);
+  const bool logScale = self->GetScale() == VTK_SCALE_LOG10;
+  double logRange[2] = { 0.0, 0.0 };
+  if (logScale)
+  {
+    vtkLookupTableLogRange(range, logRange);
+    vtkLookupShiftAndScale(logRange, p.NumColors, p.Shift, p.Scale);
+    p.Range[0] = logRange[0];
+    p.Range[1] = logRange[1];
+  }
+  else
+  {
+    vtkLookupShiftAndScale(range, p.NumColors, p.Shift, p.Scale);
+    p.Range[0] = range[0];
+    p.Range[1] = range[1];
+  }
 
-  double alpha = self->GetAlpha();
-  if (alpha >= 1.0) // no blending required
+  // The lookups keep copies of the parameters, which the writes of the
+  // colors cannot alias.
+  const TableParameters params = p;
+  const double tableRange[2] = { range[0], range[1] };
+  auto linearLookup = [params](T v) { return vtkLinearLookup(v, params); };
+  auto logLookup = [params, tableRange, logRange](T v) {
+    return vtkLinearLookup(vtkApplyLogScale(v, tableRange, logRange), params);
+  };
+
+  std::vector<vtkIdType> valueIndices;
+  const bool is8Bit = std::is_same<T, unsigned char>::value;
+  const bool is16Bit = std::is_same<T, unsigned short>::value;
+  if (is8Bit || (is16Bit && length > 65536))
   {
-    if (self->GetScale() == VTK_SCALE_LOG10)
+    valueIndices.resize(is8Bit ? 256 : 65536);
+    for (size_t i = 0; i < valueIndices.size(); ++i)
     {
-      double val;
-      double logRange[2];
-      vtkLookupTableLogRange(range, logRange);
-      vtkLookupShiftAndScale(logRange, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = logRange[0];
-      p.Range[1] = logRange[1];
-
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 4);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
-        }
-      }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // if log scale
-
-    else // not log scale
+      T v = static_cast<T>(i);
+      valueIndices[i] = logScale ? logLookup(v) : linearLookup(v);
+    }
+  }
+  const vtkIdType* indices = valueIndices.data();
+  auto tableLookup = [indices](T v) { return indices[static_cast<size_t>(v)]; };
+
+  const unsigned char* table = self->GetTable()->GetPointer(0);
+  const double alpha = self->GetAlpha();
+  vtkSMPTools::For(0, length, 4096, [&](vtkIdType begin, vtkIdType end) {
+    const T* in = input + begin * inIncr;
+    unsigned char* out = output + begin * outFormat;
+    if (!valueIndices.empty())
     {
-      vtkLookupShiftAndScale(range, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = range[0];
-      p.Range[1] = range[1];
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 4);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
-        }
-      }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // if not log lookup
-  }   // if blending not needed
-
-  else // blend with the specified alpha
-  {
-    if (self->GetScale() == VTK_SCALE_LOG10)
+      vtkLookupTableMapColors(in, inIncr, end - begin, tableLookup, table, outFormat, alpha, out);
+    }
+    else if (logScale)
     {
-      double val;
-      double logRange[2];
-      vtkLookupTableLogRange(range, logRange);
-      vtkLookupShiftAndScale(logRange, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = logRange[0];
-      p.Range[1] = logRange[1];
-
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = static_cast<unsigned char>(alpha * cptr[3] + 0.5);
-          input += inIncr;
-          output += 2;
-        }
-      }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // log scale with blending
-
-    else // no log scale with blending
+      vtkLookupTableMapColors(in, inIncr, end - begin, logLookup, table, outFormat, alpha, out);
+    }
+    else
     {
-      vtkLookupShiftAndScale(range, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = range[0];
-      p.Range[1] = range[1];
-
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
-          input += inIncr;
-          output += 2;
-        }
-      }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // no log scale
-  }   // alpha blending
+      vtkLookupTableMapColors(in, inIncr, end - begin, linearLookup, table, outFormat, alpha, out);
+    }
+  });
 }
 
 //----------------------------------------------------------------------------
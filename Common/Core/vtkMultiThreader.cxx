@@ -38,6 +38,191 @@ typedef vtkThreadFunctionType vtkExternCThreadFunctionType;
 #include <sys/types.h>
 #endif
 
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(VTK_USE_PTHREADS)
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Set in the pool threads, and in the thread executing on the pool.
+thread_local bool vtkMultiThreaderInPool = false;
+
+// The threads shared by the vtkMultiThreader instances using the pool. They
+// wait for the executions on a condition variable. Thread i of an execution
+// is pool thread i, the thread calling Execute() being thread 0.
+class vtkMultiThreaderPool
+{
+public:
+  vtkMultiThreaderPool() = default;
+  static vtkMultiThreaderPool& GetInstance();
+
+  ~vtkMultiThreaderPool();
+
+  // Call methods[i](&infos[i]) on thread i for i in [0, numThreads). Return
+  // false, without calling anything, when the pool is busy.
+  bool Execute(
+    int numThreads, const vtkThreadFunctionType* methods, vtkMultiThreader::ThreadInfo* infos);
+
+  // False in the child process of a fork() for the pool of the parent.
+  bool IsOwnedByThisProcess() const
+  {
+#if defined(VTK_USE_PTHREADS)
+    return this->ProcessId == getpid();
+#else
+    return true;
+#endif
+  }
+
+private:
+  vtkMultiThreaderPool(const vtkMultiThreaderPool&) = delete;
+  void operator=(const vtkMultiThreaderPool&) = delete;
+
+  void WorkerLoop(int threadId, unsigned long long generation);
+
+  std::mutex ExecuteMutex;
+  std::mutex Mutex;
+  std::condition_variable WakeUp;
+  std::condition_variable Done;
+  std::vector<std::thread> Threads;
+  unsigned long long Generation = 0;
+  int NumberOfThreads = 0;
+  int NumberOfBusyThreads = 0;
+  bool Stop = false;
+  const vtkThreadFunctionType* Methods = nullptr;
+  vtkMultiThreader::ThreadInfo* Infos = nullptr;
+#if defined(VTK_USE_PTHREADS)
+  pid_t ProcessId = getpid();
+#endif
+};
+
+// Owns the pool of the process. The child process of a fork() has none of
+// the threads of the pool of its parent, whose mutexes and condition
+// variables may be left in use by these threads. That pool can be neither
+// used nor destroyed, so it is leaked and the child creates its own. On
+// Windows, the static objects of a DLL are destroyed under the loader lock,
+// which the pool threads need to exit: the pool is not destroyed either,
+// its threads are terminated with the process.
+class vtkMultiThreaderPoolInstance
+{
+public:
+  ~vtkMultiThreaderPoolInstance()
+  {
+#if !defined(VTK_USE_WIN32_THREADS)
+    if (this->Pool && this->Pool->IsOwnedByThisProcess())
+    {
+      delete this->Pool;
+    }
+#endif
+  }
+
+  vtkMultiThreaderPool& Get()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (!this->Pool || !this->Pool->IsOwnedByThisProcess())
+    {
+      this->Pool = new vtkMultiThreaderPool;
+    }
+    return *this->Pool;
+  }
+
+private:
+  std::mutex Mutex;
+  vtkMultiThreaderPool* Pool = nullptr;
+};
+
+vtkMultiThreaderPool& vtkMultiThreaderPool::GetInstance()
+{
+  static vtkMultiThreaderPoolInstance instance;
+  return instance.Get();
+}
+
+vtkMultiThreaderPool::~vtkMultiThreaderPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Stop = true;
+  }
+  this->WakeUp.notify_all();
+  for (std::thread& thread : this->Threads)
+  {
+    thread.join();
+  }
+}
+
+// A new thread waits for the executions started after its creation.
+void vtkMultiThreaderPool::WorkerLoop(int threadId, unsigned long long generation)
+{
+  vtkMultiThreaderInPool = true;
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;)
+  {
+    this->WakeUp.wait(lock, [&] { return this->Stop || this->Generation != generation; });
+    if (this->Stop)
+    {
+      return;
+    }
+    generation = this->Generation;
+    if (threadId >= this->NumberOfThreads)
+    {
+      continue;
+    }
+
+    lock.unlock();
+    this->Methods[threadId]((void*)(&this->Infos[threadId]));
+    lock.lock();
+    if (--this->NumberOfBusyThreads == 0)
+    {
+      this->Done.notify_one();
+    }
+  }
+}
+
+bool vtkMultiThreaderPool::Execute(
+  int numThreads, const vtkThreadFunctionType* methods, vtkMultiThreader::ThreadInfo* infos)
+{
+  if (vtkMultiThreaderInPool)
+  {
+    return false;
+  }
+  std::unique_lock<std::mutex> executeLock(this->ExecuteMutex, std::try_to_lock);
+  if (!executeLock.owns_lock())
+  {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (int threadId = static_cast<int>(this->Threads.size()) + 1; threadId < numThreads;
+         ++threadId)
+    {
+      this->Threads.emplace_back(
+        &vtkMultiThreaderPool::WorkerLoop, this, threadId, this->Generation);
+    }
+    this->Methods = methods;
+    this->Infos = infos;
+    this->NumberOfThreads = numThreads;
+    this->NumberOfBusyThreads = numThreads - 1;
+    ++this->Generation;
+  }
+  this->WakeUp.notify_all();
+
+  vtkMultiThreaderInPool = true;
+  methods[0]((void*)(&infos[0]));
+  vtkMultiThreaderInPool = false;
+
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  this->Done.wait(lock, [this] { return this->NumberOfBusyThreads == 0; });
+  return true;
+}
+}
+#endif
+
 // Initialize static member that controls global maximum number of threads
 static int vtkMultiThreaderGlobalMaximumNumberOfThreads = 0;
 
@@ -67,6 +252,18 @@ void vtkMultiThreader::SetGlobalDefaultNumberOfThreads(int val)
   vtkMultiThreaderGlobalDefaultNumberOfThreads = val;
 }
 
+static bool vtkMultiThreaderGlobalDefaultUseThreadPool = false;
+
+void vtkMultiThreader::SetGlobalDefaultUseThreadPool(bool val)
+{
+  vtkMultiThreaderGlobalDefaultUseThreadPool = val;
+}
+
+bool vtkMultiThreader::GetGlobalDefaultUseThreadPool()
+{
+  return vtkMultiThreaderGlobalDefaultUseThreadPool;
+}
+
 int vtkMultiThreader::GetGlobalDefaultNumberOfThreads()
 {
   if (vtkMultiThreaderGlobalDefaultNumberOfThreads == 0)
@@ -141,6 +338,7 @@ vtkMultiThreader::vtkMultiThreader()
 
   this->SingleMethod = nullptr;
   this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->UseThreadPool = vtkMultiThreader::GetGlobalDefaultUseThreadPool();
 }
 
 vtkMultiThreader::~vtkMultiThreader()
@@ -218,6 +416,24 @@ void vtkMultiThreader::SingleMethodExecute()
     this->NumberOfThreads = vtkMultiThreaderGlobalMaximumNumberOfThreads;
   }
 
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+  if (this->UseThreadPool && this->NumberOfThreads > 1)
+  {
+    vtkThreadFunctionType methods[VTK_MAX_THREADS];
+    for (thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++)
+    {
+      methods[thread_loop] = this->SingleMethod;
+      this->ThreadInfoArray[thread_loop].UserData = this->SingleData;
+      this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+    }
+    if (vtkMultiThreaderPool::GetInstance().Execute(
+          this->NumberOfThreads, methods, this->ThreadInfoArray))
+    {
+      return;
+    }
+  }
+#endif
+
 #ifdef VTK_USE_WIN32_THREADS
   // Using CreateThread on Windows
   //
@@ -343,6 +559,22 @@ void vtkMultiThreader::MultipleMethodExecute()
     }
   }
 
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+  if (this->UseThreadPool && this->NumberOfThreads > 1)
+  {
+    for (thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++)
+    {
+      this->ThreadInfoArray[thread_loop].UserData = this->MultipleData[thread_loop];
+      this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+    }
+    if (vtkMultiThreaderPool::GetInstance().Execute(
+          this->NumberOfThreads, this->MultipleMethod, this->ThreadInfoArray))
+    {
+      return;
+    }
+  }
+#endif
+
 #ifdef VTK_USE_WIN32_THREADS
   // Using CreateThread on Windows
   //
@@ -623,6 +855,7 @@ void vtkMultiThreader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "Thread Count: " << this->NumberOfThreads << "\n";
+  os << indent << "Use Thread Pool: " << (this->UseThreadPool ? "On" : "Off") << "\n";
   os << indent
      << "Global Maximum Number Of Threads: " << vtkMultiThreaderGlobalMaximumNumberOfThreads
      << endl;
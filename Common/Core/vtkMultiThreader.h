@@ -20,6 +20,12 @@
  * execution using pthreads on POSIX systems, or Win32 threads on
  * Windows.  This class can be used to execute a single
  * method on multiple threads, or to specify a method per thread.
+ *
+ * By default SingleMethodExecute() and MultipleMethodExecute() create and
+ * join their threads at each call. With UseThreadPool on, they run on a
+ * pool of threads shared by all the instances instead, which are created
+ * once and woken up for each execution. This removes the cost of the
+ * thread creation from pipelines executing many small requests.
  */
 
 #ifndef vtkMultiThreader_h
@@ -134,6 +140,31 @@ public:
   static int GetGlobalDefaultNumberOfThreads();
   //@}
 
+  //@{
+  /**
+   * Run SingleMethodExecute() and MultipleMethodExecute() on the persistent
+   * thread pool. When the pool is already busy, for instance with an
+   * execution nested in another one, the threads are created as usual. A
+   * child process created by fork() starts a pool of its own. The pool
+   * threads are joined when the process exits, except on Windows where
+   * they are terminated with the process. The default is given by
+   * SetGlobalDefaultUseThreadPool().
+   */
+  vtkSetMacro(UseThreadPool, bool);
+  vtkGetMacro(UseThreadPool, bool);
+  vtkBooleanMacro(UseThreadPool, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the value which is used to initialize UseThreadPool in the
+   * constructor. The default is false. Turning it on before creating
+   * vtkThreadedImageAlgorithm filters makes them use the pool.
+   */
+  static void SetGlobalDefaultUseThreadPool(bool val);
+  static bool GetGlobalDefaultUseThreadPool();
+  //@}
+
   // These methods are excluded from wrapping 1) because the
   // wrapper gives up on them and 2) because they really shouldn't be
   // called from a script anyway.
@@ -200,6 +231,8 @@ protected:
   // The number of threads to use
   int NumberOfThreads;
 
+  bool UseThreadPool;
+
   // An array of thread info containing a thread id
   // (0, 1, 2, .. VTK_MAX_THREADS-1), the thread count, and a pointer
   // to void so that user data can be passed to each thread
@@ -1,10 +1,11 @@
 set(VTK_SMP_IMPLEMENTATION_TYPE "Sequential"
-  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, OpenMP or TBB")
+  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, STDThread, OpenMP or TBB")
 set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
   PROPERTY
-    STRINGS Sequential OpenMP TBB)
+    STRINGS Sequential STDThread OpenMP TBB)
 
 if (NOT (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP" OR
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread" OR
          VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB"))
   set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
     PROPERTY
@@ -60,6 +61,16 @@ elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
       "atomics implementation.")
   endif()
 
+elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread")
+  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/STDThread")
+  list(APPEND vtk_smp_sources
+    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.cxx")
+  list(APPEND vtk_smp_headers_to_configure
+    vtkSMPThreadLocal.h
+    vtkSMPThreadLocalImpl.h
+    vtkSMPToolsInternal.h)
+
 elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "Sequential")
   set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
   list(APPEND vtk_smp_sources
@@ -108,6 +119,9 @@ foreach (vtk_smp_header IN LISTS vtk_smp_headers_to_configure)
     "${CMAKE_CURRENT_BINARY_DIR}/${vtk_smp_header}")
 endforeach()
 
+list(APPEND vtk_smp_sources
+  vtkSMPToolsAPI.cxx)
 list(APPEND vtk_smp_headers
   vtkSMPTools.h
+  vtkSMPToolsAPI.h
   vtkSMPThreadLocalObject.h)
@@ -19,8 +19,10 @@
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
  * There are several back-end implementations of parallel functionality
- * (currently Sequential, TBB and X-Kaapi) that actual execution is
- * delegated to.
+ * (currently Sequential, STDThread, OpenMP and TBB) that actual execution
+ * is delegated to. The STDThread back-end runs the loops on a persistent pool
+ * of std::thread workers that steal chunks from each other, and needs no
+ * third party library.
  */
 
 #ifndef vtkSMPTools_h
@@ -30,8 +32,15 @@
 #include "vtkObject.h"
 
 #include "vtkSMPThreadLocal.h" // For Initialized
+#include "vtkSMPToolsAPI.h"      // For vtkSMPThreadSettings
 #include "vtkSMPToolsInternal.h"
 
+#include <algorithm>  // For std::fill and std::transform
+#include <functional> // For std::plus
+#include <iterator>   // For std::iterator_traits
+#include <string>     // For Config
+#include <vector>     // For the partial results of Reduce and the scans
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __VTK_WRAP__
 namespace vtk
@@ -79,18 +88,52 @@ public:
 template <typename Functor, bool Init>
 struct vtkSMPTools_FunctorInternal;
 
+// Run a loop in the calling thread, in chunks of grain iterations as the
+// Sequential back-end does.
+template <typename FunctorInternal>
+void vtkSMPTools_Serial_For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  if (grain <= 0)
+  {
+    grain = last - first;
+  }
+  for (vtkIdType from = first; from < last; from += grain)
+  {
+    fi.Execute(from, (last - from > grain) ? from + grain : last);
+  }
+}
+
+template <typename FunctorInternal>
+void vtkSMPTools_Dispatch_For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  if (vtk::detail::smp::ShouldRunSerially())
+  {
+    vtk::detail::smp::vtkSMPTools_Serial_For(first, last, grain, fi);
+  }
+  else
+  {
+    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, fi);
+  }
+}
+
 template <typename Functor>
 struct vtkSMPTools_FunctorInternal<Functor, false>
 {
   Functor& F;
+  vtkSMPThreadSettings Settings;
   vtkSMPTools_FunctorInternal(Functor& f)
     : F(f)
+    , Settings(vtk::detail::smp::GetLoopSettings())
   {
   }
-  void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    vtkSMPThreadSettingsScope scope(this->Settings);
+    this->F(first, last);
+  }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    vtk::detail::smp::vtkSMPTools_Dispatch_For(first, last, grain, *this);
   }
   vtkSMPTools_FunctorInternal<Functor, false>& operator=(
     const vtkSMPTools_FunctorInternal<Functor, false>&);
@@ -102,13 +145,16 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
 {
   Functor& F;
   vtkSMPThreadLocal<unsigned char> Initialized;
+  vtkSMPThreadSettings Settings;
   vtkSMPTools_FunctorInternal(Functor& f)
     : F(f)
     , Initialized(0)
+    , Settings(vtk::detail::smp::GetLoopSettings())
   {
   }
   void Execute(vtkIdType first, vtkIdType last)
   {
+    vtkSMPThreadSettingsScope scope(this->Settings);
     unsigned char& inited = this->Initialized.Local();
     if (!inited)
     {
@@ -119,7 +165,7 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    vtk::detail::smp::vtkSMPTools_Dispatch_For(first, last, grain, *this);
     this->F.Reduce();
   }
   vtkSMPTools_FunctorInternal<Functor, true>& operator=(
@@ -144,6 +190,40 @@ class vtkSMPTools_Lookup_For<Functor const>
 public:
   typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
 };
+
+// The blocks of Reduce() and of the scans. Their number only depends on the
+// size of the range, so that the results do not depend on the back-end or
+// on the number of threads, even for floating point values.
+struct vtkSMPTools_Blocks
+{
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks;
+
+  explicit vtkSMPTools_Blocks(vtkIdType size)
+    : Size(size)
+  {
+    const vtkIdType minBlockSize = 1024;
+    const vtkIdType maxNumberOfBlocks = 1024;
+    this->BlockSize = (size + maxNumberOfBlocks - 1) / maxNumberOfBlocks;
+    this->BlockSize = this->BlockSize > minBlockSize ? this->BlockSize : minBlockSize;
+    this->NumberOfBlocks = (size + this->BlockSize - 1) / this->BlockSize;
+  }
+
+  vtkIdType GetBegin(vtkIdType block) const { return block * this->BlockSize; }
+  vtkIdType GetEnd(vtkIdType block) const
+  {
+    return (block + 1) * this->BlockSize < this->Size ? (block + 1) * this->BlockSize : this->Size;
+  }
+};
+
+// A partial result of a block. The wrapper avoids std::vector<bool>, whose
+// elements cannot be written from several threads.
+template <typename T>
+struct vtkSMPTools_Partial
+{
+  T Value;
+};
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -224,10 +304,8 @@ public:
    * not required as it is automatically called before the first
    * execution of any parallel code. However, it can be used to
    * control the maximum number of threads used when the back-end
-   * supports it (currently Simple and TBB only). Make sure to call
+   * supports it (currently STDThread, OpenMP and TBB). Make sure to call
    * it before any other parallel operation.
-   * When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
-   * the number of threads used in the thread pool.
    */
   static void Initialize(int numThreads = 0);
 
@@ -239,6 +317,71 @@ public:
    */
   static int GetEstimatedNumberOfThreads();
 
+  //@{
+  /**
+   * Select the back-end running the loops. The back-ends are compiled in the
+   * code using vtkSMPTools, so the available ones are "Sequential" and the
+   * one selected at configure time by VTK_SMP_IMPLEMENTATION_TYPE. The
+   * VTK_SMP_BACKEND_IN_USE environment variable gives the initial back-end.
+   * SetBackend() returns false, and keeps the current back-end, when the
+   * requested one is not available.
+   */
+  static bool SetBackend(const char* backend);
+  static const char* GetBackend();
+  //@}
+
+  //@{
+  /**
+   * Allow the loops started from inside another loop to run in parallel.
+   * When disabled, a nested loop runs serially in the thread calling it, so
+   * that the outer loop alone uses the threads. The default is Off.
+   */
+  static void SetNestedParallelism(bool isNested);
+  static bool GetNestedParallelism();
+  //@}
+
+  /**
+   * Return true when called from inside a loop of vtkSMPTools.
+   */
+  static bool IsParallelScope();
+
+  /**
+   * The settings of LocalScope(). A default Config holds the current
+   * settings of the calling thread, the other constructors change one of
+   * them. A MaxNumberOfThreads of 0 keeps the thread count of Initialize().
+   * Config(const char*) makes a string literal select a back-end instead of
+   * converting to bool.
+   */
+  struct VTKCOMMONCORE_EXPORT Config
+  {
+    int MaxNumberOfThreads;
+    std::string Backend;
+    bool NestedParallelism;
+
+    Config();
+    Config(int maxNumberOfThreads);
+    Config(std::string backend);
+    Config(const char* backend);
+    Config(bool nestedParallelism);
+  };
+
+  /**
+   * Call lambda with the given settings. They apply to the loops started
+   * from lambda by the calling thread, and to the loops nested in them, but
+   * not to the other threads. MaxNumberOfThreads can only lower the thread
+   * count given to Initialize(). This lets code running in its own threads
+   * bound the threads used by each of its calls to VTK:
+   * \code
+   * vtkSMPTools::LocalScope(vtkSMPTools::Config{ 2 }, [&]() { filter->Update(); });
+   * \endcode
+   */
+  template <typename T>
+  static void LocalScope(Config const& config, T&& lambda)
+  {
+    vtk::detail::smp::vtkSMPThreadSettingsScope scope(vtkSMPTools::GetScopeSettings(config));
+    lambda();
+  }
+
   /**
    * A convenience method for sorting data. It is a drop in replacement for
    * std::sort(). Under the hood different methods are used. For example,
@@ -261,6 +404,205 @@ public:
   {
     vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end, comp);
   }
+
+  /**
+   * A parallel drop in replacement for std::transform(): store transform(x)
+   * for each element x of [inBegin, inEnd) in the range starting at
+   * outBegin. The iterators must be random access iterators, for instance
+   * the iterators of vtk::DataArrayValueRange().
+   */
+  template <typename InputIt, typename OutputIt, typename UnaryOp>
+  static OutputIt Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, UnaryOp transform)
+  {
+    vtkSMPTools::For(0, inEnd - inBegin, [&](vtkIdType begin, vtkIdType end) {
+      std::transform(inBegin + begin, inBegin + end, outBegin + begin, transform);
+    });
+    return outBegin + (inEnd - inBegin);
+  }
+
+  /**
+   * The binary version of Transform(): store transform(x, y) for each pair
+   * of elements of [inBegin1, inEnd1) and of the range starting at inBegin2.
+   */
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOp>
+  static OutputIt Transform(
+    InputIt1 inBegin1, InputIt1 inEnd1, InputIt2 inBegin2, OutputIt outBegin, BinaryOp transform)
+  {
+    vtkSMPTools::For(0, inEnd1 - inBegin1, [&](vtkIdType begin, vtkIdType end) {
+      std::transform(
+        inBegin1 + begin, inBegin1 + end, inBegin2 + begin, outBegin + begin, transform);
+    });
+    return outBegin + (inEnd1 - inBegin1);
+  }
+
+  /**
+   * A parallel drop in replacement for std::fill().
+   */
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtkSMPTools::For(0, end - begin, [&](vtkIdType first, vtkIdType last) {
+      std::fill(begin + first, begin + last, value);
+    });
+  }
+
+  //@{
+  /**
+   * Combine init and the transformed elements of [begin, end) with reduce,
+   * which must be associative. The range is split in blocks that only
+   * depend on its size and the partial results of the blocks are combined
+   * in order, so the result is the same for every back-end and thread count.
+   */
+  template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+  static T TransformReduce(InputIt begin, InputIt end, T init, BinaryOp reduce, UnaryOp transform)
+  {
+    const vtk::detail::smp::vtkSMPTools_Blocks blocks(end - begin);
+    std::vector<vtk::detail::smp::vtkSMPTools_Partial<T> > partials(
+      blocks.NumberOfBlocks, { init });
+    vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        InputIt it = begin + blocks.GetBegin(block);
+        const InputIt blockEnd = begin + blocks.GetEnd(block);
+        T value = transform(*it);
+        for (++it; it != blockEnd; ++it)
+        {
+          value = reduce(value, transform(*it));
+        }
+        partials[block].Value = value;
+      }
+    });
+    for (const auto& partial : partials)
+    {
+      init = reduce(init, partial.Value);
+    }
+    return init;
+  }
+  template <typename InputIt, typename T, typename BinaryOp>
+  static T Reduce(InputIt begin, InputIt end, T init, BinaryOp reduce)
+  {
+    return vtkSMPTools::TransformReduce(
+      begin, end, init, reduce, [](const T& value) { return value; });
+  }
+  template <typename InputIt, typename T>
+  static T Reduce(InputIt begin, InputIt end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  //@}
+
+  //@{
+  /**
+   * Parallel drop in replacements for std::inclusive_scan() and
+   * std::exclusive_scan(): element i of the output is the combination with
+   * op of the first i + 1, respectively i, input elements (and of init).
+   * op must be associative. The input is read twice, first to combine the
+   * elements of each block, then to write the output. The output may be the
+   * input, so a count pass followed by an in place ExclusiveScan() computes
+   * the offsets of the output of a filter without allocating anything else.
+   * As for Reduce(), the result does not depend on the number of threads.
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    const vtk::detail::smp::vtkSMPTools_Blocks blocks(end - begin);
+    if (blocks.NumberOfBlocks == 0)
+    {
+      return outBegin;
+    }
+    std::vector<vtk::detail::smp::vtkSMPTools_Partial<T> > carries(
+      blocks.NumberOfBlocks, { T(*begin) });
+    vtkSMPTools::ComputeCarries(begin, blocks, op, carries);
+    vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        InputIt it = begin + blocks.GetBegin(block);
+        const InputIt blockEnd = begin + blocks.GetEnd(block);
+        OutputIt out = outBegin + blocks.GetBegin(block);
+        T value = block == 0 ? T(*it) : op(carries[block].Value, *it);
+        *out = value;
+        for (++it, ++out; it != blockEnd; ++it, ++out)
+        {
+          value = op(value, *it);
+          *out = value;
+        }
+      }
+    });
+    return outBegin + (end - begin);
+  }
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    return vtkSMPTools::InclusiveScan(begin, end, outBegin, std::plus<T>());
+  }
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt ExclusiveScan(
+    InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    const vtk::detail::smp::vtkSMPTools_Blocks blocks(end - begin);
+    std::vector<vtk::detail::smp::vtkSMPTools_Partial<T> > carries(
+      blocks.NumberOfBlocks, { init });
+    vtkSMPTools::ComputeCarries(begin, blocks, op, carries);
+    vtkSMPTools::For(0, blocks.NumberOfBlocks, 1, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        InputIt it = begin + blocks.GetBegin(block);
+        const InputIt blockEnd = begin + blocks.GetEnd(block);
+        OutputIt out = outBegin + blocks.GetBegin(block);
+        T value = block == 0 ? init : op(init, carries[block].Value);
+        for (; it != blockEnd; ++it, ++out)
+        {
+          // Read the input before writing the output, which may be the same.
+          T next = op(value, *it);
+          *out = value;
+          value = next;
+        }
+      }
+    });
+    return outBegin + (end - begin);
+  }
+  template <typename InputIt, typename OutputIt, typename T>
+  static OutputIt ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, outBegin, init, std::plus<T>());
+  }
+  //@}
+
+private:
+  static vtk::detail::smp::vtkSMPThreadSettings GetScopeSettings(const Config& config);
+
+  // Combine the elements of each block but the last one, then scan these
+  // partial results serially: carries[i] becomes the combination of the
+  // elements of the blocks before block i. carries[0] is left untouched.
+  template <typename T, typename InputIt, typename BinaryOp>
+  static void ComputeCarries(InputIt begin, const vtk::detail::smp::vtkSMPTools_Blocks& blocks,
+    BinaryOp op, std::vector<vtk::detail::smp::vtkSMPTools_Partial<T> >& carries)
+  {
+    if (blocks.NumberOfBlocks < 2)
+    {
+      return;
+    }
+    const vtkIdType numBlocks = blocks.NumberOfBlocks - 1;
+    vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        InputIt it = begin + blocks.GetBegin(block);
+        const InputIt blockEnd = begin + blocks.GetEnd(block);
+        T value = *it;
+        for (++it; it != blockEnd; ++it)
+        {
+          value = op(value, *it);
+        }
+        carries[block + 1].Value = value;
+      }
+    });
+    for (vtkIdType block = 2; block < blocks.NumberOfBlocks; ++block)
+    {
+      carries[block].Value = op(carries[block - 1].Value, carries[block].Value);
+    }
+  }
 };
 
 #endif
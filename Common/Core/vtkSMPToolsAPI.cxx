@@ -0,0 +1,209 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsAPI.h"
+#include "vtkSMPTools.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+const char* vtkSMPSequentialBackend = "Sequential";
+
+bool vtkSMPIsBackendAvailable(const char* backend, bool& sequential)
+{
+  if (!backend)
+  {
+    return false;
+  }
+  if (vtksys::SystemTools::Strucmp(backend, vtkSMPSequentialBackend) == 0)
+  {
+    sequential = true;
+    return true;
+  }
+  if (vtksys::SystemTools::Strucmp(backend, VTK_SMP_BACKEND) == 0)
+  {
+    sequential = false;
+    return true;
+  }
+  return false;
+}
+
+// The global settings, the thread settings override them.
+struct vtkSMPGlobalSettings
+{
+  std::atomic<bool> Sequential;
+  std::atomic<bool> NestedParallelism;
+
+  vtkSMPGlobalSettings()
+    : Sequential(false)
+    , NestedParallelism(false)
+  {
+    bool sequential = false;
+    const char* backend = std::getenv("VTK_SMP_BACKEND_IN_USE");
+    if (vtkSMPIsBackendAvailable(backend, sequential))
+    {
+      this->Sequential = sequential;
+    }
+    else if (backend)
+    {
+      vtkGenericWarningMacro(
+        "VTK_SMP_BACKEND_IN_USE: the " << backend << " SMP back-end is not available.");
+    }
+  }
+};
+
+vtkSMPGlobalSettings& vtkSMPGetGlobalSettings()
+{
+  static vtkSMPGlobalSettings settings;
+  return settings;
+}
+
+bool vtkSMPIsSequential()
+{
+  const vtk::detail::smp::vtkSMPThreadSettings& settings = vtk::detail::smp::GetThreadSettings();
+  return settings.Sequential >= 0 ? settings.Sequential != 0
+                                  : vtkSMPGetGlobalSettings().Sequential.load();
+}
+}
+
+//--------------------------------------------------------------------------------
+vtk::detail::smp::vtkSMPThreadSettings& vtk::detail::smp::GetThreadSettings()
+{
+  static thread_local vtkSMPThreadSettings settings = { 0, -1, -1, false };
+  return settings;
+}
+
+//--------------------------------------------------------------------------------
+bool vtk::detail::smp::ShouldRunSerially()
+{
+  const vtkSMPThreadSettings& settings = vtk::detail::smp::GetThreadSettings();
+  return vtkSMPIsSequential() || settings.MaxNumberOfThreads == 1 ||
+    (settings.InParallelScope && !vtkSMPTools::GetNestedParallelism());
+}
+
+//--------------------------------------------------------------------------------
+int vtk::detail::smp::LimitNumberOfThreads(int numThreads)
+{
+  const vtkSMPThreadSettings& settings = vtk::detail::smp::GetThreadSettings();
+  if (vtkSMPIsSequential())
+  {
+    return 1;
+  }
+  if (settings.MaxNumberOfThreads > 0 && settings.MaxNumberOfThreads < numThreads)
+  {
+    return settings.MaxNumberOfThreads;
+  }
+  return numThreads;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  bool sequential = false;
+  if (!vtkSMPIsBackendAvailable(backend, sequential))
+  {
+    return false;
+  }
+  vtkSMPGetGlobalSettings().Sequential = sequential;
+  return true;
+}
+
+//--------------------------------------------------------------------------------
+const char* vtkSMPTools::GetBackend()
+{
+  return vtkSMPIsSequential() ? vtkSMPSequentialBackend : VTK_SMP_BACKEND;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  vtkSMPGetGlobalSettings().NestedParallelism = isNested;
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  const vtk::detail::smp::vtkSMPThreadSettings& settings = vtk::detail::smp::GetThreadSettings();
+  return settings.NestedParallelism >= 0 ? settings.NestedParallelism != 0
+                                         : vtkSMPGetGlobalSettings().NestedParallelism.load();
+}
+
+//--------------------------------------------------------------------------------
+bool vtkSMPTools::IsParallelScope()
+{
+  return vtk::detail::smp::GetThreadSettings().InParallelScope;
+}
+
+//--------------------------------------------------------------------------------
+vtk::detail::smp::vtkSMPThreadSettings vtkSMPTools::GetScopeSettings(const Config& config)
+{
+  vtk::detail::smp::vtkSMPThreadSettings settings = vtk::detail::smp::GetThreadSettings();
+  settings.MaxNumberOfThreads = config.MaxNumberOfThreads;
+  settings.NestedParallelism = config.NestedParallelism ? 1 : 0;
+  bool sequential = false;
+  if (vtkSMPIsBackendAvailable(config.Backend.c_str(), sequential))
+  {
+    settings.Sequential = sequential ? 1 : 0;
+  }
+  else
+  {
+    vtkGenericWarningMacro(
+      "LocalScope: the " << config.Backend << " SMP back-end is not available.");
+  }
+  return settings;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Config::Config()
+  : MaxNumberOfThreads(vtk::detail::smp::GetThreadSettings().MaxNumberOfThreads)
+  , Backend(vtkSMPTools::GetBackend())
+  , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+{
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Config::Config(int maxNumberOfThreads)
+  : Config()
+{
+  this->MaxNumberOfThreads = maxNumberOfThreads;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Config::Config(std::string backend)
+  : Config()
+{
+  this->Backend = backend;
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Config::Config(const char* backend)
+  : Config()
+{
+  if (backend)
+  {
+    this->Backend = backend;
+  }
+}
+
+//--------------------------------------------------------------------------------
+vtkSMPTools::Config::Config(bool nestedParallelism)
+  : Config()
+{
+  this->NestedParallelism = nestedParallelism;
+}
@@ -0,0 +1,98 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @file   vtkSMPToolsAPI.h
+ * @brief  Runtime settings shared by the vtkSMPTools back-ends.
+ *
+ * The settings given to vtkSMPTools::LocalScope() are kept per thread. The
+ * functors of vtkSMPTools::For() capture the settings of the thread starting
+ * the loop and install them in the threads executing it, so that nested
+ * loops follow the scope of the outer loop.
+ *
+ * @warning
+ * This is a private include file used by vtkSMPTools and its back-ends.
+ * Don't include it in your code.
+ */
+
+#ifndef vtkSMPToolsAPI_h
+#define vtkSMPToolsAPI_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+// The settings of a thread. A negative value, or 0 for MaxNumberOfThreads,
+// keeps the global setting.
+struct vtkSMPThreadSettings
+{
+  int MaxNumberOfThreads;
+  signed char Sequential;
+  signed char NestedParallelism;
+  bool InParallelScope;
+};
+
+VTKCOMMONCORE_EXPORT vtkSMPThreadSettings& GetThreadSettings();
+
+// The settings installed in the threads running a loop started by the
+// calling thread.
+inline vtkSMPThreadSettings GetLoopSettings()
+{
+  vtkSMPThreadSettings settings = GetThreadSettings();
+  settings.InParallelScope = true;
+  return settings;
+}
+
+// True when a loop started by the calling thread has to run serially: the
+// Sequential back-end is selected, the thread count is limited to 1, or the
+// loop is nested and nested parallelism is disabled.
+VTKCOMMONCORE_EXPORT bool ShouldRunSerially();
+
+// Limit the thread count of a back-end to the one of the current scope.
+VTKCOMMONCORE_EXPORT int LimitNumberOfThreads(int numThreads);
+
+// Install settings in the calling thread, and restore the previous ones on
+// destruction.
+class vtkSMPThreadSettingsScope
+{
+public:
+  explicit vtkSMPThreadSettingsScope(const vtkSMPThreadSettings& settings)
+    : Settings(GetThreadSettings())
+    , Previous(Settings)
+  {
+    this->Settings = settings;
+  }
+  ~vtkSMPThreadSettingsScope() { this->Settings = this->Previous; }
+
+private:
+  vtkSMPThreadSettingsScope(const vtkSMPThreadSettingsScope&) = delete;
+  void operator=(const vtkSMPThreadSettingsScope&) = delete;
+
+  vtkSMPThreadSettings& Settings;
+  vtkSMPThreadSettings Previous;
+};
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsAPI.h
@@ -157,6 +157,16 @@ public:
    **/
   void SetArrayFreeFunction(int comp, void (*callback)(void*));
 
+  //@{
+  /**
+   * Set/Get the allocator of the memory of the components, see
+   * vtkArrayAllocator. The default is the default allocator when the array is
+   * created. When there is none, the memory is allocated with malloc.
+   */
+  void SetAllocator(vtkArrayAllocator* allocator);
+  vtkArrayAllocator* GetAllocator() { return this->Allocator; }
+  //@}
+
   /**
    * Return a pointer to a contiguous block of memory containing all values for
    * a particular components (ie. a single array of the struct-of-arrays).
@@ -235,6 +245,7 @@ protected:
 
   std::vector<vtkBuffer<ValueType>*> Data;
   vtkBuffer<ValueType>* AoSCopy;
+  vtkSmartPointer<vtkArrayAllocator> Allocator;
 
 private:
   vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate&) = delete;
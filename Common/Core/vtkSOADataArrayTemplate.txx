@@ -34,6 +34,7 @@ vtkSOADataArrayTemplate<ValueType>* vtkSOADataArrayTemplate<ValueType>::New()
 template <class ValueType>
 vtkSOADataArrayTemplate<ValueType>::vtkSOADataArrayTemplate()
   : AoSCopy(nullptr)
+  , Allocator(vtkArrayAllocator::GetDefaultAllocator())
 {
 }
 
@@ -68,6 +69,22 @@ void vtkSOADataArrayTemplate<ValueType>::SetNumberOfComponents(int val)
   while (this->Data.size() < numComps)
   {
     this->Data.push_back(vtkBuffer<ValueType>::New());
+    this->Data.back()->SetAllocator(this->Allocator);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueType>
+void vtkSOADataArrayTemplate<ValueType>::SetAllocator(vtkArrayAllocator* allocator)
+{
+  this->Allocator = allocator;
+  for (vtkBuffer<ValueType>* buffer : this->Data)
+  {
+    buffer->SetAllocator(allocator);
+  }
+  if (this->AoSCopy)
+  {
+    this->AoSCopy->SetAllocator(allocator);
   }
 }
 
@@ -315,6 +332,7 @@ void* vtkSOADataArrayTemplate<ValueType>::GetVoidPointer(vtkIdType valueIdx)
   if (!this->AoSCopy)
   {
     this->AoSCopy = vtkBuffer<ValueType>::New();
+    this->AoSCopy->SetAllocator(this->Allocator);
   }
 
   if (!this->AoSCopy->Allocate(static_cast<vtkIdType>(numValues)))
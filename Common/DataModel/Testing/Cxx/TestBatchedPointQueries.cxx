@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBatchedPointQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batched queries of the point locators, evaluated
+// concurrently, give the results of the single queries, and that the
+// locators built in parallel find the closest points.
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* locator, const char* what)
+{
+  if (!condition)
+  {
+    std::cerr << locator << ": " << what << " failed\n";
+  }
+  return condition;
+}
+
+void RandomPoints(vtkPoints* points, vtkIdType numPoints, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  points->SetNumberOfPoints(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+bool SameIds(vtkCellArray* cells, vtkIdType cellId, vtkIdList* ids, bool sort)
+{
+  vtkIdType npts;
+  const vtkIdType* pts;
+  cells->GetCellAtId(cellId, npts, pts);
+  if (npts != ids->GetNumberOfIds())
+  {
+    return false;
+  }
+  std::vector<vtkIdType> batched(pts, pts + npts);
+  std::vector<vtkIdType> single(ids->GetPointer(0), ids->GetPointer(0) + npts);
+  if (sort)
+  {
+    std::sort(batched.begin(), batched.end());
+    std::sort(single.begin(), single.end());
+  }
+  return batched == single;
+}
+
+bool TestLocator(vtkAbstractPointLocator* locator, vtkPolyData* data, vtkPoints* queries)
+{
+  const char* name = locator->GetClassName();
+  locator->SetDataSet(data);
+  locator->BuildLocator();
+  bool success = true;
+
+  vtkNew<vtkIdList> closest;
+  locator->FindClosestPoints(queries, closest);
+  vtkNew<vtkCellArray> nClosest;
+  locator->FindClosestNPoints(5, queries, nClosest);
+  vtkNew<vtkCellArray> withinRadius;
+  locator->FindPointsWithinRadius(0.05, queries, withinRadius);
+  success &= Check(closest->GetNumberOfIds() == queries->GetNumberOfPoints() &&
+      nClosest->GetNumberOfCells() == queries->GetNumberOfPoints() &&
+      withinRadius->GetNumberOfCells() == queries->GetNumberOfPoints(),
+    name, "Number of results");
+  if (!success)
+  {
+    return false;
+  }
+
+  vtkNew<vtkIdList> ids;
+  bool closestOk = true, nClosestOk = true, radiusOk = true, bruteForceOk = true;
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    queries->GetPoint(i, x);
+    closestOk &= closest->GetId(i) == locator->FindClosestPoint(x);
+    locator->FindClosestNPoints(5, x, ids);
+    nClosestOk &= SameIds(nClosest, i, ids, false);
+    locator->FindPointsWithinRadius(0.05, x, ids);
+    radiusOk &= SameIds(withinRadius, i, ids, true);
+
+    if (i % 50 == 0)
+    {
+      double minDist2 = VTK_DOUBLE_MAX;
+      for (vtkIdType ptId = 0; ptId < data->GetNumberOfPoints(); ++ptId)
+      {
+        minDist2 = std::min(minDist2, vtkMath::Distance2BetweenPoints(x, data->GetPoint(ptId)));
+      }
+      // The trees store the points as floats.
+      double dist2 = vtkMath::Distance2BetweenPoints(x, data->GetPoint(closest->GetId(i)));
+      bruteForceOk &= dist2 <= minDist2 + 1e-6;
+    }
+  }
+  success &= Check(closestOk, name, "FindClosestPoints");
+  success &= Check(nClosestOk, name, "FindClosestNPoints");
+  success &= Check(radiusOk, name, "FindPointsWithinRadius");
+  success &= Check(bruteForceOk, name, "Closest point");
+  return success;
+}
+}
+
+int TestBatchedPointQueries(int, char*[])
+{
+  // Use several threads even on a single core.
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkPoints> points;
+  RandomPoints(points, 20000, 1);
+  vtkNew<vtkPolyData> data;
+  data->SetPoints(points);
+  vtkNew<vtkPoints> queries;
+  RandomPoints(queries, 1000, 2);
+
+  bool success = true;
+  success &= TestLocator(vtkSmartPointer<vtkPointLocator>::New(), data, queries);
+  success &= TestLocator(vtkSmartPointer<vtkKdTreePointLocator>::New(), data, queries);
+  success &= TestLocator(vtkSmartPointer<vtkOctreePointLocator>::New(), data, queries);
+  success &= TestLocator(vtkSmartPointer<vtkStaticPointLocator>::New(), data, queries);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
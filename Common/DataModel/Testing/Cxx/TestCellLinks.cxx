@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded build of vtkCellLinks gives the same links as the
+// serial one, and that the links can be edited afterwards.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Resolution = 40;
+
+bool Check(bool condition, const char* what)
+{
+  if (!condition)
+  {
+    std::cerr << what << " failed\n";
+  }
+  return condition;
+}
+
+vtkIdType PointId(int i, int j)
+{
+  return i + j * (Resolution + 1);
+}
+
+void AddPoints(vtkPointSet* data)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= Resolution; ++j)
+  {
+    for (int i = 0; i <= Resolution; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  data->SetPoints(points);
+}
+
+// Quads on the lower half, pairs of triangles on the upper half, lines
+// along the bottom edge and vertices on the left edge.
+void MakePolyData(vtkPolyData* pdata)
+{
+  AddPoints(pdata);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < Resolution; ++j)
+  {
+    verts->InsertNextCell({ PointId(0, j) });
+    for (int i = 0; i < Resolution; ++i)
+    {
+      if (j < Resolution / 2)
+      {
+        polys->InsertNextCell(
+          { PointId(i, j), PointId(i + 1, j), PointId(i + 1, j + 1), PointId(i, j + 1) });
+      }
+      else
+      {
+        polys->InsertNextCell({ PointId(i, j), PointId(i + 1, j), PointId(i + 1, j + 1) });
+        polys->InsertNextCell({ PointId(i, j), PointId(i + 1, j + 1), PointId(i, j + 1) });
+      }
+    }
+  }
+  for (int i = 0; i < Resolution; ++i)
+  {
+    lines->InsertNextCell({ PointId(i, 0), PointId(i + 1, 0) });
+  }
+  pdata->SetVerts(verts);
+  pdata->SetLines(lines);
+  pdata->SetPolys(polys);
+}
+
+void MakeUnstructuredGrid(vtkUnstructuredGrid* ugrid)
+{
+  AddPoints(ugrid);
+  ugrid->Allocate();
+  for (int j = 0; j < Resolution; ++j)
+  {
+    for (int i = 0; i < Resolution; ++i)
+    {
+      vtkIdType quad[4] = { PointId(i, j), PointId(i + 1, j), PointId(i + 1, j + 1),
+        PointId(i, j + 1) };
+      ugrid->InsertNextCell(VTK_QUAD, 4, quad);
+      ugrid->InsertNextCell(VTK_VERTEX, 1, quad);
+    }
+  }
+}
+
+bool SameLinks(vtkCellLinks* links, vtkCellLinks* expected, vtkIdType numPts)
+{
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (links->GetNcells(ptId) != expected->GetNcells(ptId))
+    {
+      return false;
+    }
+    for (vtkIdType i = 0; i < links->GetNcells(ptId); ++i)
+    {
+      if (links->GetCells(ptId)[i] != expected->GetCells(ptId)[i])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareBuilds(vtkDataSet* data, const char* what)
+{
+  vtkIdType numPts = data->GetNumberOfPoints();
+  vtkNew<vtkCellLinks> threaded;
+  threaded->Allocate(numPts);
+  threaded->BuildLinks(data);
+  vtkNew<vtkCellLinks> serial;
+  serial->SequentialProcessingOn();
+  serial->Allocate(numPts);
+  serial->BuildLinks(data);
+  return Check(SameLinks(threaded, serial, numPts), what);
+}
+
+bool TestBuilds()
+{
+  bool success = true;
+  vtkNew<vtkPolyData> pdata;
+  MakePolyData(pdata);
+  success &= CompareBuilds(pdata, "Polydata links");
+
+  // Cells of different types inserted in turns are not ordered as in the
+  // arrays, the serial build is used.
+  vtkNew<vtkPolyData> mixed;
+  AddPoints(mixed);
+  mixed->AllocateEstimate(2 * Resolution, 4);
+  for (int i = 0; i < Resolution; ++i)
+  {
+    vtkIdType quad[4] = { PointId(i, 0), PointId(i + 1, 0), PointId(i + 1, 1), PointId(i, 1) };
+    mixed->InsertNextCell(VTK_QUAD, 4, quad);
+    mixed->InsertNextCell(VTK_LINE, 2, quad);
+  }
+  success &= CompareBuilds(mixed, "Mixed polydata links");
+
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  MakeUnstructuredGrid(ugrid);
+  success &= CompareBuilds(ugrid, "Unstructured grid links");
+  return success;
+}
+
+bool TestEdits()
+{
+  bool success = true;
+  vtkNew<vtkPolyData> pdata;
+  MakePolyData(pdata);
+  pdata->BuildLinks();
+
+  vtkIdType corner = PointId(Resolution, Resolution);
+  vtkIdType ncells, ncellsBefore;
+  vtkIdType* cells;
+  pdata->GetPointCells(corner, ncellsBefore, cells);
+  vtkIdType tri[3] = { corner, PointId(Resolution, Resolution - 1), PointId(0, 0) };
+  vtkIdType cellId = pdata->InsertNextLinkedCell(VTK_TRIANGLE, 3, tri);
+  pdata->GetPointCells(corner, ncells, cells);
+  success &=
+    Check(ncells == ncellsBefore + 1 && cells[ncellsBefore] == cellId, "InsertNextLinkedCell");
+
+  pdata->RemoveCellReference(cellId);
+  pdata->GetPointCells(corner, ncells, cells);
+  success &= Check(ncells == ncellsBefore, "RemoveCellReference");
+
+  pdata->DeletePoint(corner);
+  pdata->GetPointCells(corner, ncells, cells);
+  success &= Check(ncells == 0, "DeletePoint");
+
+  // Copies do not share the lists.
+  vtkIdType numPts = pdata->GetNumberOfPoints();
+  vtkNew<vtkCellLinks> links;
+  links->Allocate(numPts);
+  links->BuildLinks(pdata);
+  vtkNew<vtkCellLinks> copy;
+  copy->DeepCopy(links);
+  success &= Check(SameLinks(copy, links, numPts), "DeepCopy");
+
+  vtkIdType ptId = links->InsertNextPoint(1);
+  links->InsertNextCellReference(ptId, cellId);
+  success &= Check(ptId == numPts && links->GetNcells(ptId) == 1 &&
+      links->GetCells(ptId)[0] == cellId && SameLinks(links, copy, numPts),
+    "InsertNextPoint");
+
+  // Lists not converted yet are dropped by Reset().
+  vtkNew<vtkCellLinks> reset;
+  reset->Allocate(numPts);
+  reset->BuildLinks(pdata);
+  reset->Reset();
+  success &= Check(reset->InsertNextPoint(1) == 0 && reset->GetNcells(0) == 0, "Reset");
+  return success;
+}
+}
+
+int TestCellLinks(int, char*[])
+{
+  // The threaded build is only used with several threads.
+  vtkSMPTools::Initialize(2);
+  bool success = true;
+  success &= TestBuilds();
+  success &= TestEdits();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
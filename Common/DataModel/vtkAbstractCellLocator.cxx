@@ -22,6 +22,28 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// The cell queries of vtkDataSet are thread safe once they have been called
+// from a single thread.
+void InitializeCellQueries(vtkDataSet* dataSet, vtkGenericCell* cell)
+{
+  if (dataSet && dataSet->GetNumberOfCells() > 0)
+  {
+    double bounds[6];
+    dataSet->GetCell(0, cell);
+    dataSet->GetCellBounds(0, bounds);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -51,11 +73,26 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  this->ComputeCellBounds(this->CellBounds);
+  return true;
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::ComputeCellBounds(double (*cellBounds)[6])
+{
+  vtkIdType numCells = this->DataSet->GetNumberOfCells();
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return;
   }
-  return true;
+  // GetCellBounds() is thread safe once it has been called from a single
+  // thread.
+  this->DataSet->GetCellBounds(0, cellBounds[0]);
+  vtkSMPTools::For(1, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      this->DataSet->GetCellBounds(cellId, cellBounds[cellId]);
+    }
+  });
 }
 //----------------------------------------------------------------------------
 void vtkAbstractCellLocator::FreeCellBounds()
@@ -179,6 +216,94 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 //----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(vtkPoints* points, vtkIdList* cellIds)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numPts);
+  if (numPts < 1)
+  {
+    return;
+  }
+
+  // The first query is done serially: it builds the locator if needed, as
+  // well as the structures of the data set the cell queries rely on.
+  std::vector<double> weights(
+    std::max(this->DataSet ? this->DataSet->GetMaxCellSize() : 0, VTK_CELL_SIZE));
+  InitializeCellQueries(this->DataSet, this->GenericCell);
+  auto findCells = [&](vtkIdType begin, vtkIdType end, vtkGenericCell* cell, double* w) {
+    double x[3], pcoords[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      points->GetPoint(ptId, x);
+      cellIds->SetId(ptId, this->FindCell(x, 0.0, cell, pcoords, w));
+    }
+  };
+  findCells(0, 1, this->GenericCell, weights.data());
+
+  if (this->IsFindCellThreadSafe())
+  {
+    vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+    vtkSMPThreadLocal<std::vector<double> > localWeights(weights);
+    vtkSMPTools::For(1, numPts, [&](vtkIdType begin, vtkIdType end) {
+      findCells(begin, end, localCell.Local(), localWeights.Local().data());
+    });
+  }
+  else
+  {
+    findCells(1, numPts, this->GenericCell, weights.data());
+  }
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(
+  vtkPoints* p1, vtkPoints* p2, double tol, vtkPoints* points, vtkIdList* cellIds)
+{
+  vtkIdType numLines = std::min(p1->GetNumberOfPoints(), p2->GetNumberOfPoints());
+  cellIds->SetNumberOfIds(numLines);
+  if (points)
+  {
+    points->SetNumberOfPoints(numLines);
+  }
+  if (numLines < 1)
+  {
+    return;
+  }
+
+  // The first query is done serially, see FindCells().
+  InitializeCellQueries(this->DataSet, this->GenericCell);
+  auto intersectLines = [&](vtkIdType begin, vtkIdType end, vtkGenericCell* cell) {
+    double a0[3], a1[3], x[3], pcoords[3], t;
+    int subId;
+    for (vtkIdType lineId = begin; lineId < end; lineId++)
+    {
+      p1->GetPoint(lineId, a0);
+      p2->GetPoint(lineId, a1);
+      vtkIdType cellId = -1;
+      if (!this->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+        std::copy(a1, a1 + 3, x);
+      }
+      cellIds->SetId(lineId, cellId);
+      if (points)
+      {
+        points->SetPoint(lineId, x);
+      }
+    }
+  };
+  intersectLines(0, 1, this->GenericCell);
+
+  if (this->IsIntersectWithLineThreadSafe())
+  {
+    vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+    vtkSMPTools::For(1, numLines,
+      [&](vtkIdType begin, vtkIdType end) { intersectLines(begin, end, localCell.Local()); });
+  }
+  else
+  {
+    intersectLines(1, numLines, this->GenericCell);
+  }
+}
+//----------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
   double cellBounds[6], delta[3] = { 0.0, 0.0, 0.0 };
@@ -248,6 +248,27 @@ public:
   virtual vtkIdType FindCell(
     double x[3], double tol2, vtkGenericCell* GenCell, double pcoords[3], double* weights);
 
+  /**
+   * Find the cells containing each of the given points, with a tolerance
+   * of zero. cellIds is resized to the number of points and receives -1 for
+   * the points outside of all the cells. The queries run in parallel with
+   * vtkSMPTools when the locator supports concurrent FindCell() calls, and
+   * serially otherwise.
+   */
+  virtual void FindCells(vtkPoints* points, vtkIdList* cellIds);
+
+  /**
+   * Intersect each of the finite lines (p1[i], p2[i]) with the cells of the
+   * locator, as IntersectWithLine() does. cellIds is resized to the number
+   * of lines and receives the id of the intersected cell, or -1 when the
+   * line does not hit any cell. If points is not null, it receives the
+   * intersection points, or p2[i] for the lines which do not hit any cell.
+   * The queries run in parallel with vtkSMPTools when the locator supports
+   * concurrent IntersectWithLine() calls, and serially otherwise.
+   */
+  virtual void IntersectWithLines(
+    vtkPoints* p1, vtkPoints* p2, double tol, vtkPoints* points, vtkIdList* cellIds);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -271,6 +292,23 @@ protected:
   virtual void FreeCellBounds();
   //@}
 
+  /**
+   * Compute the bounds of all the cells of the data set into cellBounds,
+   * in parallel with vtkSMPTools.
+   */
+  void ComputeCellBounds(double (*cellBounds)[6]);
+
+  //@{
+  /**
+   * Return whether FindCell() and IntersectWithLine(), in their versions
+   * taking a vtkGenericCell, can be called concurrently once the locator
+   * has been built. This decides whether FindCells() and
+   * IntersectWithLines() are threaded. Both return false by default.
+   */
+  virtual bool IsFindCellThreadSafe() { return false; }
+  virtual bool IsIntersectWithLineThreadSafe() { return false; }
+  //@}
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
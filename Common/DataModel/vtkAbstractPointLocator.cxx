@@ -14,8 +14,72 @@
 =========================================================================*/
 #include "vtkAbstractPointLocator.h"
 
+#include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Evaluate a query returning a list of ids for each point of queries, and
+// gather the lists in result. The queries are split into fixed blocks so
+// that the lists are gathered in the order of the queries whatever the
+// threads evaluating them.
+template <typename Query>
+void GatherQueries(vtkPoints* queries, vtkCellArray* result, Query query)
+{
+  const vtkIdType blockSize = 1024;
+  const vtkIdType numQueries = queries->GetNumberOfPoints();
+  const vtkIdType numBlocks = (numQueries + blockSize - 1) / blockSize;
+  std::vector<std::vector<vtkIdType> > blockIds(numBlocks);
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numQueries + 1);
+  vtkIdType* counts = offsets->GetPointer(1);
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    vtkNew<vtkIdList> ids;
+    double x[3];
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      const vtkIdType end = std::min((block + 1) * blockSize, numQueries);
+      for (vtkIdType i = block * blockSize; i < end; ++i)
+      {
+        queries->GetPoint(i, x);
+        query(x, ids);
+        counts[i] = ids->GetNumberOfIds();
+        blockIds[block].insert(
+          blockIds[block].end(), ids->GetPointer(0), ids->GetPointer(0) + counts[i]);
+      }
+    }
+  });
+
+  // Turn the counts into offsets
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    offsetsPtr[i + 1] += offsetsPtr[i];
+  }
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(offsetsPtr[numQueries]);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      std::copy(
+        blockIds[block].begin(), blockIds[block].end(), conn + offsetsPtr[block * blockSize]);
+    }
+  });
+  result->SetData(offsets, connectivity);
+}
+}
 
 //-----------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -64,6 +128,46 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(vtkPoints* queries, vtkIdList* result)
+{
+  const vtkIdType numQueries = queries->GetNumberOfPoints();
+  result->SetNumberOfIds(numQueries);
+  if (numQueries == 0)
+  {
+    return;
+  }
+
+  // The queries only read the locator once it is built.
+  this->BuildLocator();
+  vtkIdType* ids = result->GetPointer(0);
+  vtkSMPTools::For(0, numQueries, [this, queries, ids](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      queries->GetPoint(i, x);
+      ids[i] = this->FindClosestPoint(x);
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestNPoints(int N, vtkPoints* queries, vtkCellArray* result)
+{
+  this->BuildLocator();
+  GatherQueries(queries, result,
+    [this, N](const double x[3], vtkIdList* ids) { this->FindClosestNPoints(N, x, ids); });
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindPointsWithinRadius(
+  double R, vtkPoints* queries, vtkCellArray* result)
+{
+  this->BuildLocator();
+  GatherQueries(queries, result,
+    [this, R](const double x[3], vtkIdList* ids) { this->FindPointsWithinRadius(R, x, ids); });
+}
+
 //-----------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -23,6 +23,10 @@
  * and finding the closest point.  The points are provided from the specified
  * dataset input.
  *
+ * Batches of queries can be evaluated concurrently with vtkSMPTools by
+ * passing the query positions as vtkPoints to FindClosestPoints(),
+ * FindClosestNPoints() and FindPointsWithinRadius().
+ *
  * @sa
  * vtkPointLocator vtkStaticPointLocator vtkMergePoints
  */
@@ -33,7 +37,9 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkCellArray;
 class vtkIdList;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -89,6 +95,26 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   //@}
 
+  /**
+   * Find the closest point to each point of queries. The id of the point
+   * closest to queries->GetPoint(i) is returned in result->GetId(i). The
+   * locator is built first if needed, then the queries are evaluated
+   * concurrently with vtkSMPTools.
+   */
+  void FindClosestPoints(vtkPoints* queries, vtkIdList* result);
+
+  //@{
+  /**
+   * Batched versions of FindClosestNPoints() and FindPointsWithinRadius():
+   * the points found for queries->GetPoint(i) are returned as the i-th cell
+   * of result, in the order of the single queries. The locator is built
+   * first if needed, then the queries are evaluated concurrently with
+   * vtkSMPTools.
+   */
+  void FindClosestNPoints(int N, vtkPoints* queries, vtkCellArray* result);
+  void FindPointsWithinRadius(double R, vtkPoints* queries, vtkCellArray* result);
+  //@}
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
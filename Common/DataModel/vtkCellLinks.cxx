@@ -19,11 +19,83 @@
 #include "vtkGenericCell.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
+#include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 
 vtkStandardNewMacro(vtkCellLinks);
 
+namespace
+{
+// Index of the array of vtkPolyData holding the cells of the given type.
+int GetPolyDataArrayIndex(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+      return 0;
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+      return 1;
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_POLYGON:
+      return 2;
+    case VTK_TRIANGLE_STRIP:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+// Check that the cell ids of the polydata number the cells of the verts,
+// lines, polys and strips arrays one after the other, as after BuildCells().
+// Cells inserted out of this order, or deleted, make the check fail.
+bool HasOrderedCells(vtkPolyData* pdata)
+{
+  const vtkIdType numCells = pdata->GetNumberOfCells();
+  if (numCells == 0)
+  {
+    return false;
+  }
+  // Build the cells first, this is not thread safe.
+  pdata->GetCellType(0);
+
+  vtkIdType ends[4];
+  ends[0] = pdata->GetNumberOfVerts();
+  ends[1] = ends[0] + pdata->GetNumberOfLines();
+  ends[2] = ends[1] + pdata->GetNumberOfPolys();
+  ends[3] = numCells;
+
+  std::atomic<bool> ordered(true);
+  vtkSMPTools::For(0, numCells, [pdata, &ends, &ordered](vtkIdType begin, vtkIdType end) {
+    int index = 0;
+    while (ends[index] <= begin)
+    {
+      ++index;
+    }
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      while (ends[index] <= cellId)
+      {
+        ++index;
+      }
+      if (GetPolyDataArrayIndex(pdata->GetCellType(cellId)) != index)
+      {
+        ordered = false;
+        return;
+      }
+    }
+  });
+  return ordered;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkCellLinks::~vtkCellLinks()
 {
@@ -36,9 +108,17 @@ void vtkCellLinks::Initialize()
 {
   if (this->Array != nullptr)
   {
-    for (vtkIdType i = 0; i <= this->MaxId; i++)
+    if (this->LinkStorage)
+    {
+      delete[] this->LinkStorage;
+      this->LinkStorage = nullptr;
+    }
+    else
     {
-      delete[] this->Array[i].cells;
+      for (vtkIdType i = 0; i <= this->MaxId; i++)
+      {
+        delete[] this->Array[i].cells;
+      }
     }
 
     delete[] this->Array;
@@ -53,6 +133,8 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 
   this->Size = sz;
   delete[] this->Array;
+  delete[] this->LinkStorage;
+  this->LinkStorage = nullptr;
   this->Array = new vtkCellLinks::Link[sz];
   this->Extend = ext;
   this->MaxId = -1;
@@ -83,6 +165,14 @@ void vtkCellLinks::Squeeze()
 //----------------------------------------------------------------------------
 void vtkCellLinks::Reset()
 {
+  // The contiguous lists cannot be reused by InsertNextPoint(), drop them.
+  if (this->LinkStorage)
+  {
+    static vtkCellLinks::Link linkInit = { 0, nullptr };
+    std::fill_n(this->Array, this->MaxId + 1, linkInit);
+    delete[] this->LinkStorage;
+    this->LinkStorage = nullptr;
+  }
   this->MaxId = -1;
 }
 
@@ -134,6 +224,33 @@ void vtkCellLinks::BuildLinks(vtkDataSet* data)
   int j;
   vtkIdType cellId;
 
+  // Use the threaded build when the cells can be traversed in their arrays.
+  // With a single thread, the serial build is faster.
+  if (!this->SequentialProcessing && numCells > 0 &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
+  {
+    if (data->GetDataObjectType() == VTK_UNSTRUCTURED_GRID)
+    {
+      vtkCellArray* cells = static_cast<vtkUnstructuredGrid*>(data)->GetCells();
+      if (cells)
+      {
+        this->ThreadedBuildLinks(numPts, &cells, 1);
+        return;
+      }
+    }
+    else if (data->GetDataObjectType() == VTK_POLY_DATA)
+    {
+      vtkPolyData* pdata = static_cast<vtkPolyData*>(data);
+      if (HasOrderedCells(pdata))
+      {
+        vtkCellArray* cells[4] = { pdata->GetVerts(), pdata->GetLines(), pdata->GetPolys(),
+          pdata->GetStrips() };
+        this->ThreadedBuildLinks(numPts, cells, 4);
+        return;
+      }
+    }
+  }
+
   // fill out lists with number of references to cells
   std::vector<vtkIdType> linkLoc(numPts, 0);
 
@@ -202,11 +319,95 @@ void vtkCellLinks::BuildLinks(vtkDataSet* data)
   } // end else
 }
 
+//----------------------------------------------------------------------------
+// Build the links like vtkStaticCellLinksTemplate::ThreadedBuildLinks(), the
+// lists of the points pointing into a single allocation.
+void vtkCellLinks::ThreadedBuildLinks(
+  vtkIdType numPts, vtkCellArray* const* cellArrays, int numArrays)
+{
+  delete[] this->LinkStorage;
+  this->LinkStorage = nullptr;
+  if (this->Array == nullptr || this->Size < numPts)
+  {
+    this->Allocate(numPts, this->Extend);
+  }
+
+  // Count the uses of each point in parallel
+  std::atomic<vtkIdType>* counts = new std::atomic<vtkIdType>[numPts] {};
+  vtkIdType linksSize = 0;
+  for (int i = 0; i < numArrays; ++i)
+  {
+    vtkCellArray* cells = cellArrays[i];
+    linksSize += cells->GetNumberOfConnectivityIds();
+    vtkSMPTools::For(0, cells->GetNumberOfCells(), [cells, counts](vtkIdType begin, vtkIdType end) {
+      cells->Visit(vtkSCLT_detail::CountPoints{}, counts, begin, end);
+    });
+  }
+
+  // Perform prefix sum to determine offsets
+  std::vector<vtkIdType> offsets(numPts + 1);
+  offsets[0] = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    offsets[ptId + 1] = offsets[ptId] + counts[ptId];
+  }
+
+  // Now insert the cell ids, the counts going back to zero
+  this->LinkStorage = new vtkIdType[linksSize];
+  vtkIdType* links = this->LinkStorage;
+  const vtkIdType* offsetsPtr = offsets.data();
+  vtkIdType cellOffset = 0;
+  for (int i = 0; i < numArrays; ++i)
+  {
+    vtkCellArray* cells = cellArrays[i];
+    vtkSMPTools::For(0, cells->GetNumberOfCells(),
+      [cells, counts, links, offsetsPtr, cellOffset](vtkIdType begin, vtkIdType end) {
+        cells->Visit(vtkSCLT_detail::BuildLinksThreaded{}, offsetsPtr, counts, links, begin, end,
+          cellOffset);
+      });
+    cellOffset += cells->GetNumberOfCells();
+  }
+  delete[] counts;
+
+  // The threads insert the cell ids in any order, sort them so that the
+  // lists are the same as the ones of the serial build.
+  vtkCellLinks::Link* array = this->Array;
+  vtkSMPTools::For(0, numPts, [array, links, offsetsPtr](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      array[ptId].ncells = offsetsPtr[ptId + 1] - offsetsPtr[ptId];
+      array[ptId].cells = links + offsetsPtr[ptId];
+      std::sort(array[ptId].cells, array[ptId].cells + array[ptId].ncells);
+    }
+  });
+  this->MaxId = numPts - 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::ConvertToEditable()
+{
+  vtkCellLinks::Link* array = this->Array;
+  vtkSMPTools::For(0, this->MaxId + 1, [array](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      vtkIdType* cells = new vtkIdType[array[ptId].ncells];
+      std::copy_n(array[ptId].cells, array[ptId].ncells, cells);
+      array[ptId].cells = cells;
+    }
+  });
+  delete[] this->LinkStorage;
+  this->LinkStorage = nullptr;
+}
+
 //----------------------------------------------------------------------------
 // Insert a new point into the cell-links data structure. The size parameter
 // is the initial size of the list.
 vtkIdType vtkCellLinks::InsertNextPoint(int numLinks)
 {
+  if (this->LinkStorage)
+  {
+    this->ConvertToEditable();
+  }
   if (++this->MaxId >= this->Size)
   {
     this->Resize(this->MaxId + 1);
@@ -236,8 +437,16 @@ unsigned long vtkCellLinks::GetActualMemorySize()
 void vtkCellLinks::DeepCopy(vtkAbstractCellLinks* src)
 {
   vtkCellLinks* clinks = static_cast<vtkCellLinks*>(src);
+  this->Initialize();
   this->Allocate(clinks->Size, clinks->Extend);
-  memcpy(this->Array, clinks->Array, this->Size * sizeof(vtkCellLinks::Link));
+  // Copy the lists themselves, they are owned by each object.
+  for (vtkIdType ptId = 0; ptId <= clinks->MaxId; ++ptId)
+  {
+    const vtkCellLinks::Link& link = clinks->Array[ptId];
+    this->Array[ptId].ncells = link.ncells;
+    this->Array[ptId].cells = new vtkIdType[link.ncells];
+    std::copy_n(link.cells, link.ncells, this->Array[ptId].cells);
+  }
   this->MaxId = clinks->MaxId;
 }
 
@@ -22,6 +22,14 @@
  * using the point. The information provided by this object can be used to
  * determine neighbors and construct other local topological information.
  *
+ * Unless SequentialProcessing is on, BuildLinks() builds the links of
+ * unstructured grids, and of polydata whose cells are ordered as verts,
+ * lines, polys then strips, in parallel with vtkSMPTools. The lists of cell
+ * ids are then stored contiguously like in vtkStaticCellLinksTemplate, and
+ * are only copied to separate, editable lists on the first call modifying
+ * them (InsertNextPoint(), DeletePoint(), ResizeCellList()). In both cases
+ * the cell ids of a list are in increasing order.
+ *
  * @warning
  * vtkCellLinks supports incremental (i.e., "editable") operations such as
  * inserting a new cell, or deleting a point. Because of this, it is less
@@ -163,6 +171,7 @@ protected:
     , Size(0)
     , MaxId(-1)
     , Extend(1000)
+    , LinkStorage(nullptr)
   {
   }
   ~vtkCellLinks() override;
@@ -174,6 +183,19 @@ protected:
 
   void AllocateLinks(vtkIdType n);
 
+  /**
+   * Build the links of numPts points from the cells of the arrays in
+   * parallel, the cells being numbered consecutively from the first array
+   * to the last one. The lists are stored in LinkStorage.
+   */
+  void ThreadedBuildLinks(vtkIdType numPts, vtkCellArray* const* cellArrays, int numArrays);
+
+  /**
+   * Copy the lists stored in LinkStorage to separately allocated lists, so
+   * that they can be resized or deleted.
+   */
+  void ConvertToEditable();
+
   /**
    * Insert a cell id into the list of cells using the point.
    */
@@ -184,6 +206,7 @@ protected:
   vtkIdType MaxId;            // maximum index inserted thus far
   vtkIdType Extend;           // grow array by this point
   Link* Resize(vtkIdType sz); // function to resize data
+  vtkIdType* LinkStorage;     // contiguous lists of a threaded build, if any
 
 private:
   vtkCellLinks(const vtkCellLinks&) = delete;
@@ -199,6 +222,10 @@ inline void vtkCellLinks::InsertCellReference(vtkIdType ptId, vtkIdType pos, vtk
 //----------------------------------------------------------------------------
 inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 {
+  if (this->LinkStorage)
+  {
+    this->ConvertToEditable();
+  }
   this->Array[ptId].ncells = 0;
   delete[] this->Array[ptId].cells;
   this->Array[ptId].cells = nullptr;
@@ -239,6 +266,10 @@ inline void vtkCellLinks::AddCellReference(vtkIdType cellId, vtkIdType ptId)
 //----------------------------------------------------------------------------
 inline void vtkCellLinks::ResizeCellList(vtkIdType ptId, int size)
 {
+  if (this->LinkStorage)
+  {
+    this->ConvertToEditable();
+  }
   vtkIdType newSize = this->Array[ptId].ncells + size;
   vtkIdType* cells = new vtkIdType[newSize];
   memcpy(cells, this->Array[ptId].cells,
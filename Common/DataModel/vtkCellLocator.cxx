@@ -22,6 +22,7 @@
 #include "vtkPolyData.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -1189,7 +1190,7 @@ void vtkCellLocator::ForceBuildLocator()
 //
 void vtkCellLocator::BuildLocatorInternal()
 {
-  double length, cellBounds[6], *boundsPtr;
+  double length, *boundsPtr;
   vtkIdType numCells;
   int ndivs, product;
   int i, j, k, ijkMin[3], ijkMax[3];
@@ -1259,9 +1260,20 @@ void vtkCellLocator::BuildLocatorInternal()
   this->ClearCellHasBeenVisited();
   this->QueryNumber = 0;
 
+  // The bounds of the cells are computed in parallel beforehand, the
+  // insertion in the octants is serial.
+  std::vector<double> tempCellBounds;
+  double(*allCellBounds)[6];
   if (this->CacheCellBounds)
   {
     this->StoreCellBounds();
+    allCellBounds = this->CellBounds;
+  }
+  else
+  {
+    tempCellBounds.resize(6 * numCells);
+    allCellBounds = reinterpret_cast<double(*)[6]>(tempCellBounds.data());
+    this->ComputeCellBounds(allCellBounds);
   }
 
   //  Compute width of leaf octant in three directions
@@ -1277,17 +1289,9 @@ void vtkCellLocator::BuildLocatorInternal()
   //
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  boundsPtr = cellBounds;
   for (cellId = 0; cellId < numCells; cellId++)
   {
-    if (this->CellBounds)
-    {
-      boundsPtr = this->CellBounds[cellId];
-    }
-    else
-    {
-      this->DataSet->GetCellBounds(cellId, cellBounds);
-    }
+    boundsPtr = allCellBounds[cellId];
 
     // find min/max locations of bounding box
     for (i = 0; i < 3; i++)
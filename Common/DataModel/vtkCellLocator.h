@@ -33,7 +33,9 @@
  *
  * @warning
  * Most of the methods of this class are not thread-safe. For a thread-safe,
- * more efficient generic implementation, please use vtkStaticCellLocator
+ * more efficient generic implementation, please use vtkStaticCellLocator.
+ * FindCell() is the exception: once the locator is built it only reads the
+ * octree, so FindCells() answers its queries in parallel.
  *
  * @sa
  * vtkLocator vtkPointLocator vtkOBBTree vtkStaticCellLocator
@@ -180,6 +182,8 @@ protected:
   double Distance2ToBucket(const double x[3], int nei[3]);
   double Distance2ToBounds(const double x[3], double bounds[6]);
 
+  bool IsFindCellThreadSafe() override { return true; }
+
   int NumberOfOctants;   // number of octants in tree
   double Bounds[6];      // bounding box root octant
   int NumberOfParents;   // number of parent octants
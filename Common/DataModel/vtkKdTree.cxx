@@ -40,6 +40,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -49,6 +50,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace
 {
@@ -117,6 +119,24 @@ static void LastInputDeletedCallback(vtkObject* vtkNotUsed(caller), unsigned lon
 // helper class for ordering the points in vtkKdTree::FindClosestNPoints()
 namespace
 {
+// Collect the leaf regions whose data bounds intersect the sphere. Unlike
+// vtkBSPIntersections::IntersectsSphere2(), this does not modify the tree,
+// so that the point queries can be evaluated concurrently.
+int FindRegionsInSphere(vtkKdNode* node, int* ids, double x, double y, double z, double r2)
+{
+  if (!node->IntersectsSphere2(x, y, z, r2, 1))
+  {
+    return 0;
+  }
+  if (node->GetLeft() == nullptr)
+  {
+    ids[0] = node->GetID();
+    return 1;
+  }
+  int nLeft = FindRegionsInSphere(node->GetLeft(), ids, x, y, z, r2);
+  return nLeft + FindRegionsInSphere(node->GetRight(), ids + nLeft, x, y, z, r2);
+}
+
 class OrderPoints
 {
 public:
@@ -1228,7 +1248,52 @@ int vtkKdTree::DivideTest(int size, int level)
   return 1;
 }
 //----------------------------------------------------------------------------
+// The regions of a level own disjoint ranges of the points, so the tree is
+// built one level at a time, the regions of each level being divided
+// concurrently.
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+  };
+  std::vector<Region> regions(1, Region{ kd, c1, ids });
+
+  for (; !regions.empty(); ++level)
+  {
+    std::vector<Region> children(2 * regions.size(), Region{ nullptr, nullptr, nullptr });
+    vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+      [this, &regions, &children, level](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          const Region& region = regions[i];
+          if (this->SplitRegion(region.Node, region.Points, region.Ids, level))
+          {
+            int nleft = region.Node->GetLeft()->GetNumberOfPoints();
+            children[2 * i] = Region{ region.Node->GetLeft(), region.Points, region.Ids };
+            children[2 * i + 1] = Region{ region.Node->GetRight(), region.Points + nleft * 3,
+              region.Ids ? region.Ids + nleft : nullptr };
+          }
+        }
+      });
+
+    regions.clear();
+    for (const Region& child : children)
+    {
+      if (child.Node)
+      {
+        regions.push_back(child);
+      }
+    }
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKdTree::SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1288,16 +1353,7 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
     return 0; // unable to divide region further
   }
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
-
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
-
-  return 0;
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -1809,38 +1865,41 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
     int npoints = ptArrays[i]->GetNumberOfPoints();
     int nvals = npoints * 3;
 
-    int pointArrayType = ptArrays[i]->GetDataType();
-
-    if (pointArrayType == VTK_FLOAT)
+    vtkDataArray* da = ptArrays[i]->GetData();
+    float* arrayPoints = points + ptId;
+    vtkFloatArray* fa = vtkArrayDownCast<vtkFloatArray>(da);
+    if (fa)
     {
-      vtkDataArray* da = ptArrays[i]->GetData();
-      vtkFloatArray* fa = vtkArrayDownCast<vtkFloatArray>(da);
-      memcpy(points + ptId, fa->GetPointer(0), sizeof(float) * nvals);
-      ptId += nvals;
+      memcpy(arrayPoints, fa->GetPointer(0), sizeof(float) * nvals);
     }
     else
     {
       // Hopefully point arrays are usually floats.  This conversion will
-      // really slow things down.
+      // really slow things down, convert them in parallel.
 
-      for (vtkIdType ii = 0; ii < npoints; ii++)
-      {
-        double* pt = ptArrays[i]->GetPoint(ii);
+      vtkSMPTools::For(0, npoints, [da, arrayPoints](vtkIdType begin, vtkIdType end) {
+        double pt[3];
+        for (vtkIdType ii = begin; ii < end; ii++)
+        {
+          da->GetTuple(ii, pt);
 
-        points[ptId++] = static_cast<float>(pt[0]);
-        points[ptId++] = static_cast<float>(pt[1]);
-        points[ptId++] = static_cast<float>(pt[2]);
-      }
+          arrayPoints[3 * ii] = static_cast<float>(pt[0]);
+          arrayPoints[3 * ii + 1] = static_cast<float>(pt[1]);
+          arrayPoints[3 * ii + 2] = static_cast<float>(pt[2]);
+        }
+      });
     }
+    ptId += nvals;
   }
 
-  for (ptId = 0; ptId < totalNumPoints; ptId++)
-  {
-    // _Select dominates DivideRegion algorithm, operating on
-    // ints is much fast than operating on long longs
-
-    ptIds[ptId] = ptId;
-  }
+  // _Select dominates DivideRegion algorithm, operating on
+  // ints is much fast than operating on long longs
+  vtkSMPTools::For(0, totalNumPoints, [ptIds](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; id++)
+    {
+      ptIds[id] = static_cast<int>(id);
+    }
+  });
 
   TIMERDONE("Set up to build k-d tree");
 
@@ -2354,12 +2413,7 @@ int vtkKdTree::FindClosestPointInSphere(
   }
   int* regionIds = new int[this->NumberOfRegions];
 
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOn();
-
-  int nRegions = this->BSPCalculator->IntersectsSphere2(
-    regionIds, this->NumberOfRegions, x, y, z, radius * radius);
-
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOff();
+  int nRegions = FindRegionsInSphere(this->Top, regionIds, x, y, z, radius * radius);
 
   double minDistance2 = 4 * this->MaxWidth * this->MaxWidth;
   int localCloseId = -1;
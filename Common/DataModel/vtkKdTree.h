@@ -776,6 +776,9 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  // Split one region in two, return 1 if it was divided
+  int SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
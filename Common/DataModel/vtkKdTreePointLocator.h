@@ -39,6 +39,10 @@ public:
   static vtkKdTreePointLocator* New();
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindClosestNPoints;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
   /**
    * Given a position x, return the id of the point closest to it. Alternative
    * method requires separate x-y-z values.
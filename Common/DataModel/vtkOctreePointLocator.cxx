@@ -32,6 +32,7 @@
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <list>
 #include <map>
@@ -242,15 +243,55 @@ int vtkOctreePointLocator::DivideTest(int size, int level)
 }
 
 //----------------------------------------------------------------------------
+// The octants of a level own disjoint ranges of the ordering, so the octree
+// is built one level at a time, the octants of each level being divided
+// concurrently.
 void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* ordering, int level)
 {
-  if (!this->DivideTest(node->GetNumberOfPoints(), level))
+  typedef std::pair<vtkOctreePointLocatorNode*, int*> Octant;
+  std::vector<Octant> octants(1, Octant(node, ordering));
+
+  for (; !octants.empty(); ++level)
   {
-    return;
+    std::vector<Octant> children(8 * octants.size(), Octant(nullptr, nullptr));
+    vtkSMPTools::For(0, static_cast<vtkIdType>(octants.size()), 1,
+      [this, &octants, &children, level](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          vtkOctreePointLocatorNode* octant = octants[i].first;
+          if (this->SplitRegion(octant, octants[i].second, level))
+          {
+            int counter = 0;
+            for (int j = 0; j < 8; j++)
+            {
+              children[8 * i + j] = Octant(octant->GetChild(j), octants[i].second + counter);
+              counter += octant->GetChild(j)->GetNumberOfPoints();
+            }
+          }
+        }
+      });
+
+    octants.clear();
+    for (const Octant& child : children)
+    {
+      if (child.first)
+      {
+        octants.push_back(child);
+      }
+    }
+    if (!octants.empty() && level >= this->Level)
+    {
+      this->Level = level + 1;
+    }
   }
-  if (level >= this->Level)
+}
+
+//----------------------------------------------------------------------------
+int vtkOctreePointLocator::SplitRegion(vtkOctreePointLocatorNode* node, int* ordering, int level)
+{
+  if (!this->DivideTest(node->GetNumberOfPoints(), level))
   {
-    this->Level = level + 1;
+    return 0;
   }
 
   node->CreateChildNodes();
@@ -260,9 +301,11 @@ void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* o
   std::vector<int> points[7];
   int i;
   int subOctantNumberOfPoints[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  double pt[3];
   for (i = 0; i < numberOfPoints; i++)
   {
-    int index = node->GetSubOctantIndex(ds->GetPoint(ordering[i]), 0);
+    ds->GetPoint(ordering[i], pt);
+    int index = node->GetSubOctantIndex(pt, 0);
     if (index)
     {
       points[index - 1].push_back(ordering[i]);
@@ -283,13 +326,11 @@ void vtkOctreePointLocator::DivideRegion(vtkOctreePointLocatorNode* node, int* o
       memcpy(ordering + counter, &(points[i][0]), subOctantNumberOfPoints[i + 1] * sizeOfInt);
     }
   }
-  counter = 0;
   for (i = 0; i < 8; i++)
   {
     node->GetChild(i)->SetNumberOfPoints(subOctantNumberOfPoints[i]);
-    this->DivideRegion(node->GetChild(i), ordering + counter, level + 1);
-    counter += subOctantNumberOfPoints[i];
   }
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -407,14 +448,17 @@ void vtkOctreePointLocator::BuildLocator()
   // is of type float and directly copy that instead of dealing with
   // all of the casts
   vtkDataSet* ds = this->GetDataSet();
-  for (i = 0; i < numPoints; i++)
-  {
-    double* pt = ds->GetPoint(this->LocatorIds[i]);
+  vtkSMPTools::For(0, numPoints, [this, ds](vtkIdType begin, vtkIdType end) {
+    double pt[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      ds->GetPoint(this->LocatorIds[ptId], pt);
 
-    this->LocatorPoints[i * 3] = static_cast<float>(pt[0]);
-    this->LocatorPoints[i * 3 + 1] = static_cast<float>(pt[1]);
-    this->LocatorPoints[i * 3 + 2] = static_cast<float>(pt[2]);
-  }
+      this->LocatorPoints[ptId * 3] = static_cast<float>(pt[0]);
+      this->LocatorPoints[ptId * 3 + 1] = static_cast<float>(pt[1]);
+      this->LocatorPoints[ptId * 3 + 2] = static_cast<float>(pt[2]);
+    }
+  });
 
   int nextLeafNodeId = 0;
   int nextMinId = 0;
@@ -119,6 +119,10 @@ public:
    */
   void BuildLocator() override;
 
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindClosestNPoints;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
   //@{
   /**
    * Return the Id of the point that is closest to the given point.
@@ -226,6 +230,9 @@ protected:
 
   void DivideRegion(vtkOctreePointLocatorNode* node, int* ordering, int level);
 
+  // Split one region in eight octants, return 1 if it was divided
+  int SplitRegion(vtkOctreePointLocatorNode* node, int* ordering, int level);
+
   int DivideTest(int size, int level);
 
   void AddPolys(vtkOctreePointLocatorNode* node, vtkPoints* pts, vtkCellArray* polys);
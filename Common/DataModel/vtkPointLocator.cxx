@@ -21,8 +21,10 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> //std::sort
+#include <vector>
 
 vtkStandardNewMacro(vtkPointLocator);
 
@@ -825,10 +827,7 @@ void vtkPointLocator::FindPointsWithinRadius(double R, const double x[3], vtkIdL
 void vtkPointLocator::BuildLocator()
 {
   int ndivs[3];
-  vtkIdType idx;
-  vtkIdList* bucket;
   vtkIdType numPts;
-  double x[3];
   typedef vtkIdList* vtkIdListPtr;
 
   if ((this->HashTable != nullptr) && (this->BuildTime > this->MTime) &&
@@ -897,21 +896,50 @@ void vtkPointLocator::BuildLocator()
   this->ComputePerformanceFactors();
 
   //  Insert each point into the appropriate bucket.  Make sure point
-  //  falls within bucket.
+  //  falls within bucket. The buckets of the points are computed in
+  //  parallel, then the points are sorted by bucket, keeping them in
+  //  increasing order within a bucket.
   //
+  std::vector<vtkIdType> pointBuckets(numPts);
+  vtkSMPTools::For(0, numPts, [this, &pointBuckets](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->DataSet->GetPoint(i, x);
+      pointBuckets[i] = this->GetBucketIndex(x);
+    }
+  });
+
+  std::vector<vtkIdType> offsets(numBuckets + 1, 0);
+  for (vtkIdType idx : pointBuckets)
+  {
+    ++offsets[idx + 1];
+  }
+  for (vtkIdType idx = 0; idx < numBuckets; ++idx)
+  {
+    offsets[idx + 1] += offsets[idx];
+  }
+  std::vector<vtkIdType> sortedIds(numPts);
+  std::vector<vtkIdType> next(offsets.begin(), offsets.end() - 1);
   for (vtkIdType i = 0; i < numPts; ++i)
   {
-    this->DataSet->GetPoint(i, x);
-    idx = this->GetBucketIndex(x);
-    bucket = this->HashTable[idx];
-    if (!bucket)
+    sortedIds[next[pointBuckets[i]]++] = i;
+  }
+
+  // Create the lists of the non-empty buckets
+  vtkSMPTools::For(0, numBuckets, [this, &offsets, &sortedIds](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType idx = begin; idx < end; ++idx)
     {
-      bucket = vtkIdList::New();
-      bucket->Allocate(this->NumberOfPointsPerBucket, this->NumberOfPointsPerBucket / 3);
-      this->HashTable[idx] = bucket;
+      vtkIdType numIds = offsets[idx + 1] - offsets[idx];
+      if (numIds > 0)
+      {
+        vtkIdList* bucket = vtkIdList::New();
+        bucket->SetNumberOfIds(numIds);
+        std::copy_n(sortedIds.data() + offsets[idx], numIds, bucket->GetPointer(0));
+        this->HashTable[idx] = bucket;
+      }
     }
-    bucket->InsertNextId(i);
-  }
+  });
 
   // Okay we're done update mtime
   this->BuildTime.Modified();
@@ -81,7 +81,9 @@ public:
   //@}
 
   // Re-use any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindClosestNPoints;
   using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
 
   /**
    * Given a position x, return the id of the point closest to it. Alternative
@@ -240,6 +240,10 @@ protected:
   unsigned char* CellHasBeenVisited;
   unsigned char QueryNumber;
 
+  // FindCell() and IntersectWithLine() only read the binned structure.
+  bool IsFindCellThreadSafe() override { return true; }
+  bool IsIntersectWithLineThreadSafe() override { return true; }
+
 private:
   vtkStaticCellLocator(const vtkStaticCellLocator&) = delete;
   void operator=(const vtkStaticCellLocator&) = delete;
@@ -14,10 +14,15 @@
 =========================================================================*/
 
 #include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkCleanPolyData.h>
+#include <vtkIdTypeArray.h>
 #include <vtkMinimalStandardRandomSequence.h>
+#include <vtkPointData.h>
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
+
 namespace
 {
 vtkSmartPointer<vtkPolyData> ConstructLines()
@@ -252,6 +257,154 @@ bool UpdateAndTestCleanPolyData(vtkSmartPointer<vtkCleanPolyData> clean, int num
 
   return true;
 }
+
+bool SameIds(vtkDataArray* a, vtkDataArray* b)
+{
+  vtkIdTypeArray* idsA = vtkIdTypeArray::SafeDownCast(a);
+  vtkIdTypeArray* idsB = vtkIdTypeArray::SafeDownCast(b);
+  return idsA && idsB && idsA->GetNumberOfValues() == idsB->GetNumberOfValues() &&
+    std::equal(idsA->GetPointer(0), idsA->GetPointer(0) + idsA->GetNumberOfValues(),
+      idsB->GetPointer(0));
+}
+
+bool SameCells(vtkCellArray* a, vtkCellArray* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellAtId(cellId, nptsA, ptsA);
+    b->GetCellAtId(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compare the outputs of the serial and threaded implementations, which must
+// be identical.
+bool TestThreadedCleanPolyData(vtkSmartPointer<vtkCleanPolyData> clean)
+{
+  clean->EnableSMPOff();
+  clean->Update();
+  vtkSmartPointer<vtkPolyData> serial = vtkSmartPointer<vtkPolyData>::New();
+  serial->DeepCopy(clean->GetOutput());
+
+  clean->EnableSMPOn();
+  clean->Update();
+  vtkPolyData* threaded = clean->GetOutput();
+  clean->EnableSMPOff();
+
+  if (serial->GetNumberOfPoints() != threaded->GetNumberOfPoints())
+  {
+    std::cerr << "Threaded output has " << threaded->GetNumberOfPoints() << " points instead of "
+              << serial->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < serial->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    serial->GetPoint(ptId, x);
+    threaded->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Threaded output differs at point " << ptId << std::endl;
+      return false;
+    }
+  }
+  if (!SameCells(serial->GetVerts(), threaded->GetVerts()) ||
+    !SameCells(serial->GetLines(), threaded->GetLines()) ||
+    !SameCells(serial->GetPolys(), threaded->GetPolys()) ||
+    !SameCells(serial->GetStrips(), threaded->GetStrips()))
+  {
+    std::cerr << "Threaded output has different cells" << std::endl;
+    return false;
+  }
+  if (!SameIds(serial->GetPointData()->GetArray("PointIds"),
+        threaded->GetPointData()->GetArray("PointIds")) ||
+    !SameIds(
+      serial->GetCellData()->GetArray("CellIds"), threaded->GetCellData()->GetArray("CellIds")))
+  {
+    std::cerr << "Threaded output has different attributes" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Add point and cell ids as attributes, to check they are passed correctly.
+void AddIds(vtkPolyData* polydata)
+{
+  vtkSmartPointer<vtkIdTypeArray> pointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+  pointIds->SetName("PointIds");
+  for (vtkIdType ptId = 0; ptId < polydata->GetNumberOfPoints(); ++ptId)
+  {
+    pointIds->InsertNextValue(ptId);
+  }
+  polydata->GetPointData()->AddArray(pointIds);
+
+  vtkSmartPointer<vtkIdTypeArray> cellIds = vtkSmartPointer<vtkIdTypeArray>::New();
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < polydata->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  polydata->GetCellData()->AddArray(cellIds);
+}
+
+// A large random mesh with many coincident points and degenerate cells.
+vtkSmartPointer<vtkPolyData> ConstructRandomMesh()
+{
+  vtkSmartPointer<vtkMinimalStandardRandomSequence> random =
+    vtkSmartPointer<vtkMinimalStandardRandomSequence>::New();
+  random->SetSeed(1);
+
+  const vtkIdType numPts = 20000;
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      // Coordinates on a coarse lattice generate plenty of duplicates
+      x[i] = static_cast<int>(random->GetRangeValue(0.0, 20.0));
+      random->Next();
+    }
+    points->InsertNextPoint(x);
+  }
+
+  vtkSmartPointer<vtkCellArray> cells[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    cells[type] = vtkSmartPointer<vtkCellArray>::New();
+    for (int cellId = 0; cellId < 5000; ++cellId)
+    {
+      vtkIdType ptIds[5];
+      const int npts = 1 + static_cast<int>(random->GetRangeValue(0.0, 5.0));
+      random->Next();
+      for (int i = 0; i < npts; ++i)
+      {
+        ptIds[i] = static_cast<vtkIdType>(random->GetRangeValue(0.0, numPts));
+        random->Next();
+      }
+      cells[type]->InsertNextCell(npts, ptIds);
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> polydata = vtkSmartPointer<vtkPolyData>::New();
+  polydata->SetPoints(points);
+  polydata->SetVerts(cells[0]);
+  polydata->SetLines(cells[1]);
+  polydata->SetPolys(cells[2]);
+  polydata->SetStrips(cells[3]);
+
+  return polydata;
+}
 }
 
 int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
@@ -355,5 +508,27 @@ int TestCleanPolyData2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     return EXIT_FAILURE;
   }
 
+  // Now test that the threaded implementation gives the same results as the
+  // serial one, with all combinations of merging and conversions
+  auto mesh = ConstructRandomMesh();
+  vtkSmartPointer<vtkPolyData> inputs[4] = { lines, polys, strips, mesh };
+  for (auto& input : inputs)
+  {
+    AddIds(input);
+    clean->SetInputData(input);
+    for (int flags = 0; flags < 16; ++flags)
+    {
+      clean->SetPointMerging((flags & 1) != 0);
+      clean->SetConvertLinesToPoints((flags & 2) != 0);
+      clean->SetConvertPolysToLines((flags & 4) != 0);
+      clean->SetConvertStripsToPolys((flags & 8) != 0);
+      if (!TestThreadedCleanPolyData(clean))
+      {
+        std::cerr << "Threaded clean failed with flags " << flags << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
   return EXIT_SUCCESS;
 }
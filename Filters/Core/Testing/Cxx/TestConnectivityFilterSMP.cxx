@@ -0,0 +1,271 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and threaded region labeling of the
+// connectivity filters. The regions, their ids and the output cells must be
+// identical; only the order of the output points may differ.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// Random triangles and vertices picking their points in a pool, giving
+// regions of all sizes, and a few points used by no cell.
+void MakeRandomMesh(vtkPolyData* mesh)
+{
+  const vtkIdType numPts = 20000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetValue();
+    }
+    points->SetPoint(i, x);
+  }
+
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i < 7000; ++i)
+  {
+    vtkIdType tri[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      tri[j] = static_cast<vtkIdType>(random->GetRangeValue(0, numPts - 1));
+    }
+    polys->InsertNextCell(3, tri);
+  }
+  for (vtkIdType i = 0; i < 200; ++i)
+  {
+    random->Next();
+    vtkIdType vert = static_cast<vtkIdType>(random->GetRangeValue(0, numPts - 1));
+    verts->InsertNextCell(1, &vert);
+  }
+  mesh->SetPoints(points);
+  mesh->SetVerts(verts);
+  mesh->SetPolys(polys);
+}
+
+bool SameIds(vtkDataArray* serial, vtkIdType serialId, vtkDataArray* smp, vtkIdType smpId)
+{
+  if (!serial || !smp)
+  {
+    return serial == smp;
+  }
+  return serial->GetTuple1(serialId) == smp->GetTuple1(smpId);
+}
+
+// The cells must be the same, in the same order, with the same points and
+// region ids. The cell region ids of vtkConnectivityFilter are indexed by
+// input cell, so they are only compared when all the cells are extracted.
+bool CompareOutputs(vtkPointSet* serial, vtkPointSet* smp, int numSerialRegions,
+  int numSMPRegions, bool compareCellRegions, const char* name)
+{
+  if (numSerialRegions != numSMPRegions)
+  {
+    std::cerr << name << ": " << numSMPRegions << " regions instead of " << numSerialRegions
+              << "\n";
+    return false;
+  }
+  if (serial->GetNumberOfCells() != smp->GetNumberOfCells() ||
+    serial->GetNumberOfPoints() != smp->GetNumberOfPoints())
+  {
+    std::cerr << name << ": " << smp->GetNumberOfCells() << " cells and "
+              << smp->GetNumberOfPoints() << " points instead of " << serial->GetNumberOfCells()
+              << " and " << serial->GetNumberOfPoints() << "\n";
+    return false;
+  }
+
+  vtkDataArray* serialPointIds = serial->GetPointData()->GetArray("RegionId");
+  vtkDataArray* smpPointIds = smp->GetPointData()->GetArray("RegionId");
+  vtkDataArray* serialCellIds =
+    compareCellRegions ? serial->GetCellData()->GetArray("RegionId") : nullptr;
+  vtkDataArray* smpCellIds =
+    compareCellRegions ? smp->GetCellData()->GetArray("RegionId") : nullptr;
+  vtkNew<vtkIdList> serialPts;
+  vtkNew<vtkIdList> smpPts;
+  for (vtkIdType cellId = 0; cellId < serial->GetNumberOfCells(); ++cellId)
+  {
+    serial->GetCellPoints(cellId, serialPts);
+    smp->GetCellPoints(cellId, smpPts);
+    if (serial->GetCellType(cellId) != smp->GetCellType(cellId) ||
+      serialPts->GetNumberOfIds() != smpPts->GetNumberOfIds() ||
+      !SameIds(serialCellIds, cellId, smpCellIds, cellId))
+    {
+      std::cerr << name << ": cell " << cellId << " differs\n";
+      return false;
+    }
+    for (vtkIdType i = 0; i < serialPts->GetNumberOfIds(); ++i)
+    {
+      double x[3], y[3];
+      serial->GetPoint(serialPts->GetId(i), x);
+      smp->GetPoint(smpPts->GetId(i), y);
+      if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        !SameIds(serialPointIds, serialPts->GetId(i), smpPointIds, smpPts->GetId(i)))
+      {
+        std::cerr << name << ": point " << i << " of cell " << cellId << " differs\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TFilter>
+void SetExtractionMode(TFilter* filter, int mode)
+{
+  filter->SetExtractionMode(mode);
+  filter->InitializeSeedList();
+  filter->InitializeSpecifiedRegionList();
+  if (mode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+  {
+    filter->AddSeed(5);
+    filter->AddSeed(1234);
+  }
+  else if (mode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+  {
+    filter->AddSeed(0);
+    filter->AddSeed(6999);
+    filter->AddSeed(7100);
+  }
+  else if (mode == VTK_EXTRACT_SPECIFIED_REGIONS)
+  {
+    filter->AddSpecifiedRegion(0);
+    filter->AddSpecifiedRegion(3);
+    filter->AddSpecifiedRegion(100);
+  }
+  filter->SetClosestPoint(0.5, 0.5, 0.5);
+  filter->ColorRegionsOn();
+}
+
+bool TestConnectivityFilter(vtkDataSet* input, const char* name)
+{
+  bool success = true;
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS; mode <= VTK_EXTRACT_CLOSEST_POINT_REGION;
+       ++mode)
+  {
+    for (int assignment : { vtkConnectivityFilter::UNSPECIFIED,
+           vtkConnectivityFilter::CELL_COUNT_DESCENDING })
+    {
+      vtkNew<vtkConnectivityFilter> serial;
+      serial->SetInputData(input);
+      SetExtractionMode(serial.Get(), mode);
+      serial->SetRegionIdAssignmentMode(assignment);
+      serial->Update();
+
+      vtkNew<vtkConnectivityFilter> smp;
+      smp->SetInputData(input);
+      SetExtractionMode(smp.Get(), mode);
+      smp->SetRegionIdAssignmentMode(assignment);
+      smp->EnableSMPOn();
+      smp->Update();
+
+      std::string label = std::string(name) + " " + serial->GetExtractionModeAsString();
+      success &= CompareOutputs(vtkPointSet::SafeDownCast(serial->GetOutput()),
+        vtkPointSet::SafeDownCast(smp->GetOutput()), serial->GetNumberOfExtractedRegions(),
+        smp->GetNumberOfExtractedRegions(), mode == VTK_EXTRACT_ALL_REGIONS, label.c_str());
+    }
+  }
+  return success;
+}
+
+// With MarkVisitedPointIds on, the visited point ids must also match.
+bool TestPolyDataConnectivityFilter(vtkPolyData* input)
+{
+  bool success = true;
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS; mode <= VTK_EXTRACT_CLOSEST_POINT_REGION;
+       ++mode)
+  {
+    for (bool markVisited : { false, true })
+    {
+      vtkNew<vtkPolyDataConnectivityFilter> serial;
+      serial->SetInputData(input);
+      SetExtractionMode(serial.Get(), mode);
+      serial->SetMarkVisitedPointIds(markVisited);
+      serial->Update();
+
+      vtkNew<vtkPolyDataConnectivityFilter> smp;
+      smp->SetInputData(input);
+      SetExtractionMode(smp.Get(), mode);
+      smp->SetMarkVisitedPointIds(markVisited);
+      smp->EnableSMPOn();
+      smp->Update();
+
+      std::string label =
+        std::string("vtkPolyDataConnectivityFilter ") + serial->GetExtractionModeAsString();
+      if (markVisited)
+      {
+        label += " MarkVisitedPointIds";
+      }
+      success &= CompareOutputs(serial->GetOutput(), smp->GetOutput(),
+        serial->GetNumberOfExtractedRegions(), smp->GetNumberOfExtractedRegions(), true,
+        label.c_str());
+
+      vtkIdList* serialVisited = serial->GetVisitedPointIds();
+      vtkIdList* smpVisited = smp->GetVisitedPointIds();
+      bool sameVisited = serialVisited->GetNumberOfIds() == smpVisited->GetNumberOfIds() &&
+        (serialVisited->GetNumberOfIds() > 0) == markVisited;
+      for (vtkIdType i = 0; sameVisited && i < serialVisited->GetNumberOfIds(); ++i)
+      {
+        sameVisited = serialVisited->GetId(i) == smpVisited->GetId(i);
+      }
+      if (!sameVisited)
+      {
+        std::cerr << label << ": " << smpVisited->GetNumberOfIds()
+                  << " visited point ids instead of " << serialVisited->GetNumberOfIds()
+                  << "\n";
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+}
+
+int TestConnectivityFilterSMP(int, char*[])
+{
+  vtkNew<vtkPolyData> mesh;
+  MakeRandomMesh(mesh);
+
+  vtkNew<vtkAppendFilter> toUnstructuredGrid;
+  toUnstructuredGrid->AddInputData(mesh);
+  toUnstructuredGrid->Update();
+
+  bool success = true;
+  success &= TestConnectivityFilter(mesh, "vtkConnectivityFilter polydata");
+  success &= TestConnectivityFilter(
+    toUnstructuredGrid->GetOutput(), "vtkConnectivityFilter unstructured grid");
+  success &= TestPolyDataConnectivityFilter(mesh);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,204 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormals.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and threaded implementations of
+// vtkPolyDataNormals, which must be identical.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+
+#include <algorithm>
+
+namespace
+{
+bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameCells(vtkCellArray* a, vtkCellArray* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellAtId(cellId, nptsA, ptsA);
+    b->GetCellAtId(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestThreadedNormals(vtkPolyDataNormals* normals)
+{
+  normals->EnableSMPOff();
+  normals->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(normals->GetOutput());
+
+  normals->EnableSMPOn();
+  normals->Update();
+  vtkPolyData* threaded = normals->GetOutput();
+  normals->EnableSMPOff();
+
+  if (!SameValues(serial->GetPoints()->GetData(), threaded->GetPoints()->GetData()))
+  {
+    std::cerr << "Threaded output has different points" << std::endl;
+    return false;
+  }
+  if (!SameCells(serial->GetVerts(), threaded->GetVerts()) ||
+    !SameCells(serial->GetLines(), threaded->GetLines()) ||
+    !SameCells(serial->GetPolys(), threaded->GetPolys()))
+  {
+    std::cerr << "Threaded output has different cells" << std::endl;
+    return false;
+  }
+  if (!SameValues(serial->GetPointData()->GetNormals(), threaded->GetPointData()->GetNormals()) ||
+    !SameValues(serial->GetCellData()->GetNormals(), threaded->GetCellData()->GetNormals()))
+  {
+    std::cerr << "Threaded output has different normals" << std::endl;
+    return false;
+  }
+  if (!SameValues(serial->GetPointData()->GetArray("PointIds"),
+        threaded->GetPointData()->GetArray("PointIds")))
+  {
+    std::cerr << "Threaded output has different point data" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Two spheres, the first one with inconsistently ordered polygons and the
+// second one made of triangle strips, and a few vertices and lines.
+vtkSmartPointer<vtkPolyData> ConstructInput()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(48);
+  sphere->SetPhiResolution(24);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> reordered;
+  reordered->DeepCopy(sphere->GetOutput());
+  reordered->BuildCells();
+  for (vtkIdType cellId = 0; cellId < reordered->GetNumberOfCells(); cellId += 3)
+  {
+    reordered->ReverseCell(cellId);
+  }
+
+  vtkNew<vtkSphereSource> sphere2;
+  sphere2->SetCenter(2.0, 0.0, 0.0);
+  sphere2->SetThetaResolution(16);
+  sphere2->SetPhiResolution(8);
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere2->GetOutputPort());
+  stripper->Update();
+
+  vtkNew<vtkPolyData> misc;
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 2.0, 0.0);
+  points->InsertNextPoint(1.0, 2.0, 0.0);
+  misc->SetPoints(points);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(0);
+  misc->SetVerts(verts);
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(2);
+  lines->InsertCellPoint(0);
+  lines->InsertCellPoint(1);
+  misc->SetLines(lines);
+
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputData(reordered);
+  append->AddInputConnection(stripper->GetOutputPort());
+  append->AddInputData(misc);
+  append->Update();
+
+  vtkSmartPointer<vtkPolyData> input = append->GetOutput();
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    pointIds->InsertNextValue(ptId);
+  }
+  input->GetPointData()->AddArray(pointIds);
+  return input;
+}
+}
+
+int TestPolyDataNormals(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = ConstructInput();
+
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(input);
+  normals->ComputeCellNormalsOn();
+
+  for (int flags = 0; flags < 32; ++flags)
+  {
+    normals->SetConsistency((flags & 1) != 0);
+    normals->SetSplitting((flags & 2) != 0);
+    normals->SetAutoOrientNormals((flags & 4) != 0);
+    normals->SetFlipNormals((flags & 8) != 0);
+    normals->SetNonManifoldTraversal((flags & 16) != 0);
+    for (double featureAngle : { 10.0, 30.0 })
+    {
+      normals->SetFeatureAngle(featureAngle);
+      if (!TestThreadedNormals(normals))
+      {
+        std::cerr << "Failed with flags " << flags << " and feature angle " << featureAngle
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and partitioned decimation of a sphere.
+// The partitioned decimation must reach the same reduction and stay as close
+// to the sphere, and fall back to the serial algorithm on small meshes.
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+const double Radius = 0.5;
+
+// Check that the output is made of triangles using all of its points, and
+// return the largest distance of these points to the sphere.
+bool CheckMesh(vtkPolyData* output, double& maxError)
+{
+  vtkIdType numPts = output->GetNumberOfPoints();
+  std::vector<bool> used(numPts, false);
+  vtkCellArray* polys = output->GetPolys();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] || pts[0] == pts[2])
+    {
+      return false;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (pts[i] < 0 || pts[i] >= numPts)
+      {
+        return false;
+      }
+      used[pts[i]] = true;
+    }
+  }
+  if (std::find(used.begin(), used.end(), false) != used.end())
+  {
+    return false;
+  }
+
+  maxError = 0.0;
+  double x[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    output->GetPoint(i, x);
+    maxError = std::max(maxError, std::abs(vtkMath::Norm(x) - Radius));
+  }
+  return true;
+}
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    return false;
+  }
+  double xa[3], xb[3];
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    a->GetPoint(i, xa);
+    b->GetPoint(i, xb);
+    if (xa[0] != xb[0] || xa[1] != xb[1] || xa[2] != xb[2])
+    {
+      return false;
+    }
+  }
+  vtkCellArray* polysA = a->GetPolys();
+  vtkCellArray* polysB = b->GetPolys();
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  polysA->InitTraversal();
+  polysB->InitTraversal();
+  while (polysA->GetNextCell(nptsA, ptsA) && polysB->GetNextCell(nptsB, ptsB))
+  {
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestPartitionedDecimation(int resolution, bool volumePreservation)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(Radius);
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+  vtkIdType numTris = sphere->GetOutput()->GetNumberOfPolys();
+
+  vtkNew<vtkQuadricDecimation> decimate;
+  decimate->SetInputConnection(sphere->GetOutputPort());
+  decimate->SetTargetReduction(0.9);
+  decimate->SetVolumePreservation(volumePreservation);
+  decimate->EnableSMPOff();
+  decimate->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(decimate->GetOutput());
+  double serialReduction = decimate->GetActualReduction();
+
+  decimate->EnableSMPOn();
+  decimate->Update();
+  vtkPolyData* threaded = decimate->GetOutput();
+  double threadedReduction = decimate->GetActualReduction();
+
+  double serialError, threadedError;
+  if (!CheckMesh(serial, serialError) || !CheckMesh(threaded, threadedError))
+  {
+    std::cerr << "Invalid decimated mesh for resolution " << resolution << std::endl;
+    return false;
+  }
+  double reduction = 1.0 - static_cast<double>(threaded->GetNumberOfPolys()) / numTris;
+  if (std::abs(reduction - threadedReduction) > 1e-9 ||
+    std::abs(threadedReduction - serialReduction) > 0.01)
+  {
+    std::cerr << "Partitioned reduction " << threadedReduction << " (" << reduction
+              << ") differs from the serial one " << serialReduction << " for resolution "
+              << resolution << std::endl;
+    return false;
+  }
+  if (threadedError > 2.0 * serialError + 1e-6)
+  {
+    std::cerr << "Partitioned error " << threadedError << " is much larger than the serial one "
+              << serialError << " for resolution " << resolution << std::endl;
+    return false;
+  }
+
+  // small meshes are not partitioned
+  if (numTris < 2 * 16384 && !SamePolyData(serial, threaded))
+  {
+    std::cerr << "Partitioned decimation of a small mesh differs from the serial one"
+              << std::endl;
+    return false;
+  }
+
+  // the partitions do not depend on the threads, a second run must match
+  vtkNew<vtkPolyData> first;
+  first->DeepCopy(threaded);
+  decimate->Modified();
+  decimate->Update();
+  if (!SamePolyData(first, decimate->GetOutput()))
+  {
+    std::cerr << "Partitioned decimation is not reproducible for resolution " << resolution
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestQuadricDecimationSMP(int, char*[])
+{
+  if (!TestPartitionedDecimation(64, false) || !TestPartitionedDecimation(300, false) ||
+    !TestPartitionedDecimation(300, true))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
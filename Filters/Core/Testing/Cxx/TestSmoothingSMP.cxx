@@ -0,0 +1,213 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothingSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and threaded smoothing iterations, which
+// must be identical.
+
+#include "vtkAppendPolyData.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// A sphere and a plane with a boundary, with jittered points.
+void MakeNoisyMesh(vtkPolyData* mesh)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(80);
+  sphere->SetPhiResolution(60);
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(1.0, -0.5, 0.0);
+  plane->SetPoint1(2.0, -0.5, 0.0);
+  plane->SetPoint2(1.0, 0.5, 0.0);
+  plane->SetResolution(40, 40);
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(sphere->GetOutputPort());
+  append->AddInputConnection(plane->GetOutputPort());
+  append->Update();
+  mesh->DeepCopy(append->GetOutput());
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkPoints* points = mesh->GetPoints();
+  double x[3];
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    points->GetPoint(i, x);
+    for (int k = 0; k < 3; ++k)
+    {
+      random->Next();
+      x[k] += random->GetRangeValue(-0.005, 0.005);
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+double MaxDistance(vtkPoints* a, vtkPoints* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints())
+  {
+    return VTK_DOUBLE_MAX;
+  }
+  double maxDist = 0.0;
+  double xa[3], xb[3];
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    a->GetPoint(i, xa);
+    b->GetPoint(i, xb);
+    maxDist = std::max(maxDist, std::sqrt(vtkMath::Distance2BetweenPoints(xa, xb)));
+  }
+  return maxDist;
+}
+
+bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestWindowedSinc(vtkPolyData* mesh, bool featureEdges, bool normalize)
+{
+  vtkNew<vtkWindowedSincPolyDataFilter> smooth;
+  smooth->SetInputData(mesh);
+  smooth->SetNumberOfIterations(30);
+  smooth->SetFeatureEdgeSmoothing(featureEdges);
+  smooth->SetNormalizeCoordinates(normalize);
+  smooth->GenerateErrorScalarsOn();
+  smooth->GenerateErrorVectorsOn();
+  smooth->EnableSMPOff();
+  smooth->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(smooth->GetOutput());
+
+  smooth->EnableSMPOn();
+  smooth->Update();
+  vtkPolyData* threaded = smooth->GetOutput();
+
+  if (MaxDistance(serial->GetPoints(), threaded->GetPoints()) != 0.0 ||
+    !SameValues(serial->GetPointData()->GetScalars(), threaded->GetPointData()->GetScalars()) ||
+    !SameValues(serial->GetPointData()->GetVectors(), threaded->GetPointData()->GetVectors()))
+  {
+    std::cerr << "Threaded windowed sinc smoothing differs from the serial one with"
+              << " FeatureEdgeSmoothing " << featureEdges << " and NormalizeCoordinates "
+              << normalize << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestLaplacian(vtkPolyData* mesh, int dataType, bool featureEdges)
+{
+  vtkNew<vtkSmoothPolyDataFilter> smooth;
+  smooth->SetInputData(mesh);
+  smooth->SetNumberOfIterations(50);
+  smooth->SetRelaxationFactor(0.1);
+  smooth->SetFeatureEdgeSmoothing(featureEdges);
+  smooth->SetFeatureAngle(30.0);
+  smooth->GenerateErrorScalarsOn();
+  smooth->SetOutputPointsPrecision(
+    dataType == VTK_DOUBLE ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::SINGLE_PRECISION);
+  smooth->EnableSMPOff();
+  smooth->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(smooth->GetOutput());
+
+  smooth->EnableSMPOn();
+  smooth->Update();
+  vtkPolyData* threaded = smooth->GetOutput();
+
+  if (threaded->GetPoints()->GetDataType() != dataType ||
+    MaxDistance(serial->GetPoints(), threaded->GetPoints()) != 0.0 ||
+    !SameValues(serial->GetPointData()->GetScalars(), threaded->GetPointData()->GetScalars()))
+  {
+    std::cerr << "Threaded Laplacian smoothing differs from the serial one with"
+              << " FeatureEdgeSmoothing " << featureEdges << std::endl;
+    return false;
+  }
+
+  // constrained smoothing is always serial
+  smooth->SetSourceData(mesh);
+  smooth->SetNumberOfIterations(5);
+  smooth->EnableSMPOff();
+  smooth->Update();
+  serial->DeepCopy(smooth->GetOutput());
+  smooth->EnableSMPOn();
+  smooth->Update();
+  if (MaxDistance(serial->GetPoints(), smooth->GetOutput()->GetPoints()) != 0.0)
+  {
+    std::cerr << "Constrained smoothing with EnableSMP differs from the serial one"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSmoothingSMP(int, char*[])
+{
+  vtkNew<vtkPolyData> mesh;
+  MakeNoisyMesh(mesh);
+
+  for (int featureEdges = 0; featureEdges < 2; ++featureEdges)
+  {
+    for (int normalize = 0; normalize < 2; ++normalize)
+    {
+      if (!TestWindowedSinc(mesh, featureEdges != 0, normalize != 0))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  for (int featureEdges = 0; featureEdges < 2; ++featureEdges)
+  {
+    if (!TestLaplacian(mesh, VTK_FLOAT, featureEdges != 0) ||
+      !TestLaplacian(mesh, VTK_DOUBLE, featureEdges != 0))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and threaded thresholding of image data,
+// unstructured grids and polydata, which must be identical.
+
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphereSource.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+bool TestThreadedThreshold(vtkThreshold* threshold)
+{
+  threshold->EnableSMPOff();
+  threshold->Update();
+  vtkNew<vtkUnstructuredGrid> serial;
+  serial->DeepCopy(threshold->GetOutput());
+
+  threshold->EnableSMPOn();
+  threshold->Update();
+  threshold->EnableSMPOff();
+
+  if (serial->GetNumberOfCells() == 0)
+  {
+    std::cerr << "Serial output has no cells" << std::endl;
+    return false;
+  }
+  return vtkTest::SameDataSets(serial, threshold->GetOutput());
+}
+
+// Adds point and cell arrays computed from the point coordinates and the
+// cell centers.
+void AddArrays(vtkDataSet* input)
+{
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  pointValues->SetNumberOfComponents(2);
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    input->GetPoint(ptId, x);
+    pointValues->InsertNextTuple2(x[0] + x[1], x[1] * x[2]);
+  }
+  input->GetPointData()->AddArray(pointValues);
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  vtkNew<vtkIdList> cellPts;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCellPoints(cellId, cellPts);
+    double sum = 0.0;
+    for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i)
+    {
+      sum += input->GetPoint(cellPts->GetId(i))[0];
+    }
+    cellValues->InsertNextValue(sum / cellPts->GetNumberOfIds());
+    cellIds->InsertNextValue(cellId);
+  }
+  input->GetCellData()->AddArray(cellValues);
+  input->GetCellData()->AddArray(cellIds);
+}
+
+bool TestInput(vtkDataSet* input, double lower, double upper)
+{
+  AddArrays(input);
+
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(input);
+  threshold->ThresholdBetween(lower, upper);
+  for (int flags = 0; flags < 16; ++flags)
+  {
+    threshold->SetAllScalars((flags & 1) != 0);
+    threshold->SetUseContinuousCellRange((flags & 2) != 0);
+    threshold->SetInvert((flags & 4) != 0);
+    threshold->SetComponentMode(
+      (flags & 8) != 0 ? VTK_COMPONENT_MODE_USE_ANY : VTK_COMPONENT_MODE_USE_SELECTED);
+    threshold->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "PointValues");
+    if (!TestThreadedThreshold(threshold))
+    {
+      std::cerr << "Failed with the point scalars and flags " << flags << std::endl;
+      return false;
+    }
+    threshold->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "CellValues");
+    if (!TestThreadedThreshold(threshold))
+    {
+      std::cerr << "Failed with the cell scalars and flags " << flags << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThresholdSMP(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> image;
+  image->SetWholeExtent(-8, 8, -8, 8, -8, 8);
+  image->Update();
+  if (!TestInput(image->GetOutput(), -2.0, 3.0))
+  {
+    std::cerr << "Failed with image data" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkCellTypeSource> grid;
+  grid->SetCellType(VTK_TETRA);
+  grid->SetBlocksDimensions(12, 10, 8);
+  grid->Update();
+  if (!TestInput(grid->GetOutput(), 4.0, 9.0))
+  {
+    std::cerr << "Failed with an unstructured grid" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+  vtkNew<vtkPolyData> polyData;
+  polyData->ShallowCopy(sphere->GetOutput());
+  if (!TestInput(polyData, 0.05, 0.3))
+  {
+    std::cerr << "Failed with polydata" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -16,17 +16,672 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanPolyData);
 
+namespace
+{ // anonymous
+
+//----------------------------------------------------------------------------
+// The threaded path processes the four cell arrays in the order in which the
+// serial algorithm visits them (and in which they appear in the output).
+enum CellArrayType
+{
+  VERTS = 0,
+  LINES = 1,
+  POLYS = 2,
+  STRIPS = 3,
+  NUM_CELL_ARRAYS = 4
+};
+
+// Cells are processed in batches. Each batch belongs to a single input cell
+// array, and batches are ordered like the serial traversal. Per-batch counts
+// are turned into output offsets with a prefix sum, which is what makes the
+// threaded output identical to the serial one.
+struct CellBatch
+{
+  int Type;            // which input cell array the batch belongs to
+  vtkIdType BeginCell; // first cell of the batch (local to the cell array)
+  vtkIdType EndCell;   // one past the last cell of the batch
+
+  // Filled in by the counting passes, then converted to offsets.
+  vtkIdType NumPts;
+  vtkIdType NumCells[NUM_CELL_ARRAYS];
+  vtkIdType ConnSize[NUM_CELL_ARRAYS];
+};
+
+const vtkIdType CellBatchSize = 1000;
+
+//----------------------------------------------------------------------------
+// Map the points of a cell through the point map and degenerate the cell in
+// exactly the same way the serial algorithm does. Returns the type of the
+// output cell, or -1 if the cell is discarded.
+template <typename CellRangeT>
+int CleanCell(int type, const CellRangeT& cell, const vtkIdType* pointMap,
+  const vtkTypeBool convert[3], vtkIdType* updatedPts, vtkIdType& numNewPts)
+{
+  const vtkIdType npts = static_cast<vtkIdType>(cell.size());
+
+  numNewPts = 0;
+  for (const auto cellPtId : cell)
+  {
+    const vtkIdType ptId = pointMap[cellPtId];
+    if (type == VERTS || numNewPts == 0 || ptId != updatedPts[numNewPts - 1])
+    {
+      updatedPts[numNewPts++] = ptId;
+    }
+  }
+
+  const vtkTypeBool convertLinesToPoints = convert[0];
+  const vtkTypeBool convertPolysToLines = convert[1];
+  const vtkTypeBool convertStripsToPolys = convert[2];
+  switch (type)
+  {
+    case VERTS:
+      return (numNewPts > 0 ? VERTS : -1);
+
+    case LINES:
+      if (numNewPts >= 2)
+      {
+        return LINES;
+      }
+      break;
+
+    case POLYS:
+      if (numNewPts > 2 && updatedPts[0] == updatedPts[numNewPts - 1])
+      {
+        numNewPts--;
+      }
+      if (numNewPts > 2)
+      {
+        return POLYS;
+      }
+      break;
+
+    case STRIPS:
+      if (numNewPts > 1 && updatedPts[0] == updatedPts[numNewPts - 1])
+      {
+        numNewPts--;
+      }
+      if (numNewPts > 3)
+      {
+        return STRIPS;
+      }
+      else if (numNewPts == 3 && (npts == numNewPts || convertStripsToPolys))
+      {
+        return POLYS;
+      }
+      break;
+  }
+
+  if (type != LINES && numNewPts == 2 && (npts == numNewPts || convertPolysToLines))
+  {
+    return LINES;
+  }
+  else if (numNewPts == 1 && (npts == numNewPts || convertLinesToPoints))
+  {
+    return VERTS;
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+// Apply vtkCleanPolyData::OperateOnPoint() to every input point, the result
+// is used to find coincident points.
+struct MapPoints
+{
+  vtkCleanPolyData* Self;
+  vtkPoints* InPts;
+  vtkPoints* MappedPts;
+
+  MapPoints(vtkCleanPolyData* self, vtkPoints* inPts, vtkPoints* mappedPts)
+    : Self(self)
+    , InPts(inPts)
+    , MappedPts(mappedPts)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3], newx[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->InPts->GetPoint(ptId, x);
+      this->Self->OperateOnPoint(x, newx);
+      this->MappedPts->SetPoint(ptId, newx);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// For each set of merged points, record the first position in the (global)
+// cell connectivity where the set is used. This is the position at which
+// the serial algorithm inserts the point into the locator.
+struct MarkFirstUseWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType beginCell, vtkIdType endCell, vtkIdType connBase,
+    const vtkIdType* mergeMap, std::atomic<vtkIdType>* firstUse)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    const vtkIdType connBegin = state.GetBeginOffset(beginCell);
+    const vtkIdType connEnd = state.GetEndOffset(endCell - 1);
+    const auto conn = vtk::DataArrayValueRange<1>(state.GetConnectivity(), connBegin, connEnd);
+
+    vtkIdType pos = connBase + connBegin;
+    for (const ValueType ptId : conn)
+    {
+      // memory_order_relaxed is safe here, the atomics are only used to
+      // compute a minimum, not for synchronization.
+      std::atomic<vtkIdType>& first = firstUse[mergeMap[ptId]];
+      vtkIdType current = first.load(std::memory_order_relaxed);
+      while (pos < current &&
+        !first.compare_exchange_weak(current, pos, std::memory_order_relaxed))
+      {
+      }
+      ++pos;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Count (when newIds == nullptr) or number the output points used by a
+// batch of cells. A point is numbered at the position of its first use.
+struct NumberPointsWorker
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state, vtkIdType beginCell, vtkIdType endCell,
+    vtkIdType connBase, const vtkIdType* mergeMap, const std::atomic<vtkIdType>* firstUse,
+    vtkIdType newId, vtkIdType* newIds, vtkIdType* sourceIds)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    const vtkIdType connBegin = state.GetBeginOffset(beginCell);
+    const vtkIdType connEnd = state.GetEndOffset(endCell - 1);
+    const auto conn = vtk::DataArrayValueRange<1>(state.GetConnectivity(), connBegin, connEnd);
+
+    vtkIdType numPts = 0;
+    vtkIdType pos = connBase + connBegin;
+    for (const ValueType ptId : conn)
+    {
+      const vtkIdType mergedId = mergeMap[ptId];
+      if (firstUse[mergedId].load(std::memory_order_relaxed) == pos)
+      {
+        if (newIds)
+        {
+          newIds[mergedId] = newId + numPts;
+          sourceIds[newId + numPts] = ptId;
+        }
+        ++numPts;
+      }
+      ++pos;
+    }
+    return numPts;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Count (when Generate is false) or generate the output cells of a batch.
+struct CleanCellsWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, CellBatch& batch, const vtkIdType* pointMap,
+    const vtkTypeBool convert[3], vtkIdType* updatedPts, vtkIdType cellBase,
+    vtkIdType* const* outOffsets, vtkIdType* const* outConn, const vtkIdType* outCellBase,
+    vtkIdType* sourceCellIds)
+  {
+    vtkIdType numNewPts;
+    for (vtkIdType cellId = batch.BeginCell; cellId < batch.EndCell; ++cellId)
+    {
+      const auto cell = state.GetCellRange(cellId);
+      const int outType = CleanCell(batch.Type, cell, pointMap, convert, updatedPts, numNewPts);
+      if (outType < 0)
+      {
+        continue;
+      }
+
+      if (outConn)
+      {
+        const vtkIdType outCellId = batch.NumCells[outType];
+        const vtkIdType offset = batch.ConnSize[outType];
+        outOffsets[outType][outCellId] = offset;
+        std::copy(updatedPts, updatedPts + numNewPts, outConn[outType] + offset);
+        sourceCellIds[outCellBase[outType] + outCellId] = cellBase + cellId;
+      }
+      batch.NumCells[outType]++;
+      batch.ConnSize[outType] += numNewPts;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// vtkSMPTools functors operating on batches of cells.
+struct BatchFunctor
+{
+  vtkCellArray* const* CellArrays;
+  const vtkIdType* ConnBase;
+  CellBatch* Batches;
+
+  BatchFunctor(vtkCellArray* const* cellArrays, const vtkIdType* connBase, CellBatch* batches)
+    : CellArrays(cellArrays)
+    , ConnBase(connBase)
+    , Batches(batches)
+  {
+  }
+};
+
+struct MarkFirstUse : public BatchFunctor
+{
+  const vtkIdType* MergeMap;
+  std::atomic<vtkIdType>* FirstUse;
+
+  MarkFirstUse(vtkCellArray* const* cellArrays, const vtkIdType* connBase, CellBatch* batches,
+    const vtkIdType* mergeMap, std::atomic<vtkIdType>* firstUse)
+    : BatchFunctor(cellArrays, connBase, batches)
+    , MergeMap(mergeMap)
+    , FirstUse(firstUse)
+  {
+  }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      const CellBatch& batch = this->Batches[batchId];
+      this->CellArrays[batch.Type]->Visit(MarkFirstUseWorker{}, batch.BeginCell, batch.EndCell,
+        this->ConnBase[batch.Type], this->MergeMap, this->FirstUse);
+    }
+  }
+};
+
+struct NumberPoints : public BatchFunctor
+{
+  const vtkIdType* MergeMap;
+  const std::atomic<vtkIdType>* FirstUse;
+  vtkIdType* NewIds;
+  vtkIdType* SourceIds;
+
+  NumberPoints(vtkCellArray* const* cellArrays, const vtkIdType* connBase, CellBatch* batches,
+    const vtkIdType* mergeMap, const std::atomic<vtkIdType>* firstUse, vtkIdType* newIds,
+    vtkIdType* sourceIds)
+    : BatchFunctor(cellArrays, connBase, batches)
+    , MergeMap(mergeMap)
+    , FirstUse(firstUse)
+    , NewIds(newIds)
+    , SourceIds(sourceIds)
+  {
+  }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      CellBatch& batch = this->Batches[batchId];
+      const vtkIdType numPts =
+        this->CellArrays[batch.Type]->Visit(NumberPointsWorker{}, batch.BeginCell, batch.EndCell,
+          this->ConnBase[batch.Type], this->MergeMap, this->FirstUse, batch.NumPts, this->NewIds,
+          this->SourceIds);
+      if (!this->NewIds)
+      {
+        batch.NumPts = numPts;
+      }
+    }
+  }
+};
+
+// Compose the merge map with the new point numbering.
+struct BuildPointMap
+{
+  vtkIdType* PointMap; // on input, the merge map
+  const std::atomic<vtkIdType>* FirstUse;
+  const vtkIdType* NewIds;
+  vtkIdType Unused;
+
+  BuildPointMap(vtkIdType* pointMap, const std::atomic<vtkIdType>* firstUse,
+    const vtkIdType* newIds, vtkIdType unused)
+    : PointMap(pointMap)
+    , FirstUse(firstUse)
+    , NewIds(newIds)
+    , Unused(unused)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType mergedId = this->PointMap[ptId];
+      this->PointMap[ptId] =
+        (this->FirstUse[mergedId].load(std::memory_order_relaxed) == this->Unused
+            ? -1
+            : this->NewIds[mergedId]);
+    }
+  }
+};
+
+// Generate the output points. Points are regenerated from the input
+// (rather than copied from the mapped points) so that the values are
+// those the serial algorithm inserts in the output.
+struct GeneratePoints
+{
+  vtkCleanPolyData* Self;
+  vtkPoints* InPts;
+  vtkPoints* OutPts;
+  const vtkIdType* SourceIds;
+
+  GeneratePoints(vtkCleanPolyData* self, vtkPoints* inPts, vtkPoints* outPts,
+    const vtkIdType* sourceIds)
+    : Self(self)
+    , InPts(inPts)
+    , OutPts(outPts)
+    , SourceIds(sourceIds)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3], newx[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->InPts->GetPoint(this->SourceIds[ptId], x);
+      this->Self->OperateOnPoint(x, newx);
+      this->OutPts->SetPoint(ptId, newx);
+    }
+  }
+};
+
+struct CleanCells : public BatchFunctor
+{
+  const vtkIdType* CellBase;
+  const vtkIdType* PointMap;
+  vtkTypeBool Convert[3];
+  vtkIdType MaxCellSize;
+  vtkIdType* const* OutOffsets;
+  vtkIdType* const* OutConn;
+  const vtkIdType* OutCellBase;
+  vtkIdType* SourceCellIds;
+
+  CleanCells(vtkCellArray* const* cellArrays, const vtkIdType* connBase, CellBatch* batches,
+    const vtkIdType* cellBase, const vtkIdType* pointMap, const vtkTypeBool convert[3],
+    vtkIdType maxCellSize, vtkIdType* const* outOffsets, vtkIdType* const* outConn,
+    const vtkIdType* outCellBase, vtkIdType* sourceCellIds)
+    : BatchFunctor(cellArrays, connBase, batches)
+    , CellBase(cellBase)
+    , PointMap(pointMap)
+    , MaxCellSize(maxCellSize)
+    , OutOffsets(outOffsets)
+    , OutConn(outConn)
+    , OutCellBase(outCellBase)
+    , SourceCellIds(sourceCellIds)
+  {
+    std::copy(convert, convert + 3, this->Convert);
+  }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    std::vector<vtkIdType> updatedPts(this->MaxCellSize);
+    for (; batchId < endBatchId; ++batchId)
+    {
+      CellBatch& batch = this->Batches[batchId];
+      this->CellArrays[batch.Type]->Visit(CleanCellsWorker{}, batch, this->PointMap,
+        this->Convert, updatedPts.data(), this->CellBase[batch.Type], this->OutOffsets,
+        this->OutConn, this->OutCellBase, this->SourceCellIds);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Threaded implementation of vtkCleanPolyData for exact (tolerance == 0.0)
+// point merging, or no point merging at all. Coincident points are found
+// with vtkStaticPointLocator; the remainder of the algorithm is a sequence of
+// count / prefix sum / generate passes that reproduce the numbering of points
+// and cells of the serial algorithm.
+void ThreadedClean(vtkCleanPolyData* self, vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  vtkCellArray* inCells[NUM_CELL_ARRAYS] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+
+  // Global cell ids and connectivity positions of each cell array, and the
+  // batches of cells to process.
+  vtkIdType cellBase[NUM_CELL_ARRAYS], connBase[NUM_CELL_ARRAYS];
+  vtkIdType numCells = 0, connSize = 0;
+  std::vector<CellBatch> batches;
+  for (int type = 0; type < NUM_CELL_ARRAYS; ++type)
+  {
+    cellBase[type] = numCells;
+    connBase[type] = connSize;
+    const vtkIdType numTypeCells = inCells[type]->GetNumberOfCells();
+    for (vtkIdType cellId = 0; cellId < numTypeCells; cellId += CellBatchSize)
+    {
+      CellBatch batch;
+      batch.Type = type;
+      batch.BeginCell = cellId;
+      batch.EndCell = std::min(cellId + CellBatchSize, numTypeCells);
+      batches.push_back(batch);
+    }
+    numCells += numTypeCells;
+    connSize += inCells[type]->GetNumberOfConnectivityIds();
+  }
+  const vtkIdType numBatches = static_cast<vtkIdType>(batches.size());
+
+  vtkPoints* newPts = inPts->NewInstance();
+  if (self->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (self->GetOutputPointsPrecision() == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (self->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  // The merge map associates each point with the lowest point id it is
+  // coincident with. Coincidence is tested on the points transformed by
+  // OperateOnPoint() and represented with the output precision, which is
+  // what the serial algorithm compares against.
+  vtkIdType* mergeMap = new vtkIdType[numPts];
+  if (self->GetPointMerging())
+  {
+    vtkNew<vtkPoints> mappedPts;
+    mappedPts->SetDataType(newPts->GetDataType());
+    mappedPts->SetNumberOfPoints(numPts);
+    MapPoints mapPoints(self, inPts, mappedPts);
+    vtkSMPTools::For(0, numPts, mapPoints);
+
+    vtkNew<vtkPolyData> mappedPD;
+    mappedPD->SetPoints(mappedPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(mappedPD);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, mergeMap);
+  }
+  else
+  {
+    std::iota(mergeMap, mergeMap + numPts, 0);
+  }
+  self->UpdateProgress(0.25);
+
+  // Find the first use of each set of merged points, then number the used
+  // points in order of first use. This is the order in which the serial
+  // algorithm inserts points.
+  std::atomic<vtkIdType>* firstUse = new std::atomic<vtkIdType>[numPts];
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    firstUse[ptId].store(connSize, std::memory_order_relaxed);
+  }
+  MarkFirstUse markFirstUse(inCells, connBase, batches.data(), mergeMap, firstUse);
+  vtkSMPTools::For(0, numBatches, markFirstUse);
+
+  NumberPoints countPoints(
+    inCells, connBase, batches.data(), mergeMap, firstUse, nullptr, nullptr);
+  vtkSMPTools::For(0, numBatches, countPoints);
+
+  vtkIdType numNewPts = 0;
+  for (auto& batch : batches)
+  {
+    const vtkIdType numBatchPts = batch.NumPts;
+    batch.NumPts = numNewPts;
+    numNewPts += numBatchPts;
+  }
+
+  vtkIdType* newIds = new vtkIdType[numPts];
+  vtkNew<vtkIdList> sourcePtIds;
+  sourcePtIds->SetNumberOfIds(numNewPts);
+  NumberPoints numberPoints(inCells, connBase, batches.data(), mergeMap, firstUse, newIds,
+    sourcePtIds->GetPointer(0));
+  vtkSMPTools::For(0, numBatches, numberPoints);
+
+  vtkIdType* pointMap = mergeMap;
+  BuildPointMap buildPointMap(pointMap, firstUse, newIds, connSize);
+  vtkSMPTools::For(0, numPts, buildPointMap);
+  delete[] firstUse;
+  delete[] newIds;
+
+  // Output points and point data.
+  newPts->SetNumberOfPoints(numNewPts);
+  GeneratePoints generatePoints(self, inPts, newPts, sourcePtIds->GetPointer(0));
+  vtkSMPTools::For(0, numNewPts, generatePoints);
+
+  vtkNew<vtkIdList> outPtIds;
+  outPtIds->SetNumberOfIds(numNewPts);
+  std::iota(outPtIds->GetPointer(0), outPtIds->GetPointer(0) + numNewPts, 0);
+
+  if (!self->GetPointMerging())
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  outputPD->CopyData(inputPD, sourcePtIds, outPtIds);
+  self->UpdateProgress(0.5);
+
+  // Count the output cells of each batch, and turn the counts into offsets
+  // into the output cell arrays.
+  const vtkTypeBool convert[3] = { self->GetConvertLinesToPoints(),
+    self->GetConvertPolysToLines(), self->GetConvertStripsToPolys() };
+  const vtkIdType maxCellSize = input->GetMaxCellSize();
+  for (auto& batch : batches)
+  {
+    std::fill_n(batch.NumCells, NUM_CELL_ARRAYS, 0);
+    std::fill_n(batch.ConnSize, NUM_CELL_ARRAYS, 0);
+  }
+  CleanCells countCells(inCells, connBase, batches.data(), cellBase, pointMap, convert,
+    maxCellSize, nullptr, nullptr, nullptr, nullptr);
+  vtkSMPTools::For(0, numBatches, countCells);
+
+  vtkIdType numOutCells[NUM_CELL_ARRAYS] = { 0, 0, 0, 0 };
+  vtkIdType outConnSize[NUM_CELL_ARRAYS] = { 0, 0, 0, 0 };
+  for (auto& batch : batches)
+  {
+    for (int type = 0; type < NUM_CELL_ARRAYS; ++type)
+    {
+      const vtkIdType numBatchCells = batch.NumCells[type];
+      const vtkIdType batchConnSize = batch.ConnSize[type];
+      batch.NumCells[type] = numOutCells[type];
+      batch.ConnSize[type] = outConnSize[type];
+      numOutCells[type] += numBatchCells;
+      outConnSize[type] += batchConnSize;
+    }
+  }
+
+  // Allocate the output cell arrays. As in the serial algorithm, a cell
+  // array is produced if the input had cells of that type or if degenerate
+  // cells were converted to that type.
+  vtkSmartPointer<vtkIdTypeArray> offsets[NUM_CELL_ARRAYS];
+  vtkSmartPointer<vtkIdTypeArray> conn[NUM_CELL_ARRAYS];
+  vtkIdType* offsetsPtr[NUM_CELL_ARRAYS] = { nullptr, nullptr, nullptr, nullptr };
+  vtkIdType* connPtr[NUM_CELL_ARRAYS] = { nullptr, nullptr, nullptr, nullptr };
+  vtkIdType outCellBase[NUM_CELL_ARRAYS];
+  vtkIdType numTotalOutCells = 0;
+  for (int type = 0; type < NUM_CELL_ARRAYS; ++type)
+  {
+    outCellBase[type] = numTotalOutCells;
+    numTotalOutCells += numOutCells[type];
+    if (inCells[type]->GetNumberOfCells() > 0 || numOutCells[type] > 0)
+    {
+      offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      offsets[type]->SetNumberOfValues(numOutCells[type] + 1);
+      offsetsPtr[type] = offsets[type]->GetPointer(0);
+      offsetsPtr[type][numOutCells[type]] = outConnSize[type];
+      conn[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      conn[type]->SetNumberOfValues(outConnSize[type]);
+      connPtr[type] = conn[type]->GetPointer(0);
+    }
+  }
+
+  vtkNew<vtkIdList> sourceCellIds;
+  sourceCellIds->SetNumberOfIds(numTotalOutCells);
+  CleanCells generateCells(inCells, connBase, batches.data(), cellBase, pointMap, convert,
+    maxCellSize, offsetsPtr, connPtr, outCellBase, sourceCellIds->GetPointer(0));
+  vtkSMPTools::For(0, numBatches, generateCells);
+  delete[] pointMap;
+  self->UpdateProgress(0.75);
+
+  // Output cell data, ordered verts, lines, polys, strips.
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD, numTotalOutCells);
+  vtkNew<vtkIdList> outCellIds;
+  outCellIds->SetNumberOfIds(numTotalOutCells);
+  std::iota(outCellIds->GetPointer(0), outCellIds->GetPointer(0) + numTotalOutCells, 0);
+  outputCD->CopyData(inputCD, sourceCellIds, outCellIds);
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  for (int type = 0; type < NUM_CELL_ARRAYS; ++type)
+  {
+    if (offsets[type])
+    {
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(offsets[type], conn[type]);
+      switch (type)
+      {
+        case VERTS:
+          output->SetVerts(cells);
+          break;
+        case LINES:
+          output->SetLines(cells);
+          break;
+        case POLYS:
+          output->SetPolys(cells);
+          break;
+        case STRIPS:
+          output->SetStrips(cells);
+          break;
+      }
+    }
+  }
+}
+
+} // anonymous namespace
+
 //---------------------------------------------------------------------------
 // Specify a spatial locator for speeding the search process. By
 // default an instance of vtkPointLocator is used.
@@ -46,6 +701,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->Locator = nullptr;
   this->PieceInvariant = 1;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->EnableSMP = false;
 }
 
 //--------------------------------------------------------------------------
@@ -129,6 +785,22 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+
+  // Precise point merging (and no merging at all) can be threaded while
+  // producing the same output as the serial algorithm. Merging within a
+  // tolerance depends on the order in which points are inserted.
+  if (this->EnableSMP)
+  {
+    double tol =
+      (this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength());
+    if (!this->PointMerging || tol == 0.0)
+    {
+      ThreadedClean(this, input, output);
+      return 1;
+    }
+    vtkDebugMacro(<< "Merging within a tolerance, using the serial algorithm");
+  }
+
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -682,6 +1354,7 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "PieceInvariant: " << (this->PieceInvariant ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 }
 
 //--------------------------------------------------------------------------
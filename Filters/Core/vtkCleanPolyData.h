@@ -50,6 +50,13 @@
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
  *
+ * A threaded implementation (using vtkSMPTools) is available through
+ * EnableSMP. It is used when points are merged with a tolerance of
+ * precisely 0.0, or when point merging is off; otherwise the serial
+ * algorithm is used. Coincident points are found with a vtkStaticPointLocator
+ * instead of the incremental Locator, and the output is the same as the
+ * serial output (point and cell ordering included).
+ *
  * @warning
  * Merging points can alter topology, including introducing non-manifold
  * forms. The tolerance should be chosen carefully to avoid these problems.
@@ -201,6 +208,20 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Enable/disable the threaded (vtkSMPTools) implementation of the
+   * filter. It is only used when the merging tolerance is precisely 0.0 or
+   * when PointMerging is off, and the Locator is then ignored. Subclasses
+   * overriding OperateOnPoint() must make it thread safe to use this mode.
+   * Note that the threaded implementation compares point coordinates once
+   * converted to the output points precision. By default EnableSMP is off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkCleanPolyData();
   ~vtkCleanPolyData() override;
@@ -220,6 +241,7 @@ protected:
 
   vtkTypeBool PieceInvariant;
   int OutputPointsPrecision;
+  bool EnableSMP;
 
 private:
   vtkCleanPolyData(const vtkCleanPolyData&) = delete;
@@ -0,0 +1,364 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectedRegionsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectedRegionsInternal
+ * @brief   threaded labeling of the point-connected regions of a dataset
+ *
+ * vtkConnectedRegionsInternal labels the regions of cells connected through
+ * shared points with vtkSMPTools. The points of each cell are merged in a
+ * lock-free union-find structure, whose roots are then numbered in the order
+ * of the first cell of each region. This is the numbering produced by the
+ * wave propagation of vtkConnectivityFilter and vtkPolyDataConnectivityFilter
+ * when all the regions are extracted, independently of the scheduling of the
+ * threads. Seeded extractions label the union of the regions reached from
+ * the seed cells as region 0.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectedRegionsInternal_h
+#define vtkConnectedRegionsInternal_h
+
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Number of items processed by a task when the items are numbered.
+const vtkIdType VTK_CONNECTED_REGIONS_BATCH_SIZE = 65536;
+
+// Lock-free disjoint sets of point ids. A root is always linked under a
+// smaller root, so that the root of a set is its smallest point id.
+class vtkPointUnionFind
+{
+public:
+  explicit vtkPointUnionFind(vtkIdType numPts)
+    : Parent(numPts)
+  {
+    vtkSMPTools::For(0, numPts, [this](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->Parent[ptId].store(ptId, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  // Find the root of a point, halving the path on the way.
+  vtkIdType Find(vtkIdType ptId)
+  {
+    for (;;)
+    {
+      vtkIdType parent = this->Parent[ptId].load();
+      if (parent == ptId)
+      {
+        return ptId;
+      }
+      const vtkIdType grandParent = this->Parent[parent].load();
+      if (grandParent != parent)
+      {
+        // Losing this exchange to another thread is harmless: any
+        // ancestor is a valid parent.
+        this->Parent[ptId].compare_exchange_weak(parent, grandParent);
+      }
+      ptId = grandParent;
+    }
+  }
+
+  void Union(vtkIdType ptA, vtkIdType ptB)
+  {
+    for (;;)
+    {
+      ptA = this->Find(ptA);
+      ptB = this->Find(ptB);
+      if (ptA == ptB)
+      {
+        return;
+      }
+      if (ptA < ptB)
+      {
+        std::swap(ptA, ptB);
+      }
+      // Link the larger root, unless it stopped being a root meanwhile.
+      vtkIdType expected = ptA;
+      if (this->Parent[ptA].compare_exchange_strong(expected, ptB))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  std::vector<std::atomic<vtkIdType> > Parent;
+};
+
+// Number the items for which isNumbered(id) is true in increasing id order,
+// calling assign(id, number) for each of them. Returns the number of items.
+template <typename TIsNumbered, typename TAssign>
+vtkIdType vtkNumberItemsInOrder(vtkIdType numItems, TIsNumbered isNumbered, TAssign assign)
+{
+  const vtkIdType numBatches =
+    (numItems + VTK_CONNECTED_REGIONS_BATCH_SIZE - 1) / VTK_CONNECTED_REGIONS_BATCH_SIZE;
+  std::vector<vtkIdType> offsets(numBatches + 1, 0);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      const vtkIdType begin = batch * VTK_CONNECTED_REGIONS_BATCH_SIZE;
+      const vtkIdType end = std::min(begin + VTK_CONNECTED_REGIONS_BATCH_SIZE, numItems);
+      vtkIdType count = 0;
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        count += isNumbered(id) ? 1 : 0;
+      }
+      offsets[batch + 1] = count;
+    }
+  });
+  for (vtkIdType batch = 0; batch < numBatches; ++batch)
+  {
+    offsets[batch + 1] += offsets[batch];
+  }
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      const vtkIdType begin = batch * VTK_CONNECTED_REGIONS_BATCH_SIZE;
+      const vtkIdType end = std::min(begin + VTK_CONNECTED_REGIONS_BATCH_SIZE, numItems);
+      vtkIdType number = offsets[batch];
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        if (isNumbered(id))
+        {
+          assign(id, number++);
+        }
+      }
+    }
+  });
+  return offsets[numBatches];
+}
+
+class vtkConnectedRegions
+{
+public:
+  // Region of each cell, -1 for the cells which are not extracted.
+  std::vector<vtkIdType> CellRegions;
+  // Region of each point, -1 for the points of no extracted cell.
+  std::vector<vtkIdType> PointRegions;
+  // Number of cells of each region.
+  std::vector<vtkIdType> RegionSizes;
+
+  // Label all the regions of the cells of input, each with its own id.
+  void Label(vtkDataSet* input) { this->Label(input, true, nullptr, 0); }
+
+  // Label the cells of input connected to the seed cells, all with region 0.
+  void Label(vtkDataSet* input, const vtkIdType* seedCells, vtkIdType numSeedCells)
+  {
+    this->Label(input, false, seedCells, numSeedCells);
+  }
+
+  // Number the points of the extracted cells in increasing id order into
+  // pointMap, -1 for the other points. Returns the number of mapped points.
+  vtkIdType MapPoints(vtkIdType* pointMap) const
+  {
+    const vtkIdType numPts = static_cast<vtkIdType>(this->PointRegions.size());
+    std::fill_n(pointMap, numPts, -1);
+    return vtkNumberItemsInOrder(
+      numPts, [&](vtkIdType ptId) { return this->PointRegions[ptId] >= 0; },
+      [&](vtkIdType ptId, vtkIdType newPtId) { pointMap[ptId] = newPtId; });
+  }
+
+private:
+  void Label(
+    vtkDataSet* input, bool allRegions, const vtkIdType* seedCells, vtkIdType numSeedCells)
+  {
+    const vtkIdType numPts = input->GetNumberOfPoints();
+    const vtkIdType numCells = input->GetNumberOfCells();
+
+    // GetCellPoints() is thread safe once it has been called from a single
+    // thread.
+    vtkNew<vtkIdList> cellPts;
+    input->GetCellPoints(0, cellPts);
+    vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+
+    // Merge the points of each cell.
+    vtkPointUnionFind sets(numPts);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* pts = localCellPts.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, pts);
+        for (vtkIdType i = 1; i < pts->GetNumberOfIds(); ++i)
+        {
+          sets.Union(pts->GetId(0), pts->GetId(i));
+        }
+      }
+    });
+
+    // Each cell is represented by the root of its points. Cells without
+    // points form regions on their own, represented by -1 - cellId.
+    std::vector<vtkIdType> cellRoots(numCells);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* pts = localCellPts.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, pts);
+        cellRoots[cellId] = pts->GetNumberOfIds() > 0 ? sets.Find(pts->GetId(0)) : -1 - cellId;
+      }
+    });
+
+    this->CellRegions.assign(numCells, -1);
+    this->PointRegions.assign(numPts, -1);
+    std::vector<vtkIdType> rootRegions(numPts, -1);
+    vtkIdType numRegions = 1;
+    if (!allRegions)
+    {
+      // The seeds are few, mark their roots serially.
+      for (vtkIdType i = 0; i < numSeedCells; ++i)
+      {
+        const vtkIdType cellId = seedCells[i];
+        const vtkIdType root = cellRoots[cellId];
+        if (root >= 0)
+        {
+          rootRegions[root] = 0;
+        }
+        else
+        {
+          this->CellRegions[cellId] = 0;
+        }
+      }
+    }
+    else
+    {
+      // The wave propagation numbers the regions in the order of their
+      // smallest cell id: number the cells that are first in their region.
+      std::vector<std::atomic<vtkIdType> > firstCells(numPts);
+      vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          firstCells[ptId].store(numCells, std::memory_order_relaxed);
+        }
+      });
+      vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          const vtkIdType root = cellRoots[cellId];
+          if (root < 0)
+          {
+            continue;
+          }
+          vtkIdType first = firstCells[root].load();
+          while (cellId < first && !firstCells[root].compare_exchange_weak(first, cellId))
+          {
+          }
+        }
+      });
+      numRegions = vtkNumberItemsInOrder(
+        numCells,
+        [&](vtkIdType cellId) {
+          const vtkIdType root = cellRoots[cellId];
+          return root < 0 || firstCells[root].load() == cellId;
+        },
+        [&](vtkIdType cellId, vtkIdType regionId) {
+          const vtkIdType root = cellRoots[cellId];
+          if (root >= 0)
+          {
+            rootRegions[root] = regionId;
+          }
+          else
+          {
+            this->CellRegions[cellId] = regionId;
+          }
+        });
+    }
+
+    // Propagate the region ids from the roots to the cells and points.
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType root = cellRoots[cellId];
+        if (root >= 0)
+        {
+          this->CellRegions[cellId] = rootRegions[root];
+        }
+      }
+    });
+    // The points used by no cell are roots which are never numbered.
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->PointRegions[ptId] = rootRegions[sets.Find(ptId)];
+      }
+    });
+
+    this->CountRegionSizes(numRegions);
+  }
+
+  void CountRegionSizes(vtkIdType numRegions)
+  {
+    // Neighboring cells mostly belong to the same region: count runs of
+    // cells locally to limit the contention on the counters.
+    std::vector<std::atomic<vtkIdType> > sizes(numRegions);
+    for (auto& size : sizes)
+    {
+      size.store(0, std::memory_order_relaxed);
+    }
+    const vtkIdType numCells = static_cast<vtkIdType>(this->CellRegions.size());
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType runRegion = -1;
+      vtkIdType runLength = 0;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType regionId = this->CellRegions[cellId];
+        if (regionId != runRegion)
+        {
+          if (runRegion >= 0)
+          {
+            sizes[runRegion].fetch_add(runLength);
+          }
+          runRegion = regionId;
+          runLength = 0;
+        }
+        ++runLength;
+      }
+      if (runRegion >= 0)
+      {
+        sizes[runRegion].fetch_add(runLength);
+      }
+    });
+    this->RegionSizes.resize(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+    {
+      this->RegionSizes[regionId] = sizes[regionId].load();
+    }
+  }
+};
+
+} // anonymous namespace
+
+#endif // vtkConnectedRegionsInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectedRegionsInternal.h
@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -28,8 +29,10 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
 
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -61,6 +64,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->NewCellScalars = nullptr;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->EnableSMP = false;
 }
 
 vtkConnectivityFilter::~vtkConnectivityFilter()
@@ -241,28 +245,44 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->EnableSMP && !this->InScalars)
     {
-      if (cellId && !(cellId % 5000))
+      this->MarkRegionsInParallel(input, false);
+      for (i = 0; i < this->RegionNumber; i++)
       {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
+        if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
+        {
+          maxCellsInRegion = this->RegionSizes->GetValue(i);
+          largestRegionId = i;
+        }
       }
-
-      if (this->Visited[cellId] < 0)
+      this->UpdateProgress(0.9);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave->InsertNextId(cellId);
+          this->TraverseAndMark(input);
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave->Reset();
+          this->Wave2->Reset();
+        }
       }
     }
   }
@@ -319,7 +339,14 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark(input);
+    if (this->EnableSMP && !this->InScalars)
+    {
+      this->MarkRegionsInParallel(input, true);
+    }
+    else
+    {
+      this->TraverseAndMark(input);
+    }
     this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
     this->UpdateProgress(0.9);
   }
@@ -597,6 +624,58 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+// Mark the regions with the union-find labeling of
+// vtkConnectedRegionsInternal, filling the same structures as
+// TraverseAndMark(). The output points are numbered in input order.
+//
+void vtkConnectivityFilter::MarkRegionsInParallel(vtkDataSet* input, bool seeded)
+{
+  vtkConnectedRegions regions;
+  if (seeded)
+  {
+    regions.Label(input, this->Wave->GetPointer(0), this->Wave->GetNumberOfIds());
+  }
+  else
+  {
+    regions.Label(input);
+  }
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  std::copy(regions.CellRegions.begin(), regions.CellRegions.end(), this->Visited);
+  this->PointNumber = regions.MapPoints(this->PointMap);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      if (this->Visited[cellId] >= 0)
+      {
+        this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      if (this->PointMap[ptId] >= 0)
+      {
+        this->NewScalars->SetValue(this->PointMap[ptId], regions.PointRegions[ptId]);
+      }
+    }
+  });
+
+  if (seeded)
+  {
+    this->NumCellsInRegion = regions.RegionSizes[0];
+  }
+  else
+  {
+    for (vtkIdType size : regions.RegionSizes)
+    {
+      this->RegionSizes->InsertValue(this->RegionNumber++, size);
+    }
+  }
+}
+
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
 {
@@ -755,4 +834,5 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
 }
@@ -50,6 +50,13 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * The regions can be labeled in parallel with vtkSMPTools by turning on
+ * EnableSMP. The cells sharing points are then merged with a lock-free
+ * union-find structure instead of the serial wave propagation. The regions
+ * and their ids are the same as in the serial code path, but the output
+ * points are ordered by input point id rather than by traversal order.
+ * Scalar connectivity is always processed serially.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -215,6 +222,16 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Enable or disable the threaded labeling of the regions. It is ignored
+   * when ScalarConnectivity is on. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() override;
@@ -242,9 +259,17 @@ protected:
   double ScalarRange[2];
 
   int RegionIdAssignmentMode;
+  bool EnableSMP;
 
   void TraverseAndMark(vtkDataSet* input);
 
+  /**
+   * Threaded counterpart of TraverseAndMark(). When seeded, the cells
+   * connected to the cells of the wave are marked as the current region,
+   * otherwise all the regions are marked and their sizes recorded.
+   */
+  void MarkRegionsInParallel(vtkDataSet* input, bool seeded);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
 private:
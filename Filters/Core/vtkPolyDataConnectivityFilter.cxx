@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedRegionsInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -26,6 +27,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> // for fill_n
 
@@ -58,6 +60,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->EnableSMP = false;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -188,28 +191,44 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->EnableSMP && !this->InScalars && !this->MarkVisitedPointIds)
     {
-      if (cellId && !(cellId % 5000))
+      this->MarkRegionsInParallel(false);
+      for (i = 0; i < this->RegionNumber; i++)
       {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
+        if (this->RegionSizes->GetValue(i) > maxCellsInRegion)
+        {
+          maxCellsInRegion = this->RegionSizes->GetValue(i);
+          largestRegionId = i;
+        }
       }
-
-      if (this->Visited[cellId] < 0)
+      this->UpdateProgress(0.9);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave.push_back(cellId);
+          this->TraverseAndMark();
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave.clear();
+          this->Wave2.clear();
+        }
       }
     }
   }
@@ -266,7 +285,14 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark();
+    if (this->EnableSMP && !this->InScalars && !this->MarkVisitedPointIds)
+    {
+      this->MarkRegionsInParallel(true);
+    }
+    else
+    {
+      this->TraverseAndMark();
+    }
     this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
     this->UpdateProgress(0.9);
   } // else extracted seeded cells
@@ -502,6 +528,47 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+// --------------------------------------------------------------------------
+// Label the regions with vtkConnectedRegionsInternal and fill the structures
+// TraverseAndMark() fills. The output points are numbered in input order.
+void vtkPolyDataConnectivityFilter::MarkRegionsInParallel(bool seeded)
+{
+  vtkConnectedRegions regions;
+  if (seeded)
+  {
+    regions.Label(this->Mesh, this->Wave.data(), static_cast<vtkIdType>(this->Wave.size()));
+  }
+  else
+  {
+    regions.Label(this->Mesh);
+  }
+
+  std::copy(regions.CellRegions.begin(), regions.CellRegions.end(), this->Visited);
+  this->PointNumber = regions.MapPoints(this->PointMap);
+  vtkIdTypeArray* newScalars = vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars);
+  vtkSMPTools::For(0, this->Mesh->GetNumberOfPoints(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (this->PointMap[ptId] >= 0)
+      {
+        newScalars->SetValue(this->PointMap[ptId], regions.PointRegions[ptId]);
+      }
+    }
+  });
+
+  if (seeded)
+  {
+    this->NumCellsInRegion = regions.RegionSizes[0];
+  }
+  else
+  {
+    for (vtkIdType size : regions.RegionSizes)
+    {
+      this->RegionSizes->InsertValue(this->RegionNumber++, size);
+    }
+  }
+}
+
 // --------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -645,4 +712,5 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
 }
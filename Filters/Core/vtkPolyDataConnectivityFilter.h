@@ -43,6 +43,12 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * Turning on EnableSMP labels the regions in parallel with vtkSMPTools,
+ * using a lock-free union-find over the shared points. The region ids are
+ * the ones the serial wave propagation assigns, while the output points
+ * follow the input point order. It has no effect with ScalarConnectivity
+ * or MarkVisitedPointIds.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -227,6 +233,16 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Enable or disable the threaded labeling of the regions, used when
+   * ScalarConnectivity and MarkVisitedPointIds are off. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -252,6 +268,10 @@ protected:
 
   void TraverseAndMark();
 
+  // Threaded counterpart of TraverseAndMark(): marks the cells connected to
+  // the cells of the wave when seeded, or all the regions otherwise.
+  void MarkRegionsInParallel(bool seeded);
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -271,6 +291,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  bool EnableSMP;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
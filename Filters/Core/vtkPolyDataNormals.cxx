@@ -15,6 +15,7 @@
 #include "vtkPolyDataNormals.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -27,10 +28,18 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangleStrip.h"
 
 #include "vtkNew.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyDataNormals);
 
 // Construct with feature angle=30, splitting and consistency turned on,
@@ -48,6 +57,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   // some internal data
   this->NumFlips = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->EnableSMP = false;
   this->Wave = nullptr;
   this->Wave2 = nullptr;
   this->CellIds = nullptr;
@@ -64,6 +74,679 @@ vtkPolyDataNormals::vtkPolyDataNormals()
 #define VTK_CELL_NOT_VISITED 0
 #define VTK_CELL_VISITED 1
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Threaded implementation. The input polygons (OldMesh) are traversed with
+// thread-local cell array iterators, and edge neighbors are found directly
+// from the links of OldMesh. Note that the links list the cells using a point
+// in ascending order of cell id.
+struct LocalTraversal
+{
+  vtkSmartPointer<vtkCellArrayIterator> Iter;
+  std::vector<vtkIdType> Pts;
+  std::vector<vtkIdType> Neighbors;
+  std::vector<int> Regions;
+  vtkIdType NumFlips;
+};
+
+// Same as vtkPolyData::GetCellEdgeNeighbors(), using a std::vector.
+void GetEdgeNeighbors(vtkPolyData* mesh, vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+  std::vector<vtkIdType>& neighbors)
+{
+  vtkIdType ncells1, ncells2;
+  vtkIdType *cells1, *cells2;
+  mesh->GetPointCells(p1, ncells1, cells1);
+  mesh->GetPointCells(p2, ncells2, cells2);
+  vtkIdType* cells2End = cells2 + ncells2;
+
+  neighbors.clear();
+  for (vtkIdType i = 0; i < ncells1; ++i)
+  {
+    if (cells1[i] != cellId && std::find(cells2, cells2End, cells1[i]) != cells2End)
+    {
+      neighbors.push_back(cells1[i]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Consistent ordering of the polygons. The wave of TraverseAndOrder() is
+// propagated one wavefront at a time. In a first pass, each unvisited edge
+// neighbor of the wavefront is claimed by the first cell of the wavefront
+// (in wavefront order) reaching it. In a second pass, each cell visits and
+// orders the neighbors it claimed, processing its edges in order. This is
+// what the serial traversal does, and the next wavefront is assembled in the
+// same order from batches of cells of the current wavefront. Polygons are
+// not reversed during the traversal: the reversals are recorded in Flips.
+const vtkIdType WaveBatchSize = 1000;
+
+struct ClaimNeighbors
+{
+  vtkPolyData* Mesh;
+  const int* Visited;
+  const vtkIdType* Wave;
+  std::atomic<vtkIdType>* Claims;
+  vtkTypeBool NonManifoldTraversal;
+  vtkSMPThreadLocal<LocalTraversal> LocalData;
+
+  ClaimNeighbors(vtkPolyData* mesh, const int* visited, const vtkIdType* wave,
+    std::atomic<vtkIdType>* claims, vtkTypeBool nonManifoldTraversal)
+    : Mesh(mesh)
+    , Visited(visited)
+    , Wave(wave)
+    , Claims(claims)
+    , NonManifoldTraversal(nonManifoldTraversal)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalData.Local().Iter = vtk::TakeSmartPointer(this->Mesh->GetPolys()->NewIterator());
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalTraversal& local = this->LocalData.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType cellId = this->Wave[i];
+      local.Iter->GetCellAtId(cellId, npts, pts);
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        GetEdgeNeighbors(this->Mesh, cellId, pts[j], pts[(j + 1) % npts], local.Neighbors);
+        if (local.Neighbors.size() != 1 && !this->NonManifoldTraversal)
+        {
+          continue;
+        }
+        for (const vtkIdType neighbor : local.Neighbors)
+        {
+          if (this->Visited[neighbor] == VTK_CELL_NOT_VISITED)
+          {
+            // memory_order_relaxed is safe here, the atomics are only used to
+            // compute a minimum, not for synchronization.
+            std::atomic<vtkIdType>& claim = this->Claims[neighbor];
+            vtkIdType current = claim.load(std::memory_order_relaxed);
+            while (i < current &&
+              !claim.compare_exchange_weak(current, i, std::memory_order_relaxed))
+            {
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+struct OrderNeighbors
+{
+  vtkPolyData* Mesh;
+  int* Visited;
+  unsigned char* Flips;
+  const vtkIdType* Wave;
+  vtkIdType WaveSize;
+  const std::atomic<vtkIdType>* Claims;
+  vtkTypeBool NonManifoldTraversal;
+  std::vector<vtkIdType>* NextWaves;
+  vtkIdType NumFlips;
+  vtkSMPThreadLocal<LocalTraversal> LocalData;
+
+  OrderNeighbors(vtkPolyData* mesh, int* visited, unsigned char* flips, const vtkIdType* wave,
+    vtkIdType waveSize, const std::atomic<vtkIdType>* claims, vtkTypeBool nonManifoldTraversal,
+    std::vector<vtkIdType>* nextWaves)
+    : Mesh(mesh)
+    , Visited(visited)
+    , Flips(flips)
+    , Wave(wave)
+    , WaveSize(waveSize)
+    , Claims(claims)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , NextWaves(nextWaves)
+    , NumFlips(0)
+  {
+  }
+
+  void Initialize()
+  {
+    LocalTraversal& local = this->LocalData.Local();
+    local.Iter = vtk::TakeSmartPointer(this->Mesh->GetPolys()->NewIterator());
+    local.NumFlips = 0;
+  }
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    LocalTraversal& local = this->LocalData.Local();
+    vtkIdType npts, numNeiPts;
+    const vtkIdType *pts, *neiPts;
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      std::vector<vtkIdType>& nextWave = this->NextWaves[batch];
+      nextWave.clear();
+      const vtkIdType end = std::min((batch + 1) * WaveBatchSize, this->WaveSize);
+      for (vtkIdType i = batch * WaveBatchSize; i < end; ++i)
+      {
+        // Current ordering of the cell
+        const vtkIdType cellId = this->Wave[i];
+        local.Iter->GetCellAtId(cellId, npts, pts);
+        local.Pts.assign(pts, pts + npts);
+        if (this->Flips[cellId])
+        {
+          std::reverse(local.Pts.begin(), local.Pts.end());
+        }
+
+        for (vtkIdType j = 0; j < npts; ++j) // for each edge neighbor
+        {
+          const vtkIdType p1 = local.Pts[j];
+          const vtkIdType p2 = local.Pts[(j + 1) % npts];
+          GetEdgeNeighbors(this->Mesh, cellId, p1, p2, local.Neighbors);
+          if (local.Neighbors.size() != 1 && !this->NonManifoldTraversal)
+          {
+            continue;
+          }
+          for (const vtkIdType neighbor : local.Neighbors)
+          {
+            if (this->Claims[neighbor].load(std::memory_order_relaxed) == i &&
+              this->Visited[neighbor] == VTK_CELL_NOT_VISITED)
+            {
+              // The neighbor has its original ordering, which should be
+              // consistent with us (i.e., if we are p1->p2, neighbor should
+              // be p2->p1).
+              local.Iter->GetCellAtId(neighbor, numNeiPts, neiPts);
+              vtkIdType l;
+              for (l = 0; l < numNeiPts; l++)
+              {
+                if (neiPts[l] == p2)
+                {
+                  break;
+                }
+              }
+              if (neiPts[(l + 1) % numNeiPts] != p1)
+              {
+                this->Flips[neighbor] = 1;
+                local.NumFlips++;
+              }
+              this->Visited[neighbor] = VTK_CELL_VISITED;
+              nextWave.push_back(neighbor);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (const auto& local : this->LocalData)
+    {
+      this->NumFlips += local.NumFlips;
+    }
+  }
+};
+
+class ThreadedOrientation
+{
+public:
+  ThreadedOrientation(vtkPolyData* mesh, int* visited, vtkTypeBool nonManifoldTraversal)
+    : Mesh(mesh)
+    , Visited(visited)
+    , NonManifoldTraversal(nonManifoldTraversal)
+  {
+    const vtkIdType numPolys = mesh->GetNumberOfPolys();
+    this->Flips.assign(numPolys, 0);
+    this->Claims = new std::atomic<vtkIdType>[numPolys];
+    for (vtkIdType cellId = 0; cellId < numPolys; ++cellId)
+    {
+      this->Claims[cellId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  }
+
+  ~ThreadedOrientation() { delete[] this->Claims; }
+
+  // Record that a (seed) polygon is to be reversed.
+  void Reverse(vtkIdType cellId) { this->Flips[cellId] = 1; }
+
+  // Propagate the wave from a visited seed polygon. Returns the number of
+  // polygons to reverse found during the traversal.
+  vtkIdType Traverse(vtkIdType seed)
+  {
+    vtkIdType numFlips = 0;
+    this->Wave.assign(1, seed);
+    while (!this->Wave.empty())
+    {
+      const vtkIdType waveSize = static_cast<vtkIdType>(this->Wave.size());
+      ClaimNeighbors claim(
+        this->Mesh, this->Visited, this->Wave.data(), this->Claims, this->NonManifoldTraversal);
+      vtkSMPTools::For(0, waveSize, claim);
+
+      const vtkIdType numBatches = (waveSize - 1) / WaveBatchSize + 1;
+      if (static_cast<vtkIdType>(this->NextWaves.size()) < numBatches)
+      {
+        this->NextWaves.resize(numBatches);
+      }
+      OrderNeighbors order(this->Mesh, this->Visited, this->Flips.data(), this->Wave.data(),
+        waveSize, this->Claims, this->NonManifoldTraversal, this->NextWaves.data());
+      vtkSMPTools::For(0, numBatches, order);
+      numFlips += order.NumFlips;
+
+      this->Wave.clear();
+      for (vtkIdType batch = 0; batch < numBatches; ++batch)
+      {
+        this->Wave.insert(
+          this->Wave.end(), this->NextWaves[batch].begin(), this->NextWaves[batch].end());
+      }
+    }
+    return numFlips;
+  }
+
+  const unsigned char* GetFlips() const { return this->Flips.data(); }
+
+private:
+  vtkPolyData* Mesh;
+  int* Visited;
+  vtkTypeBool NonManifoldTraversal;
+  std::vector<unsigned char> Flips;
+  std::atomic<vtkIdType>* Claims;
+  std::vector<vtkIdType> Wave;
+  std::vector<std::vector<vtkIdType> > NextWaves;
+};
+
+//----------------------------------------------------------------------------
+// Reverse the ordering of the flagged polygons.
+template <typename CellStateT>
+struct ReverseCells
+{
+  CellStateT& State;
+  const unsigned char* Flips;
+
+  ReverseCells(CellStateT& state, const unsigned char* flips)
+    : State(state)
+    , Flips(flips)
+  {
+  }
+
+  void operator()(vtkIdType beginCell, vtkIdType endCell)
+  {
+    for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+    {
+      if (this->Flips[cellId])
+      {
+        auto cell = this->State.GetCellRange(cellId);
+        std::reverse(cell.begin(), cell.end());
+      }
+    }
+  }
+};
+
+struct ReverseCellsWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, const unsigned char* flips)
+  {
+    ReverseCells<CellStateT> reverse(state, flips);
+    vtkSMPTools::For(0, state.GetNumberOfCells(), reverse);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Initial polygon normals.
+struct ComputePolyNormals
+{
+  vtkPoints* Points;
+  vtkCellArray* Polys;
+  vtkFloatArray* PolyNormals;
+  vtkIdType OffsetCells;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator> > Iter;
+
+  ComputePolyNormals(
+    vtkPoints* points, vtkCellArray* polys, vtkFloatArray* polyNormals, vtkIdType offsetCells)
+    : Points(points)
+    , Polys(polys)
+    , PolyNormals(polyNormals)
+    , OffsetCells(offsetCells)
+  {
+  }
+
+  void Initialize() { this->Iter.Local() = vtk::TakeSmartPointer(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType beginCell, vtkIdType endCell)
+  {
+    vtkCellArrayIterator* iter = this->Iter.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double n[3];
+    for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, static_cast<int>(npts), pts, n);
+      this->PolyNormals->SetTuple(this->OffsetCells + cellId, n);
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+// Feature edge splitting. MarkRegions() labels the regions of cells around a
+// point as MarkAndSplit() does, using local.Regions instead of the Visited
+// array: the region of a cell is stored at the position of its first
+// occurrence in the (sorted) links of the point.
+vtkIdType FindCell(vtkIdType ncells, const vtkIdType* cells, vtkIdType cellId)
+{
+  return std::lower_bound(cells, cells + ncells, cellId) - cells;
+}
+
+vtkIdType FindNeighborPoint(vtkIdType numPts, const vtkIdType* pts, vtkIdType ptId, vtkIdType nei)
+{
+  vtkIdType spot;
+  for (spot = 0; spot < numPts; spot++)
+  {
+    if (pts[spot] == ptId)
+    {
+      break;
+    }
+  }
+
+  if (spot == 0)
+  {
+    return (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+  }
+  else if (spot == (numPts - 1))
+  {
+    return (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+  }
+  return (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+}
+
+int MarkRegions(vtkPolyData* mesh, vtkFloatArray* polyNormals, double cosAngle,
+  vtkIdType ptId, vtkIdType ncells, const vtkIdType* cells, LocalTraversal& local)
+{
+  local.Regions.assign(ncells, -1);
+
+  vtkIdType numPts;
+  const vtkIdType* pts;
+  int numRegions = 0;
+  vtkIdType neiPt[2], nei, cellId, neiCellId;
+  double thisNormal[3], neiNormal[3];
+  for (vtkIdType j = 0; j < ncells; j++) // for all cells connected to point
+  {
+    if (local.Regions[FindCell(ncells, cells, cells[j])] < 0) // for all unvisited cells
+    {
+      local.Regions[FindCell(ncells, cells, cells[j])] = numRegions;
+      // find the two edges of the seed cell using ptId
+      local.Iter->GetCellAtId(cells[j], numPts, pts);
+      neiPt[0] = FindNeighborPoint(numPts, pts, ptId, -1);
+      neiPt[1] = FindNeighborPoint(numPts, pts, ptId, neiPt[0]);
+
+      for (int i = 0; i < 2; i++) // for each of the two edges of the seed cell
+      {
+        cellId = cells[j];
+        nei = neiPt[i];
+        while (cellId >= 0) // while we can grow this region
+        {
+          GetEdgeNeighbors(mesh, cellId, ptId, nei, local.Neighbors);
+          if (local.Neighbors.size() == 1 &&
+            local.Regions[FindCell(ncells, cells, (neiCellId = local.Neighbors[0]))] < 0)
+          {
+            polyNormals->GetTuple(cellId, thisNormal);
+            polyNormals->GetTuple(neiCellId, neiNormal);
+
+            if (vtkMath::Dot(thisNormal, neiNormal) > cosAngle)
+            {
+              // visit and arrange to visit next edge neighbor
+              local.Regions[FindCell(ncells, cells, neiCellId)] = numRegions;
+              cellId = neiCellId;
+              local.Iter->GetCellAtId(cellId, numPts, pts);
+              nei = FindNeighborPoint(numPts, pts, ptId, nei);
+            }
+            else
+            {
+              cellId = -1; // separated by edge angle
+            }
+          }
+          else
+          {
+            cellId = -1; // separated by previous visit, boundary, or non-manifold
+          }
+        }
+      }
+      numRegions++;
+    }
+  }
+  return numRegions;
+}
+
+// Count (when Map is nullptr) or generate the split points. A point used by
+// N regions of cells is split into N-1 new points, which are numbered after
+// the input points in ascending order of the split points. The ids of the
+// points used by the cells of the other regions are replaced in the (already
+// reordered) output polygons.
+template <typename CellStateT>
+struct SplitPoints
+{
+  CellStateT* State;
+  vtkPolyData* Mesh;
+  vtkFloatArray* PolyNormals;
+  double CosAngle;
+  const unsigned char* Flips;
+  vtkIdType* NewIds;
+  vtkIdType* Map;
+  vtkSMPThreadLocal<LocalTraversal> LocalData;
+
+  SplitPoints(CellStateT* state, vtkPolyData* mesh, vtkFloatArray* polyNormals, double cosAngle,
+    const unsigned char* flips, vtkIdType* newIds, vtkIdType* map)
+    : State(state)
+    , Mesh(mesh)
+    , PolyNormals(polyNormals)
+    , CosAngle(cosAngle)
+    , Flips(flips)
+    , NewIds(newIds)
+    , Map(map)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalData.Local().Iter = vtk::TakeSmartPointer(this->Mesh->GetPolys()->NewIterator());
+  }
+
+  void operator()(vtkIdType beginPt, vtkIdType endPt)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    LocalTraversal& local = this->LocalData.Local();
+    vtkIdType ncells, npts;
+    vtkIdType* cells;
+    const vtkIdType* pts;
+    for (vtkIdType ptId = beginPt; ptId < endPt; ++ptId)
+    {
+      if (this->Map && this->NewIds[ptId + 1] == this->NewIds[ptId])
+      {
+        continue; // no splitting required
+      }
+      this->Mesh->GetPointCells(ptId, ncells, cells);
+      if (ncells <= 1)
+      {
+        continue; // point does not need to be further disconnected
+      }
+      const int numRegions = MarkRegions(
+        this->Mesh, this->PolyNormals, this->CosAngle, ptId, ncells, cells, local);
+      if (!this->Map)
+      {
+        this->NewIds[ptId] = numRegions - 1;
+        continue;
+      }
+
+      const vtkIdType lastId = this->NewIds[ptId];
+      for (vtkIdType newId = lastId; newId < lastId + numRegions - 1; ++newId)
+      {
+        this->Map[newId] = ptId;
+      }
+      for (vtkIdType j = 0; j < ncells; j++)
+      {
+        const vtkIdType cellId = cells[j];
+        const int region = local.Regions[FindCell(ncells, cells, cellId)];
+        if (region <= 0 || (j > 0 && cells[j - 1] == cellId))
+        {
+          continue; // first region, or cell already processed
+        }
+        const vtkIdType replacementPoint = lastId + region - 1;
+        const vtkIdType offset = this->State->GetBeginOffset(cellId);
+        local.Iter->GetCellAtId(cellId, npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          if (pts[i] == ptId)
+          {
+            const vtkIdType pos = (this->Flips && this->Flips[cellId]) ? npts - 1 - i : i;
+            this->State->GetConnectivity()->SetValue(
+              offset + pos, static_cast<ValueType>(replacementPoint));
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+struct SplitPointsWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkPolyData* mesh, vtkFloatArray* polyNormals,
+    double cosAngle, const unsigned char* flips, vtkIdList* map)
+  {
+    const vtkIdType numPts = mesh->GetNumberOfPoints();
+    std::vector<vtkIdType> newIds(numPts + 1, 0);
+
+    SplitPoints<CellStateT> countSplits(
+      &state, mesh, polyNormals, cosAngle, flips, newIds.data(), nullptr);
+    vtkSMPTools::For(0, numPts, countSplits);
+
+    vtkIdType numNewPts = numPts;
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      const vtkIdType numSplits = newIds[ptId];
+      newIds[ptId] = numNewPts;
+      numNewPts += numSplits;
+    }
+    newIds[numPts] = numNewPts;
+
+    map->SetNumberOfIds(numNewPts);
+    std::iota(map->GetPointer(0), map->GetPointer(0) + numPts, 0);
+    SplitPoints<CellStateT> splitPoints(
+      &state, mesh, polyNormals, cosAngle, flips, newIds.data(), map->GetPointer(0));
+    vtkSMPTools::For(0, numPts, splitPoints);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Copy the points (split points included) to the output.
+struct CopyPoints
+{
+  vtkPoints* InPts;
+  vtkPoints* OutPts;
+  const vtkIdType* Map;
+
+  CopyPoints(vtkPoints* inPts, vtkPoints* outPts, const vtkIdType* map)
+    : InPts(inPts)
+    , OutPts(outPts)
+    , Map(map)
+  {
+  }
+
+  void operator()(vtkIdType beginPt, vtkIdType endPt)
+  {
+    double x[3];
+    for (vtkIdType ptId = beginPt; ptId < endPt; ++ptId)
+    {
+      this->InPts->GetPoint(this->Map[ptId], x);
+      this->OutPts->SetPoint(ptId, x);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Point normals. Rather than scattering the polygon normals to the points,
+// each point gathers the normals of the polygons using it, found from the
+// links of the original point. The polygons are visited in ascending order
+// so that the sums are the same as in the serial algorithm.
+template <typename CellStateT>
+struct GatherPointNormals
+{
+  CellStateT& State;
+  vtkPolyData* Mesh;
+  const vtkIdType* Map;
+  const float* PolyNormals;
+  float* Normals;
+  double FlipDirection;
+
+  GatherPointNormals(CellStateT& state, vtkPolyData* mesh, const vtkIdType* map,
+    const float* polyNormals, float* normals, double flipDirection)
+    : State(state)
+    , Mesh(mesh)
+    , Map(map)
+    , PolyNormals(polyNormals)
+    , Normals(normals)
+    , FlipDirection(flipDirection)
+  {
+  }
+
+  void operator()(vtkIdType beginPt, vtkIdType endPt)
+  {
+    vtkIdType ncells;
+    vtkIdType* cells;
+    for (vtkIdType ptId = beginPt; ptId < endPt; ++ptId)
+    {
+      float* n = this->Normals + 3 * ptId;
+      n[0] = n[1] = n[2] = 0.0f;
+      this->Mesh->GetPointCells(this->Map ? this->Map[ptId] : ptId, ncells, cells);
+      for (vtkIdType j = 0; j < ncells; ++j)
+      {
+        const vtkIdType cellId = cells[j];
+        if (j > 0 && cells[j - 1] == cellId)
+        {
+          continue; // cell using the point several times
+        }
+        const float* cellNormal = this->PolyNormals + 3 * cellId;
+        for (const auto id : this->State.GetCellRange(cellId))
+        {
+          if (id == ptId)
+          {
+            n[0] += cellNormal[0];
+            n[1] += cellNormal[1];
+            n[2] += cellNormal[2];
+          }
+        }
+      }
+
+      const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * this->FlipDirection;
+      if (length != 0.0)
+      {
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+      }
+    }
+  }
+};
+
+struct GatherPointNormalsWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkPolyData* mesh, const vtkIdType* map,
+    const float* polyNormals, float* normals, vtkIdType numPts, double flipDirection)
+  {
+    GatherPointNormals<CellStateT> gatherNormals(
+      state, mesh, map, polyNormals, normals, flipDirection);
+    vtkSMPTools::For(0, numPts, gatherNormals);
+  }
+};
+
+} // anonymous namespace
+
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -207,6 +890,15 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->Visited = nullptr;
   }
 
+  // The threaded traversal records the polygons to reverse; they are
+  // reversed once all the waves have been propagated.
+  ThreadedOrientation* orientation = nullptr;
+  if (this->EnableSMP && (this->Consistency || this->AutoOrientNormals))
+  {
+    orientation =
+      new ThreadedOrientation(this->OldMesh, this->Visited, this->NonManifoldTraversal);
+  }
+
   //  Traverse all polygons insuring proper direction of ordering.  This
   //  works by propagating a wave from a seed polygon to the polygon's
   //  edge neighbors. Each neighbor may be reordered to maintain consistency
@@ -295,14 +987,28 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
         // normals, but if both are true, then we leave it as it is.
         if (bestReverseFlag ^ this->FlipNormals)
         {
-          this->NewMesh->ReverseCell(leftmostCellID);
+          if (orientation)
+          {
+            orientation->Reverse(leftmostCellID);
+          }
+          else
+          {
+            this->NewMesh->ReverseCell(leftmostCellID);
+          }
           this->NumFlips++;
         }
-        this->Wave->InsertNextId(leftmostCellID);
         this->Visited[leftmostCellID] = VTK_CELL_VISITED;
-        this->TraverseAndOrder();
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        if (orientation)
+        {
+          this->NumFlips += static_cast<int>(orientation->Traverse(leftmostCellID));
+        }
+        else
+        {
+          this->Wave->InsertNextId(leftmostCellID);
+          this->TraverseAndOrder();
+          this->Wave->Reset();
+          this->Wave2->Reset();
+        }
       } // if found leftmost cell
     }   // Still some points in the queue
     this->Wave->Delete();
@@ -325,11 +1031,25 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
           if (this->FlipNormals)
           {
             this->NumFlips++;
-            this->NewMesh->ReverseCell(cellId);
+            if (orientation)
+            {
+              orientation->Reverse(cellId);
+            }
+            else
+            {
+              this->NewMesh->ReverseCell(cellId);
+            }
           }
-          this->Wave->InsertNextId(cellId);
           this->Visited[cellId] = VTK_CELL_VISITED;
-          this->TraverseAndOrder();
+          if (orientation)
+          {
+            this->NumFlips += static_cast<int>(orientation->Traverse(cellId));
+          }
+          else
+          {
+            this->Wave->InsertNextId(cellId);
+            this->TraverseAndOrder();
+          }
         }
 
         this->Wave->Reset();
@@ -342,6 +1062,14 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     } // Consistent ordering
   }   // don't automatically orient normals
 
+  const unsigned char* flips = nullptr;
+  if (orientation)
+  {
+    flips = orientation->GetFlips();
+    newPolys->Visit(ReverseCellsWorker{}, flips);
+    newPolys->Modified();
+  }
+
   this->UpdateProgress(0.333);
 
   //  Initial pass to compute polygon normals without effects of neighbors
@@ -362,18 +1090,26 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->PolyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
+  if (this->EnableSMP)
   {
-    if ((cellId % 1000) == 0)
+    ComputePolyNormals computePolyNormals(inPts, newPolys, this->PolyNormals, offsetCells);
+    vtkSMPTools::For(0, numPolys, computePolyNormals);
+  }
+  else
+  {
+    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
     {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
+      if ((cellId % 1000) == 0)
       {
-        break;
+        this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
+        if (this->GetAbortExecute())
+        {
+          break;
+        }
       }
+      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+      this->PolyNormals->SetTuple(offsetCells + cellId, n);
     }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
   }
 
   // Split mesh if sharp features
@@ -388,16 +1124,25 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     // to map new points into old points.
     //
     this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (vtkIdType i = 0; i < numPts; i++)
+    if (this->EnableSMP)
     {
-      this->Map->SetId(i, i);
+      newPolys->Visit(
+        SplitPointsWorker{}, this->OldMesh, this->PolyNormals, this->CosAngle, flips, this->Map);
+      newPolys->Modified();
     }
-
-    for (ptId = 0; ptId < numPts; ptId++)
+    else
     {
-      this->MarkAndSplit(ptId);
-    } // for all input points
+      this->Map->SetNumberOfIds(numPts);
+      for (vtkIdType i = 0; i < numPts; i++)
+      {
+        this->Map->SetId(i, i);
+      }
+
+      for (ptId = 0; ptId < numPts; ptId++)
+      {
+        this->MarkAndSplit(ptId);
+      } // for all input points
+    }
 
     numNewPts = this->Map->GetNumberOfIds();
 
@@ -433,13 +1178,25 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId = 0; ptId < numNewPts; ptId++)
+    if (this->EnableSMP)
     {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId, inPts->GetPoint(oldId));
-      outPD->CopyData(pd, oldId, ptId);
+      CopyPoints copyPoints(inPts, newPts, this->Map->GetPointer(0));
+      vtkSMPTools::For(0, numNewPts, copyPoints);
+
+      vtkNew<vtkIdList> newIds;
+      newIds->SetNumberOfIds(numNewPts);
+      std::iota(newIds->GetPointer(0), newIds->GetPointer(0) + numNewPts, 0);
+      outPD->CopyData(pd, this->Map, newIds);
+    }
+    else
+    {
+      for (ptId = 0; ptId < numNewPts; ptId++)
+      {
+        oldId = this->Map->GetId(ptId);
+        newPts->SetPoint(ptId, inPts->GetPoint(oldId));
+        outPD->CopyData(pd, oldId, ptId);
+      }
     }
-    this->Map->Delete();
   } // splitting
 
   else // no splitting, so no new points
@@ -449,6 +1206,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     outPD->PassData(pd);
   }
 
+  delete orientation;
   if (this->Consistency || this->Splitting)
   {
     delete[] this->Visited;
@@ -479,7 +1237,13 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
 
-  if (this->ComputePointNormals)
+  if (this->ComputePointNormals && this->EnableSMP)
+  {
+    newPolys->Visit(GatherPointNormalsWorker{}, this->OldMesh,
+      this->Splitting ? this->Map->GetPointer(0) : nullptr, fPolyNormals, fNormals, numNewPts,
+      flipDirection);
+  }
+  else if (this->ComputePointNormals)
   {
     for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
     {
@@ -506,6 +1270,12 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  if (this->Splitting)
+  {
+    this->Map->Delete();
+    this->Map = nullptr;
+  }
+
   //  Update ourselves.  If no new nodes have been created (i.e., no
   //  splitting), we can simply pass data through.
   //
@@ -787,4 +1557,5 @@ void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Cell Normals: " << (this->ComputeCellNormals ? "On\n" : "Off\n");
   os << indent << "Non-manifold Traversal: " << (this->NonManifoldTraversal ? "On\n" : "Off\n");
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 }
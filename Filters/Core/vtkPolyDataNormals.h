@@ -47,6 +47,14 @@
  * Triangle strips are broken up into triangle polygons. You may want to
  * restrip the triangles.
  *
+ * @warning
+ * A threaded implementation (using vtkSMPTools) is available through
+ * EnableSMP. Polygon normals, feature edge splitting and the accumulation of
+ * point normals are computed in parallel, and the consistent ordering of the
+ * polygons is propagated from each seed polygon one wavefront at a time, the
+ * cells of a wavefront being processed in parallel. The output is the same as
+ * the output of the serial algorithm.
+ *
  * @sa
  * For high-performance rendering, you could use vtkTriangleMeshPointNormals
  * if you know that you have a triangle mesh which does not require splitting
@@ -173,6 +181,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Enable/disable the threaded (vtkSMPTools) implementation of the
+   * filter. The threaded implementation produces the same output as the
+   * serial one. By default EnableSMP is off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkPolyDataNormals();
   ~vtkPolyDataNormals() override {}
@@ -190,6 +209,7 @@ protected:
   vtkTypeBool ComputeCellNormals;
   int NumFlips;
   int OutputPointsPrecision;
+  bool EnableSMP;
 
 private:
   vtkIdList* Wave;
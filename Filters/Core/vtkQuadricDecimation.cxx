@@ -40,6 +40,7 @@
 // toggling on and off sets it to 1 and 0
 
 #include "vtkQuadricDecimation.h"
+#include "vtkBoundingBox.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
@@ -49,12 +50,18 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 //----------------------------------------------------------------------------
@@ -87,6 +94,8 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TensorsWeight = 0.1;
 
   this->ActualReduction = 0.0;
+
+  this->EnableSMP = false;
 }
 
 //----------------------------------------------------------------------------
@@ -185,21 +194,10 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts = input->GetNumberOfPoints();
   vtkIdType numTris = input->GetNumberOfPolys();
-  vtkIdType edgeId, i;
-  int j;
-  double cost;
-  double* x;
-  vtkCellArray* polys;
+  vtkIdType i;
   vtkDataArray* attrib;
-  vtkPoints* points;
-  vtkPointData* pointData;
-  vtkIdType endPtIds[2];
   vtkIdList* outputCellList;
-  vtkIdType npts;
-  const vtkIdType* pts;
-  vtkIdType numDeletedTris = 0;
 
   // check some assumptions about the data
   if (input->GetPolys() == nullptr || input->GetPoints() == nullptr ||
@@ -215,10 +213,100 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  // The attribute error metric needs the attribute ranges of the whole mesh,
+  // which the partitions do not have: it is only supported serially.
+  bool partitioned = false;
+  if (this->EnableSMP && !this->AttributeErrorMetric)
+  {
+    vtkNew<vtkPolyData> merged;
+    if (this->DecimatePartitions(input, merged))
+    {
+      partitioned = true;
+      merged->GetFieldData()->PassData(input->GetFieldData());
+
+      // collapse the boundary edges until the overall target is reached
+      vtkIdType numMergedTris = merged->GetNumberOfPolys();
+      double targetReduction = 0.0;
+      if (numMergedTris > 0)
+      {
+        targetReduction = (this->TargetReduction * numTris - (numTris - numMergedTris)) /
+          static_cast<double>(numMergedTris);
+        targetReduction = vtkMath::ClampValue(targetReduction, 0.0, 1.0);
+      }
+      this->Decimate(merged, targetReduction, nullptr);
+    }
+  }
+  if (!partitioned)
+  {
+    this->Decimate(input, this->TargetReduction, nullptr);
+  }
+
+  outputCellList = vtkIdList::New();
+
+  // copy the simplified mesh from the working mesh to the output mesh
+  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  {
+    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+    {
+      outputCellList->InsertNextId(i);
+    }
+  }
+
+  output->Reset();
+  output->AllocateCopy(this->Mesh);
+  output->GetPointData()->CopyAllocate(this->Mesh->GetPointData(), 1);
+  output->CopyCells(this->Mesh, outputCellList);
+
+  this->Mesh->DeleteLinks();
+  this->Mesh->Delete();
+  this->Mesh = nullptr;
+
+  // the partial reductions of the partitions are not part of the one of the
+  // final pass
+  if (partitioned && numTris > 0)
+  {
+    this->ActualReduction =
+      1.0 - static_cast<double>(outputCellList->GetNumberOfIds()) / numTris;
+  }
+  outputCellList->Delete();
+
+  // renormalize, clamp attributes
+  if (this->AttributeErrorMetric)
+  {
+    if (nullptr != (attrib = output->GetPointData()->GetNormals()))
+    {
+      for (i = 0; i < attrib->GetNumberOfTuples(); i++)
+      {
+        vtkMath::Normalize(attrib->GetTuple3(i));
+      }
+    }
+    // might want to add clamping texture coordinates??
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::Decimate(
+  vtkPolyData* input, double targetReduction, const unsigned char* lockedPoints)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numTris = input->GetNumberOfPolys();
+  vtkIdType edgeId, i;
+  int j;
+  double cost;
+  double* x;
+  vtkCellArray* polys;
+  vtkPoints* points;
+  vtkPointData* pointData;
+  vtkIdType endPtIds[2];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType numDeletedTris = 0;
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   pointData = vtkPointData::New();
-  outputCellList = vtkIdList::New();
 
   // copy the input (only polys) to our working mesh
   this->Mesh = vtkPolyData::New();
@@ -322,7 +410,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   int abort = 0;
   while (
-    !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX && this->ActualReduction < this->TargetReduction)
+    !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX && this->ActualReduction < targetReduction)
   {
     if (!(this->NumberOfEdgeCollapses % 10000))
     {
@@ -333,6 +421,15 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
     endPtIds[0] = this->EndPoint1List->GetId(edgeId);
     endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+
+    // edges touching a locked point are dropped, they will be reconsidered
+    // by the caller once the locks are released
+    if (lockedPoints && (lockedPoints[endPtIds[0]] || lockedPoints[endPtIds[1]]))
+    {
+      edgeId = this->EdgeCosts->Pop(0, cost);
+      continue;
+    }
+
     this->TargetPoints->GetTuple(edgeId, x);
 
     // check for a poorly placed point
@@ -383,39 +480,250 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   delete[] this->TempB;
   delete[] this->TempA;
   delete[] this->TempData;
+}
 
-  // copy the simplified mesh from the working mesh to the output mesh
-  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+namespace
+{
+// Partitions are kept above this number of triangles so that the points
+// locked along their boundaries remain a small fraction of the mesh.
+const vtkIdType QuadricPartitionSize = 16384;
+
+// What survives the decimation of a partition: its triangles, in the point
+// ids of the input, and the points the collapses have moved.
+struct QuadricPartition
+{
+  std::vector<vtkIdType> Triangles;
+  std::vector<vtkIdType> MovedIds;
+  std::vector<double> MovedPoints;
+};
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuadricDecimation::DecimatePartitions(vtkPolyData* input, vtkPolyData* merged)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numTris = input->GetNumberOfPolys();
+  vtkPoints* inPts = input->GetPoints();
+
+  // The number of partitions only depends on the size of the mesh, so that
+  // the result does not depend on the number of threads.
+  vtkIdType numPartitions = 1;
+  while (numTris / (2 * numPartitions) >= QuadricPartitionSize)
   {
-    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+    numPartitions *= 2;
+  }
+  if (numPartitions == 1)
+  {
+    return false;
+  }
+
+  // gather the triangles, giving up on degenerate polygons
+  std::vector<vtkIdType> tris(3 * numTris);
+  vtkCellArray* polys = input->GetPolys();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType triId = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++triId)
+  {
+    if (npts != 3)
     {
-      outputCellList->InsertNextId(i);
+      return false;
     }
+    std::copy(pts, pts + 3, tris.begin() + 3 * triId);
   }
 
-  output->Reset();
-  output->AllocateCopy(this->Mesh);
-  output->GetPointData()->CopyAllocate(this->Mesh->GetPointData(), 1);
-  output->CopyCells(this->Mesh, outputCellList);
-
-  this->Mesh->DeleteLinks();
-  this->Mesh->Delete();
-  outputCellList->Delete();
+  std::vector<double> centroids(3 * numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      double* c = centroids.data() + 3 * t;
+      c[0] = c[1] = c[2] = 0.0;
+      for (int k = 0; k < 3; ++k)
+      {
+        inPts->GetPoint(tris[3 * t + k], x);
+        c[0] += x[0] / 3.0;
+        c[1] += x[1] / 3.0;
+        c[2] += x[2] / 3.0;
+      }
+    }
+  });
+
+  // Split the triangles at the median centroid along the longest axis of
+  // their bounding box, one level of the kd-tree at a time. The triangles of
+  // partition p are order[offsets[p]] to order[offsets[p + 1] - 1].
+  std::vector<vtkIdType> order(numTris);
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<vtkIdType> offsets{ 0, numTris };
+  for (vtkIdType numParts = 1; numParts < numPartitions; numParts *= 2)
+  {
+    std::vector<vtkIdType> splitOffsets(2 * numParts + 1);
+    vtkSMPTools::For(0, numParts, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType p = begin; p < end; ++p)
+      {
+        vtkIdType* first = order.data() + offsets[p];
+        vtkIdType* last = order.data() + offsets[p + 1];
+        vtkBoundingBox bbox;
+        for (vtkIdType* t = first; t != last; ++t)
+        {
+          bbox.AddPoint(centroids.data() + 3 * (*t));
+        }
+        double lengths[3];
+        bbox.GetLengths(lengths);
+        int axis = 0;
+        for (int k = 1; k < 3; ++k)
+        {
+          if (lengths[k] > lengths[axis])
+          {
+            axis = k;
+          }
+        }
+        vtkIdType* middle = first + (last - first) / 2;
+        std::nth_element(first, middle, last, [&](vtkIdType a, vtkIdType b) {
+          return centroids[3 * a + axis] < centroids[3 * b + axis];
+        });
+        splitOffsets[2 * p] = offsets[p];
+        splitOffsets[2 * p + 1] = offsets[p] + (middle - first);
+      }
+    });
+    splitOffsets[2 * numParts] = numTris;
+    offsets.swap(splitOffsets);
+  }
 
-  // renormalize, clamp attributes
-  if (this->AttributeErrorMetric)
+  // lock the points used by more than one partition
+  std::vector<vtkIdType> owners(numPts, -1);
+  std::vector<unsigned char> locked(numPts, 0);
+  for (vtkIdType p = 0; p < numPartitions; ++p)
   {
-    if (nullptr != (attrib = output->GetPointData()->GetNormals()))
+    for (vtkIdType i = offsets[p]; i < offsets[p + 1]; ++i)
     {
-      for (i = 0; i < attrib->GetNumberOfTuples(); i++)
+      for (int k = 0; k < 3; ++k)
       {
-        vtkMath::Normalize(attrib->GetTuple3(i));
+        vtkIdType ptId = tris[3 * order[i] + k];
+        if (owners[ptId] < 0)
+        {
+          owners[ptId] = p;
+        }
+        else if (owners[ptId] != p)
+        {
+          locked[ptId] = 1;
+        }
       }
     }
-    // might want to add clamping texture coordinates??
   }
 
-  return 1;
+  // Decimate each partition with its own instance of the filter, as the
+  // working data lives in the filter.
+  std::vector<QuadricPartition> partitions(numPartitions);
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType p = begin; p < end; ++p)
+    {
+      // keep the triangles in input order
+      vtkIdType* first = order.data() + offsets[p];
+      vtkIdType* last = order.data() + offsets[p + 1];
+      std::sort(first, last);
+
+      // the local id of a point is its rank among the points of the partition
+      std::vector<vtkIdType> ptIds;
+      ptIds.reserve(3 * (last - first));
+      for (vtkIdType* t = first; t != last; ++t)
+      {
+        ptIds.insert(ptIds.end(), tris.begin() + 3 * (*t), tris.begin() + 3 * (*t) + 3);
+      }
+      std::sort(ptIds.begin(), ptIds.end());
+      ptIds.erase(std::unique(ptIds.begin(), ptIds.end()), ptIds.end());
+      vtkIdType numLocalPts = static_cast<vtkIdType>(ptIds.size());
+
+      vtkNew<vtkPoints> subPts;
+      subPts->SetDataType(inPts->GetDataType());
+      subPts->SetNumberOfPoints(numLocalPts);
+      std::vector<unsigned char> subLocked(numLocalPts);
+      double x[3];
+      for (vtkIdType i = 0; i < numLocalPts; ++i)
+      {
+        inPts->GetPoint(ptIds[i], x);
+        subPts->SetPoint(i, x);
+        subLocked[i] = locked[ptIds[i]];
+      }
+      vtkNew<vtkCellArray> subPolys;
+      subPolys->AllocateExact(last - first, 3 * (last - first));
+      for (vtkIdType* t = first; t != last; ++t)
+      {
+        vtkIdType tri[3];
+        for (int k = 0; k < 3; ++k)
+        {
+          tri[k] =
+            std::lower_bound(ptIds.begin(), ptIds.end(), tris[3 * (*t) + k]) - ptIds.begin();
+        }
+        subPolys->InsertNextCell(3, tri);
+      }
+      vtkNew<vtkPolyData> sub;
+      sub->SetPoints(subPts);
+      sub->SetPolys(subPolys);
+
+      vtkNew<vtkQuadricDecimation> worker;
+      worker->SetVolumePreservation(this->VolumePreservation);
+      worker->Decimate(sub, this->TargetReduction, subLocked.data());
+
+      QuadricPartition& result = partitions[p];
+      vtkPolyData* mesh = worker->Mesh;
+      std::vector<unsigned char> used(numLocalPts, 0);
+      vtkIdType numCellPts;
+      const vtkIdType* cellPts;
+      for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+      {
+        if (mesh->GetCellType(cellId) == VTK_EMPTY_CELL)
+        {
+          continue;
+        }
+        mesh->GetCellPoints(cellId, numCellPts, cellPts);
+        for (int k = 0; k < 3; ++k)
+        {
+          result.Triangles.push_back(ptIds[cellPts[k]]);
+          used[cellPts[k]] = 1;
+        }
+      }
+      for (vtkIdType i = 0; i < numLocalPts; ++i)
+      {
+        if (used[i] && !subLocked[i])
+        {
+          mesh->GetPoint(i, x);
+          result.MovedIds.push_back(ptIds[i]);
+          result.MovedPoints.insert(result.MovedPoints.end(), x, x + 3);
+        }
+      }
+      mesh->DeleteLinks();
+      mesh->Delete();
+      worker->Mesh = nullptr;
+    }
+  });
+
+  // Merge the partitions. A point that is not locked belongs to a single
+  // partition, so the moved points never conflict.
+  vtkNew<vtkPoints> newPts;
+  newPts->DeepCopy(inPts);
+  vtkIdType numMergedTris = 0;
+  for (const QuadricPartition& result : partitions)
+  {
+    numMergedTris += static_cast<vtkIdType>(result.Triangles.size()) / 3;
+    for (size_t i = 0; i < result.MovedIds.size(); ++i)
+    {
+      newPts->SetPoint(result.MovedIds[i], result.MovedPoints.data() + 3 * i);
+    }
+  }
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->AllocateExact(numMergedTris, 3 * numMergedTris);
+  for (const QuadricPartition& result : partitions)
+  {
+    for (size_t i = 0; i < result.Triangles.size(); i += 3)
+    {
+      newPolys->InsertNextCell(3, result.Triangles.data() + i);
+    }
+  }
+  merged->SetPoints(newPts);
+  merged->SetPolys(newPolys);
+
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -1466,4 +1774,5 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
 }
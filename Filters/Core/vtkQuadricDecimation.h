@@ -48,6 +48,17 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * Large meshes can be decimated in parallel with vtkSMPTools by turning on
+ * EnableSMP. The triangles are split at their median centroid along the
+ * longest axis, kd-tree fashion, into partitions of a few ten thousand
+ * triangles, and each partition is decimated independently with the points
+ * it shares with other partitions locked in place. A serial pass over the
+ * merged mesh then collapses the edges left along the partition boundaries
+ * until the target reduction is met. The result is close to, but not
+ * identical to, the one of the serial algorithm; it does not depend on the
+ * number of threads. The attribute error metric is only supported by the
+ * serial algorithm.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -156,12 +167,39 @@ public:
   vtkGetMacro(ActualReduction, double);
   //@}
 
+  //@{
+  /**
+   * Enable or disable the partitioned, threaded decimation of the mesh.
+   * It is ignored when AttributeErrorMetric is on or when the mesh is too
+   * small to be partitioned. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Build the working mesh from the triangles of input and collapse edges
+   * until targetReduction is reached. If lockedPoints is not null, edges
+   * using a point flagged there are never collapsed. The working mesh is
+   * left in this->Mesh for the caller to extract and delete.
+   */
+  void Decimate(vtkPolyData* input, double targetReduction, const unsigned char* lockedPoints);
+
+  /**
+   * Split the triangles of input into spatial partitions and decimate them
+   * in parallel with their shared points locked. The surviving triangles,
+   * which still index the points of input, are stored in merged. Return
+   * false if the input is not a pure triangle mesh large enough to be split.
+   */
+  bool DecimatePartitions(vtkPolyData* input, vtkPolyData* merged);
+
   /**
    * Do the dirty work of eliminating the edge; return the number of
    * triangles deleted.
@@ -247,6 +285,8 @@ protected:
   double TCoordsWeight;
   double TensorsWeight;
 
+  bool EnableSMP;
+
   int NumberOfEdgeCollapses;
   vtkEdgeTable* Edges;
   vtkIdList* EndPoint1List;
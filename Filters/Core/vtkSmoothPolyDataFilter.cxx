@@ -25,10 +25,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -126,6 +131,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->EnableSMP = false;
 
   this->SmoothPoints = nullptr;
 
@@ -276,6 +282,155 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// Threaded variant of vtkSPDF_MovePoints, for unconstrained smoothing. The
+// serial iterations move the points in place, in order: a point is moved
+// from the already moved positions of its neighbors before it and from the
+// previous positions of its neighbors after it. The points are sorted into
+// levels such that, for each pair of connected points, the point with the
+// lower id is in a lower level. The levels are moved one after the other,
+// and the points of a level concurrently, which gives the serial results.
+template <typename T>
+void vtkSPDF_MovePointsThreaded(vtkSPDF_InternalParams<T>& params)
+{
+  // the connected points of the movable vertices, in a compressed sparse
+  // row layout
+  std::vector<vtkIdType> edgeOffsets(params.numPts + 1, 0);
+  for (vtkIdType i = 0; i < params.numPts; ++i)
+  {
+    vtkMeshVertexPtr vertsPtr = params.vertexPtr + i;
+    edgeOffsets[i + 1] = edgeOffsets[i] +
+      (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges != nullptr
+          ? vertsPtr->edges->GetNumberOfIds()
+          : 0);
+  }
+  std::vector<vtkIdType> edgeIds(edgeOffsets[params.numPts]);
+  for (vtkIdType i = 0; i < params.numPts; ++i)
+  {
+    if (edgeOffsets[i + 1] > edgeOffsets[i])
+    {
+      vtkIdType* edgeIdPtr = params.vertexPtr[i].edges->GetPointer(0);
+      std::copy(edgeIdPtr, edgeIdPtr + (edgeOffsets[i + 1] - edgeOffsets[i]),
+        edgeIds.begin() + edgeOffsets[i]);
+    }
+  }
+
+  // The level of each movable point, or -1. The edge lists are not
+  // symmetric when smoothing along feature edges, so the level of a point is
+  // both pulled from its neighbors before it and pushed to its neighbors
+  // after it.
+  auto movable = [&](vtkIdType i) { return edgeOffsets[i + 1] > edgeOffsets[i]; };
+  std::vector<vtkIdType> levels(params.numPts, -1);
+  vtkIdType numLevels = 0;
+  for (vtkIdType i = 0; i < params.numPts; ++i)
+  {
+    if (!movable(i))
+    {
+      continue;
+    }
+    vtkIdType& level = levels[i];
+    level = std::max<vtkIdType>(level, 0);
+    for (vtkIdType j = edgeOffsets[i]; j < edgeOffsets[i + 1]; ++j)
+    {
+      if (edgeIds[j] < i && movable(edgeIds[j]))
+      {
+        level = std::max(level, levels[edgeIds[j]] + 1);
+      }
+    }
+    for (vtkIdType j = edgeOffsets[i]; j < edgeOffsets[i + 1]; ++j)
+    {
+      if (edgeIds[j] > i && movable(edgeIds[j]))
+      {
+        levels[edgeIds[j]] = std::max(levels[edgeIds[j]], level + 1);
+      }
+    }
+    numLevels = std::max(numLevels, level + 1);
+  }
+
+  // the movable points sorted by level
+  std::vector<vtkIdType> levelOffsets(numLevels + 1, 0);
+  for (vtkIdType i = 0; i < params.numPts; ++i)
+  {
+    if (levels[i] >= 0)
+    {
+      ++levelOffsets[levels[i] + 1];
+    }
+  }
+  std::partial_sum(levelOffsets.begin(), levelOffsets.end(), levelOffsets.begin());
+  std::vector<vtkIdType> levelPts(levelOffsets[numLevels]);
+  std::vector<vtkIdType> levelEnds(levelOffsets.begin(), levelOffsets.end() - 1);
+  for (vtkIdType i = 0; i < params.numPts; ++i)
+  {
+    if (levels[i] >= 0)
+    {
+      levelPts[levelEnds[levels[i]]++] = i;
+    }
+  }
+
+  T* coords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  vtkSMPThreadLocal<T> localMaxDist(0);
+  auto movePoints = [&](vtkIdType begin, vtkIdType end) {
+    T& threadMaxDist = localMaxDist.Local();
+    T dist, deltaX[3];
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      const vtkIdType i = levelPts[idx];
+      vtkIdType npts = edgeOffsets[i + 1] - edgeOffsets[i];
+      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+      // Compute the mean (cumulated) direction vector
+      for (vtkIdType j = edgeOffsets[i]; j < edgeOffsets[i + 1]; ++j)
+      {
+        for (unsigned short k = 0; k < 3; ++k)
+        {
+          deltaX[k] += coords[3 * edgeIds[j] + k];
+        }
+      }
+
+      // Move the point
+      for (unsigned short k = 0; k < 3; ++k)
+      {
+        coords[3 * i + k] += params.factor * (deltaX[k] / npts - coords[3 * i + k]);
+      }
+
+      if ((dist = vtkMath::Norm(deltaX)) > threadMaxDist)
+      {
+        threadMaxDist = dist;
+      }
+    }
+  };
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
+      if (params.spdf->GetAbortExecute())
+      {
+        break;
+      }
+    }
+
+    for (T& threadMaxDist : localMaxDist)
+    {
+      threadMaxDist = 0.0;
+    }
+    // small levels are moved by the calling thread
+    for (vtkIdType level = 0; level < numLevels; ++level)
+    {
+      vtkSMPTools::For(levelOffsets[level], levelOffsets[level + 1], 1024, movePoints);
+    }
+
+    maxDist = 0.0;
+    for (T threadMaxDist : localMaxDist)
+    {
+      maxDist = std::max(maxDist, threadMaxDist);
+    }
+  }
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
 } // namespace
 
 int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -671,7 +826,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
       this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->EnableSMP && !source)
+    {
+      vtkSPDF_MovePointsThreaded(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
   else
   {
@@ -679,7 +841,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
       this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->EnableSMP && !source)
+    {
+      vtkSPDF_MovePointsThreaded(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
 
   if (source)
@@ -787,4 +956,5 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
 }
@@ -77,6 +77,14 @@
  * second input: the Source. If defined, the input mesh is constrained to
  * lie on the surface defined by the Source ivar.
  *
+ * The smoothing iterations can run in parallel with vtkSMPTools by turning
+ * on EnableSMP. Each iteration moves the vertices in place, from the already
+ * moved positions of the vertices before them: the vertices are sorted into
+ * levels that can be moved concurrently, one level after the other, which
+ * gives the same results as the serial iterations. The speedup depends on
+ * the number of levels, hence on the ordering of the points.
+ * Smoothing constrained by a Source is always serial.
+ *
  *
  * @warning
  * The Laplacian operation reduces high frequency information in the geometry
@@ -215,6 +223,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Enable or disable the threaded smoothing iterations. The results are
+   * identical to those of the serial iterations. It is ignored when a Source
+   * is set. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkSmoothPolyDataFilter();
   ~vtkSmoothPolyDataFilter() override {}
@@ -232,6 +251,7 @@ protected:
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
   int OutputPointsPrecision;
+  bool EnableSMP;
 
   vtkSmoothPoints* SmoothPoints;
 
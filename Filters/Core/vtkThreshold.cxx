@@ -15,17 +15,26 @@
 #include "vtkThreshold.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -48,6 +57,7 @@ vtkThreshold::vtkThreshold()
 
   this->UseContinuousCellRange = 0;
   this->Invert = false;
+  this->EnableSMP = false;
 }
 
 vtkThreshold::~vtkThreshold() = default;
@@ -178,6 +188,22 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     newPoints->SetDataType(VTK_DOUBLE);
   }
 
+  // are we using pointScalars?
+  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
+  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+
+  vtkUnstructuredGrid* inputUG = vtkUnstructuredGrid::SafeDownCast(input);
+  if (this->EnableSMP && !(inputUG && inputUG->GetFaces()))
+  {
+    this->ThreadedThreshold(input, inScalars, usePointScalars, newPoints, output);
+    vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
+
+    output->SetPoints(newPoints);
+    newPoints->Delete();
+    output->Squeeze();
+    return 1;
+  }
+
   newPoints->Allocate(numPts);
 
   pointMap = vtkIdList::New(); // maps old point ids into new
@@ -189,10 +215,6 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
 
   newCellPts = vtkIdList::New();
 
-  // are we using pointScalars?
-  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
-  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
-
   // Check that the scalars of each cell satisfy the threshold criterion
   for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
   {
@@ -200,41 +222,7 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     cellPts = cell->GetPointIds();
     numCellPts = cell->GetNumberOfPoints();
 
-    if (usePointScalars)
-    {
-      if (this->AllScalars)
-      {
-        keepCell = 1;
-        for (i = 0; keepCell && (i < numCellPts); i++)
-        {
-          ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents(inScalars, ptId);
-        }
-      }
-      else
-      {
-        if (!this->UseContinuousCellRange)
-        {
-          keepCell = 0;
-          for (i = 0; (!keepCell) && (i < numCellPts); i++)
-          {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents(inScalars, ptId);
-          }
-        }
-        else
-        {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
-        }
-      }
-    }
-    else // use cell scalars
-    {
-      keepCell = this->EvaluateComponents(inScalars, cellId);
-    }
-
-    // Invert the keep flag if the Invert option is enabled.
-    keepCell = this->Invert ? (1 - keepCell) : keepCell;
+    keepCell = this->KeepCell(inScalars, cellId, cellPts, usePointScalars);
 
     if (numCellPts > 0 && keepCell)
     {
@@ -352,6 +340,260 @@ int vtkThreshold::EvaluateComponents(vtkDataArray* scalars, vtkIdType id)
   return keepCell;
 }
 
+int vtkThreshold::KeepCell(
+  vtkDataArray* scalars, vtkIdType cellId, vtkIdList* cellPts, bool usePointScalars)
+{
+  const int numCellPts = static_cast<int>(cellPts->GetNumberOfIds());
+  int keepCell;
+  int i;
+
+  if (usePointScalars)
+  {
+    if (this->AllScalars)
+    {
+      keepCell = 1;
+      for (i = 0; keepCell && (i < numCellPts); i++)
+      {
+        keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+      }
+    }
+    else
+    {
+      if (!this->UseContinuousCellRange)
+      {
+        keepCell = 0;
+        for (i = 0; (!keepCell) && (i < numCellPts); i++)
+        {
+          keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+        }
+      }
+      else
+      {
+        keepCell = this->EvaluateCell(scalars, cellPts, numCellPts);
+      }
+    }
+  }
+  else // use cell scalars
+  {
+    keepCell = this->EvaluateComponents(scalars, cellId);
+  }
+
+  // Invert the keep flag if the Invert option is enabled.
+  return this->Invert ? (1 - keepCell) : keepCell;
+}
+
+namespace
+{
+const vtkIdType ThresholdBatchSize = 1000;
+
+// Exclusive prefix sum of values[0, n), the total is stored in values[n].
+void PrefixSum(vtkIdType* values, vtkIdType n)
+{
+  vtkIdType total = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const vtkIdType value = values[i];
+    values[i] = total;
+    total += value;
+  }
+  values[n] = total;
+}
+}
+
+void vtkThreshold::ThreadedThreshold(vtkDataSet* input, vtkDataArray* inScalars,
+  bool usePointScalars, vtkPoints* newPoints, vtkUnstructuredGrid* output)
+{
+  vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
+  vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numBatches = numCells > 0 ? (numCells - 1) / ThresholdBatchSize + 1 : 0;
+
+  // The dataset queries used below are only thread safe once they have been
+  // called from a single thread, which builds the cells of a vtkPolyData.
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  if (numCells > 0)
+  {
+    double x[3];
+    input->GetCellPoints(0, tlCellPts.Local());
+    input->GetCellType(0);
+    input->GetPoint(0, x);
+  }
+
+  // Evaluate the criterion for all the cells, counting the cells kept in each
+  // batch and the size of their connectivity.
+  std::vector<unsigned char> keep(numCells);
+  std::vector<vtkIdType> batchCells(numBatches + 1);
+  std::vector<vtkIdType> batchConn(numBatches + 1);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType numKept = 0;
+      vtkIdType connSize = 0;
+      const vtkIdType endCellId = std::min((batch + 1) * ThresholdBatchSize, numCells);
+      for (vtkIdType cellId = batch * ThresholdBatchSize; cellId < endCellId; ++cellId)
+      {
+        input->GetCellPoints(cellId, cellPts);
+        const vtkIdType numCellPts = cellPts->GetNumberOfIds();
+        // non-empty cells only, i.e. not VTK_EMPTY_CELL
+        keep[cellId] =
+          numCellPts > 0 && this->KeepCell(inScalars, cellId, cellPts, usePointScalars);
+        if (keep[cellId])
+        {
+          ++numKept;
+          connSize += numCellPts;
+        }
+      }
+      batchCells[batch] = numKept;
+      batchConn[batch] = connSize;
+    }
+  });
+  PrefixSum(batchCells.data(), numBatches);
+  PrefixSum(batchConn.data(), numBatches);
+  const vtkIdType numNewCells = batchCells[numBatches];
+  const vtkIdType connSize = batchConn[numBatches];
+
+  // Write the offsets, types and connectivity of the kept cells at the
+  // offsets of their batch. The connectivity still refers to the input points.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewCells + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numNewCells);
+  vtkNew<vtkIdList> sourceCells;
+  sourceCells->SetNumberOfIds(numNewCells);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connPtr = conn->GetPointer(0);
+  unsigned char* typesPtr = types->GetPointer(0);
+  vtkIdType* sourceCellsPtr = sourceCells->GetPointer(0);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType newCellId = batchCells[batch];
+      vtkIdType loc = batchConn[batch];
+      const vtkIdType endCellId = std::min((batch + 1) * ThresholdBatchSize, numCells);
+      for (vtkIdType cellId = batch * ThresholdBatchSize; cellId < endCellId; ++cellId)
+      {
+        if (!keep[cellId])
+        {
+          continue;
+        }
+        input->GetCellPoints(cellId, cellPts);
+        const vtkIdType numCellPts = cellPts->GetNumberOfIds();
+        offsetsPtr[newCellId] = loc;
+        typesPtr[newCellId] = static_cast<unsigned char>(input->GetCellType(cellId));
+        sourceCellsPtr[newCellId] = cellId;
+        std::copy(cellPts->GetPointer(0), cellPts->GetPointer(0) + numCellPts, connPtr + loc);
+        loc += numCellPts;
+        ++newCellId;
+      }
+    }
+  });
+  offsetsPtr[numNewCells] = connSize;
+
+  // Number the used input points in the order of their first use in the
+  // connectivity, which is the order of the serial code.
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  for (std::atomic<vtkIdType>& ptFirstUse : firstUse)
+  {
+    ptFirstUse.store(VTK_ID_MAX, std::memory_order_relaxed);
+  }
+  const vtkIdType numConnBatches = connSize > 0 ? (connSize - 1) / ThresholdBatchSize + 1 : 0;
+  vtkSMPTools::For(0, numConnBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    const vtkIdType end = std::min(endBatch * ThresholdBatchSize, connSize);
+    for (vtkIdType i = beginBatch * ThresholdBatchSize; i < end; ++i)
+    {
+      // memory_order_relaxed is safe here, the atomics are only used to
+      // compute a minimum, not for synchronization.
+      std::atomic<vtkIdType>& ptFirstUse = firstUse[connPtr[i]];
+      vtkIdType current = ptFirstUse.load(std::memory_order_relaxed);
+      while (
+        i < current && !ptFirstUse.compare_exchange_weak(current, i, std::memory_order_relaxed))
+      {
+      }
+    }
+  });
+
+  std::vector<vtkIdType> batchPts(numConnBatches + 1);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  auto numberPoints = [&](vtkIdType beginBatch, vtkIdType endBatch, bool generate) {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType newPtId = generate ? batchPts[batch] : 0;
+      const vtkIdType end = std::min((batch + 1) * ThresholdBatchSize, connSize);
+      for (vtkIdType i = batch * ThresholdBatchSize; i < end; ++i)
+      {
+        if (firstUse[connPtr[i]].load(std::memory_order_relaxed) == i)
+        {
+          if (generate)
+          {
+            pointMap[connPtr[i]] = newPtId;
+          }
+          ++newPtId;
+        }
+      }
+      if (!generate)
+      {
+        batchPts[batch] = newPtId;
+      }
+    }
+  };
+  vtkSMPTools::For(0, numConnBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    numberPoints(beginBatch, endBatch, false);
+  });
+  PrefixSum(batchPts.data(), numConnBatches);
+  vtkSMPTools::For(0, numConnBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    numberPoints(beginBatch, endBatch, true);
+  });
+  const vtkIdType numNewPts = batchPts[numConnBatches];
+
+  // Copy the used points and map the connectivity to the output points.
+  vtkNew<vtkIdList> sourcePts;
+  sourcePts->SetNumberOfIds(numNewPts);
+  vtkIdType* sourcePtsPtr = sourcePts->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (pointMap[ptId] >= 0)
+      {
+        sourcePtsPtr[pointMap[ptId]] = ptId;
+      }
+    }
+  });
+  newPoints->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType newPtId = begin; newPtId < end; ++newPtId)
+    {
+      input->GetPoint(sourcePtsPtr[newPtId], x);
+      newPoints->SetPoint(newPtId, x);
+    }
+  });
+  vtkSMPTools::For(0, connSize, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      connPtr[i] = pointMap[connPtr[i]];
+    }
+  });
+
+  // The per-id attribute copies are not thread safe, copy them in bulk.
+  vtkNew<vtkIdList> destPts;
+  destPts->SetNumberOfIds(numNewPts);
+  std::iota(destPts->GetPointer(0), destPts->GetPointer(0) + numNewPts, 0);
+  outPD->CopyData(pd, sourcePts, destPts);
+  vtkNew<vtkIdList> destCells;
+  destCells->SetNumberOfIds(numNewCells);
+  std::iota(destCells->GetPointer(0), destCells->GetPointer(0) + numNewCells, 0);
+  outCD->CopyData(cd, sourceCells, destCells);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, conn);
+  output->SetCells(types, cells);
+}
+
 // Return the method for manipulating scalar data as a string.
 const char* vtkThreshold::GetAttributeModeAsString()
 {
@@ -460,4 +702,5 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Upper Threshold: " << this->UpperThreshold << "\n";
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
   os << indent << "Use Continuous Cell Range: " << this->UseContinuousCellRange << endl;
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << endl;
 }
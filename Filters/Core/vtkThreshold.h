@@ -30,6 +30,12 @@
  * By default only the first scalar value is used in the decision. Use the ComponentMode
  * and SelectedComponent ivars to control this behavior.
  *
+ * The cells can be thresholded in parallel with vtkSMPTools by turning on
+ * EnableSMP. The criterion is first evaluated for all the cells, and the
+ * output cells and points are then written at offsets given by prefix sums,
+ * producing the same output as the serial code path. Unstructured grids with
+ * polyhedra are always processed serially.
+ *
  * @sa
  * vtkThresholdPoints vtkThresholdTextureCoords
  */
@@ -51,6 +57,7 @@
 
 class vtkDataArray;
 class vtkIdList;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -208,6 +215,17 @@ public:
   int Upper(double s) const;
   int Between(double s) const;
   //@}
+
+  //@{
+  /**
+   * Enable or disable the threaded thresholding of the cells. The output is
+   * identical to the one of the serial implementation. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkThreshold();
   ~vtkThreshold() override;
@@ -226,6 +244,7 @@ protected:
   int OutputPointsPrecision;
   vtkTypeBool UseContinuousCellRange;
   bool Invert;
+  bool EnableSMP;
 
   int (vtkThreshold::*ThresholdFunction)(double s) const;
 
@@ -233,6 +252,21 @@ protected:
   int EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts);
   int EvaluateCell(vtkDataArray* scalars, int c, vtkIdList* cellPts, int numCellPts);
 
+  /**
+   * Evaluate the threshold criterion for the cell cellId whose point ids are
+   * cellPts, taking Invert into account.
+   */
+  int KeepCell(vtkDataArray* scalars, vtkIdType cellId, vtkIdList* cellPts, bool usePointScalars);
+
+  /**
+   * Threaded counterpart of the cell loop of RequestData(), used when EnableSMP
+   * is on. A keep mask of the cells is computed in parallel and prefix summed
+   * per batch of cells, so that the connectivity, offsets and types of the
+   * output are then generated in a single parallel pass without reallocation.
+   */
+  void ThreadedThreshold(vtkDataSet* input, vtkDataArray* inScalars, bool usePointScalars,
+    vtkPoints* newPoints, vtkUnstructuredGrid* output);
+
 private:
   vtkThreshold(const vtkThreshold&) = delete;
   void operator=(const vtkThreshold&) = delete;
@@ -24,9 +24,13 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 //-----------------------------------------------------------------------------
@@ -50,6 +54,8 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->NormalizeCoordinates = 0;
+
+  this->EnableSMP = false;
 }
 
 #define VTK_SIMPLE_VERTEX 0
@@ -81,7 +87,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
   vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; // Cosine of angle between adjacent polys
   double CosEdgeAngle;    // Cosine of angle between adjacent edges
@@ -95,7 +100,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -580,112 +585,161 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
                      "Unpredictable smoothing/shrinkage may result.");
   }
 
-  // first iteration
+  // Gather the connected points of all the vertices once, in a compressed
+  // sparse row layout: the iterations below only read it, each point
+  // gathering from its neighbors.
+  std::vector<vtkIdType> edgeOffsets(numPts + 1, 0);
+  for (i = 0; i < numPts; i++)
+  {
+    edgeOffsets[i + 1] =
+      edgeOffsets[i] + (Verts[i].edges != nullptr ? Verts[i].edges->GetNumberOfIds() : 0);
+  }
+  std::vector<vtkIdType> edgeIds(edgeOffsets[numPts]);
   for (i = 0; i < numPts; i++)
   {
-    if (Verts[i].edges != nullptr && (npts = Verts[i].edges->GetNumberOfIds()) > 0)
+    if (Verts[i].edges != nullptr)
     {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); // use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+      std::copy(Verts[i].edges->GetPointer(0),
+        Verts[i].edges->GetPointer(0) + Verts[i].edges->GetNumberOfIds(),
+        edgeIds.begin() + edgeOffsets[i]);
+    }
+  }
 
-      // calculate the negative of the laplacian
-      for (j = 0; j < npts; j++) // for all connected points
+  // Every point of an iteration only depends on the points of the previous
+  // ones, so the points can be updated in any order, or in parallel, with
+  // the same result.
+  auto firstIteration = [&](vtkIdType begin, vtkIdType end) {
+    double xCur[3], yCur[3], delta[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      vtkIdType numEdges = edgeOffsets[ptId + 1] - edgeOffsets[ptId];
+      newPts[zero]->GetPoint(ptId, xCur); // use current points
+      if (numEdges > 0)
       {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k = 0; k < 3; k++)
+        // point is allowed to move
+        delta[0] = delta[1] = delta[2] = 0.0;
+
+        // calculate the negative of the laplacian
+        for (vtkIdType e = edgeOffsets[ptId]; e < edgeOffsets[ptId + 1]; e++)
+        {
+          newPts[zero]->GetPoint(edgeIds[e], yCur);
+          for (int comp = 0; comp < 3; comp++)
+          {
+            delta[comp] += (xCur[comp] - yCur[comp]) / numEdges;
+          }
+        }
+        // newPts[one] = newPts[zero] - 0.5 newPts[one]
+        for (int comp = 0; comp < 3; comp++)
         {
-          deltaX[k] += (x[k] - y[k]) / npts;
+          delta[comp] = xCur[comp] - 0.5 * delta[comp];
         }
-      }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k = 0; k < 3; k++)
-      {
-        deltaX[k] = x[k] - 0.5 * deltaX[k];
-      }
-      newPts[one]->SetPoint(i, deltaX);
+        newPts[one]->SetPoint(ptId, delta);
 
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k = 0; k < 3; k++)
-      {
-        deltaX[k] = c[0] * x[k] + c[1] * deltaX[k];
-      }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-      {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
+        // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+        for (int comp = 0; comp < 3; comp++)
+        {
+          delta[comp] = c[0] * xCur[comp] + c[1] * delta[comp];
+        }
+        if (Verts[ptId].type == VTK_FIXED_VERTEX)
+        {
+          newPts[three]->SetPoint(ptId, xCur);
+        }
+        else
+        {
+          newPts[three]->SetPoint(ptId, delta);
+        }
+      } // if can move point
       else
       {
-        newPts[three]->SetPoint(i, deltaX);
-      }
-    } // if can move point
-    else
-    {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-    }
-  } // for all points
-
-  // for the rest of the iterations
-  for (iterationNumber = 2; iterationNumber <= this->NumberOfIterations; iterationNumber++)
-  {
-    if (iterationNumber && !(iterationNumber % 5))
-    {
-      this->UpdateProgress(0.5 + 0.5 * iterationNumber / this->NumberOfIterations);
-      if (this->GetAbortExecute())
-      {
-        break;
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        newPts[one]->SetPoint(ptId, zerovector);
+        newPts[three]->SetPoint(ptId, xCur);
       }
-    }
+    } // for all points
+  };
 
-    for (i = 0; i < numPts; i++)
+  auto nextIteration = [&](vtkIdType begin, vtkIdType end) {
+    double x0[3], x1[3], x3[3], yCur[3], delta[3], xCur[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
     {
-      if (Verts[i].edges != nullptr && (npts = Verts[i].edges->GetNumberOfIds()) > 0)
+      vtkIdType numEdges = edgeOffsets[ptId + 1] - edgeOffsets[ptId];
+      if (numEdges > 0)
       {
         // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); // use current points
-        newPts[one]->GetPoint(i, p_x1);
+        newPts[zero]->GetPoint(ptId, x0); // use current points
+        newPts[one]->GetPoint(ptId, x1);
 
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+        delta[0] = delta[1] = delta[2] = 0.0;
 
         // calculate the negative laplacian of x1
-        for (j = 0; j < npts; j++)
+        for (vtkIdType e = edgeOffsets[ptId]; e < edgeOffsets[ptId + 1]; e++)
         {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k = 0; k < 3; k++)
+          newPts[one]->GetPoint(edgeIds[e], yCur);
+          for (int comp = 0; comp < 3; comp++)
           {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
+            delta[comp] += (x1[comp] - yCur[comp]) / numEdges;
           }
         } // for all connected points
 
         // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k = 0; k < 3; k++)
+        for (int comp = 0; comp < 3; comp++)
         {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
+          delta[comp] = x1[comp] - x0[comp] + x1[comp] - delta[comp];
         }
-        newPts[two]->SetPoint(i, deltaX);
+        newPts[two]->SetPoint(ptId, delta);
 
         // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k = 0; k < 3; k++)
+        newPts[three]->GetPoint(ptId, x3);
+        for (int comp = 0; comp < 3; comp++)
         {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
+          xCur[comp] = x3[comp] + c[iterationNumber] * delta[comp];
         }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
+        if (Verts[ptId].type != VTK_FIXED_VERTEX)
         {
-          newPts[three]->SetPoint(i, xNew);
+          newPts[three]->SetPoint(ptId, xCur);
         }
       } // if can move point
       else
       {
         // point is not allowed to move, just use the old point...
         // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
+        newPts[one]->SetPoint(ptId, zerovector);
+        newPts[two]->SetPoint(ptId, zerovector);
       }
     } // for all points
+  };
+
+  // first iteration
+  if (this->EnableSMP)
+  {
+    vtkSMPTools::For(0, numPts, firstIteration);
+  }
+  else
+  {
+    firstIteration(0, numPts);
+  }
+
+  // for the rest of the iterations
+  for (iterationNumber = 2; iterationNumber <= this->NumberOfIterations; iterationNumber++)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      this->UpdateProgress(0.5 + 0.5 * iterationNumber / this->NumberOfIterations);
+      if (this->GetAbortExecute())
+      {
+        break;
+      }
+    }
+
+    if (this->EnableSMP)
+    {
+      vtkSMPTools::For(0, numPts, nextIteration);
+    }
+    else
+    {
+      nextIteration(0, numPts);
+    }
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -809,4 +863,5 @@ void vtkWindowedSincPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Nonmanifold Smoothing: " << (this->NonManifoldSmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << "\n";
 }
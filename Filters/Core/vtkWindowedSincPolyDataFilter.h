@@ -125,6 +125,11 @@
  * ivar GenerateErrorVectors is on, then a vector representing change in
  * position is computed.
  *
+ * The smoothing iterations can run in parallel with vtkSMPTools by turning
+ * on EnableSMP. Each iteration only reads the positions of the previous
+ * ones, so the points are updated concurrently and the output is identical
+ * to the serial one.
+ *
  * @warning
  * The smoothing operation reduces high frequency information in the
  * geometry of the mesh. With excessive smoothing important details may be
@@ -250,6 +255,16 @@ public:
   vtkBooleanMacro(GenerateErrorVectors, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Enable or disable the threaded smoothing iterations. The output is
+   * identical to the one of the serial implementation. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkWindowedSincPolyDataFilter();
   ~vtkWindowedSincPolyDataFilter() override {}
@@ -266,6 +281,7 @@ protected:
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
   vtkTypeBool NormalizeCoordinates;
+  bool EnableSMP;
 
 private:
   vtkWindowedSincPolyDataFilter(const vtkWindowedSincPolyDataFilter&) = delete;
@@ -0,0 +1,254 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorsBatchQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the batched FindCells() and IntersectWithLines() queries of the
+// cell locators with the equivalent loops of single queries, and check that
+// the legacy IntersectCellInternal() overrides are still called.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkImageDataToPointSet.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStructuredGrid.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkIdType numPts, double range,
+  vtkPoints* points)
+{
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(-range, range);
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+bool TestFindCells(vtkAbstractCellLocator* locator, vtkDataSet* input, vtkPoints* queries)
+{
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+
+  vtkNew<vtkIdList> cellIds;
+  locator->FindCells(queries, cellIds);
+  if (cellIds->GetNumberOfIds() != queries->GetNumberOfPoints())
+  {
+    std::cerr << locator->GetClassName() << ": wrong number of FindCells() results\n";
+    return false;
+  }
+
+  vtkIdType numFound = 0;
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    queries->GetPoint(i, x);
+    vtkIdType cellId = locator->FindCell(x);
+    if (cellId != cellIds->GetId(i))
+    {
+      std::cerr << locator->GetClassName() << ": FindCells() returned " << cellIds->GetId(i)
+                << " instead of " << cellId << " for point " << i << "\n";
+      return false;
+    }
+    numFound += (cellId >= 0 ? 1 : 0);
+  }
+  if (numFound == 0 || numFound == queries->GetNumberOfPoints())
+  {
+    std::cerr << locator->GetClassName() << ": the test points do not cover both cases\n";
+    return false;
+  }
+  return true;
+}
+
+bool TestIntersectWithLines(
+  vtkAbstractCellLocator* locator, vtkDataSet* input, vtkPoints* p1, vtkPoints* p2)
+{
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkIdList> cellIds;
+  locator->IntersectWithLines(p1, p2, 0.0, points, cellIds);
+  if (cellIds->GetNumberOfIds() != p1->GetNumberOfPoints() ||
+    points->GetNumberOfPoints() != p1->GetNumberOfPoints())
+  {
+    std::cerr << locator->GetClassName() << ": wrong number of IntersectWithLines() results\n";
+    return false;
+  }
+
+  vtkIdType numHits = 0;
+  for (vtkIdType i = 0; i < p1->GetNumberOfPoints(); ++i)
+  {
+    double a0[3], a1[3], x[3], pcoords[3], t, y[3];
+    int subId;
+    vtkIdType cellId = -1;
+    p1->GetPoint(i, a0);
+    p2->GetPoint(i, a1);
+    if (!locator->IntersectWithLine(a0, a1, 0.0, t, x, pcoords, subId, cellId))
+    {
+      cellId = -1;
+      x[0] = a1[0];
+      x[1] = a1[1];
+      x[2] = a1[2];
+    }
+    points->GetPoint(i, y);
+    if (cellId != cellIds->GetId(i) || x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << locator->GetClassName() << ": IntersectWithLines() returned cell "
+                << cellIds->GetId(i) << " instead of " << cellId << " for line " << i << "\n";
+      return false;
+    }
+    numHits += (cellId >= 0 ? 1 : 0);
+  }
+  if (numHits == 0 || numHits == p1->GetNumberOfPoints())
+  {
+    std::cerr << locator->GetClassName() << ": the test lines do not cover both cases\n";
+    return false;
+  }
+
+  // The intersection points are optional.
+  vtkNew<vtkIdList> cellIds2;
+  locator->IntersectWithLines(p1, p2, 0.0, nullptr, cellIds2);
+  for (vtkIdType i = 0; i < p1->GetNumberOfPoints(); ++i)
+  {
+    if (cellIds2->GetId(i) != cellIds->GetId(i))
+    {
+      std::cerr << locator->GetClassName() << ": IntersectWithLines() without points differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifndef VTK_LEGACY_REMOVE
+// A locator overriding the legacy cell/ray test to reject every cell.
+template <typename TLocator>
+class vtkLegacyIntersectLocator : public TLocator
+{
+public:
+  static vtkLegacyIntersectLocator* New() { VTK_STANDARD_NEW_BODY(vtkLegacyIntersectLocator); }
+
+  std::atomic<vtkIdType> NumberOfCalls{ 0 };
+  std::atomic<int> NumberOfActiveCalls{ 0 };
+  std::atomic<bool> ConcurrentCalls{ false };
+
+protected:
+  int IntersectCellInternal(vtkIdType, const double*, const double*, const double, double&,
+    double*, double*, int&) override
+  {
+    ++this->NumberOfCalls;
+    if (++this->NumberOfActiveCalls > 1)
+    {
+      this->ConcurrentCalls = true;
+    }
+    --this->NumberOfActiveCalls;
+    return 0;
+  }
+};
+
+template <typename TLocator>
+bool TestLegacyIntersectCellInternal(vtkDataSet* input, vtkPoints* p1, vtkPoints* p2)
+{
+  vtkNew<vtkLegacyIntersectLocator<TLocator> > locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  vtkNew<vtkIdList> cellIds;
+  locator->IntersectWithLines(p1, p2, 0.0, nullptr, cellIds);
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+  {
+    if (cellIds->GetId(i) >= 0)
+    {
+      std::cerr << locator->GetClassName() << ": the legacy IntersectCellInternal() is ignored\n";
+      return false;
+    }
+  }
+  if (locator->NumberOfCalls == 0)
+  {
+    std::cerr << locator->GetClassName() << ": the legacy IntersectCellInternal() is not called\n";
+    return false;
+  }
+  if (locator->ConcurrentCalls)
+  {
+    std::cerr << locator->GetClassName()
+              << ": the legacy IntersectCellInternal() is called concurrently\n";
+    return false;
+  }
+  return true;
+}
+#endif
+}
+
+int TestCellLocatorsBatchQueries(int, char*[])
+{
+  // A volume for the point queries, a surface for the line queries.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(24, 24, 24);
+  image->SetOrigin(-1.0, -1.0, -1.0);
+  image->SetSpacing(2.0 / 23, 2.0 / 23, 2.0 / 23);
+  vtkNew<vtkImageDataToPointSet> toPointSet;
+  toPointSet->SetInputData(image);
+  toPointSet->Update();
+  vtkStructuredGrid* volume = toPointSet->GetOutput();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> queries;
+  RandomPoints(random, 5000, 1.25, queries);
+  vtkNew<vtkPoints> p1;
+  vtkNew<vtkPoints> p2;
+  RandomPoints(random, 5000, 1.0, p1);
+  RandomPoints(random, 5000, 2.0, p2);
+
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkStaticCellLocator> staticCellLocator;
+  vtkNew<vtkCellTreeLocator> cellTreeLocator;
+  vtkNew<vtkModifiedBSPTree> bspTree;
+  vtkAbstractCellLocator* locators[] = { cellLocator, staticCellLocator, cellTreeLocator,
+    bspTree };
+
+  bool success = true;
+  for (vtkAbstractCellLocator* locator : locators)
+  {
+    success &= TestFindCells(locator, volume, queries);
+    success &= TestIntersectWithLines(locator, surface, p1, p2);
+  }
+#ifndef VTK_LEGACY_REMOVE
+  success &= TestLegacyIntersectCellInternal<vtkCellTreeLocator>(surface, p1, p2);
+  success &= TestLegacyIntersectCellInternal<vtkModifiedBSPTree>(surface, p1, p2);
+#endif
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
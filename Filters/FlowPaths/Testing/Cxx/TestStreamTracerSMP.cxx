@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the streamlines integrated by the serial and threaded code paths
+// of vtkStreamTracer, which must be identical.
+
+#include "vtkCellTypeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStreamTracer.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+bool TestThreadedStreamTracer(vtkStreamTracer* tracer)
+{
+  tracer->EnableSMPOff();
+  tracer->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(tracer->GetOutput());
+
+  tracer->EnableSMPOn();
+  tracer->Update();
+  tracer->EnableSMPOff();
+
+  if (serial->GetNumberOfLines() == 0)
+  {
+    std::cerr << "Serial output has no streamlines" << std::endl;
+    return false;
+  }
+  return vtkTest::SameDataSets(serial, tracer->GetOutput());
+}
+}
+
+int TestStreamTracerSMP(int, char*[])
+{
+  // A smooth analytic flow on image data, seeded from a plane.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-10, 10, -10, 10, -10, 10);
+  vtkNew<vtkDoubleArray> imageVelocity;
+  imageVelocity->SetName("Velocity");
+  imageVelocity->SetNumberOfComponents(3);
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    image->GetPoint(ptId, x);
+    imageVelocity->InsertNextTuple3(
+      std::sin(0.3 * x[1]) + 0.2, std::cos(0.3 * x[0]), 0.3 * std::sin(0.2 * (x[0] + x[1])));
+  }
+  image->GetPointData()->SetVectors(imageVelocity);
+
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(-8.0, -8.0, 0.5);
+  plane->SetPoint1(8.0, -8.0, 0.5);
+  plane->SetPoint2(-8.0, 8.0, 0.5);
+  plane->SetResolution(15, 15);
+
+  vtkNew<vtkStreamTracer> tracer;
+  tracer->SetInputData(image);
+  tracer->SetSourceConnection(plane->GetOutputPort());
+  tracer->SetMaximumPropagation(20.0);
+  tracer->SetIntegrationDirectionToBoth();
+  for (int integrator = vtkStreamTracer::RUNGE_KUTTA2;
+       integrator <= vtkStreamTracer::RUNGE_KUTTA45; ++integrator)
+  {
+    tracer->SetIntegratorType(integrator);
+    if (!TestThreadedStreamTracer(tracer))
+    {
+      std::cerr << "Failed with image data and integrator " << integrator << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The vorticity adds the rotation and the normals of the streamlines.
+  tracer->SetComputeVorticity(true);
+  if (!TestThreadedStreamTracer(tracer) ||
+    !tracer->GetOutput()->GetPointData()->GetArray("Normals"))
+  {
+    std::cerr << "Failed with image data and vorticity" << std::endl;
+    return EXIT_FAILURE;
+  }
+  tracer->SetComputeVorticity(false);
+
+  // A swirling flow on tetrahedra, with both interpolator types.
+  vtkNew<vtkCellTypeSource> tetras;
+  tetras->SetCellType(VTK_TETRA);
+  tetras->SetBlocksDimensions(8, 8, 8);
+  tetras->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(tetras->GetOutput());
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    grid->GetPoint(ptId, x);
+    velocity->InsertNextTuple3(4.0 - x[1], x[0] - 4.0, 0.2);
+  }
+  grid->GetPointData()->SetVectors(velocity);
+
+  plane->SetOrigin(4.5, 0.5, 0.5);
+  plane->SetPoint1(7.5, 0.5, 0.5);
+  plane->SetPoint2(4.5, 0.5, 7.5);
+  tracer->SetInputData(grid);
+  tracer->SetIntegrationDirectionToForward();
+  tracer->SetMaximumPropagation(30.0);
+  tracer->SetIntegrationStepUnit(vtkStreamTracer::LENGTH_UNIT);
+  tracer->SetInitialIntegrationStep(0.2);
+  for (int interpolator = vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR;
+       interpolator <= vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR; ++interpolator)
+  {
+    tracer->SetInterpolatorType(interpolator);
+    if (!TestThreadedStreamTracer(tracer))
+    {
+      std::cerr << "Failed with an unstructured grid and interpolator " << interpolator
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -18,10 +18,12 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
 #include <stack>
+#include <typeinfo>
 #include <vector>
 
 #include "vtkAppendPolyData.h"
@@ -212,24 +214,26 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   //
   this->StoreCellBounds();
   //
-  // sort the cells into 6 lists using structure for subdividing tests
+  // sort the cells into 6 lists using structure for subdividing tests.
+  // The lists are independent so each one is filled and sorted by its own
+  // task, the subdivision below remains serial.
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i = 0; i < 3; i++)
-  { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
+  vtkSMPTools::For(0, 6, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType list = begin; list < end; list++)
+    {
+      const int i = static_cast<int>(list / 2); // i=0 x, i=1 y, i=2 z
+      cell_extents* extents = (list % 2 == 0) ? lists->Mins[i] : lists->Maxs[i];
+      for (vtkIdType j = 0; j < numCells; j++)
+      { // loop over each cell
+        extents[j].min = CellBounds[j][i * 2];
+        extents[j].max = CellBounds[j][i * 2 + 1];
+        extents[j].cell_ID = j;
+      }
+      // Sort
+      qsort(extents, numCells, sizeof(cell_extents),
+        (list % 2 == 0) ? __compareMin : __compareMax);
     }
-    // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), __compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), __compareMax);
-  }
+  });
   //
   // call the recursive subdivision routine
   //
@@ -652,18 +656,15 @@ int BSPNode::getDominantAxis(const double dir[3])
 }
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 //---------------------------------------------------------------------------
+// The candidate cells are tested with the given generic cell so that
+// concurrent queries do not share any state of the tree.
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
 {
   //
   BSPNode *node, *Near, *Mid, *Far;
@@ -782,7 +783,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
       ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit < closest_intersection)
           {
@@ -801,6 +802,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellId, cell);
   }
   //
   return HIT;
@@ -950,7 +952,8 @@ int vtkModifiedBSPTree::IntersectWithLine(
       ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(
+              cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, this->GenericCell))
         {
           if (points)
           {
@@ -995,14 +998,73 @@ int vtkModifiedBSPTree::IntersectWithLine(
   //
   return HIT;
 }
+//---------------------------------------------------------------------------
+#ifndef VTK_LEGACY_REMOVE
+namespace
+{
+// The cell given to the IntersectCellInternal() call running in each thread.
+thread_local vtkGenericCell* vtkModifiedBSPTreeIntersectCell = nullptr;
+}
+
+// The legacy IntersectCellInternal() is called from the new one.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+#endif
+
+int vtkModifiedBSPTree::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
+{
+#ifndef VTK_LEGACY_REMOVE
+  vtkGenericCell* previousCell = vtkModifiedBSPTreeIntersectCell;
+  vtkModifiedBSPTreeIntersectCell = cell;
+  int hit = this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId);
+  vtkModifiedBSPTreeIntersectCell = previousCell;
+  return hit;
+#else
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
+    const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+#endif
+}
+
+#ifndef VTK_LEGACY_REMOVE
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic pop
+#endif
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
   const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(
+  vtkGenericCell* cell =
+    vtkModifiedBSPTreeIntersectCell ? vtkModifiedBSPTreeIntersectCell : this->GenericCell;
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
     const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
+#endif
+
+//---------------------------------------------------------------------------
+bool vtkModifiedBSPTree::IsIntersectWithLineThreadSafe()
+{
+#ifndef VTK_LEGACY_REMOVE
+  // Subclasses may override the legacy IntersectCellInternal(), which can
+  // only use the shared GenericCell.
+  return typeid(*this) == typeid(vtkModifiedBSPTree);
+#else
+  return true;
+#endif
+}
 //////////////////////////////////////////////////////////////////////////////
 // FindCell stuff
 //////////////////////////////////////////////////////////////////////////////
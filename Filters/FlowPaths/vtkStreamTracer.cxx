@@ -43,9 +43,13 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStaticCellLocator.h"
 
+#include <algorithm>
+#include <mutex>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer);
@@ -116,6 +120,7 @@ vtkStreamTracer::vtkStreamTracer()
   this->LastUsedStepSize = 0.0;
 
   this->GenerateNormalsInIntegrate = true;
+  this->IntegrateInThreads = false;
 
   this->InterpolatorPrototype = nullptr;
 
@@ -128,6 +133,7 @@ vtkStreamTracer::vtkStreamTracer()
   this->HasMatchingPointAttributes = true;
 
   this->SurfaceStreamlines = false;
+  this->EnableSMP = false;
 }
 
 //---------------------------------------------------------------------------
@@ -511,8 +517,20 @@ int vtkStreamTracer::RequestData(vtkInformation* vtkNotUsed(request),
       double propagation = 0;
       vtkIdType numSteps = 0;
       double integrationTime = 0;
-      this->Integrate(input0->GetPointData(), output, seeds, seedIds, integrationDirections,
-        lastPoint, func, maxCellSize, vecType, vecName, propagation, numSteps, integrationTime);
+      // The custom termination callbacks may not be thread safe, and the
+      // point data of mismatching blocks is handled by removing arrays from
+      // the output, which the threaded path does not support.
+      if (this->EnableSMP && vtkCompositeInterpolatedVelocityField::SafeDownCast(func) &&
+        this->CustomTerminationCallback.empty() && this->HasMatchingPointAttributes)
+      {
+        this->ThreadedIntegrate(input0->GetPointData(), output, seeds, seedIds,
+          integrationDirections, func, maxCellSize, vecType, vecName);
+      }
+      else
+      {
+        this->Integrate(input0->GetPointData(), output, seeds, seedIds, integrationDirections,
+          lastPoint, func, maxCellSize, vecType, vecName, propagation, numSteps, integrationTime);
+      }
     }
     func->Delete();
     seeds->Delete();
@@ -776,7 +794,10 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   for (int currentLine = 0; currentLine < numLines; currentLine++)
   {
     double progress = static_cast<double>(currentLine) / numLines;
-    this->UpdateProgress(progress);
+    if (!this->IntegrateInThreads)
+    {
+      this->UpdateProgress(progress);
+    }
 
     switch (integrationDirections->GetValue(currentLine))
     {
@@ -921,8 +942,11 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
 
       if (numSteps++ % 1000 == 1)
       {
-        progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
-        this->UpdateProgress(progress);
+        if (!this->IntegrateInThreads)
+        {
+          progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
+          this->UpdateProgress(progress);
+        }
 
         if (this->GetAbortExecute())
         {
@@ -955,7 +979,10 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
         }
         maxStep = stepSize.Interval;
       }
-      this->LastUsedStepSize = stepSize.Interval;
+      if (!this->IntegrateInThreads)
+      {
+        this->LastUsedStepSize = stepSize.Interval;
+      }
 
       // Calculate the next step using the integrator provided
       // Break if the next point is out of bounds.
@@ -1192,6 +1219,216 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   output->Squeeze();
 }
 
+//---------------------------------------------------------------------------
+void vtkStreamTracer::ThreadedIntegrate(vtkPointData* input0Data, vtkPolyData* output,
+  vtkDataArray* seedSource, vtkIdList* seedIds, vtkIntArray* integrationDirections,
+  vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType, const char* vecName)
+{
+  if (this->GetIntegrator() == nullptr)
+  {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+  }
+
+  // Done here rather than in the threads, as Integrate() turns the option
+  // off.
+  if (this->SurfaceStreamlines && vtkInterpolatedVelocityField::SafeDownCast(func) == nullptr)
+  {
+    vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
+                       "Interpolated Velocity Field, setting it off");
+    this->SetSurfaceStreamlines(false);
+  }
+
+  // The dataset queries made by the interpolators are only thread safe once
+  // they have been called from a single thread, which builds the cells, the
+  // links and the point locators of the datasets.
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(this->InputData->NewIterator());
+  std::vector<vtkDataSet*> datasets;
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> cellIds;
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!ds)
+    {
+      continue;
+    }
+    datasets.push_back(ds);
+    ds->GetBounds();
+    if (ds->GetNumberOfCells() > 0 && ds->GetNumberOfPoints() > 0)
+    {
+      ds->GetCell(0, cell);
+      ds->GetPointCells(0, cellIds);
+    }
+    if (vtkPointSet* ps = vtkPointSet::SafeDownCast(ds))
+    {
+      ps->BuildPointLocator();
+    }
+  }
+
+  const vtkIdType numLines = seedIds->GetNumberOfIds();
+  const vtkIdType batchSize = 32;
+  // Always integrate at least one, possibly empty, batch to get the arrays
+  // of the output.
+  const vtkIdType numBatches = std::max<vtkIdType>((numLines + batchSize - 1) / batchSize, 1);
+  std::vector<vtkSmartPointer<vtkPolyData> > batchOutputs(numBatches);
+  vtkSMPThreadLocal<vtkSmartPointer<vtkAbstractInterpolatedVelocityField> > localFuncs;
+  vtkIdType numIntegrated = 0;
+  std::mutex progressMutex;
+
+  // The normals are generated once on the concatenated output below.
+  const bool generateNormals = this->GenerateNormalsInIntegrate;
+  this->GenerateNormalsInIntegrate = false;
+  this->IntegrateInThreads = true;
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    vtkSmartPointer<vtkAbstractInterpolatedVelocityField>& localFunc = localFuncs.Local();
+    if (!localFunc)
+    {
+      localFunc.TakeReference(func->NewInstance());
+      localFunc->CopyParameters(func);
+      localFunc->SelectVectors(vecType, vecName);
+      vtkCompositeInterpolatedVelocityField* compositeFunc =
+        vtkCompositeInterpolatedVelocityField::SafeDownCast(localFunc);
+      for (vtkDataSet* ds : datasets)
+      {
+        compositeFunc->AddDataSet(ds);
+      }
+    }
+
+    vtkNew<vtkIdList> batchSeedIds;
+    vtkNew<vtkIntArray> batchDirections;
+    for (vtkIdType batch = beginBatch; batch < endBatch && !this->GetAbortExecute(); ++batch)
+    {
+      const vtkIdType begin = batch * batchSize;
+      const vtkIdType end = std::min(begin + batchSize, numLines);
+      batchSeedIds->SetNumberOfIds(end - begin);
+      batchDirections->SetNumberOfValues(end - begin);
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        batchSeedIds->SetId(i - begin, seedIds->GetId(i));
+        batchDirections->SetValue(i - begin, integrationDirections->GetValue(i));
+      }
+
+      double lastPoint[3];
+      double propagation = 0;
+      vtkIdType numSteps = 0;
+      double integrationTime = 0;
+      batchOutputs[batch] = vtkSmartPointer<vtkPolyData>::New();
+      this->Integrate(input0Data, batchOutputs[batch], seedSource, batchSeedIds, batchDirections,
+        lastPoint, localFunc, maxCellSize, vecType, vecName, propagation, numSteps,
+        integrationTime);
+
+      std::lock_guard<std::mutex> guard(progressMutex);
+      numIntegrated += end - begin;
+      this->UpdateProgress(static_cast<double>(numIntegrated) / numLines);
+    }
+  });
+  this->IntegrateInThreads = false;
+  this->GenerateNormalsInIntegrate = generateNormals;
+
+  if (this->GetAbortExecute())
+  {
+    return;
+  }
+
+  // Concatenate the outputs of the batches in seed order. They all have the
+  // same point data arrays, and the cell data of those with streamlines is
+  // the reason for termination and the seed id of each line.
+  vtkIdType numPts = 0;
+  vtkIdType numCells = 0;
+  for (const auto& batchOutput : batchOutputs)
+  {
+    numPts += batchOutput->GetNumberOfPoints();
+    numCells += batchOutput->GetNumberOfLines();
+  }
+
+  vtkNew<vtkPoints> outputPoints;
+  outputPoints->SetNumberOfPoints(numPts);
+  vtkNew<vtkCellArray> outputLines;
+  vtkDataSetAttributes* outputPD = output->GetPointData();
+  vtkDataSetAttributes* batchPD = batchOutputs[0]->GetPointData();
+  for (int i = 0; i < batchPD->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = batchPD->GetAbstractArray(i);
+    vtkSmartPointer<vtkAbstractArray> outputArray;
+    outputArray.TakeReference(array->NewInstance());
+    outputArray->SetName(array->GetName());
+    outputArray->SetNumberOfComponents(array->GetNumberOfComponents());
+    outputArray->SetNumberOfTuples(numPts);
+    outputPD->AddArray(outputArray);
+  }
+  for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+  {
+    if (vtkAbstractArray* array = batchPD->GetAbstractAttribute(attribute))
+    {
+      outputPD->SetActiveAttribute(array->GetName(), attribute);
+    }
+  }
+  vtkNew<vtkIntArray> retVals;
+  retVals->SetName("ReasonForTermination");
+  retVals->SetNumberOfValues(numCells);
+  vtkNew<vtkIntArray> sids;
+  sids->SetName("SeedIds");
+  sids->SetNumberOfValues(numCells);
+
+  vtkIdType ptOffset = 0;
+  vtkIdType cellOffset = 0;
+  for (const auto& batchOutput : batchOutputs)
+  {
+    const vtkIdType batchNumPts = batchOutput->GetNumberOfPoints();
+    if (batchNumPts > 0)
+    {
+      outputPoints->GetData()->InsertTuples(
+        ptOffset, batchNumPts, 0, batchOutput->GetPoints()->GetData());
+      vtkDataSetAttributes* pd = batchOutput->GetPointData();
+      for (int i = 0; i < outputPD->GetNumberOfArrays(); ++i)
+      {
+        vtkAbstractArray* array = outputPD->GetAbstractArray(i);
+        array->InsertTuples(ptOffset, batchNumPts, 0, pd->GetAbstractArray(array->GetName()));
+      }
+    }
+
+    vtkCellArray* lines = batchOutput->GetLines();
+    const vtkIdType batchNumCells = lines->GetNumberOfCells();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    std::vector<vtkIdType> linePts;
+    for (vtkIdType cellId = 0; cellId < batchNumCells; ++cellId)
+    {
+      lines->GetCellAtId(cellId, npts, pts);
+      linePts.resize(npts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        linePts[i] = pts[i] + ptOffset;
+      }
+      outputLines->InsertNextCell(npts, linePts.data());
+    }
+    if (batchNumCells > 0)
+    {
+      vtkDataSetAttributes* cd = batchOutput->GetCellData();
+      retVals->InsertTuples(cellOffset, batchNumCells, 0, cd->GetArray("ReasonForTermination"));
+      sids->InsertTuples(cellOffset, batchNumCells, 0, cd->GetArray("SeedIds"));
+    }
+    ptOffset += batchNumPts;
+    cellOffset += batchNumCells;
+  }
+
+  output->SetPoints(outputPoints);
+  if (numPts > 1)
+  {
+    output->SetLines(outputLines);
+    if (this->GenerateNormalsInIntegrate)
+    {
+      this->GenerateNormals(output, nullptr, vecName);
+    }
+    output->GetCellData()->AddArray(retVals);
+    output->GetCellData()->AddArray(sids);
+  }
+
+  output->Squeeze();
+}
+
 //---------------------------------------------------------------------------
 void vtkStreamTracer::GenerateNormals(vtkPolyData* output, double* firstNormal, const char* vecName)
 {
@@ -1403,6 +1640,7 @@ void vtkStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Maximum number of steps: " << this->MaximumNumberOfSteps << endl;
   os << indent << "Vorticity computation: " << (this->ComputeVorticity ? " On" : " Off") << endl;
   os << indent << "Rotation scale: " << this->RotationScale << endl;
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On" : "Off") << endl;
 }
 
 //---------------------------------------------------------------------------
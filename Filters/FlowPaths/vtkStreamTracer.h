@@ -69,6 +69,14 @@
  * a source object, traces will be generated from each point in the source
  * that is inside the dataset.
  *
+ * The streamlines of the seeds can be integrated in parallel with
+ * vtkSMPTools by turning on EnableSMP. The seeds are then split in batches,
+ * each thread integrating its batches with its own copy of the velocity
+ * field interpolator, and the streamlines of the batches are concatenated in
+ * seed order. The threaded path is not used with AMR inputs, with custom
+ * termination callbacks, which may not be thread safe, or when the point
+ * data of the blocks of a composite input do not match.
+ *
  * @sa
  * vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver
  * vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkParticleTracerBase
@@ -375,6 +383,17 @@ public:
   void AddCustomTerminationCallback(
     CustomTerminationCallbackType callback, void* clientdata, int reasonForTermination);
 
+  //@{
+  /**
+   * Enable or disable the threaded integration of the streamlines. The
+   * streamlines are generated in the same order as with the serial
+   * implementation. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkStreamTracer();
   ~vtkStreamTracer() override;
@@ -402,8 +421,23 @@ protected:
   int CheckInputs(vtkAbstractInterpolatedVelocityField*& func, int* maxCellSize);
   void GenerateNormals(vtkPolyData* output, double* firstNormal, const char* vecName);
 
+  /**
+   * Threaded counterpart of Integrate(), used by RequestData() when
+   * EnableSMP is on. Batches of seeds are integrated by Integrate() in
+   * parallel, each thread using its own copy of func, into separate outputs
+   * that are then concatenated in seed order.
+   */
+  void ThreadedIntegrate(vtkPointData* inputData, vtkPolyData* output, vtkDataArray* seedSource,
+    vtkIdList* seedIds, vtkIntArray* integrationDirections,
+    vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType,
+    const char* vecFieldName);
+
   bool GenerateNormalsInIntegrate;
 
+  // Set while Integrate() runs in several threads, which then neither
+  // updates the progress nor LastUsedStepSize.
+  bool IntegrateInThreads;
+
   // starting from global x-y-z position
   double StartPosition[3];
 
@@ -447,6 +481,8 @@ protected:
   // Compute streamlines only on surface.
   bool SurfaceStreamlines;
 
+  bool EnableSMP;
+
   vtkAbstractInterpolatedVelocityField* InterpolatorPrototype;
 
   vtkCompositeDataSet* InputData;
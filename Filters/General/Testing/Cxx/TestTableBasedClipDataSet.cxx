@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSet.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and threaded clipping of an unstructured
+// grid, which must be identical.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkShortArray.h"
+#include "vtkStringArray.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+bool TestThreadedClip(vtkTableBasedClipDataSet* clip)
+{
+  clip->EnableSMPOff();
+  clip->Update();
+  vtkNew<vtkUnstructuredGrid> serial;
+  serial->DeepCopy(clip->GetOutput());
+  vtkNew<vtkUnstructuredGrid> serialClipped;
+  serialClipped->DeepCopy(clip->GetClippedOutput());
+
+  clip->EnableSMPOn();
+  clip->Update();
+  clip->EnableSMPOff();
+
+  if (serial->GetNumberOfCells() == 0 || serialClipped->GetNumberOfCells() == 0)
+  {
+    std::cerr << "Serial output has no cells" << std::endl;
+    return false;
+  }
+  return vtkTest::SameDataSets(serial, clip->GetOutput()) &&
+    vtkTest::SameDataSets(serialClipped, clip->GetClippedOutput());
+}
+
+// Blocks of all the linear cell types handled by the clipping tables, a few
+// vertices, and a block of quadratic tetrahedra clipped by vtkClipDataSet.
+vtkSmartPointer<vtkUnstructuredGrid> ConstructInput()
+{
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : { VTK_HEXAHEDRON, VTK_TETRA, VTK_WEDGE, VTK_PYRAMID, VTK_QUAD, VTK_TRIANGLE,
+         VTK_LINE, VTK_QUADRATIC_TETRA })
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(4, 3, 2);
+    append->AddInputConnection(source->GetOutputPort());
+  }
+  append->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->DeepCopy(append->GetOutput());
+  for (vtkIdType ptId = 0; ptId < 40; ptId += 3)
+  {
+    grid->InsertNextCell(VTK_VERTEX, 1, &ptId);
+  }
+
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> origNodes;
+  origNodes->SetName("avtOriginalNodeNumbers");
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    grid->GetPoint(ptId, x);
+    scalars->InsertNextValue(static_cast<float>(x[0] * x[1] - x[2]));
+    origNodes->InsertNextValue(static_cast<int>(ptId));
+  }
+  grid->GetPointData()->SetScalars(scalars);
+  grid->GetPointData()->AddArray(origNodes);
+  // Interpolated integral values are rounded.
+  vtkNew<vtkShortArray> levels;
+  levels->SetName("Levels");
+  levels->SetNumberOfComponents(2);
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    levels->InsertNextTuple2(static_cast<double>(ptId % 7), static_cast<double>(ptId % 5));
+  }
+  grid->GetPointData()->AddArray(levels);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+}
+
+int TestTableBasedClipDataSet(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> input = ConstructInput();
+
+  // Clip with the point scalars.
+  vtkNew<vtkTableBasedClipDataSet> clip;
+  clip->SetInputData(input);
+  clip->SetValue(2.5);
+  clip->GenerateClippedOutputOn();
+  if (!TestThreadedClip(clip))
+  {
+    std::cerr << "Failed with the point scalars" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Clip with an oblique plane, which generates centroids.
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.0, 1.5, 1.0);
+  plane->SetNormal(0.2, 1.0, 0.5);
+  clip->SetClipFunction(plane);
+  clip->SetValue(0.0);
+  clip->GenerateClipScalarsOn();
+  for (int insideOut = 0; insideOut < 2; ++insideOut)
+  {
+    clip->SetInsideOut(insideOut);
+    if (!TestThreadedClip(clip))
+    {
+      std::cerr << "Failed with the clip function and InsideOut " << insideOut << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // String arrays cannot be written concurrently, the clipping is serial.
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    names->InsertNextValue(cellId % 2 ? "odd" : "even");
+  }
+  input->GetCellData()->AddArray(names);
+  if (!TestThreadedClip(clip))
+  {
+    std::cerr << "Failed with a string array" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
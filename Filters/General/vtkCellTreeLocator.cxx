@@ -21,6 +21,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include <algorithm>
 #include <cassert>
@@ -28,6 +30,7 @@
 #include <cstdlib>
 #include <limits>
 #include <stack>
+#include <typeinfo>
 #include <vector>
 
 vtkStandardNewMacro(vtkCellTreeLocator);
@@ -433,9 +436,43 @@ public:
   void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
   {
     const vtkIdType size = ds->GetNumberOfCells();
-    double cellBounds[6];
     this->m_pc.resize(size);
 
+    // The per-cell boxes are filled in parallel, each thread accumulating
+    // its own data bounds. GetCellBounds() is thread safe once it has been
+    // called from a single thread.
+    double cellBounds[6];
+    ds->GetCellBounds(0, cellBounds);
+    vtkSMPThreadLocal<vtkBoundingBox> localBBox;
+    vtkSMPTools::For(0, size, [&](vtkIdType begin, vtkIdType end) {
+      vtkBoundingBox& bbox = localBBox.Local();
+      double bounds[6];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        this->m_pc[i].Ind = i;
+
+        double* boundsPtr = bounds;
+        if (ctl->CellBounds)
+        {
+          boundsPtr = ctl->CellBounds[i];
+        }
+        else
+        {
+          ds->GetCellBounds(i, boundsPtr);
+        }
+
+        for (int d = 0; d < 3; ++d)
+        {
+          this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
+          this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
+        }
+        // Accumulate the float values so that the data bounds match the
+        // cell boxes exactly.
+        bbox.AddPoint(this->m_pc[i].Min[0], this->m_pc[i].Min[1], this->m_pc[i].Min[2]);
+        bbox.AddPoint(this->m_pc[i].Max[0], this->m_pc[i].Max[1], this->m_pc[i].Max[2]);
+      }
+    });
+
     float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
       std::numeric_limits<float>::max() };
 
@@ -445,34 +482,16 @@ public:
       -std::numeric_limits<float>::max(),
     };
 
-    for (vtkIdType i = 0; i < size; ++i)
+    for (const vtkBoundingBox& bbox : localBBox)
     {
-      this->m_pc[i].Ind = i;
-
-      double* boundsPtr = cellBounds;
-      if (ctl->CellBounds)
-      {
-        boundsPtr = ctl->CellBounds[i];
-      }
-      else
+      if (!bbox.IsValid())
       {
-        ds->GetCellBounds(i, boundsPtr);
+        continue;
       }
-
       for (int d = 0; d < 3; ++d)
       {
-        this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
-        this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
-
-        if (this->m_pc[i].Min[d] < min[d])
-        {
-          min[d] = this->m_pc[i].Min[d];
-        }
-
-        if (this->m_pc[i].Max[d] > max[d]) /// This can be m_pc[i].max[d] instead of min
-        {
-          max[d] = this->m_pc[i].Max[d];
-        }
+        min[d] = std::min(min[d], static_cast<float>(bbox.GetMinPoint()[d]));
+        max[d] = std::max(max[d], static_cast<float>(bbox.GetMaxPoint()[d]));
       }
     }
 
@@ -684,18 +703,15 @@ double _getMinDistNEG_Z(const double origin[3], const double dir[3], const doubl
 typedef std::pair<double, int> Intersection;
 
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 
+// The candidate cells are loaded into the caller's generic cell, so that
+// concurrent queries do not share any state of the locator.
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds, vtkGenericCell* cell)
 {
   //
   vtkCellTreeNode *node, *near, *far;
@@ -822,7 +838,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
       ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit < closest_intersection)
           {
@@ -841,6 +857,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellIds, cell);
   }
   //
   return HIT;
@@ -1217,14 +1234,73 @@ void vtkCellTreeLocator::Classify(const double origin[3], const double dir[3], d
     }
   }
 }
+//----------------------------------------------------------------------------
+#ifndef VTK_LEGACY_REMOVE
+namespace
+{
+// The cell given to the IntersectCellInternal() call running in each thread.
+thread_local vtkGenericCell* vtkCellTreeLocatorIntersectCell = nullptr;
+}
+
+// The legacy IntersectCellInternal() is called from the new one.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+#endif
+
+int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
+{
+#ifndef VTK_LEGACY_REMOVE
+  vtkGenericCell* previousCell = vtkCellTreeLocatorIntersectCell;
+  vtkCellTreeLocatorIntersectCell = cell;
+  int hit = this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId);
+  vtkCellTreeLocatorIntersectCell = previousCell;
+  return hit;
+#else
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
+    const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+#endif
+}
+
+#ifndef VTK_LEGACY_REMOVE
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic pop
+#endif
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 //----------------------------------------------------------------------------
 int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
   const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(
+  vtkGenericCell* cell =
+    vtkCellTreeLocatorIntersectCell ? vtkCellTreeLocatorIntersectCell : this->GenericCell;
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
     const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
+#endif
+
+//----------------------------------------------------------------------------
+bool vtkCellTreeLocator::IsIntersectWithLineThreadSafe()
+{
+#ifndef VTK_LEGACY_REMOVE
+  // Subclasses may override the legacy IntersectCellInternal(), which can
+  // only use the shared GenericCell.
+  return typeid(*this) == typeid(vtkCellTreeLocator);
+#else
+  return true;
+#endif
+}
 //----------------------------------------------------------------------------
 void vtkCellTreeLocator::FreeSearchStructure()
 {
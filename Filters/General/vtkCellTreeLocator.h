@@ -214,8 +214,28 @@ protected:
   // it can be overridden by subclasses to perform special treatment
   // (Example : Particles stored in tree, have no dimension, so we must
   // override the cell test to return a value based on some particle size
+  // The cell is loaded into the given generic cell. The default
+  // implementation goes through the legacy signature below, so subclasses
+  // overriding only that one are still called.
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
-    const double tol, double& t, double ipt[3], double pcoords[3], int& subId);
+    const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+    vtkGenericCell* cell);
+
+#ifndef VTK_LEGACY_REMOVE
+  // @deprecated Replaced by the signature taking a vtkGenericCell as of
+  // VTK 9.1. Its default implementation loads the cell given to the call
+  // above.
+  VTK_LEGACY(virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+    const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3],
+    int& subId));
+#endif
+
+  // The queries only read the tree once it is built.
+  bool IsFindCellThreadSafe() override { return true; }
+  // IntersectWithLine() is thread safe for this class only, as subclasses
+  // may override the legacy IntersectCellInternal(). Subclasses overriding
+  // the new one instead may override this to return true.
+  bool IsIntersectWithLineThreadSafe() override;
 
   int NumberOfBuckets;
 
@@ -45,18 +45,30 @@
 #include "vtkPlane.h"
 
 #include "vtkAppendFilter.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 #include "vtkTableBasedClipCases.cxx"
 
 vtkStandardNewMacro(vtkTableBasedClipDataSet);
@@ -1564,6 +1576,7 @@ vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
   this->GenerateClippedOutput = 0;
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->EnableSMP = false;
 
   this->SetNumberOfOutputPorts(2);
   vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
@@ -2901,6 +2914,11 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
 {
   vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
+  if (this->EnableSMP &&
+    this->ThreadedClipUnstructuredGridData(unstruct, clipAray, isoValue, outputUG))
+  {
+    return;
+  }
 
   vtkIdType i, j;
   vtkIdType numbPnts = 0;
@@ -3280,6 +3298,1174 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   unstruct = nullptr;
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// Number of input cells, or of connectivity entries, processed by a task of
+// the threaded clipping.
+const vtkIdType ClipBatchSize = 1000;
+
+// The output cells are grouped by shape, in the order used by
+// vtkTableBasedClipperVolumeFromVolume::ConstructDataSet().
+const int NumberOfShapes = 8;
+const int ShapeSizes[NumberOfShapes] = { 4, 5, 6, 8, 4, 3, 2, 1 };
+const unsigned char ShapeTypes[NumberOfShapes] = { VTK_TETRA, VTK_PYRAMID, VTK_WEDGE,
+  VTK_HEXAHEDRON, VTK_QUAD, VTK_TRIANGLE, VTK_LINE, VTK_VERTEX };
+
+typedef const int EDGEIDXS[2];
+
+bool CanClip(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Look up the output shapes of a clippable cell in the clipping tables.
+void GetClipCase(int cellType, int caseIndx, const unsigned char*& thisCase, int& nOutputs,
+  EDGEIDXS*& edgeVtxs)
+{
+  int startIdx = 0;
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      break;
+
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      break;
+
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      break;
+
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      break;
+
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      break;
+
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      break;
+
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      break;
+
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      break;
+
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      break;
+
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
+      edgeVtxs = nullptr;
+      break;
+  }
+}
+
+// Index of an output shape of the clipping tables in ShapeSizes and ShapeTypes.
+int GetShapeIndex(unsigned char shape)
+{
+  switch (shape)
+  {
+    case ST_TET:
+      return 0;
+    case ST_PYR:
+      return 1;
+    case ST_WDG:
+      return 2;
+    case ST_HEX:
+      return 3;
+    case ST_QUA:
+      return 4;
+    case ST_TRI:
+      return 5;
+    case ST_LIN:
+      return 6;
+    case ST_VTX:
+      return 7;
+    default:
+      return -1;
+  }
+}
+
+// A point requested along an edge of an input cell. As in the edge hash table
+// of the serial code, the input points are sorted and the weight of the first
+// one is adjusted accordingly.
+struct ClipEdge
+{
+  vtkIdType Ids[2];
+  double Percent;
+};
+
+struct ClipCentroid
+{
+  int NumberOfPoints;
+  vtkIdType Ids[8];
+};
+
+// The output of a batch of input cells: the number of cells of each shape,
+// of edge points and of centroids, and the number of cells left to
+// vtkClipDataSet. After the prefix sum, the offsets of the batch.
+struct ClipBatchCounts
+{
+  vtkIdType Shapes[NumberOfShapes];
+  vtkIdType Edges;
+  vtkIdType Centroids;
+  vtkIdType Specials;
+};
+
+// Exclusive prefix sum of counts[0, n), the totals are stored in counts[n].
+void PrefixSum(std::vector<ClipBatchCounts>& counts, vtkIdType n)
+{
+  ClipBatchCounts total = {};
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const ClipBatchCounts count = counts[i];
+    counts[i] = total;
+    for (int t = 0; t < NumberOfShapes; ++t)
+    {
+      total.Shapes[t] += count.Shapes[t];
+    }
+    total.Edges += count.Edges;
+    total.Centroids += count.Centroids;
+    total.Specials += count.Specials;
+  }
+  counts[n] = total;
+}
+
+// Exclusive prefix sum of values[0, n), the total is stored in values[n].
+void PrefixSum(vtkIdType* values, vtkIdType n)
+{
+  vtkIdType total = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const vtkIdType value = values[i];
+    values[i] = total;
+    total += value;
+  }
+  values[n] = total;
+}
+
+// Clips the cells of each batch with the clipping tables. The first pass
+// counts the output of the batches, the second one generates it at the
+// offsets of the batches. The point ids of the generated cells are
+// provisional: an input point keeps its id, the edge point requested at index
+// r gets NumberOfPoints + r and the centroid c gets -1 - c.
+struct ClipCells
+{
+  vtkUnstructuredGrid* Input;
+  vtkDataArray* ClipArray;
+  double IsoValue;
+  bool InsideOut;
+  ClipBatchCounts* Counts;
+  bool Generate;
+  const vtkIdType* ShapeStarts;
+  const vtkIdType* ShapeConnStarts;
+  vtkIdType* Offsets;
+  vtkIdType* Conn;
+  unsigned char* Types;
+  vtkIdType* SourceCells;
+  ClipEdge* Edges;
+  ClipCentroid* Centroids;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  ClipCells(vtkUnstructuredGrid* input, vtkDataArray* clipArray, double isoValue, bool insideOut,
+    ClipBatchCounts* counts)
+    : Input(input)
+    , ClipArray(clipArray)
+    , IsoValue(isoValue)
+    , InsideOut(insideOut)
+    , Counts(counts)
+    , Generate(false)
+    , ShapeStarts(nullptr)
+    , ShapeConnStarts(nullptr)
+    , Offsets(nullptr)
+    , Conn(nullptr)
+    , Types(nullptr)
+    , SourceCells(nullptr)
+    , Edges(nullptr)
+    , Centroids(nullptr)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Iterator.Local() = vtk::TakeSmartPointer(this->Input->GetCells()->NewIterator());
+  }
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    const vtkIdType numPts = this->Input->GetNumberOfPoints();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      ClipBatchCounts pos = {};
+      if (this->Generate)
+      {
+        pos = this->Counts[batch];
+      }
+      const vtkIdType endCellId = std::min((batch + 1) * ClipBatchSize, numCells);
+      for (vtkIdType cellId = batch * ClipBatchSize; cellId < endCellId; ++cellId)
+      {
+        const int cellType = this->Input->GetCellType(cellId);
+        if (!CanClip(cellType))
+        {
+          ++pos.Specials;
+          continue;
+        }
+
+        vtkIdType numbPnts;
+        const vtkIdType* pntIndxs;
+        iter->GetCellAtId(cellId, numbPnts, pntIndxs);
+
+        int caseIndx = 0;
+        double grdDiffs[8];
+        for (vtkIdType j = numbPnts - 1; j >= 0; j--)
+        {
+          grdDiffs[j] = this->ClipArray->GetComponent(pntIndxs[j], 0) - this->IsoValue;
+          caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
+          caseIndx <<= (1 - (!j));
+        }
+
+        const unsigned char* thisCase = nullptr;
+        int nOutputs = 0;
+        EDGEIDXS* edgeVtxs = nullptr;
+        GetClipCase(cellType, caseIndx, thisCase, nOutputs, edgeVtxs);
+
+        vtkIdType intrpIds[4];
+        for (int j = 0; j < nOutputs; j++)
+        {
+          int nCellPts = 0;
+          int theColor = -1;
+          int intrpIdx = -1;
+          const unsigned char theShape = *thisCase++;
+          if (theShape == ST_PNT)
+          {
+            intrpIdx = *thisCase++;
+            theColor = *thisCase++;
+            nCellPts = *thisCase++;
+          }
+          else
+          {
+            const int shapeIdx = GetShapeIndex(theShape);
+            nCellPts = shapeIdx < 0 ? 0 : ShapeSizes[shapeIdx];
+            theColor = *thisCase++;
+          }
+
+          if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
+          {
+            // We don't want this one; it's the wrong side.
+            thisCase += nCellPts;
+            continue;
+          }
+
+          vtkIdType shapeIds[8];
+          for (int p = 0; p < nCellPts; p++)
+          {
+            const unsigned char pntIndex = *thisCase++;
+            if (pntIndex <= P7)
+            {
+              shapeIds[p] = pntIndxs[pntIndex];
+            }
+            else if (pntIndex >= EA && pntIndex <= EL)
+            {
+              int pt1Index = edgeVtxs[pntIndex - EA][0];
+              int pt2Index = edgeVtxs[pntIndex - EA][1];
+              if (pt2Index < pt1Index)
+              {
+                std::swap(pt1Index, pt2Index);
+              }
+              double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
+              double pt1ToIso = 0.0 - grdDiffs[pt1Index];
+              double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
+
+              if (this->Generate)
+              {
+                ClipEdge& edge = this->Edges[pos.Edges];
+                if (pntIndxs[pt2Index] < pntIndxs[pt1Index])
+                {
+                  edge.Ids[0] = pntIndxs[pt2Index];
+                  edge.Ids[1] = pntIndxs[pt1Index];
+                  edge.Percent = 1.0 - p1Weight;
+                }
+                else
+                {
+                  edge.Ids[0] = pntIndxs[pt1Index];
+                  edge.Ids[1] = pntIndxs[pt2Index];
+                  edge.Percent = p1Weight;
+                }
+              }
+              shapeIds[p] = numPts + pos.Edges++;
+            }
+            else if (pntIndex >= N0 && pntIndex <= N3)
+            {
+              shapeIds[p] = intrpIds[pntIndex - N0];
+            }
+          }
+
+          if (theShape == ST_PNT)
+          {
+            if (this->Generate)
+            {
+              ClipCentroid& centroid = this->Centroids[pos.Centroids];
+              centroid.NumberOfPoints = nCellPts;
+              std::copy(shapeIds, shapeIds + nCellPts, centroid.Ids);
+            }
+            intrpIds[intrpIdx] = -1 - pos.Centroids++;
+          }
+          else if (nCellPts > 0)
+          {
+            const int shapeIdx = GetShapeIndex(theShape);
+            if (this->Generate)
+            {
+              const vtkIdType outCellId = this->ShapeStarts[shapeIdx] + pos.Shapes[shapeIdx];
+              const vtkIdType offset =
+                this->ShapeConnStarts[shapeIdx] + pos.Shapes[shapeIdx] * nCellPts;
+              this->Offsets[outCellId] = offset;
+              this->Types[outCellId] = ShapeTypes[shapeIdx];
+              this->SourceCells[outCellId] = cellId;
+              std::copy(shapeIds, shapeIds + nCellPts, this->Conn + offset);
+            }
+            ++pos.Shapes[shapeIdx];
+          }
+        }
+      }
+      if (!this->Generate)
+      {
+        this->Counts[batch] = pos;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Orders the edge requests by input points, then by request index, so that
+// the first request of each edge is the one that creates the point in the
+// serial code.
+struct EdgeLess
+{
+  const ClipEdge* Edges;
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    const ClipEdge& ea = this->Edges[a];
+    const ClipEdge& eb = this->Edges[b];
+    if (ea.Ids[0] != eb.Ids[0])
+    {
+      return ea.Ids[0] < eb.Ids[0];
+    }
+    if (ea.Ids[1] != eb.Ids[1])
+    {
+      return ea.Ids[1] < eb.Ids[1];
+    }
+    return a < b;
+  }
+};
+
+bool SameEdge(const ClipEdge& a, const ClipEdge& b)
+{
+  return a.Ids[0] == b.Ids[0] && a.Ids[1] == b.Ids[1];
+}
+
+// Flags the edge requests that create a point, the first one of each edge.
+struct MarkCreators
+{
+  const ClipEdge* Edges;
+  const vtkIdType* Order;
+  vtkIdType* Creators;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType r = this->Order[i];
+      this->Creators[r] = (i == 0 || !SameEdge(this->Edges[this->Order[i - 1]], this->Edges[r]));
+    }
+  }
+};
+
+// Gives all the requests of an edge the point id of its creator, which were
+// numbered in request order.
+struct AssignEdgeIds
+{
+  const ClipEdge* Edges;
+  const vtkIdType* Order;
+  vtkIdType NumberOfRequests;
+  const vtkIdType* Creators;
+  vtkIdType* EdgeIds;
+  vtkIdType* SourceEdges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType r = this->Order[i];
+      if (i > 0 && SameEdge(this->Edges[this->Order[i - 1]], this->Edges[r]))
+      {
+        continue;
+      }
+      const vtkIdType edgeId = this->Creators[r];
+      this->SourceEdges[edgeId] = r;
+      for (vtkIdType j = i;
+           j < this->NumberOfRequests && SameEdge(this->Edges[this->Order[j]], this->Edges[r]); ++j)
+      {
+        this->EdgeIds[this->Order[j]] = edgeId;
+      }
+    }
+  }
+};
+
+// Records, for each input point, the first position of the connectivity at
+// which it is used.
+struct MarkFirstUse
+{
+  const vtkIdType* Conn;
+  vtkIdType ConnSize;
+  vtkIdType NumberOfPoints;
+  std::atomic<vtkIdType>* FirstUse;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    const vtkIdType end = std::min(endBatch * ClipBatchSize, this->ConnSize);
+    for (vtkIdType i = beginBatch * ClipBatchSize; i < end; ++i)
+    {
+      const vtkIdType ptId = this->Conn[i];
+      if (ptId >= 0 && ptId < this->NumberOfPoints)
+      {
+        // memory_order_relaxed is safe here, the atomics are only used to
+        // compute a minimum, not for synchronization.
+        std::atomic<vtkIdType>& firstUse = this->FirstUse[ptId];
+        vtkIdType current = firstUse.load(std::memory_order_relaxed);
+        while (
+          i < current && !firstUse.compare_exchange_weak(current, i, std::memory_order_relaxed))
+        {
+        }
+      }
+    }
+  }
+};
+
+// Counts the input points first used in each batch of the connectivity, or
+// numbers them when the offsets of the batches are known. This is the order
+// in which the serial code numbers the input points of the output.
+struct NumberPoints
+{
+  const vtkIdType* Conn;
+  vtkIdType ConnSize;
+  vtkIdType NumberOfPoints;
+  const std::atomic<vtkIdType>* FirstUse;
+  vtkIdType* BatchPts;
+  vtkIdType* PointMap;
+  bool Generate;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType newPtId = this->Generate ? this->BatchPts[batch] : 0;
+      const vtkIdType end = std::min((batch + 1) * ClipBatchSize, this->ConnSize);
+      for (vtkIdType i = batch * ClipBatchSize; i < end; ++i)
+      {
+        const vtkIdType ptId = this->Conn[i];
+        if (ptId >= 0 && ptId < this->NumberOfPoints &&
+          this->FirstUse[ptId].load(std::memory_order_relaxed) == i)
+        {
+          if (this->Generate)
+          {
+            this->PointMap[ptId] = newPtId;
+          }
+          ++newPtId;
+        }
+      }
+      if (!this->Generate)
+      {
+        this->BatchPts[batch] = newPtId;
+      }
+    }
+  }
+};
+
+// Maps the provisional point ids to the output point ids: the used input
+// points first, then the edge points and the centroids.
+struct MapPointIds
+{
+  vtkIdType NumberOfPoints;
+  const vtkIdType* PointMap;
+  const vtkIdType* EdgeIds;
+  vtkIdType EdgeStart;
+  vtkIdType CentroidStart;
+
+  vtkIdType operator()(vtkIdType ptId) const
+  {
+    if (ptId < 0)
+    {
+      return this->CentroidStart - 1 - ptId;
+    }
+    if (ptId >= this->NumberOfPoints)
+    {
+      return this->EdgeStart + this->EdgeIds[ptId - this->NumberOfPoints];
+    }
+    return this->PointMap[ptId];
+  }
+};
+
+struct MapConnectivity
+{
+  MapPointIds Map;
+  vtkIdType* Conn;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Conn[i] = this->Map(this->Conn[i]);
+    }
+  }
+};
+
+struct MapCentroids
+{
+  MapPointIds Map;
+  ClipCentroid* Centroids;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      ClipCentroid& centroid = this->Centroids[i];
+      for (int k = 0; k < centroid.NumberOfPoints; ++k)
+      {
+        centroid.Ids[k] = this->Map(centroid.Ids[k]);
+      }
+    }
+  }
+};
+
+// A pair of input and output attribute arrays. vtkDataSetAttributes::CopyData()
+// and the Interpolate*() methods iterate over the arrays with a member
+// iterator, and vtkDataArray::InterpolateTuple() inserts the tuples, updating
+// the size of the output array: none of them can be called concurrently.
+// Hence the threaded code copies and interpolates the tuples of each pair of
+// arrays with their typed API, into output arrays sized beforehand. This
+// requires arrays handled by vtkArrayDispatch, see CanCopyConcurrently().
+struct ClipArrayPair
+{
+  vtkDataArray* From;
+  vtkDataArray* To;
+  bool Nearest;
+};
+
+struct CheckDispatch
+{
+  template <typename ArrayT>
+  void operator()(ArrayT*) const
+  {
+  }
+};
+
+// Whether the tuples of all the arrays of the attributes can be written
+// concurrently: bit arrays share their bytes between tuples and the other
+// abstract arrays, such as string arrays, update their state when modified.
+bool CanCopyConcurrently(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = attributes->GetArray(i);
+    if (!array || !vtkArrayDispatch::Dispatch::Execute(array, CheckDispatch()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<ClipArrayPair> GetArrayPairs(vtkDataSetAttributes* in, vtkDataSetAttributes* out)
+{
+  std::vector<ClipArrayPair> pairs;
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* to = out->GetArray(i);
+    const int attributeType = out->IsArrayAnAttribute(i);
+    vtkDataArray* from = nullptr;
+    if (attributeType != -1)
+    {
+      from = in->GetAttribute(attributeType);
+    }
+    else if (to->GetName())
+    {
+      from = in->GetArray(to->GetName());
+    }
+    if (from)
+    {
+      const bool nearest = attributeType != -1 &&
+        out->GetCopyAttribute(attributeType, vtkDataSetAttributes::INTERPOLATE) == 2;
+      pairs.push_back({ from, to, nearest });
+    }
+  }
+  return pairs;
+}
+
+// The typed counterparts of vtkDataArray::SetTuple() and InterpolateTuple(),
+// with the same numerics.
+template <typename InArrayT, typename OutArrayT>
+void CopyTypedTuple(InArrayT* in, vtkIdType inId, OutArrayT* out, vtkIdType outId)
+{
+  using ValueType = typename OutArrayT::ValueType;
+  const int numComps = out->GetNumberOfComponents();
+  for (int c = 0; c < numComps; ++c)
+  {
+    out->SetTypedComponent(outId, c, static_cast<ValueType>(in->GetTypedComponent(inId, c)));
+  }
+}
+
+template <typename InArrayT, typename OutArrayT>
+void InterpolateTypedEdge(
+  InArrayT* in, vtkIdType id1, vtkIdType id2, double t, OutArrayT* out, vtkIdType outId)
+{
+  using ValueType = typename OutArrayT::ValueType;
+  const int numComps = out->GetNumberOfComponents();
+  const double oneMinusT = 1. - t;
+  for (int c = 0; c < numComps; ++c)
+  {
+    const double val =
+      in->GetTypedComponent(id1, c) * oneMinusT + in->GetTypedComponent(id2, c) * t;
+    ValueType valT;
+    vtkMath::RoundDoubleToIntegralIfNecessary(val, &valT);
+    out->SetTypedComponent(outId, c, valT);
+  }
+}
+
+template <typename InArrayT, typename OutArrayT>
+void InterpolateTypedTuple(InArrayT* in, int numIds, const vtkIdType* ids, const double* weights,
+  OutArrayT* out, vtkIdType outId)
+{
+  using ValueType = typename OutArrayT::ValueType;
+  const int numComps = out->GetNumberOfComponents();
+  for (int c = 0; c < numComps; ++c)
+  {
+    double val = 0.;
+    for (int i = 0; i < numIds; ++i)
+    {
+      val += weights[i] * static_cast<double>(in->GetTypedComponent(ids[i], c));
+    }
+    ValueType valT;
+    vtkMath::RoundDoubleToIntegralIfNecessary(val, &valT);
+    out->SetTypedComponent(outId, c, valT);
+  }
+}
+
+// Copies the data of the input points used by the output cells.
+struct CopyInputPointsWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* in, OutArrayT* out, const vtkIdType* pointMap, vtkIdType begin,
+    vtkIdType end) const
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (pointMap[ptId] >= 0)
+      {
+        CopyTypedTuple(in, ptId, out, pointMap[ptId]);
+      }
+    }
+  }
+};
+
+// Copies the input points used by the output cells and their data.
+struct CopyInputPoints
+{
+  vtkPoints* InPoints;
+  vtkPoints* OutPoints;
+  const vtkIdType* PointMap;
+  const std::vector<ClipArrayPair>& Arrays;
+  vtkIntArray* OrigNodes;
+  vtkIntArray* NewOrigNodes;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType outPtId = this->PointMap[ptId];
+      if (outPtId < 0)
+      {
+        continue;
+      }
+      this->InPoints->GetPoint(ptId, x);
+      this->OutPoints->SetPoint(outPtId, x);
+      if (this->NewOrigNodes)
+      {
+        this->NewOrigNodes->SetTuple(outPtId, ptId, this->OrigNodes);
+      }
+    }
+    for (const ClipArrayPair& pair : this->Arrays)
+    {
+      vtkArrayDispatch::Dispatch2SameValueType::Execute(
+        pair.From, pair.To, CopyInputPointsWorker(), this->PointMap, begin, end);
+    }
+  }
+};
+
+// Interpolates the data of the edge points, or copies the one of the nearest
+// input point.
+struct EdgePointsWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* in, OutArrayT* out, bool nearest, const ClipEdge* edges,
+    const vtkIdType* sourceEdges, vtkIdType edgeStart, vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+    {
+      const ClipEdge& edge = edges[sourceEdges[edgeId]];
+      const double bp = 1.0 - edge.Percent;
+      if (nearest)
+      {
+        CopyTypedTuple(in, bp < 0.5 ? edge.Ids[0] : edge.Ids[1], out, edgeStart + edgeId);
+      }
+      else
+      {
+        InterpolateTypedEdge(in, edge.Ids[0], edge.Ids[1], bp, out, edgeStart + edgeId);
+      }
+    }
+  }
+};
+
+// Generates the points along the edges and interpolates their data.
+struct GenerateEdgePoints
+{
+  vtkPoints* InPoints;
+  vtkPoints* OutPoints;
+  const ClipEdge* Edges;
+  const vtkIdType* SourceEdges;
+  vtkIdType EdgeStart;
+  const std::vector<ClipArrayPair>& Arrays;
+  vtkIntArray* OrigNodes;
+  vtkIntArray* NewOrigNodes;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double pt1[3], pt2[3], pt[3];
+    for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+    {
+      const ClipEdge& edge = this->Edges[this->SourceEdges[edgeId]];
+      const vtkIdType ptIdx = this->EdgeStart + edgeId;
+      this->InPoints->GetPoint(edge.Ids[0], pt1);
+      this->InPoints->GetPoint(edge.Ids[1], pt2);
+      double p = edge.Percent;
+      double bp = 1.0 - p;
+      pt[0] = pt1[0] * p + pt2[0] * bp;
+      pt[1] = pt1[1] * p + pt2[1] * bp;
+      pt[2] = pt1[2] * p + pt2[2] * bp;
+      this->OutPoints->SetPoint(ptIdx, pt);
+      if (this->NewOrigNodes)
+      {
+        vtkIdType id = (bp <= 0.5 ? edge.Ids[0] : edge.Ids[1]);
+        this->NewOrigNodes->SetTuple(ptIdx, id, this->OrigNodes);
+      }
+    }
+    for (const ClipArrayPair& pair : this->Arrays)
+    {
+      vtkArrayDispatch::Dispatch2SameValueType::Execute(pair.From, pair.To, EdgePointsWorker(),
+        pair.Nearest, this->Edges, this->SourceEdges, this->EdgeStart, begin, end);
+    }
+  }
+};
+
+// Interpolates the data of the centroids from the output points, in order
+// since a centroid may depend on the previous centroids of its cell.
+struct CentroidsWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, bool nearest, const ClipCentroid* centroids,
+    vtkIdType centroidStart, vtkIdType begin, vtkIdType end) const
+  {
+    double weights[8];
+    for (vtkIdType c = begin; c < end; ++c)
+    {
+      const ClipCentroid& ce = centroids[c];
+      if (nearest)
+      {
+        // all the weights are equal, the first point is the nearest one
+        CopyTypedTuple(array, ce.Ids[0], array, centroidStart + c);
+      }
+      else
+      {
+        std::fill(weights, weights + ce.NumberOfPoints, 1.0 / ce.NumberOfPoints);
+        InterpolateTypedTuple(
+          array, ce.NumberOfPoints, ce.Ids, weights, array, centroidStart + c);
+      }
+    }
+  }
+};
+
+// Generates the centroids and interpolates their data from the output points.
+// A centroid may depend on the previous centroids of its cell, hence the
+// centroids are processed by batches of input cells, in order.
+struct GenerateCentroids
+{
+  vtkPoints* OutPoints;
+  const ClipCentroid* Centroids;
+  const ClipBatchCounts* Counts;
+  vtkIdType CentroidStart;
+  const std::vector<ClipArrayPair>& Arrays;
+  vtkIntArray* NewOrigNodes;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    const vtkIdType begin = this->Counts[beginBatch].Centroids;
+    const vtkIdType end = this->Counts[endBatch].Centroids;
+    for (vtkIdType c = begin; c < end; ++c)
+    {
+      const ClipCentroid& ce = this->Centroids[c];
+      const vtkIdType ptIdx = this->CentroidStart + c;
+      double pts[8][3];
+      double pt[3] = { 0.0, 0.0, 0.0 };
+      double weight_factor = 1.0 / ce.NumberOfPoints;
+      for (int k = 0; k < ce.NumberOfPoints; k++)
+      {
+        this->OutPoints->GetPoint(ce.Ids[k], pts[k]);
+        pt[0] += pts[k][0];
+        pt[1] += pts[k][1];
+        pt[2] += pts[k][2];
+      }
+      pt[0] *= weight_factor;
+      pt[1] *= weight_factor;
+      pt[2] *= weight_factor;
+      this->OutPoints->SetPoint(ptIdx, pt);
+      if (this->NewOrigNodes)
+      {
+        // these 'created' nodes have no original designation
+        for (int z = 0; z < this->NewOrigNodes->GetNumberOfComponents(); z++)
+        {
+          this->NewOrigNodes->SetComponent(ptIdx, z, -1);
+        }
+      }
+    }
+
+    // The output point data is interpolated from itself.
+    for (const ClipArrayPair& pair : this->Arrays)
+    {
+      vtkArrayDispatch::Dispatch::Execute(pair.To, CentroidsWorker(), pair.Nearest,
+        this->Centroids, this->CentroidStart, begin, end);
+    }
+  }
+};
+
+struct CopyCellDataWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* in, OutArrayT* out, const vtkIdType* sourceCells, vtkIdType begin,
+    vtkIdType end) const
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      CopyTypedTuple(in, sourceCells[cellId], out, cellId);
+    }
+  }
+};
+
+struct CopyCellData
+{
+  const vtkIdType* SourceCells;
+  const std::vector<ClipArrayPair>& Arrays;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (const ClipArrayPair& pair : this->Arrays)
+    {
+      vtkArrayDispatch::Dispatch2SameValueType::Execute(
+        pair.From, pair.To, CopyCellDataWorker(), this->SourceCells, begin, end);
+    }
+  }
+};
+
+// Sizes the arrays allocated by CopyAllocate() so that their tuples can be
+// set concurrently.
+void SetNumberOfTuples(vtkDataSetAttributes* attributes, vtkIdType numTuples)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    attributes->GetAbstractArray(i)->SetNumberOfTuples(numTuples);
+  }
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+bool vtkTableBasedClipDataSet::ThreadedClipUnstructuredGridData(vtkUnstructuredGrid* inputUG,
+  vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  if (!CanCopyConcurrently(inputUG->GetPointData()) ||
+    !CanCopyConcurrently(inputUG->GetCellData()))
+  {
+    return false;
+  }
+
+  const vtkIdType numPts = inputUG->GetNumberOfPoints();
+  const vtkIdType numCells = inputUG->GetNumberOfCells();
+  const vtkIdType numBatches = numCells > 0 ? (numCells - 1) / ClipBatchSize + 1 : 0;
+
+  // Clip the cells, in two passes.
+  std::vector<ClipBatchCounts> counts(numBatches + 1, ClipBatchCounts());
+  ClipCells clipCells(inputUG, clipAray, isoValue, this->InsideOut != 0, counts.data());
+  vtkSMPTools::For(0, numBatches, clipCells);
+  PrefixSum(counts, numBatches);
+  const ClipBatchCounts& totals = counts[numBatches];
+
+  vtkIdType shapeStarts[NumberOfShapes];
+  vtkIdType shapeConnStarts[NumberOfShapes];
+  vtkIdType numOutCells = 0;
+  vtkIdType connSize = 0;
+  for (int t = 0; t < NumberOfShapes; ++t)
+  {
+    shapeStarts[t] = numOutCells;
+    shapeConnStarts[t] = connSize;
+    numOutCells += totals.Shapes[t];
+    connSize += totals.Shapes[t] * ShapeSizes[t];
+  }
+  const vtkIdType numRequests = totals.Edges;
+  const vtkIdType numCentroids = totals.Centroids;
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutCells + 1);
+  offsets->SetValue(numOutCells, connSize);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfValues(numOutCells);
+  std::vector<vtkIdType> sourceCells(numOutCells);
+  std::vector<ClipEdge> edges(numRequests);
+  std::vector<ClipCentroid> centroids(numCentroids);
+
+  clipCells.Generate = true;
+  clipCells.ShapeStarts = shapeStarts;
+  clipCells.ShapeConnStarts = shapeConnStarts;
+  clipCells.Offsets = offsets->GetPointer(0);
+  clipCells.Conn = conn->GetPointer(0);
+  clipCells.Types = cellTypes->GetPointer(0);
+  clipCells.SourceCells = sourceCells.data();
+  clipCells.Edges = edges.data();
+  clipCells.Centroids = centroids.data();
+  vtkSMPTools::For(0, numBatches, clipCells);
+
+  // Merge the requests of the same edges. The points are numbered in the
+  // order of their first request, which is the order of the edge hash table.
+  std::vector<vtkIdType> order(numRequests);
+  std::iota(order.begin(), order.end(), 0);
+  vtkSMPTools::Sort(order.begin(), order.end(), EdgeLess{ edges.data() });
+  std::vector<vtkIdType> creators(numRequests + 1);
+  MarkCreators markCreators{ edges.data(), order.data(), creators.data() };
+  vtkSMPTools::For(0, numRequests, markCreators);
+  PrefixSum(creators.data(), numRequests);
+  const vtkIdType numEdgePts = creators[numRequests];
+  std::vector<vtkIdType> edgeIds(numRequests);
+  std::vector<vtkIdType> sourceEdges(numEdgePts);
+  AssignEdgeIds assignEdgeIds{ edges.data(), order.data(), numRequests, creators.data(),
+    edgeIds.data(), sourceEdges.data() };
+  vtkSMPTools::For(0, numRequests, assignEdgeIds);
+
+  // Number the used input points in the order of their first use.
+  std::vector<std::atomic<vtkIdType>> firstUse(numPts);
+  for (std::atomic<vtkIdType>& ptFirstUse : firstUse)
+  {
+    ptFirstUse.store(VTK_ID_MAX, std::memory_order_relaxed);
+  }
+  const vtkIdType numConnBatches = connSize > 0 ? (connSize - 1) / ClipBatchSize + 1 : 0;
+  MarkFirstUse markFirstUse{ conn->GetPointer(0), connSize, numPts, firstUse.data() };
+  vtkSMPTools::For(0, numConnBatches, markFirstUse);
+
+  std::vector<vtkIdType> batchPts(numConnBatches + 1);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  NumberPoints numberPoints{ conn->GetPointer(0), connSize, numPts, firstUse.data(),
+    batchPts.data(), pointMap.data(), false };
+  vtkSMPTools::For(0, numConnBatches, numberPoints);
+  PrefixSum(batchPts.data(), numConnBatches);
+  numberPoints.Generate = true;
+  vtkSMPTools::For(0, numConnBatches, numberPoints);
+
+  const vtkIdType numUsed = batchPts[numConnBatches];
+  const vtkIdType centroidStart = numUsed + numEdgePts;
+  const vtkIdType nOutPts = centroidStart + numCentroids;
+  MapPointIds mapPointIds{ numPts, pointMap.data(), edgeIds.data(), numUsed, centroidStart };
+  MapConnectivity mapConnectivity{ mapPointIds, conn->GetPointer(0) };
+  vtkSMPTools::For(0, connSize, mapConnectivity);
+  MapCentroids mapCentroids{ mapPointIds, centroids.data() };
+  vtkSMPTools::For(0, numCentroids, mapCentroids);
+
+  // Clip the cells that the tables do not handle with vtkClipDataSet, as the
+  // serial code does.
+  vtkUnstructuredGrid* visItGrd = outputUG;
+  vtkSmartPointer<vtkUnstructuredGrid> specials;
+  if (totals.Specials > 0)
+  {
+    specials = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    specials->SetPoints(inputUG->GetPoints());
+    specials->GetPointData()->ShallowCopy(inputUG->GetPointData());
+    specials->Allocate(totals.Specials);
+    specials->GetCellData()->CopyAllocate(inputUG->GetCellData(), totals.Specials);
+    int numCants = 0;
+    for (vtkIdType i = 0; i < numCells; i++)
+    {
+      int cellType = inputUG->GetCellType(i);
+      if (CanClip(cellType))
+      {
+        continue;
+      }
+      if (cellType == VTK_POLYHEDRON)
+      {
+        vtkIdType nfaces;
+        const vtkIdType* facePtIds;
+        inputUG->GetFaceStream(i, nfaces, facePtIds);
+        specials->InsertNextCell(cellType, nfaces, facePtIds);
+      }
+      else
+      {
+        vtkIdType numbPnts;
+        const vtkIdType* pntIndxs;
+        inputUG->GetCellPoints(i, numbPnts, pntIndxs);
+        specials->InsertNextCell(cellType, numbPnts, pntIndxs);
+      }
+      specials->GetCellData()->CopyData(inputUG->GetCellData(), i, numCants);
+      numCants++;
+    }
+    visItGrd = vtkUnstructuredGrid::New();
+  }
+
+  // Generate the output points and their data.
+  vtkPointData* inPD = inputUG->GetPointData();
+  vtkPointData* outPD = visItGrd->GetPointData();
+  vtkNew<vtkPoints> outPts;
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    outPts->SetDataType(inputUG->GetPoints()->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_DOUBLE);
+  }
+  outPts->SetNumberOfPoints(nOutPts);
+  outPD->CopyAllocate(inPD, nOutPts);
+  SetNumberOfTuples(outPD, nOutPts);
+  const std::vector<ClipArrayPair> pointArrays = GetArrayPairs(inPD, outPD);
+
+  vtkSmartPointer<vtkIntArray> newOrigNodes;
+  vtkIntArray* origNodes = vtkArrayDownCast<vtkIntArray>(inPD->GetArray("avtOriginalNodeNumbers"));
+  if (origNodes != nullptr)
+  {
+    newOrigNodes = vtkSmartPointer<vtkIntArray>::New();
+    newOrigNodes->SetNumberOfComponents(origNodes->GetNumberOfComponents());
+    newOrigNodes->SetNumberOfTuples(nOutPts);
+    newOrigNodes->SetName(origNodes->GetName());
+  }
+
+  vtkPoints* inPts = inputUG->GetPoints();
+  CopyInputPoints copyInputPoints{ inPts, outPts, pointMap.data(), pointArrays, origNodes,
+    newOrigNodes };
+  vtkSMPTools::For(0, numPts, copyInputPoints);
+  GenerateEdgePoints generateEdgePoints{ inPts, outPts, edges.data(), sourceEdges.data(), numUsed,
+    pointArrays, origNodes, newOrigNodes };
+  vtkSMPTools::For(0, numEdgePts, generateEdgePoints);
+  if (numCentroids > 0)
+  {
+    GenerateCentroids generateCentroids{ outPts, centroids.data(), counts.data(), centroidStart,
+      pointArrays, newOrigNodes };
+    vtkSMPTools::For(0, numBatches, generateCentroids);
+  }
+
+  visItGrd->SetPoints(outPts);
+  if (newOrigNodes)
+  {
+    // AddArray will overwrite an already existing array with
+    // the same name, exactly what we want here.
+    outPD->AddArray(newOrigNodes);
+  }
+
+  // Generate the output cells and their data.
+  vtkCellData* inCD = inputUG->GetCellData();
+  vtkCellData* outCD = visItGrd->GetCellData();
+  outCD->CopyAllocate(inCD, numOutCells);
+  SetNumberOfTuples(outCD, numOutCells);
+  const std::vector<ClipArrayPair> cellArrays = GetArrayPairs(inCD, outCD);
+  CopyCellData copyCellData{ sourceCells.data(), cellArrays };
+  vtkSMPTools::For(0, numOutCells, copyCellData);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, conn);
+  visItGrd->SetCells(cellTypes, cells);
+
+  if (specials)
+  {
+    vtkNew<vtkUnstructuredGrid> vtkUGrid;
+    this->ClipDataSet(specials, clipAray, vtkUGrid);
+
+    vtkNew<vtkAppendFilter> appender;
+    appender->AddInputData(vtkUGrid);
+    appender->AddInputData(visItGrd);
+    appender->Update();
+
+    outputUG->ShallowCopy(appender->GetOutput());
+    visItGrd->Delete();
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkTableBasedClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -3312,4 +4498,6 @@ void vtkTableBasedClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseValueAsOffset: " << (this->UseValueAsOffset ? "On\n" : "Off\n");
 
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 }
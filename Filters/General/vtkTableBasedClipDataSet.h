@@ -68,6 +68,12 @@
  *  advantages are gained by adopting the unique clipping and triangulation tables
  *  proposed by VisIt.
  *
+ *  Unstructured grids may be clipped using multiple threads by enabling
+ *  EnableSMP. The cells are then processed in parallel batches and the
+ *  duplicate points along the cut edges are merged afterwards, producing the
+ *  same output as the serial code path. Cells that are not handled by the
+ *  clipping tables still go through vtkClipDataSet, serially.
+ *
  * @warning
  *  vtkTableBasedClipDataSet makes use of a hash table (that is provided by class
  *  maintained by internal class vtkTableBasedClipperDataSetFromVolume) to achieve
@@ -226,6 +232,17 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Enable or disable the threaded clipping of unstructured grids. The output
+   * is identical to the one of the serial implementation. Grids with bit or
+   * string attribute arrays are still clipped serially. The default is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
 protected:
   vtkTableBasedClipDataSet(vtkImplicitFunction* cf = nullptr);
   ~vtkTableBasedClipDataSet() override;
@@ -283,6 +300,17 @@ protected:
   void ClipUnstructuredGridData(
     vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG);
 
+  /**
+   * Threaded counterpart of ClipUnstructuredGridData(), used when EnableSMP is
+   * on. The cells are clipped in batches, in two passes: the first one counts
+   * the output cells and points of each batch and the second one generates them
+   * at offsets given by a prefix sum of these counts. Returns false, without
+   * clipping, if the point or cell data holds arrays whose tuples cannot be
+   * written concurrently, such as bit or string arrays.
+   */
+  bool ThreadedClipUnstructuredGridData(vtkUnstructuredGrid* inputUG, vtkDataArray* clipAray,
+    double isoValue, vtkUnstructuredGrid* outputUG);
+
   /**
    * Register a callback function with the InternalProgressObserver.
    */
@@ -304,6 +332,7 @@ protected:
   vtkIncrementalPointLocator* Locator;
 
   int OutputPointsPrecision;
+  bool EnableSMP;
 
 private:
   vtkTableBasedClipDataSet(const vtkTableBasedClipDataSet&) = delete;
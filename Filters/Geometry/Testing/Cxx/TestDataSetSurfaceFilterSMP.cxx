@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the outputs of the serial and threaded extraction of the external
+// faces of an unstructured grid, which must be identical.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+bool TestThreadedSurface(vtkDataSetSurfaceFilter* surface)
+{
+  surface->EnableSMPOff();
+  surface->Update();
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(surface->GetOutput());
+
+  surface->EnableSMPOn();
+  surface->Update();
+  surface->EnableSMPOff();
+
+  if (serial->GetNumberOfPolys() == 0)
+  {
+    std::cerr << "Serial output has no polygons" << std::endl;
+    return false;
+  }
+  return vtkTest::SameDataSets(serial, surface->GetOutput());
+}
+
+// Blocks of hexahedra, tetrahedra, wedges and pyramids, a few duplicated
+// cells, a hexagonal prism, a polygon and a line.
+vtkSmartPointer<vtkUnstructuredGrid> ConstructInput()
+{
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : { VTK_HEXAHEDRON, VTK_TETRA, VTK_WEDGE, VTK_PYRAMID })
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(4, 3, 2);
+    append->AddInputConnection(source->GetOutputPort());
+  }
+  append->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->CopyStructure(append->GetOutput());
+  vtkPoints* points = grid->GetPoints();
+
+  vtkNew<vtkIdList> cellPts;
+  for (vtkIdType cellId : { 0, 1, 30 })
+  {
+    grid->GetCellPoints(cellId, cellPts);
+    grid->InsertNextCell(grid->GetCellType(cellId), cellPts);
+  }
+
+  const vtkIdType first = points->GetNumberOfPoints();
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      const double angle = i * vtkMath::Pi() / 3.0;
+      points->InsertNextPoint(25.0 + std::cos(angle), std::sin(angle), k);
+    }
+  }
+  cellPts->SetNumberOfIds(12);
+  for (vtkIdType i = 0; i < 12; ++i)
+  {
+    cellPts->SetId(i, first + i);
+  }
+  grid->InsertNextCell(VTK_HEXAGONAL_PRISM, cellPts);
+  cellPts->SetNumberOfIds(6);
+  grid->InsertNextCell(VTK_POLYGON, cellPts);
+  cellPts->SetNumberOfIds(2);
+  cellPts->SetId(0, 0);
+  cellPts->SetId(1, first + 11);
+  grid->InsertNextCell(VTK_LINE, cellPts);
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    pointIds->InsertNextValue(ptId);
+  }
+  grid->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+}
+
+int TestDataSetSurfaceFilterSMP(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> input = ConstructInput();
+
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(input);
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  if (!TestThreadedSurface(surface))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Faces with hidden points are not extracted.
+  input->AllocatePointGhostArray();
+  input->GetPointGhostArray()->SetValue(7, vtkDataSetAttributes::HIDDENPOINT);
+  input->Modified();
+  if (!TestThreadedSurface(surface))
+  {
+    std::cerr << "Failed with hidden points" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 #include "vtkBezierTriangle.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
 #include "vtkCellTypes.h"
@@ -37,6 +38,8 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -53,8 +56,11 @@
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <numeric>
 #include <unordered_map>
+#include <vector>
 
 static inline int sizeofFastQuad(int numPts)
 {
@@ -138,6 +144,8 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->OriginalPointIdsName = nullptr;
 
   this->NonlinearSubdivisionLevel = 1;
+
+  this->EnableSMP = false;
 }
 
 //----------------------------------------------------------------------------
@@ -1449,6 +1457,7 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OriginalPointIdsName: " << this->GetOriginalPointIdsName() << endl;
 
   os << indent << "NonlinearSubdivisionLevel: " << this->GetNonlinearSubdivisionLevel() << endl;
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 }
 
 //========================================================================
@@ -1607,8 +1616,41 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
     this->OriginalPointIds->SetNumberOfComponents(1);
   }
 
+  // The faces of the 3D cells of linear unstructured grids can be extracted
+  // by ThreadedExternalFaces() instead of the hash. The loops below then only
+  // process the cell types present in the input.
+  vtkUnstructuredGrid* threadedInput = nullptr;
+  bool hasVerts = true;
+  bool hasLines = true;
+  if (this->EnableSMP && !handleSubdivision)
+  {
+    threadedInput = vtkUnstructuredGrid::SafeDownCast(input);
+  }
+  if (threadedInput)
+  {
+    vtkNew<vtkCellTypes> types;
+    threadedInput->GetCellTypes(types);
+    for (vtkIdType t = 0; t < types->GetNumberOfTypes(); ++t)
+    {
+      if (!vtkCellTypes::IsLinear(types->GetCellType(t)))
+      {
+        threadedInput = nullptr;
+        break;
+      }
+    }
+    if (threadedInput)
+    {
+      hasVerts = types->IsType(VTK_VERTEX) || types->IsType(VTK_POLY_VERTEX);
+      hasLines = types->IsType(VTK_LINE) || types->IsType(VTK_POLY_LINE);
+      flag2D = types->IsType(VTK_PIXEL) || types->IsType(VTK_QUAD) ||
+        types->IsType(VTK_TRIANGLE) || types->IsType(VTK_POLYGON) ||
+        types->IsType(VTK_TRIANGLE_STRIP);
+    }
+  }
+
   // First insert all points.  Points have to come first in poly data.
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
+  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal() && hasVerts;
+       cellIter->GoToNextCell())
   {
     cellType = cellIter->GetCellType();
 
@@ -1639,7 +1681,8 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
 
   // First insert all points lines in output and 3D geometry in hash.
   // Save 2D geometry for second pass.
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal() && !abort;
+  for (cellIter->InitTraversal();
+       !cellIter->IsDoneWithTraversal() && !abort && (!threadedInput || hasLines);
        cellIter->GoToNextCell())
   {
     vtkIdType cellId = cellIter->GetCellId();
@@ -1654,6 +1697,10 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
     progressCount++;
 
     cellType = cellIter->GetCellType();
+    if (threadedInput && cellType != VTK_LINE && cellType != VTK_POLY_LINE)
+    {
+      continue;
+    }
     switch (cellType)
     {
       case VTK_VERTEX:
@@ -2190,37 +2237,44 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
     }
   } // for all cells.
 
-  // Now transfer geometry from hash to output (only triangles and quads).
-  this->InitQuadHashTraversal();
-  while ((q = this->GetNextVisibleQuadFromHash()))
+  if (threadedInput)
   {
-    // If one of the points is hidden (meaning invalid), do not
-    // extract surface cell.
-    // Removed checking for whether all points are ghost, because that's an
-    // incorrect assumption.
-    bool oneHidden = false;
-    // handle all polys
-    for (i = 0; i < q->numPts; i++)
+    this->ThreadedExternalFaces(threadedInput, output, newPts, newPolys);
+  }
+  else
+  {
+    // Now transfer geometry from hash to output (only triangles and quads).
+    this->InitQuadHashTraversal();
+    while ((q = this->GetNextVisibleQuadFromHash()))
     {
-      if (ghosts)
+      // If one of the points is hidden (meaning invalid), do not
+      // extract surface cell.
+      // Removed checking for whether all points are ghost, because that's an
+      // incorrect assumption.
+      bool oneHidden = false;
+      // handle all polys
+      for (i = 0; i < q->numPts; i++)
       {
-        unsigned char val = ghosts->GetValue(q->ptArray[i]);
-        if (val & vtkDataSetAttributes::HIDDENPOINT)
+        if (ghosts)
         {
-          oneHidden = true;
+          unsigned char val = ghosts->GetValue(q->ptArray[i]);
+          if (val & vtkDataSetAttributes::HIDDENPOINT)
+          {
+            oneHidden = true;
+          }
         }
-      }
 
-      q->ptArray[i] = this->GetOutputPointId(q->ptArray[i], input, newPts, outputPD);
-    }
+        q->ptArray[i] = this->GetOutputPointId(q->ptArray[i], input, newPts, outputPD);
+      }
 
-    if (oneHidden)
-    {
-      continue;
+      if (oneHidden)
+      {
+        continue;
+      }
+      newPolys->InsertNextCell(q->numPts, q->ptArray);
+      this->RecordOrigCellId(this->NumberOfNewCells, q);
+      outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
     }
-    newPolys->InsertNextCell(q->numPts, q->ptArray);
-    this->RecordOrigCellId(this->NumberOfNewCells, q);
-    outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
   }
 
   if (this->PassThroughCellIds)
@@ -2773,3 +2827,758 @@ void vtkDataSetSurfaceFilter::RecordOrigPointId(vtkIdType destIndex, vtkIdType o
     this->OriginalPointIds->InsertValue(destIndex, originalId);
   }
 }
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Threaded extraction of the external faces of linear unstructured grids.
+// The faces of the 3D cells are generated cell by cell, with the same point
+// order as the one used by the Insert*InHash() methods, which puts the
+// smallest point id first. The faces are then sorted into bins by their first
+// point id, like in the hash, and matched bin by bin. Inside a bin, faces are
+// matched in ascending cell order, which is the insertion order of the serial
+// implementation. The bins are processed in batches, and the output points
+// and faces are numbered in the order of the hash traversal.
+const vtkIdType BinBatchSize = 1000;
+
+// Thread-local generation of the faces of a cell.
+class CellFaces
+{
+public:
+  std::vector<vtkIdType> Conn;
+  std::vector<vtkIdType> Sizes;
+
+  void Initialize(vtkUnstructuredGrid* input)
+  {
+    this->Input = input;
+    this->Iter = vtk::TakeSmartPointer(input->GetCells()->NewIterator());
+    this->Cell = vtkSmartPointer<vtkGenericCell>::New();
+  }
+
+  void Generate(vtkIdType cellId)
+  {
+    this->Conn.clear();
+    this->Sizes.clear();
+
+    vtkIdType npts;
+    const vtkIdType* ids;
+    switch (this->Input->GetCellType(cellId))
+    {
+      case VTK_EMPTY_CELL:
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+      case VTK_TRIANGLE:
+      case VTK_TRIANGLE_STRIP:
+      case VTK_POLYGON:
+      case VTK_PIXEL:
+      case VTK_QUAD:
+        // These are not inserted in the hash.
+        break;
+
+      case VTK_HEXAHEDRON:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddQuad(ids[0], ids[1], ids[5], ids[4]);
+        this->AddQuad(ids[0], ids[3], ids[2], ids[1]);
+        this->AddQuad(ids[0], ids[4], ids[7], ids[3]);
+        this->AddQuad(ids[1], ids[2], ids[6], ids[5]);
+        this->AddQuad(ids[2], ids[3], ids[7], ids[6]);
+        this->AddQuad(ids[4], ids[5], ids[6], ids[7]);
+        break;
+
+      case VTK_VOXEL:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddQuad(ids[0], ids[1], ids[5], ids[4]);
+        this->AddQuad(ids[0], ids[2], ids[3], ids[1]);
+        this->AddQuad(ids[0], ids[4], ids[6], ids[2]);
+        this->AddQuad(ids[1], ids[3], ids[7], ids[5]);
+        this->AddQuad(ids[2], ids[6], ids[7], ids[3]);
+        this->AddQuad(ids[4], ids[5], ids[7], ids[6]);
+        break;
+
+      case VTK_TETRA:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddTri(ids[0], ids[1], ids[3]);
+        this->AddTri(ids[0], ids[2], ids[1]);
+        this->AddTri(ids[0], ids[3], ids[2]);
+        this->AddTri(ids[1], ids[2], ids[3]);
+        break;
+
+      case VTK_PENTAGONAL_PRISM:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddQuad(ids[0], ids[1], ids[6], ids[5]);
+        this->AddQuad(ids[1], ids[2], ids[7], ids[6]);
+        this->AddQuad(ids[2], ids[3], ids[8], ids[7]);
+        this->AddQuad(ids[3], ids[4], ids[9], ids[8]);
+        this->AddQuad(ids[4], ids[0], ids[5], ids[9]);
+        this->AddPolygon(ids, 5);
+        this->AddPolygon(ids + 5, 5);
+        break;
+
+      case VTK_HEXAGONAL_PRISM:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddQuad(ids[0], ids[1], ids[7], ids[6]);
+        this->AddQuad(ids[1], ids[2], ids[8], ids[7]);
+        this->AddQuad(ids[2], ids[3], ids[9], ids[8]);
+        this->AddQuad(ids[3], ids[4], ids[10], ids[9]);
+        this->AddQuad(ids[4], ids[5], ids[11], ids[10]);
+        this->AddQuad(ids[5], ids[0], ids[6], ids[11]);
+        this->AddPolygon(ids, 6);
+        this->AddPolygon(ids + 6, 6);
+        break;
+
+      case VTK_PYRAMID:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddQuad(ids[3], ids[2], ids[1], ids[0]);
+        this->AddTri(ids[0], ids[1], ids[4]);
+        this->AddTri(ids[1], ids[2], ids[4]);
+        this->AddTri(ids[2], ids[3], ids[4]);
+        this->AddTri(ids[3], ids[0], ids[4]);
+        break;
+
+      case VTK_WEDGE:
+        this->Iter->GetCellAtId(cellId, npts, ids);
+        this->AddQuad(ids[0], ids[2], ids[5], ids[3]);
+        this->AddQuad(ids[1], ids[0], ids[3], ids[4]);
+        this->AddQuad(ids[2], ids[1], ids[4], ids[5]);
+        this->AddTri(ids[0], ids[1], ids[2]);
+        this->AddTri(ids[3], ids[5], ids[4]);
+        break;
+
+      default:
+        this->Input->GetCell(cellId, this->Cell);
+        if (this->Cell->GetCellDimension() == 3)
+        {
+          const int numFaces = this->Cell->GetNumberOfFaces();
+          for (int j = 0; j < numFaces; ++j)
+          {
+            vtkIdList* faceIds = this->Cell->GetFace(j)->PointIds;
+            const vtkIdType numFacePts = faceIds->GetNumberOfIds();
+            if (numFacePts == 4)
+            {
+              this->AddQuad(faceIds->GetId(0), faceIds->GetId(1), faceIds->GetId(2),
+                faceIds->GetId(3));
+            }
+            else if (numFacePts == 3)
+            {
+              this->AddTri(faceIds->GetId(0), faceIds->GetId(1), faceIds->GetId(2));
+            }
+            else
+            {
+              this->AddPolygon(faceIds->GetPointer(0), numFacePts);
+            }
+          }
+        }
+        break;
+    }
+  }
+
+private:
+  vtkUnstructuredGrid* Input;
+  vtkSmartPointer<vtkCellArrayIterator> Iter;
+  vtkSmartPointer<vtkGenericCell> Cell;
+
+  // Same reordering as InsertQuadInHash().
+  void AddQuad(vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType d)
+  {
+    if (b < a && b < c && b < d)
+    {
+      this->Conn.insert(this->Conn.end(), { b, c, d, a });
+    }
+    else if (c < a && c < b && c < d)
+    {
+      this->Conn.insert(this->Conn.end(), { c, d, a, b });
+    }
+    else if (d < a && d < b && d < c)
+    {
+      this->Conn.insert(this->Conn.end(), { d, a, b, c });
+    }
+    else
+    {
+      this->Conn.insert(this->Conn.end(), { a, b, c, d });
+    }
+    this->Sizes.push_back(4);
+  }
+
+  // Same reordering as InsertTriInHash().
+  void AddTri(vtkIdType a, vtkIdType b, vtkIdType c)
+  {
+    if (b < a && b < c)
+    {
+      this->Conn.insert(this->Conn.end(), { b, c, a });
+    }
+    else if (c < a && c < b)
+    {
+      this->Conn.insert(this->Conn.end(), { c, a, b });
+    }
+    else
+    {
+      this->Conn.insert(this->Conn.end(), { a, b, c });
+    }
+    this->Sizes.push_back(3);
+  }
+
+  // Same reordering as InsertPolygonInHash().
+  void AddPolygon(const vtkIdType* ids, vtkIdType numPts)
+  {
+    if (numPts == 0)
+    {
+      return;
+    }
+    const vtkIdType offset = std::min_element(ids, ids + numPts) - ids;
+    this->Conn.insert(this->Conn.end(), ids + offset, ids + numPts);
+    this->Conn.insert(this->Conn.end(), ids, ids + offset);
+    this->Sizes.push_back(numPts);
+  }
+};
+
+// Same tests as the Insert*InHash() methods, face being the inserted face
+// and other a face already in the bin.
+bool SameFace(const vtkIdType* face, vtkIdType numPts, const vtkIdType* other, vtkIdType numOther)
+{
+  if (numPts == 4)
+  {
+    return numOther == 4 && face[2] == other[2] &&
+      ((face[1] == other[1] && face[3] == other[3]) ||
+        (face[1] == other[3] && face[3] == other[1]));
+  }
+  if (numPts == 3)
+  {
+    return numOther == 3 &&
+      ((face[1] == other[1] && face[2] == other[2]) ||
+        (face[1] == other[2] && face[2] == other[1]));
+  }
+  if (numPts != numOther || face[0] != other[0])
+  {
+    return false;
+  }
+  if (numPts > 1 && face[1] == other[1])
+  {
+    return std::equal(face + 2, face + numPts, other + 2);
+  }
+  for (vtkIdType i = 1; i < numPts; ++i)
+  {
+    if (face[numPts - i] != other[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Faces with a hidden point are not extracted.
+bool HasHiddenPoint(vtkUnsignedCharArray* ghosts, const vtkIdType* pts, vtkIdType npts)
+{
+  if (ghosts)
+  {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (ghosts->GetValue(pts[i]) & vtkDataSetAttributes::HIDDENPOINT)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Counts the faces of each cell and their points.
+struct CountCellFaces
+{
+  vtkUnstructuredGrid* Input;
+  vtkIdType* NumFaces;
+  vtkIdType* NumFacePts;
+  vtkSMPThreadLocal<CellFaces> Faces;
+
+  CountCellFaces(vtkUnstructuredGrid* input, vtkIdType* numFaces, vtkIdType* numFacePts)
+    : Input(input)
+    , NumFaces(numFaces)
+    , NumFacePts(numFacePts)
+  {
+  }
+
+  void Initialize() { this->Faces.Local().Initialize(this->Input); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    CellFaces& faces = this->Faces.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      faces.Generate(cellId);
+      this->NumFaces[cellId] = static_cast<vtkIdType>(faces.Sizes.size());
+      this->NumFacePts[cellId] = static_cast<vtkIdType>(faces.Conn.size());
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Generates the faces of each cell and counts the faces of each bin.
+struct GenerateCellFaces
+{
+  vtkUnstructuredGrid* Input;
+  const vtkIdType* CellFaceOffsets;
+  const vtkIdType* CellConnOffsets;
+  vtkIdType* FaceOffsets;
+  vtkIdType* FaceConn;
+  vtkIdType* FaceCells;
+  std::atomic<vtkIdType>* BinCounts;
+  vtkSMPThreadLocal<CellFaces> Faces;
+
+  GenerateCellFaces(vtkUnstructuredGrid* input, const vtkIdType* cellFaceOffsets,
+    const vtkIdType* cellConnOffsets, vtkIdType* faceOffsets, vtkIdType* faceConn,
+    vtkIdType* faceCells, std::atomic<vtkIdType>* binCounts)
+    : Input(input)
+    , CellFaceOffsets(cellFaceOffsets)
+    , CellConnOffsets(cellConnOffsets)
+    , FaceOffsets(faceOffsets)
+    , FaceConn(faceConn)
+    , FaceCells(faceCells)
+    , BinCounts(binCounts)
+  {
+  }
+
+  void Initialize() { this->Faces.Local().Initialize(this->Input); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    CellFaces& faces = this->Faces.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (this->CellFaceOffsets[cellId] == this->CellFaceOffsets[cellId + 1])
+      {
+        continue;
+      }
+      faces.Generate(cellId);
+      vtkIdType faceId = this->CellFaceOffsets[cellId];
+      vtkIdType offset = this->CellConnOffsets[cellId];
+      std::copy(faces.Conn.begin(), faces.Conn.end(), this->FaceConn + offset);
+      for (const vtkIdType size : faces.Sizes)
+      {
+        this->FaceOffsets[faceId] = offset;
+        this->FaceCells[faceId++] = cellId;
+        this->BinCounts[this->FaceConn[offset]].fetch_add(1, std::memory_order_relaxed);
+        offset += size;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Sorts the faces into their bins, in no particular order.
+struct BinFaces
+{
+  const vtkIdType* FaceOffsets;
+  const vtkIdType* FaceConn;
+  const vtkIdType* BinOffsets;
+  std::atomic<vtkIdType>* BinFill;
+  vtkIdType* Bins;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType faceId = begin; faceId < end; ++faceId)
+    {
+      const vtkIdType bin = this->FaceConn[this->FaceOffsets[faceId]];
+      const vtkIdType fill = this->BinFill[bin].fetch_add(1, std::memory_order_relaxed);
+      this->Bins[this->BinOffsets[bin] + fill] = faceId;
+    }
+  }
+};
+
+// Matches the faces of each bin of a batch, like the hash does, and moves the
+// visible faces to the front of the bin. Counts the point references of the
+// visible faces, and the faces and points of the output polygons.
+struct MatchFaces
+{
+  vtkIdType NumberOfBins;
+  const vtkIdType* FaceOffsets;
+  const vtkIdType* FaceConn;
+  const vtkIdType* BinOffsets;
+  vtkIdType* Bins;
+  vtkIdType* NumVisible;
+  vtkUnsignedCharArray* Ghosts;
+  vtkIdType* BatchRefs;
+  vtkIdType* BatchFaces;
+  vtkIdType* BatchConn;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    std::vector<vtkIdType> kept;
+    std::vector<unsigned char> hidden;
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType numRefs = 0;
+      vtkIdType numFaces = 0;
+      vtkIdType numConn = 0;
+      const vtkIdType endBin = std::min((batch + 1) * BinBatchSize, this->NumberOfBins);
+      for (vtkIdType bin = batch * BinBatchSize; bin < endBin; ++bin)
+      {
+        vtkIdType* faces = this->Bins + this->BinOffsets[bin];
+        vtkIdType* facesEnd = this->Bins + this->BinOffsets[bin + 1];
+        std::sort(faces, facesEnd);
+
+        kept.clear();
+        hidden.clear();
+        for (vtkIdType* face = faces; face != facesEnd; ++face)
+        {
+          const vtkIdType* pts = this->FaceConn + this->FaceOffsets[*face];
+          const vtkIdType npts = this->FaceOffsets[*face + 1] - this->FaceOffsets[*face];
+          bool match = false;
+          for (size_t i = 0; i < kept.size() && !match; ++i)
+          {
+            const vtkIdType* other = this->FaceConn + this->FaceOffsets[kept[i]];
+            const vtkIdType nother = this->FaceOffsets[kept[i] + 1] - this->FaceOffsets[kept[i]];
+            if (SameFace(pts, npts, other, nother))
+            {
+              hidden[i] = 1;
+              match = true;
+            }
+          }
+          if (!match)
+          {
+            kept.push_back(*face);
+            hidden.push_back(0);
+          }
+        }
+
+        vtkIdType numVisible = 0;
+        for (size_t i = 0; i < kept.size(); ++i)
+        {
+          if (hidden[i])
+          {
+            continue;
+          }
+          faces[numVisible++] = kept[i];
+          const vtkIdType* pts = this->FaceConn + this->FaceOffsets[kept[i]];
+          const vtkIdType npts = this->FaceOffsets[kept[i] + 1] - this->FaceOffsets[kept[i]];
+          numRefs += npts;
+          if (!HasHiddenPoint(this->Ghosts, pts, npts))
+          {
+            ++numFaces;
+            numConn += npts;
+          }
+        }
+        this->NumVisible[bin] = numVisible;
+      }
+      this->BatchRefs[batch] = numRefs;
+      this->BatchFaces[batch] = numFaces;
+      this->BatchConn[batch] = numConn;
+    }
+  }
+};
+
+// Traversal of the visible faces in hash order.
+struct VisibleFaces
+{
+  vtkIdType NumberOfBins;
+  const vtkIdType* FaceOffsets;
+  const vtkIdType* FaceConn;
+  const vtkIdType* BinOffsets;
+  const vtkIdType* Bins;
+  const vtkIdType* NumVisible;
+
+  // Calls f(faceId, pts, npts) for the visible faces of a batch.
+  template <typename Functor>
+  void ForEachFace(vtkIdType batch, Functor&& f) const
+  {
+    const vtkIdType endBin = std::min((batch + 1) * BinBatchSize, this->NumberOfBins);
+    for (vtkIdType bin = batch * BinBatchSize; bin < endBin; ++bin)
+    {
+      const vtkIdType* faces = this->Bins + this->BinOffsets[bin];
+      for (vtkIdType i = 0; i < this->NumVisible[bin]; ++i)
+      {
+        const vtkIdType faceId = faces[i];
+        f(faceId, this->FaceConn + this->FaceOffsets[faceId],
+          this->FaceOffsets[faceId + 1] - this->FaceOffsets[faceId]);
+      }
+    }
+  }
+};
+
+// Finds the first reference of each point not in the output yet.
+struct MarkFirstUse
+{
+  VisibleFaces Faces;
+  const vtkIdType* PointMap;
+  const vtkIdType* BatchRefs;
+  std::atomic<vtkIdType>* FirstUse;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType ref = this->BatchRefs[batch];
+      this->Faces.ForEachFace(batch, [&](vtkIdType, const vtkIdType* pts, vtkIdType npts) {
+        for (vtkIdType i = 0; i < npts; ++i, ++ref)
+        {
+          if (this->PointMap[pts[i]] == -1)
+          {
+            // memory_order_relaxed is safe here, the atomics are only used to
+            // compute a minimum, not for synchronization.
+            std::atomic<vtkIdType>& firstUse = this->FirstUse[pts[i]];
+            vtkIdType current = firstUse.load(std::memory_order_relaxed);
+            while (ref < current &&
+              !firstUse.compare_exchange_weak(current, ref, std::memory_order_relaxed))
+            {
+            }
+          }
+        }
+      });
+    }
+  }
+};
+
+// Counts the new points of each batch, or numbers them when the offsets of
+// the batches are known. A point is new at its first reference.
+struct NumberPoints
+{
+  VisibleFaces Faces;
+  const vtkIdType* BatchRefs;
+  const std::atomic<vtkIdType>* FirstUse;
+  vtkIdType* BatchPts;
+  vtkIdType* PointMap;
+  vtkIdType* SourcePts;
+  vtkIdType FirstPoint;
+  bool Generate;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType ref = this->BatchRefs[batch];
+      vtkIdType newPtId = this->Generate ? this->BatchPts[batch] : 0;
+      this->Faces.ForEachFace(batch, [&](vtkIdType, const vtkIdType* pts, vtkIdType npts) {
+        for (vtkIdType i = 0; i < npts; ++i, ++ref)
+        {
+          if (this->FirstUse[pts[i]].load(std::memory_order_relaxed) == ref)
+          {
+            if (this->Generate)
+            {
+              this->PointMap[pts[i]] = this->FirstPoint + newPtId;
+              this->SourcePts[newPtId] = pts[i];
+            }
+            ++newPtId;
+          }
+        }
+      });
+      if (!this->Generate)
+      {
+        this->BatchPts[batch] = newPtId;
+      }
+    }
+  }
+};
+
+// Generates the output polygons.
+struct GenerateFaces
+{
+  VisibleFaces Faces;
+  const vtkIdType* PointMap;
+  const vtkIdType* FaceCells;
+  vtkUnsignedCharArray* Ghosts;
+  const vtkIdType* BatchFaces;
+  const vtkIdType* BatchConn;
+  vtkIdType* Offsets;
+  vtkIdType* Conn;
+  vtkIdType* SourceCells;
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkIdType outFaceId = this->BatchFaces[batch];
+      vtkIdType offset = this->BatchConn[batch];
+      this->Faces.ForEachFace(batch, [&](vtkIdType faceId, const vtkIdType* pts, vtkIdType npts) {
+        if (HasHiddenPoint(this->Ghosts, pts, npts))
+        {
+          return;
+        }
+        this->Offsets[outFaceId] = offset;
+        this->SourceCells[outFaceId++] = this->FaceCells[faceId];
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          this->Conn[offset++] = this->PointMap[pts[i]];
+        }
+      });
+    }
+  }
+};
+
+// Copies the new points.
+struct CopyPoints
+{
+  vtkDataSet* Input;
+  vtkPoints* OutPoints;
+  const vtkIdType* SourcePts;
+  vtkIdType FirstPoint;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Input->GetPoint(this->SourcePts[i], x);
+      this->OutPoints->SetPoint(this->FirstPoint + i, x);
+    }
+  }
+};
+
+// Exclusive prefix sum of values[0, n), the total is stored in values[n].
+void PrefixSum(vtkIdType* values, vtkIdType n)
+{
+  vtkIdType total = 0;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    const vtkIdType value = values[i];
+    values[i] = total;
+    total += value;
+  }
+  values[n] = total;
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkDataSetSurfaceFilter::ThreadedExternalFaces(
+  vtkUnstructuredGrid* input, vtkPolyData* output, vtkPoints* newPts, vtkCellArray* newPolys)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+
+  // Generate the faces of all the cells.
+  std::vector<vtkIdType> cellFaceOffsets(numCells + 1);
+  std::vector<vtkIdType> cellConnOffsets(numCells + 1);
+  CountCellFaces countFaces(input, cellFaceOffsets.data(), cellConnOffsets.data());
+  vtkSMPTools::For(0, numCells, countFaces);
+  PrefixSum(cellFaceOffsets.data(), numCells);
+  PrefixSum(cellConnOffsets.data(), numCells);
+  const vtkIdType numFaces = cellFaceOffsets[numCells];
+  if (numFaces == 0)
+  {
+    return;
+  }
+
+  std::vector<vtkIdType> faceOffsets(numFaces + 1);
+  std::vector<vtkIdType> faceConn(cellConnOffsets[numCells]);
+  std::vector<vtkIdType> faceCells(numFaces);
+  faceOffsets[numFaces] = cellConnOffsets[numCells];
+  std::atomic<vtkIdType>* binCounts = new std::atomic<vtkIdType>[numPts];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    binCounts[i].store(0, std::memory_order_relaxed);
+  }
+  GenerateCellFaces generateCellFaces(input, cellFaceOffsets.data(), cellConnOffsets.data(),
+    faceOffsets.data(), faceConn.data(), faceCells.data(), binCounts);
+  vtkSMPTools::For(0, numCells, generateCellFaces);
+
+  // Sort the faces into bins keyed by their first point id.
+  std::vector<vtkIdType> binOffsets(numPts + 1);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    binOffsets[i] = binCounts[i].load(std::memory_order_relaxed);
+    binCounts[i].store(0, std::memory_order_relaxed);
+  }
+  PrefixSum(binOffsets.data(), numPts);
+  std::vector<vtkIdType> bins(numFaces);
+  BinFaces binFaces{ faceOffsets.data(), faceConn.data(), binOffsets.data(), binCounts,
+    bins.data() };
+  vtkSMPTools::For(0, numFaces, binFaces);
+
+  // Match the faces and count the output of each batch of bins.
+  const vtkIdType numBatches = (numPts - 1) / BinBatchSize + 1;
+  std::vector<vtkIdType> numVisible(numPts);
+  std::vector<vtkIdType> batchRefs(numBatches + 1);
+  std::vector<vtkIdType> batchFaces(numBatches + 1);
+  std::vector<vtkIdType> batchConn(numBatches + 1);
+  MatchFaces matchFaces{ numPts, faceOffsets.data(), faceConn.data(), binOffsets.data(),
+    bins.data(), numVisible.data(), ghosts, batchRefs.data(), batchFaces.data(),
+    batchConn.data() };
+  vtkSMPTools::For(0, numBatches, matchFaces);
+  PrefixSum(batchRefs.data(), numBatches);
+  PrefixSum(batchFaces.data(), numBatches);
+  PrefixSum(batchConn.data(), numBatches);
+
+  // Number the new points in the order of their first reference, which is
+  // the order in which GetOutputPointId() would add them.
+  VisibleFaces visibleFaces{ numPts, faceOffsets.data(), faceConn.data(), binOffsets.data(),
+    bins.data(), numVisible.data() };
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    binCounts[i].store(VTK_ID_MAX, std::memory_order_relaxed);
+  }
+  std::atomic<vtkIdType>* firstUse = binCounts;
+  MarkFirstUse markFirstUse{ visibleFaces, this->PointMap, batchRefs.data(), firstUse };
+  vtkSMPTools::For(0, numBatches, markFirstUse);
+
+  const vtkIdType firstPoint = newPts->GetNumberOfPoints();
+  std::vector<vtkIdType> batchPts(numBatches + 1);
+  NumberPoints numberPoints{ visibleFaces, batchRefs.data(), firstUse, batchPts.data(),
+    this->PointMap, nullptr, firstPoint, false };
+  vtkSMPTools::For(0, numBatches, numberPoints);
+  PrefixSum(batchPts.data(), numBatches);
+  const vtkIdType numNewPts = batchPts[numBatches];
+  vtkNew<vtkIdList> sourcePts;
+  sourcePts->SetNumberOfIds(numNewPts);
+  numberPoints.SourcePts = sourcePts->GetPointer(0);
+  numberPoints.Generate = true;
+  vtkSMPTools::For(0, numBatches, numberPoints);
+  delete[] binCounts;
+
+  // Generate the output polygons.
+  const vtkIdType numOutFaces = batchFaces[numBatches];
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutFaces + 1);
+  offsets->SetValue(numOutFaces, batchConn[numBatches]);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(batchConn[numBatches]);
+  vtkNew<vtkIdList> sourceCells;
+  sourceCells->SetNumberOfIds(numOutFaces);
+  GenerateFaces generateFaces{ visibleFaces, this->PointMap, faceCells.data(), ghosts,
+    batchFaces.data(), batchConn.data(), offsets->GetPointer(0), conn->GetPointer(0),
+    sourceCells->GetPointer(0) };
+  vtkSMPTools::For(0, numBatches, generateFaces);
+
+  if (newPolys->GetNumberOfCells() == 0)
+  {
+    newPolys->SetData(offsets, conn);
+  }
+  else
+  {
+    vtkNew<vtkCellArray> faces;
+    faces->SetData(offsets, conn);
+    newPolys->Append(faces);
+  }
+
+  // Copy the new points and their data.
+  newPts->SetNumberOfPoints(firstPoint + numNewPts);
+  CopyPoints copyPoints{ input, newPts, sourcePts->GetPointer(0), firstPoint };
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+  vtkNew<vtkIdList> destPts;
+  destPts->SetNumberOfIds(numNewPts);
+  std::iota(destPts->GetPointer(0), destPts->GetPointer(0) + numNewPts, firstPoint);
+  output->GetPointData()->CopyData(input->GetPointData(), sourcePts, destPts);
+  if (this->OriginalPointIds != nullptr)
+  {
+    this->OriginalPointIds->SetNumberOfValues(firstPoint + numNewPts);
+    std::copy(sourcePts->GetPointer(0), sourcePts->GetPointer(0) + numNewPts,
+      this->OriginalPointIds->GetPointer(firstPoint));
+  }
+
+  // Copy the cell data of the polygons.
+  vtkNew<vtkIdList> destCells;
+  destCells->SetNumberOfIds(numOutFaces);
+  std::iota(destCells->GetPointer(0), destCells->GetPointer(0) + numOutFaces,
+    this->NumberOfNewCells);
+  output->GetCellData()->CopyData(input->GetCellData(), sourceCells, destCells);
+  if (this->OriginalCellIds != nullptr)
+  {
+    this->OriginalCellIds->SetNumberOfValues(this->NumberOfNewCells + numOutFaces);
+    std::copy(sourceCells->GetPointer(0), sourceCells->GetPointer(0) + numOutFaces,
+      this->OriginalCellIds->GetPointer(this->NumberOfNewCells));
+  }
+  this->NumberOfNewCells += numOutFaces;
+}
@@ -21,6 +21,11 @@
  * vtkGeometryFilter.  It only has one option: whether to use triangle strips
  * when the input type is structured.
  *
+ * When EnableSMP is on, the external faces of unstructured grids made of
+ * linear cells are extracted with vtkSMPTools. Faces are binned by their
+ * smallest point id and matched bin by bin, and the output is the same as
+ * the one of the serial implementation. Other inputs are processed serially.
+ *
  * @sa
  * vtkGeometryFilter vtkStructuredGridGeometryFilter.
  */
@@ -31,10 +36,12 @@
 #include "vtkFiltersGeometryModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkCellArray;
 class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 
 // Helper structure for hashing faces.
 struct vtkFastGeomQuadStruct
@@ -126,6 +133,17 @@ public:
   vtkGetMacro(NonlinearSubdivisionLevel, int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the threaded extraction of the external faces of unstructured
+   * grids made of linear cells. Subclasses that override the methods inserting
+   * faces in the hash should leave it off. By default, EnableSMP is Off.
+   */
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+  //@}
+
   //@{
   /**
    * Direct access methods that can be used to use the this class as an
@@ -253,6 +271,16 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  bool EnableSMP;
+
+  /**
+   * Threaded replacement of the hash used by UnstructuredGridExecute() for
+   * the faces of the 3D cells. Appends the external faces to newPolys, in the
+   * order of the hash traversal.
+   */
+  void ThreadedExternalFaces(vtkUnstructuredGrid* input, vtkPolyData* output, vtkPoints* newPts,
+    vtkCellArray* newPolys);
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&) = delete;
   void operator=(const vtkDataSetSurfaceFilter&) = delete;
@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressZFP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkZFPDataCompressor
+// .SECTION Description
+//
+
+#include "vtkNew.h"
+#include "vtkZFPDataCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+template <typename T>
+bool RoundTrip(vtkZFPDataCompressor* compressor, const std::vector<T>& values,
+  std::vector<T>& result, size_t& compressedSize)
+{
+  const size_t size = values.size() * sizeof(T);
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(values.data());
+  std::vector<unsigned char> cbuffer(compressor->GetMaximumCompressionSpace(size));
+  compressedSize = compressor->Compress(data, size, cbuffer.data(), cbuffer.size());
+  if (compressedSize == 0)
+  {
+    return false;
+  }
+  result.assign(values.size(), T(0));
+  // The uncompression does not depend on the settings.
+  vtkNew<vtkZFPDataCompressor> uncompressor;
+  return uncompressor->Uncompress(cbuffer.data(), compressedSize,
+           reinterpret_cast<unsigned char*>(result.data()), size) == size;
+}
+
+template <typename T>
+double MaximumError(const std::vector<T>& values, const std::vector<T>& result)
+{
+  double error = 0.0;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    error = std::max(error, std::fabs(static_cast<double>(values[i]) - result[i]));
+  }
+  return error;
+}
+}
+
+int TestCompressZFP(int argc, char* argv[])
+{
+  const size_t count = 10001;
+  std::vector<double> doubles(count);
+  std::vector<float> floats(count);
+  std::vector<int> ints(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    doubles[i] = std::sin(0.001 * i) + 0.1 * std::cos(0.05 * i);
+    floats[i] = static_cast<float>(doubles[i]);
+    ints[i] = static_cast<int>((i * i) % 7);
+  }
+
+  vtkNew<vtkZFPDataCompressor> compressor;
+  size_t compressedSize;
+
+  // Without a floating point type, the buffers are compressed without loss.
+  std::vector<int> intResult;
+  if (!RoundTrip(compressor.GetPointer(), ints, intResult, compressedSize) || intResult != ints)
+  {
+    cerr << "Lossless compression failed" << endl;
+    return 1;
+  }
+  std::vector<double> doubleResult;
+  compressor->SetDataType(VTK_DOUBLE);
+  if (!RoundTrip(compressor.GetPointer(), ints, intResult, compressedSize) || intResult != ints)
+  {
+    cerr << "Lossless compression of a buffer of odd size failed" << endl;
+    return 1;
+  }
+
+  const double tolerances[] = { 1e-2, 1e-4, 1e-8 };
+  for (double tolerance : tolerances)
+  {
+    compressor->SetModeToFixedAccuracy();
+    compressor->SetTolerance(tolerance);
+    if (!RoundTrip(compressor.GetPointer(), doubles, doubleResult, compressedSize) ||
+      MaximumError(doubles, doubleResult) > tolerance)
+    {
+      cerr << "Fixed accuracy compression failed with tolerance " << tolerance << endl;
+      return 1;
+    }
+  }
+
+  compressor->SetModeToFixedRate();
+  compressor->SetRate(8);
+  if (!RoundTrip(compressor.GetPointer(), doubles, doubleResult, compressedSize) ||
+    compressedSize > count + 64 || MaximumError(doubles, doubleResult) > 5e-2)
+  {
+    cerr << "Fixed rate compression failed, " << compressedSize << " bytes, error "
+         << MaximumError(doubles, doubleResult) << endl;
+    return 1;
+  }
+
+  std::vector<float> floatResult;
+  compressor->SetDataType(VTK_FLOAT);
+  compressor->SetModeToFixedPrecision();
+  compressor->SetPrecision(32);
+  if (!RoundTrip(compressor.GetPointer(), floats, floatResult, compressedSize) ||
+    MaximumError(floats, floatResult) > 1e-6)
+  {
+    cerr << "Fixed precision compression failed" << endl;
+    return 1;
+  }
+
+  for (int level = 1; level <= 9; ++level)
+  {
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level)
+    {
+      cerr << "Compression level " << level << " read back as "
+           << compressor->GetCompressionLevel() << endl;
+      return 1;
+    }
+  }
+  cout << argv[0] << " Works " << argc << endl;
+  return 0;
+}
@@ -0,0 +1,65 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressZstd.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+//
+
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cstring>
+#include <vector>
+
+int TestCompressZstd(int argc, char* argv[])
+{
+  const size_t size = 100024;
+  std::vector<unsigned char> buffer(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    buffer[i] = static_cast<unsigned char>((i * i) % 7);
+  }
+  buffer[0] = 'v';
+  buffer[1] = 't';
+  buffer[2] = 'k';
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int level = 1; level <= 9; ++level)
+  {
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level)
+    {
+      cerr << "Compression level " << level << " read back as "
+           << compressor->GetCompressionLevel() << endl;
+      return 1;
+    }
+
+    std::vector<unsigned char> cbuffer(compressor->GetMaximumCompressionSpace(size));
+    size_t rlen = compressor->Compress(buffer.data(), size, cbuffer.data(), cbuffer.size());
+    if (rlen == 0 || rlen >= size)
+    {
+      cerr << "Compression failed at level " << level << endl;
+      return 1;
+    }
+    std::vector<unsigned char> ucbuffer(size);
+    if (compressor->Uncompress(cbuffer.data(), rlen, ucbuffer.data(), size) != size ||
+      ucbuffer != buffer)
+    {
+      cerr << "Decompression failed at level " << level << endl;
+      return 1;
+    }
+  }
+  cout << argv[0] << " Works " << argc << endl;
+  return 0;
+}
@@ -16,7 +16,10 @@
 #include "vtkUnsignedCharArray.h"
 
 //----------------------------------------------------------------------------
-vtkDataCompressor::vtkDataCompressor() = default;
+vtkDataCompressor::vtkDataCompressor()
+{
+  this->ThreadSafe = false;
+}
 
 //----------------------------------------------------------------------------
 vtkDataCompressor::~vtkDataCompressor() = default;
@@ -25,6 +28,7 @@ vtkDataCompressor::~vtkDataCompressor() = default;
 void vtkDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ThreadSafe: " << (this->ThreadSafe ? "On" : "Off") << endl;
 }
 
 //----------------------------------------------------------------------------
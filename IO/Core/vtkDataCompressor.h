@@ -28,6 +28,12 @@
  * should be implemented with this in mind to provide a predictable
  * compressor interface for vtkDataCompressor users.
  *
+ * @par Thread safety:
+ * The XML readers and writers compress and uncompress blocks concurrently
+ * with a compressor whose ThreadSafe flag is on, and one block at a time
+ * otherwise. Subclasses turn it on when CompressBuffer() and
+ * UncompressBuffer() may run concurrently, which the VTK compressors do.
+ *
  * @pat Thanks:
  * Homogeneous CompressionLevel behavior contributed by Quincy Wofford
  * (qwofford@lanl.gov) and John Patchett (patchett@lanl.gov)
@@ -99,6 +105,18 @@ public:
   virtual void SetCompressionLevel(int compressionLevel) = 0;
   virtual int GetCompressionLevel() = 0;
 
+  //@{
+  /**
+   * Set/Get whether Compress() and Uncompress() may be called concurrently
+   * from several threads, while the settings of the compressor do not
+   * change. Only turn it on for a compressor that keeps no state between
+   * the calls. The default is Off, the VTK compressors turn it on.
+   */
+  vtkSetMacro(ThreadSafe, bool);
+  vtkGetMacro(ThreadSafe, bool);
+  vtkBooleanMacro(ThreadSafe, bool);
+  //@}
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor() override;
@@ -112,6 +130,8 @@ protected:
   virtual size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
     unsigned char* uncompressedData, size_t uncompressedSize) = 0;
 
+  bool ThreadSafe;
+
 private:
   vtkDataCompressor(const vtkDataCompressor&) = delete;
   void operator=(const vtkDataCompressor&) = delete;
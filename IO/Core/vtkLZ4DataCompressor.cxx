@@ -21,6 +21,7 @@ vtkStandardNewMacro(vtkLZ4DataCompressor);
 //----------------------------------------------------------------------------
 vtkLZ4DataCompressor::vtkLZ4DataCompressor()
 {
+  this->ThreadSafe = true;
   this->AccelerationLevel = 1;
 }
 
@@ -21,6 +21,7 @@ vtkStandardNewMacro(vtkLZMADataCompressor);
 //----------------------------------------------------------------------------
 vtkLZMADataCompressor::vtkLZMADataCompressor()
 {
+  this->ThreadSafe = true;
   this->CompressionLevel = 5;
 }
 
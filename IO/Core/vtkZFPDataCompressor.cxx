@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZFPDataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkZLibDataCompressor.h"
+#include "vtk_zfp.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkZFPDataCompressor);
+
+namespace
+{
+// The first byte of the compressed buffers tells how they were compressed.
+const unsigned char LosslessTag = 0;
+const unsigned char ZFPTag = 1;
+
+// The ZFP bit streams are read and written by 64-bit words, they are kept
+// in aligned buffers.
+using StreamWord = vtkTypeUInt64;
+
+size_t NumberOfStreamWords(size_t bytes)
+{
+  return (bytes + sizeof(StreamWord) - 1) / sizeof(StreamWord);
+}
+
+zfp_type GetZFPType(int dataType)
+{
+  switch (dataType)
+  {
+    case VTK_FLOAT:
+      return zfp_type_float;
+    case VTK_DOUBLE:
+      return zfp_type_double;
+    default:
+      return zfp_type_none;
+  }
+}
+
+void SetStreamMode(zfp_stream* zfp, zfp_type type, vtkZFPDataCompressor* compressor)
+{
+  switch (compressor->GetMode())
+  {
+    case vtkZFPDataCompressor::FIXED_RATE:
+      zfp_stream_set_rate(zfp, compressor->GetRate(), type, 1, 0);
+      break;
+    case vtkZFPDataCompressor::FIXED_PRECISION:
+      zfp_stream_set_precision(zfp, static_cast<unsigned int>(compressor->GetPrecision()));
+      break;
+    default:
+      zfp_stream_set_accuracy(zfp, compressor->GetTolerance());
+      break;
+  }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkZFPDataCompressor::vtkZFPDataCompressor()
+{
+  this->ThreadSafe = true;
+  this->DataType = VTK_VOID;
+  this->Mode = FIXED_ACCURACY;
+  this->Rate = 16.0;
+  this->Precision = 24;
+  this->Tolerance = 1e-6;
+  this->LosslessCompressor = vtkZLibDataCompressor::New();
+}
+
+//----------------------------------------------------------------------------
+vtkZFPDataCompressor::~vtkZFPDataCompressor()
+{
+  this->LosslessCompressor->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkZFPDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "DataType: " << this->DataType << endl;
+  os << indent << "Mode: " << this->Mode << endl;
+  os << indent << "Rate: " << this->Rate << endl;
+  os << indent << "Precision: " << this->Precision << endl;
+  os << indent << "Tolerance: " << this->Tolerance << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  if (compressionSpace < 1)
+  {
+    return 0;
+  }
+
+  zfp_type type = GetZFPType(this->DataType);
+  size_t numValues = type != zfp_type_none ? uncompressedSize / zfp_type_size(type) : 0;
+  if (numValues == 0 || numValues * zfp_type_size(type) != uncompressedSize ||
+    numValues > VTK_UNSIGNED_INT_MAX)
+  {
+    compressedData[0] = LosslessTag;
+    size_t cs = this->LosslessCompressor->Compress(
+      uncompressedData, uncompressedSize, compressedData + 1, compressionSpace - 1);
+    return cs ? cs + 1 : 0;
+  }
+
+  // ZFP does not modify the values it compresses.
+  zfp_field* field = zfp_field_1d(
+    const_cast<unsigned char*>(uncompressedData), type, static_cast<unsigned int>(numValues));
+  zfp_stream* zfp = zfp_stream_open(nullptr);
+  SetStreamMode(zfp, type, this);
+  std::vector<StreamWord> buffer(NumberOfStreamWords(zfp_stream_maximum_size(zfp, field)));
+  bitstream* stream = stream_open(buffer.data(), buffer.size() * sizeof(StreamWord));
+  zfp_stream_set_bit_stream(zfp, stream);
+  zfp_stream_rewind(zfp);
+
+  // The header holds the type, size and mode needed to uncompress.
+  size_t cs = 0;
+  if (zfp_write_header(zfp, field, ZFP_HEADER_FULL))
+  {
+    cs = zfp_compress(zfp, field);
+  }
+  zfp_field_free(field);
+  zfp_stream_close(zfp);
+  stream_close(stream);
+
+  if (cs == 0 || cs + 1 > compressionSpace)
+  {
+    vtkErrorMacro("ZFP error while compressing data.");
+    return 0;
+  }
+  compressedData[0] = ZFPTag;
+  memcpy(compressedData + 1, buffer.data(), cs);
+  return cs + 1;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  if (compressedSize < 1)
+  {
+    vtkErrorMacro("Cannot uncompress an empty buffer.");
+    return 0;
+  }
+  if (compressedData[0] == LosslessTag)
+  {
+    return this->LosslessCompressor->Uncompress(
+      compressedData + 1, compressedSize - 1, uncompressedData, uncompressedSize);
+  }
+  if (compressedData[0] != ZFPTag)
+  {
+    vtkErrorMacro("Unknown compression of the buffer.");
+    return 0;
+  }
+
+  std::vector<StreamWord> buffer(NumberOfStreamWords(compressedSize - 1));
+  memcpy(buffer.data(), compressedData + 1, compressedSize - 1);
+  bitstream* stream = stream_open(buffer.data(), buffer.size() * sizeof(StreamWord));
+  zfp_stream* zfp = zfp_stream_open(stream);
+  zfp_field* field = zfp_field_alloc();
+
+  size_t us = 0;
+  if (zfp_read_header(zfp, field, ZFP_HEADER_FULL) &&
+    zfp_field_size(field, nullptr) * zfp_type_size(zfp_field_type(field)) == uncompressedSize)
+  {
+    zfp_field_set_pointer(field, uncompressedData);
+    if (zfp_decompress(zfp, field))
+    {
+      us = uncompressedSize;
+    }
+  }
+  zfp_field_free(field);
+  zfp_stream_close(zfp);
+  stream_close(stream);
+
+  if (us == 0)
+  {
+    vtkErrorMacro("ZFP error while uncompressing data.");
+  }
+  return us;
+}
+
+//----------------------------------------------------------------------------
+int vtkZFPDataCompressor::GetCompressionLevel()
+{
+  return this->LosslessCompressor->GetCompressionLevel();
+}
+
+//----------------------------------------------------------------------------
+void vtkZFPDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int previousLevel = this->LosslessCompressor->GetCompressionLevel();
+  this->LosslessCompressor->SetCompressionLevel(compressionLevel);
+  if (this->LosslessCompressor->GetCompressionLevel() != previousLevel)
+  {
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  size_t space = this->LosslessCompressor->GetMaximumCompressionSpace(size);
+  zfp_type type = GetZFPType(this->DataType);
+  size_t numValues = type != zfp_type_none ? size / zfp_type_size(type) : 0;
+  if (numValues > 0 && numValues <= VTK_UNSIGNED_INT_MAX)
+  {
+    zfp_field* field = zfp_field_1d(nullptr, type, static_cast<unsigned int>(numValues));
+    zfp_stream* zfp = zfp_stream_open(nullptr);
+    SetStreamMode(zfp, type, this);
+    // The bit streams are written by whole words.
+    size_t zfpSpace = NumberOfStreamWords(zfp_stream_maximum_size(zfp, field)) * sizeof(StreamWord);
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+    space = std::max(space, zfpSpace);
+  }
+  return space + 1;
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZFPDataCompressor
+ * @brief   Lossy data compression of floating point values using ZFP.
+ *
+ * vtkZFPDataCompressor provides a concrete vtkDataCompressor class using
+ * ZFP for compressing float and double values with loss. The type of the
+ * values of the buffers is given with SetDataType(). Buffers of VTK_FLOAT
+ * or VTK_DOUBLE values are compressed by ZFP in the fixed-rate,
+ * fixed-precision or fixed-accuracy mode, the buffers of any other type
+ * are compressed without loss by zlib. Each compressed buffer starts with
+ * a tag telling how it was compressed, and the ZFP streams embed their
+ * parameters, so buffers are uncompressed whatever the settings.
+ *
+ * @warning
+ * The values are compressed in the native byte order.
+ *
+ * @sa
+ * vtkZLibDataCompressor
+ */
+
+#ifndef vtkZFPDataCompressor_h
+#define vtkZFPDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+class vtkZLibDataCompressor;
+
+class VTKIOCORE_EXPORT vtkZFPDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZFPDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZFPDataCompressor* New();
+
+  /**
+   * Get the maximum space that may be needed to store data of the
+   * given uncompressed size after compression.  This is the minimum
+   * size of the output buffer that can be passed to the four-argument
+   * Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  //@{
+  /**
+   * Get/Set the compression level of the lossless compression.
+   */
+  int GetCompressionLevel() override;
+  void SetCompressionLevel(int compressionLevel) override;
+  //@}
+
+  //@{
+  /**
+   * Get/Set the type of the values of the buffers compressed next. Only the
+   * VTK_FLOAT and VTK_DOUBLE buffers are compressed with loss. The default
+   * is VTK_VOID, all the buffers are compressed without loss.
+   */
+  vtkSetMacro(DataType, int);
+  vtkGetMacro(DataType, int);
+  //@}
+
+  enum ModeType
+  {
+    FIXED_RATE,
+    FIXED_PRECISION,
+    FIXED_ACCURACY
+  };
+
+  //@{
+  /**
+   * Get/Set the ZFP mode. In the FIXED_RATE mode, each value is stored in
+   * Rate bits. In the FIXED_PRECISION mode, Precision bit planes of the
+   * values are kept. In the FIXED_ACCURACY mode, the absolute error is at
+   * most Tolerance. The default is FIXED_ACCURACY.
+   */
+  vtkSetClampMacro(Mode, int, FIXED_RATE, FIXED_ACCURACY);
+  vtkGetMacro(Mode, int);
+  void SetModeToFixedRate() { this->SetMode(FIXED_RATE); }
+  void SetModeToFixedPrecision() { this->SetMode(FIXED_PRECISION); }
+  void SetModeToFixedAccuracy() { this->SetMode(FIXED_ACCURACY); }
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of bits per value of the FIXED_RATE mode. The default
+   * is 16.
+   */
+  vtkSetClampMacro(Rate, double, 1.0, 64.0);
+  vtkGetMacro(Rate, double);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of bit planes of the FIXED_PRECISION mode. The
+   * default is 24.
+   */
+  vtkSetClampMacro(Precision, int, 1, 64);
+  vtkGetMacro(Precision, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the absolute error tolerance of the FIXED_ACCURACY mode. The
+   * default is 1e-6.
+   */
+  vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Tolerance, double);
+  //@}
+
+protected:
+  vtkZFPDataCompressor();
+  ~vtkZFPDataCompressor() override;
+
+  int DataType;
+  int Mode;
+  double Rate;
+  int Precision;
+  double Tolerance;
+  vtkZLibDataCompressor* LosslessCompressor;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZFPDataCompressor(const vtkZFPDataCompressor&) = delete;
+  void operator=(const vtkZFPDataCompressor&) = delete;
+};
+
+#endif
@@ -21,6 +21,7 @@ vtkStandardNewMacro(vtkZLibDataCompressor);
 //----------------------------------------------------------------------------
 vtkZLibDataCompressor::vtkZLibDataCompressor()
 {
+  this->ThreadSafe = true;
   this->CompressionLevel = Z_DEFAULT_COMPRESSION;
 }
 
@@ -0,0 +1,120 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtk_zstd.h"
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+namespace
+{
+// The Zstandard levels matching the compression levels 1 to 9.
+const int ZstdLevels[9] = { 1, 2, 3, 5, 7, 9, 12, 15, 19 };
+}
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->ThreadSafe = true;
+  this->ZstdLevel = 3;
+}
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ZstdLevel: " << this->ZstdLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // A context per call, the buffers may be compressed concurrently.
+  ZSTD_CCtx* context = ZSTD_createCCtx();
+  if (!context)
+  {
+    vtkErrorMacro("Zstandard error while creating a compression context.");
+    return 0;
+  }
+  ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, this->ZstdLevel);
+  ZSTD_CCtx_setParameter(context, ZSTD_c_contentSizeFlag, 0);
+  ZSTD_CCtx_setParameter(context, ZSTD_c_checksumFlag, 0);
+  ZSTD_CCtx_setParameter(context, ZSTD_c_dictIDFlag, 0);
+  size_t cs =
+    ZSTD_compress2(context, compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  ZSTD_freeCCtx(context);
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstandard error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  size_t us = ZSTD_decompress(uncompressedData, uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstandard error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//----------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  int compressionLevel = 1;
+  while (compressionLevel < 9 && ZstdLevels[compressionLevel - 1] < this->ZstdLevel)
+  {
+    ++compressionLevel;
+  }
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << compressionLevel);
+  return compressionLevel;
+}
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  // Accept the compressionLevel values 1..9 of vtkDataCompressor, 1 being the
+  // fastest and 9 the best compression.
+  compressionLevel = compressionLevel < 1 ? 1 : (compressionLevel > 9 ? 9 : compressionLevel);
+  this->SetZstdLevel(ZstdLevels[compressionLevel - 1]);
+}
+
+//----------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLBlockCompression.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the compressed blocks written and read concurrently give the
+// same file as with one thread, and the data written. The arrays selected
+// for the lossy compression are read within its tolerance. A compressor that
+// is not thread safe must only be called from one thread at a time.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkZFPDataCompressor.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+void MakeImage(vtkImageData* image)
+{
+  image->SetDimensions(40, 40, 40);
+  vtkIdType numPts = image->GetNumberOfPoints();
+
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("floats");
+  floats->SetNumberOfComponents(3);
+  floats->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  doubles->SetNumberOfTuples(numPts);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(numPts);
+  vtkNew<vtkUnsignedCharArray> chars;
+  chars->SetName("chars");
+  chars->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    float tuple[3] = { std::sin(0.01f * i), 0.5f, static_cast<float>(i) };
+    floats->SetTypedTuple(i, tuple);
+    doubles->SetValue(i, std::cos(0.001 * i));
+    ids->SetValue(i, i / 7);
+    chars->SetValue(i, static_cast<unsigned char>(i % 13));
+  }
+  image->GetPointData()->AddArray(floats);
+  image->GetPointData()->AddArray(doubles);
+  image->GetPointData()->AddArray(ids);
+  image->GetPointData()->AddArray(chars);
+}
+
+std::string Write(vtkImageData* image, int compressorType, int dataMode, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressorType);
+  writer->SetDataMode(dataMode);
+  writer->EncodeAppendedDataOff();
+  writer->SetBlockSize(4096);
+  writer->SetByteOrderToBigEndian();
+  writer->SetIdTypeToInt32();
+  if (compressorType == vtkXMLWriter::ZFP)
+  {
+    // The values are compressed with loss only in the byte order of the
+    // machine.
+#ifndef VTK_WORDS_BIGENDIAN
+    writer->SetByteOrderToLittleEndian();
+#endif
+    writer->AddLossyArray("doubles");
+    vtkZFPDataCompressor::SafeDownCast(writer->GetCompressor())->SetTolerance(1e-5);
+  }
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+// A zlib compressor that is not declared thread safe, and records the calls
+// made concurrently.
+class vtkSerialCompressor : public vtkZLibDataCompressor
+{
+public:
+  static vtkSerialCompressor* New();
+  vtkTypeMacro(vtkSerialCompressor, vtkZLibDataCompressor);
+
+  std::atomic<int> NumberOfCalls{ 0 };
+  std::atomic<bool> ConcurrentCalls{ false };
+
+protected:
+  vtkSerialCompressor() { this->ThreadSafeOff(); }
+
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override
+  {
+    if (++this->NumberOfCalls > 1)
+    {
+      this->ConcurrentCalls = true;
+    }
+    // Leave time for other threads to call the compressor.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    size_t size = this->Superclass::CompressBuffer(
+      uncompressedData, uncompressedSize, compressedData, compressionSpace);
+    --this->NumberOfCalls;
+    return size;
+  }
+};
+vtkStandardNewMacro(vtkSerialCompressor);
+
+bool TestSerialCompressor(vtkImageData* image)
+{
+  std::string files[2];
+  bool concurrentCalls = false;
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkSMPTools::Initialize(i == 0 ? 1 : 4);
+    vtkNew<vtkSerialCompressor> compressor;
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetInputData(image);
+    writer->WriteToOutputStringOn();
+    writer->SetCompressor(compressor);
+    writer->SetBlockSize(4096);
+    writer->Write();
+    files[i] = writer->GetOutputString();
+    concurrentCalls |= compressor->ConcurrentCalls;
+  }
+  if (concurrentCalls || files[0] != files[1])
+  {
+    std::cerr << "A compressor that is not thread safe was called concurrently\n";
+    return false;
+  }
+  return true;
+}
+
+bool SameData(vtkImageData* image, vtkImageData* read, const char* lossyArray)
+{
+  vtkPointData* expected = image->GetPointData();
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = expected->GetArray(i);
+    vtkDataArray* readArray = read->GetPointData()->GetArray(array->GetName());
+    if (!readArray || readArray->GetNumberOfValues() != array->GetNumberOfValues())
+    {
+      return false;
+    }
+    int numComps = array->GetNumberOfComponents();
+    double tolerance = lossyArray && !strcmp(array->GetName(), lossyArray) ? 1e-5 : 0.0;
+    double maxError = 0.0;
+    for (vtkIdType j = 0; j < array->GetNumberOfValues(); ++j)
+    {
+      maxError = std::max(maxError,
+        std::fabs(array->GetComponent(j / numComps, j % numComps) -
+          readArray->GetComponent(j / numComps, j % numComps)));
+    }
+    // The lossy array is not read exactly.
+    if (maxError > tolerance || (tolerance > 0.0 && maxError == 0.0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLBlockCompression(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image);
+  // The keys of the ranges cached by the first write appear in the next
+  // files, cache them beforehand.
+  Write(image, vtkXMLWriter::NONE, vtkXMLWriter::Appended, 1);
+
+  bool success = true;
+  const int compressors[] = { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA,
+    vtkXMLWriter::ZFP };
+  const int dataModes[] = { vtkXMLWriter::Appended, vtkXMLWriter::Binary };
+  for (int compressor : compressors)
+  {
+    for (int dataMode : dataModes)
+    {
+      std::string serial = Write(image, compressor, dataMode, 1);
+      std::string threaded = Write(image, compressor, dataMode, 4);
+      if (serial != threaded)
+      {
+        std::cerr << "Compressor " << compressor << ", data mode " << dataMode
+                  << ": the files written with 1 and 4 threads differ\n";
+        success = false;
+      }
+
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->ReadFromInputStringOn();
+      reader->SetInputString(threaded);
+      reader->Update();
+      const char* lossyArray = compressor == vtkXMLWriter::ZFP ? "doubles" : nullptr;
+      if (!SameData(image, reader->GetOutput(), lossyArray))
+      {
+        std::cerr << "Compressor " << compressor << ", data mode " << dataMode
+                  << ": wrong data read\n";
+        success = false;
+      }
+    }
+  }
+  success &= TestSerialCompressor(image);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMappedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the appended data used in place from the mapped files gives
+// the data written, in both byte orders, that it outlives the reader, and
+// that modifying the arrays leaves the file untouched.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTesting.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void MakeImage(vtkImageData* image)
+{
+  image->SetDimensions(30, 30, 30);
+  vtkIdType numPts = image->GetNumberOfPoints();
+
+  // The odd number of chars leaves the next arrays unaligned without the
+  // padding of the writer.
+  vtkNew<vtkUnsignedCharArray> chars;
+  chars->SetName("chars");
+  chars->SetNumberOfTuples(numPts);
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("floats");
+  floats->SetNumberOfComponents(3);
+  floats->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  doubles->SetNumberOfTuples(numPts);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    chars->SetValue(i, static_cast<unsigned char>(i % 13));
+    float tuple[3] = { std::sin(0.01f * i), 0.5f, static_cast<float>(i) };
+    floats->SetTypedTuple(i, tuple);
+    doubles->SetValue(i, std::cos(0.001 * i));
+    ids->SetValue(i, i / 7);
+  }
+  image->GetPointData()->AddArray(chars);
+  image->GetPointData()->AddArray(floats);
+  image->GetPointData()->AddArray(doubles);
+  image->GetPointData()->AddArray(ids);
+}
+
+bool SameData(vtkImageData* image, vtkImageData* read)
+{
+  vtkPointData* expected = image->GetPointData();
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = expected->GetArray(i);
+    vtkDataArray* readArray = read->GetPointData()->GetArray(array->GetName());
+    if (!readArray || readArray->GetNumberOfValues() != array->GetNumberOfValues())
+    {
+      return false;
+    }
+    int numComps = array->GetNumberOfComponents();
+    for (vtkIdType j = 0; j < array->GetNumberOfValues(); ++j)
+    {
+      if (array->GetComponent(j / numComps, j % numComps) !=
+        readArray->GetComponent(j / numComps, j % numComps))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkImageData> Read(const std::string& fileName, bool mapped)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(mapped);
+  reader->Update();
+  return reader->GetOutput();
+}
+}
+
+int TestXMLMemoryMappedData(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  std::string fileName = std::string(testing->GetTempDirectory()) + "/TestXMLMemoryMappedData.vti";
+
+  vtkNew<vtkImageData> image;
+  MakeImage(image);
+
+  bool success = true;
+  const int byteOrders[] = { vtkXMLWriter::LittleEndian, vtkXMLWriter::BigEndian };
+  for (int byteOrder : byteOrders)
+  {
+    for (int compressed = 0; compressed < 2; ++compressed)
+    {
+      vtkNew<vtkXMLImageDataWriter> writer;
+      writer->SetInputData(image);
+      writer->SetFileName(fileName.c_str());
+      writer->SetDataModeToAppended();
+      writer->EncodeAppendedDataOff();
+      writer->SetByteOrder(byteOrder);
+      writer->SetCompressorType(compressed ? vtkXMLWriter::ZLIB : vtkXMLWriter::NONE);
+      writer->Write();
+
+      // The arrays outlive the reader.
+      vtkSmartPointer<vtkImageData> read = Read(fileName, true);
+      if (!SameData(image, read))
+      {
+        std::cerr << "Byte order " << byteOrder << ", compressed " << compressed
+                  << ": wrong data read\n";
+        success = false;
+        continue;
+      }
+
+      vtkDataArray* doubles = read->GetPointData()->GetArray("doubles");
+      doubles->SetComponent(0, 0, -1.0);
+      read = Read(fileName, false);
+      if (!SameData(image, read))
+      {
+        std::cerr << "Byte order " << byteOrder << ", compressed " << compressed
+                  << ": the file was modified\n";
+        success = false;
+      }
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -42,7 +42,11 @@
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
+#include "vtkZFPDataCompressor.h"
 #include "vtkZLibDataCompressor.h"
+#if VTK_MODULE_ENABLE_VTK_zstd
+#include "vtkZstdDataCompressor.h"
+#endif
 
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
@@ -137,6 +141,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapAppendedData = 0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -227,6 +232,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << "," << this->TimeStepRange[1]
      << ")\n";
 }
@@ -448,6 +454,16 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+    else if (strcmp(type, "vtkZFPDataCompressor") == 0)
+    {
+      compressor = vtkZFPDataCompressor::New();
+    }
+#if VTK_MODULE_ENABLE_VTK_zstd
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -651,6 +667,14 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   // reads will work.
   (*this->Stream).imbue(std::locale::classic());
   this->XMLParser->SetStream(this->Stream);
+  if (this->MemoryMapAppendedData && !this->ReadFromInputString && this->XMLParser)
+  {
+    // Fall back on reading the data when the file cannot be mapped.
+    if (!this->XMLParser->MapFile(this->FileName))
+    {
+      vtkWarningMacro("Reading the data of " << this->FileName << " without mapping it.");
+    }
+  }
 
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
@@ -684,8 +708,13 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   // We have finished reading.
   this->UpdateProgressDiscrete(1);
 
-  // Close the input stream to prevent resource leaks.
+  // Close the input stream to prevent resource leaks. The arrays keep the
+  // mapped file as long as they use it.
   this->CloseStream();
+  if (this->XMLParser)
+  {
+    this->XMLParser->UnmapFile();
+  }
   if (this->TimeSteps)
   {
     // The SetupOutput should not reallocate this should be done only in a TimeStep case
@@ -842,18 +871,29 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
     return 0;
   }
   this->InReadData = 1;
-  int result;
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
+  int result = 0;
+  vtkTypeInt64 offset = 0;
+  if (this->MemoryMapAppendedData && arrayIndex == 0 && startIndex == 0 &&
+    numValues == array->GetNumberOfValues() && da->GetScalarAttribute("offset", offset))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    // The whole array is used in place when possible.
+    result = this->XMLParser->MapAppendedData(offset, array);
   }
-  if (iter)
+  if (!result)
   {
-    iter->Delete();
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser, arrayIndex,
+          static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -71,6 +71,20 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   //@}
 
+  //@{
+  /**
+   * Enable using the raw uncompressed appended data in place from the file
+   * mapped in memory, instead of reading it into the arrays. Only the pages
+   * of the values accessed are then read. The arrays of a piece read at
+   * once share the mapping, which is private, so the file should not be
+   * truncated while they are in use. Other data is read as usual. The
+   * default is off.
+   */
+  vtkSetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkGetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkBooleanMacro(MemoryMapAppendedData, vtkTypeBool);
+  //@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -312,6 +326,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether the appended data is used in place from the mapped file.
+  vtkTypeBool MemoryMapAppendedData;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
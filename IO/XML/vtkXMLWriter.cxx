@@ -44,10 +44,16 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkZFPDataCompressor.h"
 #include "vtkZLibDataCompressor.h"
+#if VTK_MODULE_ENABLE_VTK_zstd
+#include "vtkZstdDataCompressor.h"
+#endif
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef vtkXMLOffsetsManager_DoNotInclude
@@ -64,9 +70,11 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -472,6 +480,10 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; // 2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = nullptr;
+  this->CompressionBuffer = nullptr;
+  this->CompressionBufferBlockSizes = nullptr;
+  this->CompressionBufferCapacity = 0;
+  this->NumberOfBufferedBlocks = 0;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -552,6 +564,30 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#if VTK_MODULE_ENABLE_VTK_zstd
+    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZstdDataCompressor"))
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkWarningMacro("Zstandard compression requires VTK to be built with the VTK::zstd module.");
+#endif
+  }
+  else if (compressorType == ZFP)
+  {
+    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZFPDataCompressor"))
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZFPDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -576,6 +612,59 @@ void vtkXMLWriter::SetCompressionLevel(int compressionLevel)
     this->Modified();
   }
 }
+//----------------------------------------------------------------------------
+void vtkXMLWriter::AddLossyArray(const char* name)
+{
+  if (name && this->LossyArrays.insert(name).second)
+  {
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLWriter::RemoveAllLossyArrays()
+{
+  if (!this->LossyArrays.empty())
+  {
+    this->LossyArrays.clear();
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkXMLWriter::IsLossyArray(vtkAbstractArray* a)
+{
+  int wordType = a->GetDataType();
+  if ((wordType != VTK_FLOAT && wordType != VTK_DOUBLE) || !a->GetName())
+  {
+    return false;
+  }
+  // ZFP reads the values in the byte order of the machine.
+#ifdef VTK_WORDS_BIGENDIAN
+  if (this->ByteOrder != vtkXMLWriter::BigEndian)
+#else
+  if (this->ByteOrder != vtkXMLWriter::LittleEndian)
+#endif
+  {
+    return false;
+  }
+  if (!this->LossyArrays.empty() && this->LossyArrays.count(a->GetName()) == 0)
+  {
+    return false;
+  }
+  // The arrays written may be copies of the extent of a piece, they are
+  // found by name.
+  vtkDataSet* input = vtkDataSet::SafeDownCast(this->GetInput());
+  if (!input)
+  {
+    return false;
+  }
+  vtkAbstractArray* pointArray = input->GetPointData()->GetAbstractArray(a->GetName());
+  vtkAbstractArray* cellArray = input->GetCellData()->GetAbstractArray(a->GetName());
+  return (pointArray && pointArray->GetDataType() == wordType) ||
+    (cellArray && cellArray->GetDataType() == wordType);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -617,6 +706,12 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Compressor: (none)\n";
   }
+  os << indent << "LossyArrays:";
+  for (const std::string& name : this->LossyArrays)
+  {
+    os << " " << name;
+  }
+  os << "\n";
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
   if (this->Stream)
@@ -1294,6 +1389,11 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
 
   if (this->Compressor)
   {
+    if (vtkZFPDataCompressor* zfp = vtkZFPDataCompressor::SafeDownCast(this->Compressor))
+    {
+      zfp->SetDataType(this->IsLossyArray(a) ? wordType : VTK_VOID);
+    }
+
     // Need to compress the data.  Create compression header.  This
     // reserves enough space in the output.
     if (!this->CreateCompressionHeader(dataSize))
@@ -1309,6 +1409,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress the blocks still buffered.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1321,9 +1427,15 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
-    // Destroy the compression header if it was used.
+    // Destroy the compression header and buffers if they were used.
     delete this->CompressionHeader;
     this->CompressionHeader = nullptr;
+    delete[] this->CompressionBuffer;
+    this->CompressionBuffer = nullptr;
+    delete[] this->CompressionBufferBlockSizes;
+    this->CompressionBufferBlockSizes = nullptr;
+    this->CompressionBufferCapacity = 0;
+    this->NumberOfBufferedBlocks = 0;
 
     return result;
   }
@@ -1669,14 +1781,45 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
 
+  // The blocks are independent. With several threads and a thread safe
+  // compressor, they are buffered and compressed a few per thread at a time,
+  // then written in order, so that the output does not depend on the number
+  // of threads.
+  size_t numThreads = static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  if (numThreads > 1 && numBlocks > 1 && this->Compressor->GetThreadSafe())
+  {
+    this->CompressionBufferCapacity = std::min(numBlocks, 4 * numThreads);
+    this->CompressionBuffer = new unsigned char[this->CompressionBufferCapacity * this->BlockSize];
+    this->CompressionBufferBlockSizes = new size_t[this->CompressionBufferCapacity];
+  }
+  this->NumberOfBufferedBlocks = 0;
+
   return result;
 }
 
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  if (this->CompressionBuffer)
+  {
+    // Copy the block, the caller re-uses its buffer.
+    size_t index = this->NumberOfBufferedBlocks++;
+    memcpy(this->CompressionBuffer + index * this->BlockSize, data, size);
+    this->CompressionBufferBlockSizes[index] = size;
+    if (this->NumberOfBufferedBlocks == this->CompressionBufferCapacity)
+    {
+      return this->FlushCompressionBlocks();
+    }
+    return 1;
+  }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  if (!outputArray)
+  {
+    vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+    return 0;
+  }
 
   // Find the compressed size.
   size_t outputSize = outputArray->GetNumberOfTuples();
@@ -1698,6 +1841,52 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  size_t numBlocks = this->NumberOfBufferedBlocks;
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
+  this->NumberOfBufferedBlocks = 0;
+
+  // Compress the buffered blocks concurrently.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray> > outputArrays(numBlocks);
+  vtkDataCompressor* compressor = this->Compressor;
+  const unsigned char* buffer = this->CompressionBuffer;
+  const size_t* sizes = this->CompressionBufferBlockSizes;
+  const size_t blockSize = this->BlockSize;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1,
+    [&outputArrays, compressor, buffer, sizes, blockSize](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        outputArrays[i].TakeReference(compressor->Compress(buffer + i * blockSize, sizes[i]));
+      }
+    });
+
+  // Write the compressed blocks in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    if (!outputArrays[i])
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+      return 0;
+    }
+    size_t outputSize = outputArrays[i]->GetNumberOfTuples();
+    result = this->DataStream->Write(outputArrays[i]->GetPointer(0), outputSize);
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
+  this->Stream->flush();
+  if (this->Stream->fail())
+  {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
+  }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
@@ -2335,6 +2524,16 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  if (!this->EncodeAppendedData && !this->Compressor)
+  {
+    // Pad so that the raw values start on a multiple of 8 bytes in the file
+    // and can be used in place from a memory mapping by the readers.
+    ostream& os = *(this->Stream);
+    vtkTypeInt64 headerSize = this->HeaderType == vtkXMLWriter::UInt64 ? 8 : 4;
+    vtkTypeInt64 padding = (8 - (static_cast<vtkTypeInt64>(os.tellp()) + headerSize) % 8) % 8;
+    const char zeros[8] = { 0 };
+    os.write(zeros, padding);
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
@@ -21,6 +21,11 @@
  * subclasses provide actual writer implementations calling upon this
  * functionality.
  *
+ * When the data are compressed, each block of BlockSize bytes is compressed
+ * on its own. With several vtkSMPTools threads, the blocks of an array are
+ * compressed concurrently; the file written is the same whatever the
+ * number of threads.
+ *
  * @par Thanks
  * CompressionLevel getters/setters exposed by Quincy Wofford
  * (qwofford@lanl.gov) and John Patchett (patchett@lanl.gov),
@@ -33,7 +38,9 @@
 #include "vtkAlgorithm.h"
 #include "vtkIOXMLModule.h" // For export macro
 
+#include <set>     // For LossyArrays ivar
 #include <sstream> // For ostringstream ivar
+#include <string>  // For LossyArrays ivar
 
 class vtkAbstractArray;
 class vtkArrayIterator;
@@ -173,23 +180,41 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD,
+    ZFP
   };
 
   //@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD is only available when VTK is built with the VTK::zstd module.
+   * ZFP compresses the float and double arrays with loss, see AddLossyArray().
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
+  void SetCompressorTypeToZFP() { this->SetCompressorType(ZFP); }
 
   void SetCompressionLevel(int compressorLevel);
   vtkGetMacro(CompressionLevel, int);
   //@}
 
+  //@{
+  /**
+   * Add/Remove the names of the point and cell data arrays compressed with
+   * loss when the compressor is a vtkZFPDataCompressor. When no name was
+   * added, all the float and double point and cell data arrays are. The
+   * points, the cells and the arrays written in the byte order of the other
+   * machines are always compressed without loss.
+   */
+  void AddLossyArray(const char* name);
+  void RemoveAllLossyArrays();
+  //@}
+
   //@{
   /**
    * Get/Set the block size used in compression.  When reading, this
@@ -220,7 +245,9 @@ public:
    * encoded, reading and writing will be slower, but the file will be
    * fully valid XML and text-only.  If not encoded, the XML
    * specification will be violated, but reading and writing will be
-   * fast.  The default is to do the encoding.
+   * fast.  The default is to do the encoding.  Without encoding nor
+   * compression, the values of each array start on a multiple of 8 bytes
+   * in the file, so that readers can map them in memory.
    */
   vtkSetMacro(EncodeAppendedData, vtkTypeBool);
   vtkGetMacro(EncodeAppendedData, vtkTypeBool);
@@ -339,9 +366,20 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  // Blocks waiting to be compressed concurrently, CompressionBufferCapacity
+  // blocks of BlockSize bytes. Not allocated when compressing serially.
+  unsigned char* CompressionBuffer;
+  size_t* CompressionBufferBlockSizes;
+  size_t CompressionBufferCapacity;
+  size_t NumberOfBufferedBlocks;
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel = 5;
+  // Names of the arrays compressed with loss, all of them when empty.
+  std::set<std::string> LossyArrays;
+
+  // Whether the array is compressed with loss by a vtkZFPDataCompressor.
+  bool IsLossyArray(vtkAbstractArray* a);
 
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
@@ -462,6 +500,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -14,29 +14,134 @@
 =========================================================================*/
 #include "vtkXMLDataParser.h"
 
+#include "vtkAbstractArray.h"
 #include "vtkBase64InputStream.h"
 #include "vtkByteSwap.h"
 #include "vtkCommand.h"
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
 #include "vtkXMLUtilities.h"
 
+#if defined(_WIN32)
+#include "vtksys/Encoding.hxx"
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
 
+namespace
+{
+// The files mapped by the parsers, by address, with their length and the
+// number of parsers and arrays using them.
+struct MappedFileUsage
+{
+  size_t Length;
+  int References;
+};
+
+std::mutex MappedFilesMutex;
+std::map<char*, MappedFileUsage> MappedFiles;
+
+char* MapFileInMemory(const char* fileName, size_t& length)
+{
+  // Private copy-on-write mappings, the arrays may be modified.
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWide(fileName).c_str(), GENERIC_READ,
+    FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  char* data = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0 &&
+    static_cast<vtkTypeUInt64>(size.QuadPart) <= std::numeric_limits<size_t>::max())
+  {
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping)
+    {
+      data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+      CloseHandle(mapping);
+    }
+    length = static_cast<size_t>(size.QuadPart);
+  }
+  CloseHandle(file);
+  return data;
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  struct stat fs;
+  char* data = nullptr;
+  if (fstat(fd, &fs) == 0 && fs.st_size > 0 &&
+    static_cast<vtkTypeUInt64>(fs.st_size) <= std::numeric_limits<size_t>::max())
+  {
+    length = static_cast<size_t>(fs.st_size);
+    void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    data = ptr != MAP_FAILED ? static_cast<char*>(ptr) : nullptr;
+  }
+  close(fd);
+  return data;
+#endif
+}
+
+void AcquireMappedFile(char* data)
+{
+  std::lock_guard<std::mutex> lock(MappedFilesMutex);
+  ++MappedFiles[data].References;
+}
+
+// The free function of the arrays using a mapped file, given a pointer
+// inside the file.
+void ReleaseMappedFile(void* ptr)
+{
+  std::lock_guard<std::mutex> lock(MappedFilesMutex);
+  auto it = MappedFiles.upper_bound(static_cast<char*>(ptr));
+  if (it == MappedFiles.begin())
+  {
+    return;
+  }
+  --it;
+  if (--it->second.References == 0)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(it->first);
+#else
+    munmap(it->first, it->second.Length);
+#endif
+    MappedFiles.erase(it);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkXMLDataParser::vtkXMLDataParser()
 {
@@ -53,6 +158,8 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
   this->Compressor = nullptr;
+  this->MappedFile = nullptr;
+  this->MappedFileLength = 0;
 
   this->AsciiDataBuffer = nullptr;
   this->AsciiDataBufferLength = 0;
@@ -87,6 +194,7 @@ vtkXMLDataParser::~vtkXMLDataParser()
   delete[] this->BlockCompressedSizes;
   delete[] this->BlockStartOffsets;
   this->SetCompressor(nullptr);
+  this->UnmapFile();
   if (this->AsciiDataBuffer)
   {
     this->FreeAsciiBuffer();
@@ -638,6 +746,54 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock,
+  unsigned char* buffer, size_t wordSize)
+{
+  // The blocks are stored one after the other, read them all at once.
+  vtkTypeInt64 beginOffset = this->BlockStartOffsets[firstBlock];
+  size_t compressedSize = static_cast<size_t>(this->BlockStartOffsets[endBlock - 1] +
+    static_cast<vtkTypeInt64>(this->BlockCompressedSizes[endBlock - 1]) - beginOffset);
+  if (!this->DataStream->Seek(beginOffset))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  // Then decompress and byte swap them, concurrently if the compressor is
+  // thread safe.
+  std::atomic<bool> success(true);
+  auto uncompressBlocks = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      size_t uncompressedSize = this->FindBlockSize(block);
+      unsigned char* output = buffer + (block - firstBlock) * this->BlockUncompressedSize;
+      if (!this->Compressor->Uncompress(
+            readBuffer.data() + (this->BlockStartOffsets[block] - beginOffset),
+            this->BlockCompressedSizes[block], output, uncompressedSize))
+      {
+        success = false;
+        return;
+      }
+      this->PerformByteSwap(output, uncompressedSize / wordSize, wordSize);
+    }
+  };
+  if (this->Compressor->GetThreadSafe())
+  {
+    vtkSMPTools::For(
+      static_cast<vtkIdType>(firstBlock), static_cast<vtkIdType>(endBlock), 1, uncompressBlocks);
+  }
+  else
+  {
+    uncompressBlocks(static_cast<vtkIdType>(firstBlock), static_cast<vtkIdType>(endBlock));
+  }
+  return success ? 1 : 0;
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -810,21 +966,21 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in between a few per thread at a time, so
+    // that a thread safe compressor decompresses them concurrently.
+    vtkTypeUInt64 blocksPerRead = 4 * vtkSMPTools::GetEstimatedNumberOfThreads();
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock < lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      vtkTypeUInt64 endBlock = std::min(lastBlock, currentBlock + blocksPerRead);
+      if (!this->ReadBlocks(currentBlock, endBlock, outputPointer, wordSize))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += (endBlock - currentBlock) * blockSize;
+      currentBlock = endBlock;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -963,6 +1119,74 @@ size_t vtkXMLDataParser::ReadInlineData(vtkXMLDataElement* element, int isAscii,
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::MapFile(const char* fileName)
+{
+  this->UnmapFile();
+  size_t length = 0;
+  char* data = fileName ? MapFileInMemory(fileName, length) : nullptr;
+  if (!data)
+  {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(MappedFilesMutex);
+  MappedFiles[data] = MappedFileUsage{ length, 1 };
+  this->MappedFile = data;
+  this->MappedFileLength = length;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataParser::UnmapFile()
+{
+  if (this->MappedFile)
+  {
+    ReleaseMappedFile(this->MappedFile);
+    this->MappedFile = nullptr;
+    this->MappedFileLength = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::MapAppendedData(vtkTypeInt64 offset, vtkAbstractArray* array)
+{
+  if (!this->MappedFile || this->Compressor || !this->AppendedDataPosition ||
+    this->AppendedDataStream->IsA("vtkBase64InputStream") ||
+    array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate ||
+    array->GetNumberOfValues() == 0 || offset < 0)
+  {
+    return 0;
+  }
+
+  // Check that the header and the data are inside the file.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  vtkTypeUInt64 position = static_cast<vtkTypeUInt64>(this->AppendedDataPosition + offset);
+  if (position + headerSize > this->MappedFileLength)
+  {
+    return 0;
+  }
+  memcpy(uh->Data(), this->MappedFile + position, headerSize);
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+
+  size_t wordSize = this->GetWordTypeSize(array->GetDataType());
+  size_t numWords = static_cast<size_t>(array->GetNumberOfValues());
+  char* data = this->MappedFile + position + headerSize;
+  if (uh->Get(0) != numWords * wordSize ||
+    position + headerSize + numWords * wordSize > this->MappedFileLength ||
+    reinterpret_cast<uintptr_t>(data) % wordSize != 0)
+  {
+    return 0;
+  }
+
+  // The pages of swapped values are copied, the file is left untouched.
+  this->PerformByteSwap(data, numWords, wordSize);
+  AcquireMappedFile(this->MappedFile);
+  array->SetVoidArray(data, array->GetNumberOfValues(), 1);
+  array->SetArrayFreeFunction(ReleaseMappedFile);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadAppendedData(
   vtkTypeInt64 offset, void* buffer, vtkTypeUInt64 startWord, size_t numWords, int wordType)
@@ -22,6 +22,10 @@
  * representation is then used by vtkXMLReader and its subclasses to
  * traverse the structure of the file and extract data.
  *
+ * The blocks of compressed data are decompressed concurrently with
+ * vtkSMPTools. Raw uncompressed appended data can also be used in place
+ * from the file mapped in memory, see MapFile() and MapAppendedData().
+ *
  * @sa
  * vtkXMLDataElement
  */
@@ -33,6 +37,7 @@
 #include "vtkXMLDataElement.h"    //For inline definition.
 #include "vtkXMLParser.h"
 
+class vtkAbstractArray;
 class vtkInputStream;
 class vtkDataCompressor;
 
@@ -81,6 +86,28 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  //@{
+  /**
+   * Map the file of the parsed XML in memory, privately, so that
+   * MapAppendedData() can use its appended data in place. Returns 1 for
+   * okay, 0 for error. UnmapFile() releases the mapping of the parser,
+   * the arrays given the mapped data keep it alive until they release it.
+   */
+  int MapFile(const char* fileName);
+  void UnmapFile();
+  //@}
+
+  /**
+   * Make the values of the array the words of raw uncompressed appended
+   * data starting at the given appended data offset, in place in the file
+   * mapped by MapFile(). The array must be a vtkAOSDataArrayTemplate whose
+   * number of values is the number of words of the data, and the data must
+   * be aligned on the size of a word. The values are byte swapped in place
+   * when the byte order of the file is not the one of the machine. Returns
+   * 1 when the array uses the mapped data, 0 when the data has to be read.
+   */
+  int MapAppendedData(vtkTypeInt64 offset, vtkAbstractArray* array);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -186,6 +213,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer,
+    size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -232,6 +261,10 @@ protected:
   // The stream to use for appended data.
   vtkInputStream* AppendedDataStream;
 
+  // The file mapped by MapFile(), if any.
+  char* MappedFile;
+  size_t MappedFileLength;
+
   // Decompression data.
   vtkDataCompressor* Compressor;
   size_t NumberOfBlocks;
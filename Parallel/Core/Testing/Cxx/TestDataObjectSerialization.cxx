@@ -0,0 +1,635 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataObjectSerialization.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestDataObjectSerialization.cxx -- Test for vtkDataObjectSerializer
+//
+// .SECTION Description
+//  Round trips data objects of each supported type through the serializer,
+//  both buffer by buffer and packed by vtkCommunicator::MarshalDataObject.
+
+#include "vtkAMRBox.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObjectSerializer.h"
+#include "vtkDoubleArray.h"
+#include "vtkExplicitStructuredGrid.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkMutableDirectedGraph.h"
+#include "vtkMutableUndirectedGraph.h"
+#include "vtkNew.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkTree.h"
+#include "vtkUndirectedGraph.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVariantArray.h"
+
+#include <cstring>
+#include <string>
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: " #cond " failed at line " << __LINE__ << endl;                                \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Serializes and deserializes `object` as a communicator does it, filling
+// each buffer separately.
+vtkSmartPointer<vtkDataObject> RoundTripBuffers(vtkDataObject* object)
+{
+  vtkNew<vtkDataObjectSerializer> sender;
+  if (!sender->Serialize(object))
+  {
+    return nullptr;
+  }
+  vtkMultiProcessStream header = sender->GetHeader();
+  vtkNew<vtkDataObjectSerializer> receiver;
+  if (!receiver->BeginDeserialize(header) ||
+    receiver->GetNumberOfBuffers() != sender->GetNumberOfBuffers())
+  {
+    return nullptr;
+  }
+  for (int i = 0; i < sender->GetNumberOfBuffers(); ++i)
+  {
+    if (receiver->GetBufferType(i) != sender->GetBufferType(i) ||
+      receiver->GetBufferLength(i) != sender->GetBufferLength(i))
+    {
+      return nullptr;
+    }
+    memcpy(receiver->GetBufferPointer(i), sender->GetBufferPointer(i),
+      sender->GetBufferLength(i) *
+        vtkAbstractArray::GetDataTypeSize(sender->GetBufferType(i)));
+  }
+  return receiver->EndDeserialize();
+}
+
+//------------------------------------------------------------------------------
+// Same, through the packed buffer used for gathers.
+vtkSmartPointer<vtkDataObject> RoundTripMarshal(vtkDataObject* object)
+{
+  vtkNew<vtkCharArray> buffer;
+  if (!vtkCommunicator::MarshalDataObject(object, buffer) ||
+    !vtkDataObjectSerializer::IsMarshalled(buffer))
+  {
+    return nullptr;
+  }
+  return vtkCommunicator::UnMarshalDataObject(buffer);
+}
+
+//------------------------------------------------------------------------------
+bool CompareArrays(vtkAbstractArray* a, vtkAbstractArray* b)
+{
+  TEST_ASSERT(a && b);
+  TEST_ASSERT(a->GetDataType() == b->GetDataType());
+  TEST_ASSERT(a->GetNumberOfComponents() == b->GetNumberOfComponents());
+  TEST_ASSERT(a->GetNumberOfTuples() == b->GetNumberOfTuples());
+  TEST_ASSERT((a->GetName() == nullptr) == (b->GetName() == nullptr));
+  TEST_ASSERT(!a->GetName() || strcmp(a->GetName(), b->GetName()) == 0);
+  for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+  {
+    const char* nameA = a->GetComponentName(c);
+    const char* nameB = b->GetComponentName(c);
+    TEST_ASSERT((nameA == nullptr) == (nameB == nullptr));
+    TEST_ASSERT(!nameA || strcmp(nameA, nameB) == 0);
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    TEST_ASSERT(a->GetVariantValue(i) == b->GetVariantValue(i));
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareFieldData(vtkFieldData* a, vtkFieldData* b)
+{
+  TEST_ASSERT(a->GetNumberOfArrays() == b->GetNumberOfArrays());
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    if (!CompareArrays(a->GetAbstractArray(i), b->GetAbstractArray(i)))
+    {
+      return false;
+    }
+  }
+  vtkDataSetAttributes* dsaA = vtkDataSetAttributes::SafeDownCast(a);
+  vtkDataSetAttributes* dsaB = vtkDataSetAttributes::SafeDownCast(b);
+  if (dsaA && dsaB)
+  {
+    for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+    {
+      TEST_ASSERT(dsaA->IsArrayAnAttribute(i) == dsaB->IsArrayAnAttribute(i));
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareCellArrays(vtkCellArray* a, vtkCellArray* b)
+{
+  TEST_ASSERT(a->GetNumberOfCells() == b->GetNumberOfCells());
+  return a->GetNumberOfCells() == 0 ||
+    (CompareArrays(a->GetOffsetsArray(), b->GetOffsetsArray()) &&
+      CompareArrays(a->GetConnectivityArray(), b->GetConnectivityArray()));
+}
+
+//------------------------------------------------------------------------------
+bool ComparePoints(vtkPoints* a, vtkPoints* b)
+{
+  TEST_ASSERT((a == nullptr) == (b == nullptr));
+  return !a || CompareArrays(a->GetData(), b->GetData());
+}
+
+//------------------------------------------------------------------------------
+bool CompareDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  TEST_ASSERT(a->GetNumberOfPoints() == b->GetNumberOfPoints());
+  TEST_ASSERT(a->GetNumberOfCells() == b->GetNumberOfCells());
+  return CompareFieldData(a->GetPointData(), b->GetPointData()) &&
+    CompareFieldData(a->GetCellData(), b->GetCellData());
+}
+
+//------------------------------------------------------------------------------
+bool CompareDataObjects(vtkDataObject* a, vtkDataObject* b)
+{
+  TEST_ASSERT((a == nullptr) == (b == nullptr));
+  if (!a)
+  {
+    return true;
+  }
+  TEST_ASSERT(strcmp(a->GetClassName(), b->GetClassName()) == 0);
+  if (!CompareFieldData(a->GetFieldData(), b->GetFieldData()))
+  {
+    return false;
+  }
+
+  if (vtkDataSet* dsA = vtkDataSet::SafeDownCast(a))
+  {
+    vtkDataSet* dsB = vtkDataSet::SafeDownCast(b);
+    if (!CompareDataSets(dsA, dsB))
+    {
+      return false;
+    }
+    double boundsA[6], boundsB[6];
+    dsA->GetBounds(boundsA);
+    dsB->GetBounds(boundsB);
+    for (int i = 0; i < 6; ++i)
+    {
+      TEST_ASSERT(boundsA[i] == boundsB[i]);
+    }
+  }
+  if (vtkImageData* imageA = vtkImageData::SafeDownCast(a))
+  {
+    vtkImageData* imageB = vtkImageData::SafeDownCast(b);
+    for (int i = 0; i < 6; ++i)
+    {
+      TEST_ASSERT(imageA->GetExtent()[i] == imageB->GetExtent()[i]);
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+      TEST_ASSERT(imageA->GetDirectionMatrix()->GetData()[i] ==
+        imageB->GetDirectionMatrix()->GetData()[i]);
+    }
+  }
+  if (vtkPolyData* pdA = vtkPolyData::SafeDownCast(a))
+  {
+    vtkPolyData* pdB = vtkPolyData::SafeDownCast(b);
+    if (!ComparePoints(pdA->GetPoints(), pdB->GetPoints()) ||
+      !CompareCellArrays(pdA->GetVerts(), pdB->GetVerts()) ||
+      !CompareCellArrays(pdA->GetPolys(), pdB->GetPolys()))
+    {
+      return false;
+    }
+  }
+  if (vtkUnstructuredGrid* ugA = vtkUnstructuredGrid::SafeDownCast(a))
+  {
+    vtkUnstructuredGrid* ugB = vtkUnstructuredGrid::SafeDownCast(b);
+    if (!CompareCellArrays(ugA->GetCells(), ugB->GetCells()) ||
+      !CompareArrays(ugA->GetCellTypesArray(), ugB->GetCellTypesArray()) ||
+      !CompareArrays(ugA->GetFaces(), ugB->GetFaces()) ||
+      !CompareArrays(ugA->GetFaceLocations(), ugB->GetFaceLocations()))
+    {
+      return false;
+    }
+  }
+  if (vtkTable* tableA = vtkTable::SafeDownCast(a))
+  {
+    if (!CompareFieldData(tableA->GetRowData(), vtkTable::SafeDownCast(b)->GetRowData()))
+    {
+      return false;
+    }
+  }
+  if (vtkGraph* graphA = vtkGraph::SafeDownCast(a))
+  {
+    vtkGraph* graphB = vtkGraph::SafeDownCast(b);
+    TEST_ASSERT(graphA->GetNumberOfVertices() == graphB->GetNumberOfVertices());
+    TEST_ASSERT(graphA->GetNumberOfEdges() == graphB->GetNumberOfEdges());
+    for (vtkIdType e = 0; e < graphA->GetNumberOfEdges(); ++e)
+    {
+      TEST_ASSERT(graphA->GetSourceVertex(e) == graphB->GetSourceVertex(e));
+      TEST_ASSERT(graphA->GetTargetVertex(e) == graphB->GetTargetVertex(e));
+    }
+    if (!CompareFieldData(graphA->GetVertexData(), graphB->GetVertexData()) ||
+      !CompareFieldData(graphA->GetEdgeData(), graphB->GetEdgeData()))
+    {
+      return false;
+    }
+  }
+  if (vtkMultiBlockDataSet* mbA = vtkMultiBlockDataSet::SafeDownCast(a))
+  {
+    vtkMultiBlockDataSet* mbB = vtkMultiBlockDataSet::SafeDownCast(b);
+    TEST_ASSERT(mbA->GetNumberOfBlocks() == mbB->GetNumberOfBlocks());
+    for (unsigned int i = 0; i < mbA->GetNumberOfBlocks(); ++i)
+    {
+      TEST_ASSERT(mbA->HasMetaData(i) == mbB->HasMetaData(i));
+      if (mbA->HasMetaData(i))
+      {
+        TEST_ASSERT(strcmp(mbA->GetMetaData(i)->Get(vtkCompositeDataSet::NAME()),
+                      mbB->GetMetaData(i)->Get(vtkCompositeDataSet::NAME())) == 0);
+      }
+      if (!CompareDataObjects(mbA->GetBlock(i), mbB->GetBlock(i)))
+      {
+        return false;
+      }
+    }
+  }
+  if (vtkPartitionedDataSet* pA = vtkPartitionedDataSet::SafeDownCast(a))
+  {
+    vtkPartitionedDataSet* pB = vtkPartitionedDataSet::SafeDownCast(b);
+    TEST_ASSERT(pA->GetNumberOfPartitions() == pB->GetNumberOfPartitions());
+    for (unsigned int i = 0; i < pA->GetNumberOfPartitions(); ++i)
+    {
+      if (!CompareDataObjects(pA->GetPartitionAsDataObject(i), pB->GetPartitionAsDataObject(i)))
+      {
+        return false;
+      }
+    }
+  }
+  if (vtkPartitionedDataSetCollection* pdcA = vtkPartitionedDataSetCollection::SafeDownCast(a))
+  {
+    vtkPartitionedDataSetCollection* pdcB = vtkPartitionedDataSetCollection::SafeDownCast(b);
+    TEST_ASSERT(pdcA->GetNumberOfPartitionedDataSets() == pdcB->GetNumberOfPartitionedDataSets());
+    for (unsigned int i = 0; i < pdcA->GetNumberOfPartitionedDataSets(); ++i)
+    {
+      if (!CompareDataObjects(pdcA->GetPartitionedDataSet(i), pdcB->GetPartitionedDataSet(i)))
+      {
+        return false;
+      }
+    }
+  }
+  if (vtkOverlappingAMR* amrA = vtkOverlappingAMR::SafeDownCast(a))
+  {
+    vtkOverlappingAMR* amrB = vtkOverlappingAMR::SafeDownCast(b);
+    TEST_ASSERT(amrA->GetNumberOfLevels() == amrB->GetNumberOfLevels());
+    for (unsigned int level = 0; level < amrA->GetNumberOfLevels(); ++level)
+    {
+      TEST_ASSERT(amrA->GetNumberOfDataSets(level) == amrB->GetNumberOfDataSets(level));
+      TEST_ASSERT(amrA->GetRefinementRatio(level) == amrB->GetRefinementRatio(level));
+      for (unsigned int index = 0; index < amrA->GetNumberOfDataSets(level); ++index)
+      {
+        TEST_ASSERT(amrA->GetAMRBox(level, index) == amrB->GetAMRBox(level, index));
+        if (!CompareDataObjects(amrA->GetDataSet(level, index), amrB->GetDataSet(level, index)))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool RoundTrip(vtkDataObject* object)
+{
+  cout << "Testing " << (object ? object->GetClassName() : "nullptr") << endl;
+  return CompareDataObjects(object, RoundTripBuffers(object)) &&
+    CompareDataObjects(object, RoundTripMarshal(object));
+}
+
+//------------------------------------------------------------------------------
+void AddArrays(vtkDataSet* dataSet)
+{
+  const vtkIdType numberOfPoints = dataSet->GetNumberOfPoints();
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkSOADataArrayTemplate<double> > vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetComponentName(1, "Y");
+  vectors->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bits");
+  bits->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    scalars->SetValue(i, static_cast<float>(i) / 3);
+    vectors->SetTuple3(i, i, 2 * i, 3 * i);
+    bits->SetValue(i, i % 3 == 0);
+  }
+  dataSet->GetPointData()->SetScalars(scalars);
+  dataSet->GetPointData()->SetVectors(vectors);
+  dataSet->GetPointData()->AddArray(bits);
+
+  const vtkIdType numberOfCells = dataSet->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(numberOfCells);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfTuples(numberOfCells);
+  for (vtkIdType i = 0; i < numberOfCells; ++i)
+  {
+    ids->SetValue(i, 1000 + i);
+    labels->SetValue(i, "cell " + std::to_string(i));
+  }
+  dataSet->GetCellData()->SetGlobalIds(ids);
+  dataSet->GetCellData()->AddArray(labels);
+
+  vtkNew<vtkStringArray> note;
+  note->SetName("Note");
+  note->InsertNextValue("field data");
+  dataSet->GetFieldData()->AddArray(note);
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(1, 1, 0);
+  points->InsertNextPoint(0, 1, 1);
+  vtkNew<vtkCellArray> polys;
+  vtkIdType quad[4] = { 0, 1, 2, 3 };
+  polys->InsertNextCell(4, quad);
+  polys->InsertNextCell(3, quad);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell(1, quad + 3);
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+  polyData->SetVerts(verts);
+  AddArrays(polyData);
+  return polyData;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid()
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; ++i)
+  {
+    points->InsertNextPoint(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  vtkIdType tetra[4] = { 0, 1, 2, 4 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  // A pyramid given as a polyhedron, to serialize faces.
+  vtkIdType pyramid[5] = { 0, 1, 3, 2, 7 };
+  vtkIdType faces[] = { 4, 0, 1, 3, 2, 3, 0, 1, 7, 3, 1, 3, 7, 3, 3, 2, 7, 3, 2, 0, 7 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 5, pyramid, 5, faces);
+  AddArrays(grid);
+  return grid;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> MakeImageData()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(2, 5, -1, 1, 0, 0);
+  image->SetOrigin(1, 2, 3);
+  image->SetSpacing(0.5, 0.25, 1);
+  image->SetDirectionMatrix(0, -1, 0, 1, 0, 0, 0, 0, 1);
+  AddArrays(image);
+  return image;
+}
+
+//------------------------------------------------------------------------------
+bool TestDataSets()
+{
+  vtkNew<vtkRectilinearGrid> rectilinear;
+  rectilinear->SetExtent(0, 2, 0, 1, 0, 0);
+  vtkNew<vtkDoubleArray> x;
+  x->InsertNextValue(0);
+  x->InsertNextValue(1);
+  x->InsertNextValue(3);
+  vtkNew<vtkFloatArray> y;
+  y->InsertNextValue(-1);
+  y->InsertNextValue(1);
+  vtkNew<vtkFloatArray> z;
+  z->InsertNextValue(0);
+  rectilinear->SetXCoordinates(x);
+  rectilinear->SetYCoordinates(y);
+  rectilinear->SetZCoordinates(z);
+  AddArrays(rectilinear);
+
+  vtkNew<vtkStructuredGrid> structured;
+  structured->SetExtent(0, 1, 0, 1, 3, 3);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->InsertNextPoint(0, 0, 3);
+  points->InsertNextPoint(1, 0, 3);
+  points->InsertNextPoint(0, 1, 3);
+  points->InsertNextPoint(1, 2, 3);
+  structured->SetPoints(points);
+  AddArrays(structured);
+
+  vtkNew<vtkExplicitStructuredGrid> explicitGrid;
+  explicitGrid->SetDimensions(2, 2, 2);
+  vtkNew<vtkPoints> hexPoints;
+  for (int i = 0; i < 8; ++i)
+  {
+    hexPoints->InsertNextPoint(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+  }
+  vtkNew<vtkCellArray> hexes;
+  vtkIdType hex[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  hexes->InsertNextCell(8, hex);
+  explicitGrid->SetPoints(hexPoints);
+  explicitGrid->SetCells(hexes);
+  AddArrays(explicitGrid);
+
+  vtkNew<vtkUniformGrid> uniform;
+  uniform->ShallowCopy(MakeImageData());
+
+  vtkNew<vtkPolyData> empty;
+
+  return RoundTrip(MakePolyData()) && RoundTrip(MakeUnstructuredGrid()) &&
+    RoundTrip(MakeImageData()) && RoundTrip(uniform) && RoundTrip(rectilinear) &&
+    RoundTrip(structured) && RoundTrip(explicitGrid) && RoundTrip(empty);
+}
+
+//------------------------------------------------------------------------------
+bool TestTablesAndGraphs()
+{
+  vtkNew<vtkTable> table;
+  vtkNew<vtkIntArray> column;
+  column->SetName("Column");
+  column->InsertNextValue(4);
+  column->InsertNextValue(2);
+  table->AddColumn(column);
+
+  vtkNew<vtkMutableDirectedGraph> builder;
+  builder->SetNumberOfVertices(4);
+  builder->AddEdge(0, 1);
+  builder->AddEdge(0, 2);
+  builder->AddEdge(2, 3);
+  vtkNew<vtkIntArray> weights;
+  weights->SetName("Weights");
+  weights->InsertNextValue(3);
+  weights->InsertNextValue(5);
+  weights->InsertNextValue(7);
+  builder->GetEdgeData()->AddArray(weights);
+  vtkNew<vtkTree> tree;
+  TEST_ASSERT(tree->CheckedShallowCopy(builder));
+
+  vtkNew<vtkMutableUndirectedGraph> undirected;
+  undirected->SetNumberOfVertices(3);
+  undirected->AddEdge(0, 1);
+  undirected->AddEdge(1, 2);
+  undirected->AddEdge(2, 0);
+  vtkNew<vtkStringArray> names;
+  names->SetName("Names");
+  names->InsertNextValue("a");
+  names->InsertNextValue("b");
+  names->InsertNextValue("c");
+  undirected->GetVertexData()->AddArray(names);
+  vtkNew<vtkUndirectedGraph> graph;
+  TEST_ASSERT(graph->CheckedShallowCopy(undirected));
+
+  return RoundTrip(table) && RoundTrip(tree) && RoundTrip(graph);
+}
+
+//------------------------------------------------------------------------------
+bool TestComposites()
+{
+  vtkNew<vtkMultiPieceDataSet> pieces;
+  pieces->SetNumberOfPieces(3);
+  pieces->SetPiece(0, MakeUnstructuredGrid());
+  pieces->SetPiece(2, MakePolyData());
+
+  vtkNew<vtkMultiBlockDataSet> nested;
+  nested->SetBlock(0, MakeImageData());
+
+  vtkNew<vtkMultiBlockDataSet> multiBlock;
+  multiBlock->SetNumberOfBlocks(4);
+  multiBlock->SetBlock(0, MakePolyData());
+  multiBlock->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+  multiBlock->SetBlock(2, pieces);
+  multiBlock->SetBlock(3, nested);
+  multiBlock->GetMetaData(3u)->Set(vtkCompositeDataSet::NAME(), "nested");
+
+  vtkNew<vtkPartitionedDataSet> partitioned;
+  partitioned->SetPartition(0, MakePolyData());
+  partitioned->SetPartition(1, MakeUnstructuredGrid());
+  vtkNew<vtkPartitionedDataSetCollection> collection;
+  collection->SetPartitionedDataSet(0, partitioned);
+  collection->SetPartitionedDataSet(1, partitioned);
+
+  return RoundTrip(multiBlock) && RoundTrip(collection);
+}
+
+//------------------------------------------------------------------------------
+bool TestAMR()
+{
+  const int blocksPerLevel[2] = { 1, 1 };
+  const double origin[3] = { 0, 0, 0 };
+  vtkNew<vtkOverlappingAMR> amr;
+  amr->Initialize(2, blocksPerLevel);
+  amr->SetOrigin(origin);
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    const double h = 1.0 / (1 << level);
+    const double spacing[3] = { h, h, h };
+    amr->SetSpacing(level, spacing);
+    const int lo[3] = { 0, 0, 0 };
+    const int hi[3] = { 3, 3, 3 };
+    vtkAMRBox box(lo, hi);
+    amr->SetAMRBox(level, 0, box);
+
+    vtkNew<vtkUniformGrid> grid;
+    grid->SetOrigin(origin);
+    grid->SetSpacing(spacing);
+    grid->SetDimensions(5, 5, 5);
+    AddArrays(grid);
+    amr->SetDataSet(level, 0, grid);
+  }
+  amr->SetRefinementRatio(0, 2);
+  amr->SetRefinementRatio(1, 2);
+  return RoundTrip(amr);
+}
+
+//------------------------------------------------------------------------------
+bool TestUnsupported()
+{
+  // vtkVariantArray is not supported by the serializer: marshalling falls
+  // back to the legacy writers.
+  vtkNew<vtkTable> table;
+  vtkNew<vtkVariantArray> variants;
+  variants->SetName("Variants");
+  variants->InsertNextValue(vtkVariant(1));
+  variants->InsertNextValue(vtkVariant("two"));
+  table->AddColumn(variants);
+
+  vtkNew<vtkDataObjectSerializer> serializer;
+  TEST_ASSERT(!serializer->Serialize(table));
+  vtkNew<vtkCharArray> buffer;
+  TEST_ASSERT(vtkCommunicator::MarshalDataObject(table, buffer));
+  TEST_ASSERT(!vtkDataObjectSerializer::IsMarshalled(buffer));
+  vtkSmartPointer<vtkDataObject> received = vtkCommunicator::UnMarshalDataObject(buffer);
+  TEST_ASSERT(vtkTable::SafeDownCast(received));
+  TEST_ASSERT(vtkTable::SafeDownCast(received)->GetNumberOfRows() == 2);
+  return RoundTrip(nullptr);
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataObjectSerialization(int argc, char* argv[])
+{
+  // Resolve compiler warnings about unused vars
+  static_cast<void>(argc);
+  static_cast<void>(argv);
+
+  bool success = TestDataSets() && TestTablesAndGraphs() && TestComposites() && TestAMR() &&
+    TestUnsupported();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
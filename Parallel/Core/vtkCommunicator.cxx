@@ -17,6 +17,7 @@
 #include "vtkBoundingBox.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataObjectSerializer.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDataSetReader.h"
@@ -47,6 +48,13 @@
 
 #define EXTENT_HEADER_SIZE 128
 
+// Marshals through vtkGenericDataObjectWriter, for the data objects
+// vtkDataObjectSerializer cannot handle.
+static int vtkCommunicatorMarshalWithWriter(vtkDataObject* object, vtkCharArray* buffer);
+
+// Shallow copies a received data object in the one given by the caller.
+static int vtkCommunicatorCopyDataObject(vtkDataObject* source, vtkDataObject* object);
+
 //=============================================================================
 // Functions and classes that perform the default reduction operations.
 #define STANDARD_OPERATION_DEFINITION(name, op)                                                    \
@@ -178,11 +186,10 @@ int vtkCommunicator::Send(vtkDataObject* data, int remoteHandle, int tag)
     case VTK_DATA_SET:
     case VTK_PIECEWISE_FUNCTION:
     case VTK_POINT_SET:
-    case VTK_UNIFORM_GRID:
     case VTK_GENERIC_DATA_SET:
     case VTK_HYPER_OCTREE:
     case VTK_COMPOSITE_DATA_SET:
-    case VTK_HIERARCHICAL_BOX_DATA_SET: // since we cannot send vtkUniformGrid anyways.
+    case VTK_HIERARCHICAL_BOX_DATA_SET: // obsolete
     case VTK_MULTIGROUP_DATA_SET:       // obsolete
     case VTK_HIERARCHICAL_DATA_SET:     // obsolete
     default:
@@ -203,6 +210,14 @@ int vtkCommunicator::Send(vtkDataObject* data, int remoteHandle, int tag)
     case VTK_MULTIBLOCK_DATA_SET:
     case VTK_UNIFORM_GRID_AMR:
     case VTK_OVERLAPPING_AMR:
+    case VTK_UNIFORM_GRID:
+    case VTK_EXPLICIT_STRUCTURED_GRID:
+    case VTK_PATH:
+    case VTK_DIRECTED_ACYCLIC_GRAPH:
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+    case VTK_NON_OVERLAPPING_AMR:
       return this->SendElementalDataObject(data, remoteHandle, tag);
   }
 }
@@ -210,8 +225,34 @@ int vtkCommunicator::Send(vtkDataObject* data, int remoteHandle, int tag)
 //----------------------------------------------------------------------------
 int vtkCommunicator::SendElementalDataObject(vtkDataObject* data, int remoteHandle, int tag)
 {
+  // Send the header of the serialized object, then its arrays straight from
+  // their memory. Objects the serializer does not handle go through the
+  // legacy writers instead.
+  vtkNew<vtkDataObjectSerializer> serializer;
+  int binary = serializer->Serialize(data) ? 1 : 0;
+  if (!this->Send(&binary, 1, remoteHandle, tag))
+  {
+    return 0;
+  }
+  if (binary)
+  {
+    if (!this->Send(serializer->GetHeader(), remoteHandle, tag))
+    {
+      return 0;
+    }
+    for (int i = 0; i < serializer->GetNumberOfBuffers(); ++i)
+    {
+      if (!this->SendVoidArray(serializer->GetBufferPointer(i), serializer->GetBufferLength(i),
+            serializer->GetBufferType(i), remoteHandle, tag))
+      {
+        return 0;
+      }
+    }
+    return 1;
+  }
+
   VTK_CREATE(vtkCharArray, buffer);
-  if (vtkCommunicator::MarshalDataObject(data, buffer))
+  if (vtkCommunicatorMarshalWithWriter(data, buffer))
   {
     return this->Send(buffer, remoteHandle, tag);
   }
@@ -370,11 +411,10 @@ int vtkCommunicator::ReceiveDataObject(vtkDataObject* data, int remoteHandle, in
     case VTK_DATA_SET:
     case VTK_PIECEWISE_FUNCTION:
     case VTK_POINT_SET:
-    case VTK_UNIFORM_GRID:
     case VTK_GENERIC_DATA_SET:
     case VTK_HYPER_OCTREE:
     case VTK_COMPOSITE_DATA_SET:
-    case VTK_HIERARCHICAL_BOX_DATA_SET: // since we cannot send vtkUniformGrid anyways.
+    case VTK_HIERARCHICAL_BOX_DATA_SET: // obsolete
     case VTK_MULTIGROUP_DATA_SET:       // obsolete.
     case VTK_HIERARCHICAL_DATA_SET:     // obsolete.
     default:
@@ -396,6 +436,14 @@ int vtkCommunicator::ReceiveDataObject(vtkDataObject* data, int remoteHandle, in
     case VTK_MULTIBLOCK_DATA_SET:
     case VTK_UNIFORM_GRID_AMR:
     case VTK_OVERLAPPING_AMR:
+    case VTK_UNIFORM_GRID:
+    case VTK_EXPLICIT_STRUCTURED_GRID:
+    case VTK_PATH:
+    case VTK_DIRECTED_ACYCLIC_GRAPH:
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+    case VTK_NON_OVERLAPPING_AMR:
       return this->ReceiveElementalDataObject(data, remoteHandle, tag);
   }
 }
@@ -403,6 +451,31 @@ int vtkCommunicator::ReceiveDataObject(vtkDataObject* data, int remoteHandle, in
 //----------------------------------------------------------------------------
 int vtkCommunicator::ReceiveElementalDataObject(vtkDataObject* data, int remoteHandle, int tag)
 {
+  int binary = 0;
+  if (!this->Receive(&binary, 1, remoteHandle, tag))
+  {
+    return 0;
+  }
+  if (binary)
+  {
+    // Receive the arrays directly in the memory of the new object.
+    vtkMultiProcessStream header;
+    vtkNew<vtkDataObjectSerializer> serializer;
+    if (!this->Receive(header, remoteHandle, tag) || !serializer->BeginDeserialize(header))
+    {
+      return 0;
+    }
+    for (int i = 0; i < serializer->GetNumberOfBuffers(); ++i)
+    {
+      if (!this->ReceiveVoidArray(serializer->GetBufferPointer(i), serializer->GetBufferLength(i),
+            serializer->GetBufferType(i), remoteHandle, tag))
+      {
+        return 0;
+      }
+    }
+    return vtkCommunicatorCopyDataObject(serializer->EndDeserialize(), data);
+  }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (!this->Receive(buffer, remoteHandle, tag))
   {
@@ -511,6 +584,19 @@ int vtkCommunicator::MarshalDataObject(vtkDataObject* object, vtkCharArray* buff
     return 1;
   }
 
+  if (vtkDataObjectSerializer::Marshal(object, buffer))
+  {
+    return 1;
+  }
+  return vtkCommunicatorMarshalWithWriter(object, buffer);
+}
+
+//-----------------------------------------------------------------------------
+static int vtkCommunicatorMarshalWithWriter(vtkDataObject* object, vtkCharArray* buffer)
+{
+  buffer->Initialize();
+  buffer->SetNumberOfComponents(1);
+
   VTK_CREATE(vtkGenericDataObjectWriter, writer);
 
   vtkSmartPointer<vtkDataObject> copy;
@@ -581,14 +667,19 @@ int vtkCommunicator::UnMarshalDataObject(vtkCharArray* buffer, vtkDataObject* ob
     vtkGenericWarningMacro("Invalid 'object'!");
     return 0;
   }
-  vtkSmartPointer<vtkDataObject> dobj = vtkCommunicator::UnMarshalDataObject(buffer);
-  if (dobj)
+  return vtkCommunicatorCopyDataObject(vtkCommunicator::UnMarshalDataObject(buffer), object);
+}
+
+//-----------------------------------------------------------------------------
+static int vtkCommunicatorCopyDataObject(vtkDataObject* source, vtkDataObject* object)
+{
+  if (source)
   {
-    if (!dobj->IsA(object->GetClassName()))
+    if (!source->IsA(object->GetClassName()))
     {
       vtkGenericWarningMacro("Type mismatch while unmarshalling data.");
     }
-    object->ShallowCopy(dobj);
+    object->ShallowCopy(source);
   }
   else
   {
@@ -605,6 +696,10 @@ vtkSmartPointer<vtkDataObject> vtkCommunicator::UnMarshalDataObject(vtkCharArray
   {
     return nullptr;
   }
+  if (vtkDataObjectSerializer::IsMarshalled(buffer))
+  {
+    return vtkDataObjectSerializer::UnMarshal(buffer);
+  }
 
   // You would think that the extent information would be properly saved, but
   // no, it is not.
@@ -823,10 +918,49 @@ int vtkCommunicator::BroadcastVoidArray(void* data, vtkIdType length, int type,
 //-----------------------------------------------------------------------------
 int vtkCommunicator::Broadcast(vtkDataObject* data, int srcProcessId)
 {
+  // As in SendElementalDataObject, broadcast a header then each array.
+  vtkNew<vtkDataObjectSerializer> serializer;
+  int binary = 0;
+  if (this->LocalProcessId == srcProcessId)
+  {
+    binary = serializer->Serialize(data) ? 1 : 0;
+  }
+  if (!this->Broadcast(&binary, 1, srcProcessId))
+  {
+    return 0;
+  }
+  if (binary)
+  {
+    vtkMultiProcessStream received;
+    vtkMultiProcessStream& header =
+      this->LocalProcessId == srcProcessId ? serializer->GetHeader() : received;
+    if (!this->Broadcast(header, srcProcessId))
+    {
+      return 0;
+    }
+    if (this->LocalProcessId != srcProcessId && !serializer->BeginDeserialize(header))
+    {
+      return 0;
+    }
+    for (int i = 0; i < serializer->GetNumberOfBuffers(); ++i)
+    {
+      if (!this->BroadcastVoidArray(serializer->GetBufferPointer(i),
+            serializer->GetBufferLength(i), serializer->GetBufferType(i), srcProcessId))
+      {
+        return 0;
+      }
+    }
+    if (this->LocalProcessId == srcProcessId)
+    {
+      return 1;
+    }
+    return vtkCommunicatorCopyDataObject(serializer->EndDeserialize(), data);
+  }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (this->LocalProcessId == srcProcessId)
   {
-    if (vtkCommunicator::MarshalDataObject(data, buffer))
+    if (vtkCommunicatorMarshalWithWriter(data, buffer))
     {
       return this->Broadcast(buffer, srcProcessId);
     }
@@ -1113,11 +1247,10 @@ int vtkCommunicator::GatherV(
     case VTK_DATA_SET:
     case VTK_PIECEWISE_FUNCTION:
     case VTK_POINT_SET:
-    case VTK_UNIFORM_GRID:
     case VTK_GENERIC_DATA_SET:
     case VTK_HYPER_OCTREE:
     case VTK_COMPOSITE_DATA_SET:
-    case VTK_HIERARCHICAL_BOX_DATA_SET: // since we cannot send vtkUniformGrid anyways.
+    case VTK_HIERARCHICAL_BOX_DATA_SET: // obsolete
     case VTK_MULTIGROUP_DATA_SET:       // obsolete
     case VTK_HIERARCHICAL_DATA_SET:     // obsolete
     default:
@@ -1138,6 +1271,14 @@ int vtkCommunicator::GatherV(
     case VTK_MULTIBLOCK_DATA_SET:
     case VTK_UNIFORM_GRID_AMR:
     case VTK_OVERLAPPING_AMR:
+    case VTK_UNIFORM_GRID:
+    case VTK_EXPLICIT_STRUCTURED_GRID:
+    case VTK_PATH:
+    case VTK_DIRECTED_ACYCLIC_GRAPH:
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+    case VTK_NON_OVERLAPPING_AMR:
 
     case -1:
       return this->GatherVElementalDataObject(sendData, receiveData, destProcessId);
@@ -128,6 +128,9 @@ public:
    * This method sends a data object to a destination.
    * Tag eliminates ambiguity
    * and is used to match sends to receives.
+   * Types supported by vtkDataObjectSerializer are sent as a small header
+   * followed by the memory of each of their arrays, without being copied
+   * into an intermediate buffer.
    */
   int Send(vtkDataObject* data, int remoteHandle, int tag);
 
@@ -1265,7 +1268,9 @@ public:
   /**
    * Convert a data object into a string that can be transmitted and vice versa.
    * Returns 1 for success and 0 for failure.
-   * WARNING: This will only work for types that have a vtkDataWriter class.
+   * Types supported by vtkDataObjectSerializer are packed in binary, with
+   * their arrays copied as is. Other types go through the legacy writers,
+   * which only works for types that have a vtkDataWriter class.
    */
   static int MarshalDataObject(vtkDataObject* object, vtkCharArray* buffer);
   static int UnMarshalDataObject(vtkCharArray* buffer, vtkDataObject* object);
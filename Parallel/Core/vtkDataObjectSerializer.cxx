@@ -0,0 +1,1486 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataObjectSerializer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataObjectSerializer.h"
+
+#include "vtkAMRBox.h"
+#include "vtkAMRInformation.h"
+#include "vtkBitArray.h"
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDirectedGraph.h"
+#include "vtkDoubleArray.h"
+#include "vtkExplicitStructuredGrid.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkMutableDirectedGraph.h"
+#include "vtkMutableUndirectedGraph.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkObjectFactory.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Version of the header layout, bumped whenever it changes.
+const int HeaderVersion = 1;
+
+// Layout of the buffers packed by Marshal():
+//   magic (8 bytes) | big endian flag (1) | sizeof(vtkIdType) (1) | unused (6) |
+//   header size (8) | header, padded to 8 bytes | each buffer, padded to 8 bytes
+const char MarshalMagic[8] = { 'v', 't', 'k', 'D', 'O', 'S', 'e', 'r' };
+const size_t MarshalPreambleSize = 24;
+const size_t MarshalAlignment = 8;
+
+size_t PadToAlignment(size_t size)
+{
+  return (size + MarshalAlignment - 1) / MarshalAlignment * MarshalAlignment;
+}
+
+struct Buffer
+{
+  void* Pointer;
+  vtkIdType Length;
+  int Type;
+};
+
+//----------------------------------------------------------------------------
+template <typename MutableGraphT>
+bool BuildGraph(vtkGraph* graph, vtkIdType numberOfVertices, vtkIdTypeArray* edges,
+  vtkPoints* points, vtkIdTypeArray* edgePointCounts, vtkDoubleArray* edgePoints,
+  vtkDataSetAttributes* vertexData, vtkDataSetAttributes* edgeData)
+{
+  vtkNew<MutableGraphT> builder;
+  builder->SetNumberOfVertices(numberOfVertices);
+  const vtkIdType numberOfEdges = edges ? edges->GetNumberOfTuples() : 0;
+  for (vtkIdType e = 0; e < numberOfEdges; ++e)
+  {
+    builder->AddEdge(edges->GetTypedComponent(e, 0), edges->GetTypedComponent(e, 1));
+  }
+  if (edgePointCounts && edgePoints)
+  {
+    const double* coordinates = edgePoints->GetPointer(0);
+    for (vtkIdType e = 0; e < numberOfEdges; ++e)
+    {
+      const vtkIdType count = edgePointCounts->GetValue(e);
+      if (count > 0)
+      {
+        builder->SetEdgePoints(e, count, coordinates);
+        coordinates += 3 * count;
+      }
+    }
+  }
+  if (points)
+  {
+    builder->SetPoints(points);
+  }
+  builder->GetVertexData()->ShallowCopy(vertexData);
+  builder->GetEdgeData()->ShallowCopy(edgeData);
+
+  // Keep the field data already read into the graph, the copy replaces it.
+  vtkNew<vtkFieldData> fieldData;
+  fieldData->ShallowCopy(graph->GetFieldData());
+  if (!graph->CheckedShallowCopy(builder))
+  {
+    return false;
+  }
+  graph->GetFieldData()->ShallowCopy(fieldData);
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+class vtkDataObjectSerializer::vtkInternals
+{
+public:
+  vtkMultiProcessStream Header;
+  std::vector<Buffer> Buffers;
+
+  // Arrays created while serializing (copies of arrays that are not laid out
+  // contiguously) or deserializing, kept alive as long as the buffers.
+  std::vector<vtkSmartPointer<vtkAbstractArray> > Arrays;
+
+  // Steps run by EndDeserialize() once the buffers are filled.
+  std::vector<std::function<bool()> > Finalizers;
+
+  vtkSmartPointer<vtkDataObject> Output;
+  bool Failed = false;
+
+  void Reset()
+  {
+    this->Header.Reset();
+    this->Buffers.clear();
+    this->Arrays.clear();
+    this->Finalizers.clear();
+    this->Output = nullptr;
+    this->Failed = false;
+  }
+
+  void AddBuffer(void* pointer, vtkIdType length, int type)
+  {
+    if (length > 0)
+    {
+      this->Buffers.push_back(Buffer{ pointer, length, type });
+    }
+  }
+
+  bool WriteDataObject(vtkDataObject* object);
+  vtkSmartPointer<vtkDataObject> ReadDataObject();
+
+private:
+  //@{
+  /**
+   * Serialization of the pieces shared by the data object types. The read
+   * variants set Failed on error.
+   */
+  bool WriteArray(vtkAbstractArray* array);
+  vtkSmartPointer<vtkAbstractArray> ReadArray();
+  bool WriteFieldData(vtkFieldData* fieldData);
+  void ReadFieldData(vtkFieldData* fieldData);
+  bool WritePoints(vtkPoints* points);
+  vtkSmartPointer<vtkPoints> ReadPoints();
+  void WriteCellArray(vtkCellArray* cells);
+  vtkSmartPointer<vtkCellArray> ReadCellArray();
+  bool WriteDataSetAttributes(vtkDataSet* dataSet);
+  void ReadDataSetAttributes(vtkDataSet* dataSet);
+  bool WriteChild(vtkDataObject* child, vtkInformation* metaData);
+  vtkSmartPointer<vtkDataObject> ReadChild(std::string& name, bool& hasName);
+  //@}
+
+  //@{
+  /**
+   * Type specific serialization.
+   */
+  bool WriteImageData(vtkImageData* image);
+  void ReadImageData(vtkImageData* image);
+  bool WriteRectilinearGrid(vtkRectilinearGrid* grid);
+  void ReadRectilinearGrid(vtkRectilinearGrid* grid);
+  bool WriteStructuredGrid(vtkStructuredGrid* grid);
+  void ReadStructuredGrid(vtkStructuredGrid* grid);
+  bool WriteExplicitStructuredGrid(vtkExplicitStructuredGrid* grid);
+  void ReadExplicitStructuredGrid(vtkExplicitStructuredGrid* grid);
+  bool WritePolyData(vtkPolyData* polyData);
+  void ReadPolyData(vtkPolyData* polyData);
+  bool WriteUnstructuredGrid(vtkUnstructuredGrid* grid);
+  void ReadUnstructuredGrid(vtkUnstructuredGrid* grid);
+  bool WritePointSet(vtkPointSet* pointSet);
+  void ReadPointSet(vtkPointSet* pointSet);
+  bool WriteGraph(vtkGraph* graph);
+  void ReadGraph(vtkGraph* graph);
+  bool WriteMultiBlock(vtkMultiBlockDataSet* multiBlock);
+  void ReadMultiBlock(vtkMultiBlockDataSet* multiBlock);
+  bool WritePartitioned(vtkPartitionedDataSet* partitioned);
+  void ReadPartitioned(vtkPartitionedDataSet* partitioned);
+  bool WritePartitionedCollection(vtkPartitionedDataSetCollection* collection);
+  void ReadPartitionedCollection(vtkPartitionedDataSetCollection* collection);
+  bool WriteAMR(vtkUniformGridAMR* amr);
+  void ReadAMR(vtkUniformGridAMR* amr);
+  //@}
+};
+
+//============================================================================
+bool vtkDataObjectSerializer::vtkInternals::WriteArray(vtkAbstractArray* array)
+{
+  if (!array)
+  {
+    this->Header << 0;
+    return true;
+  }
+
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array);
+  if (!dataArray && !stringArray)
+  {
+    // vtkVariantArray, vtkUnicodeStringArray, ...
+    return false;
+  }
+
+  const int dataType = array->GetDataType();
+  const int numberOfComponents = array->GetNumberOfComponents();
+  const vtkIdType numberOfTuples = array->GetNumberOfTuples();
+  const vtkIdType numberOfValues = numberOfTuples * numberOfComponents;
+  const char* name = array->GetName();
+
+  this->Header << 1 << dataType << numberOfComponents
+               << static_cast<vtkTypeInt64>(numberOfTuples);
+  this->Header << (name != nullptr);
+  if (name)
+  {
+    this->Header << std::string(name);
+  }
+  if (array->HasAComponentName())
+  {
+    for (int c = 0; c < numberOfComponents; ++c)
+    {
+      if (const char* componentName = array->GetComponentName(c))
+      {
+        this->Header << c << std::string(componentName);
+      }
+    }
+  }
+  this->Header << -1;
+
+  if (stringArray)
+  {
+    for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+      this->Header << stringArray->GetValue(i);
+    }
+    return true;
+  }
+  if (numberOfValues == 0)
+  {
+    return true;
+  }
+
+  if (vtkBitArray* bitArray = vtkBitArray::SafeDownCast(array))
+  {
+    this->AddBuffer(bitArray->GetPointer(0), (numberOfValues + 7) / 8, VTK_UNSIGNED_CHAR);
+    return true;
+  }
+  if (!dataArray->HasStandardMemoryLayout())
+  {
+    // Implicit, SOA or mapped arrays: copy them to a contiguous array first.
+    vtkSmartPointer<vtkDataArray> copy =
+      vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(dataType));
+    copy->DeepCopy(dataArray);
+    this->Arrays.push_back(copy);
+    dataArray = copy;
+  }
+  this->AddBuffer(dataArray->GetVoidPointer(0), numberOfValues, dataType);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkAbstractArray> vtkDataObjectSerializer::vtkInternals::ReadArray()
+{
+  int present = 0;
+  this->Header >> present;
+  if (!present)
+  {
+    return nullptr;
+  }
+
+  int dataType = 0;
+  int numberOfComponents = 0;
+  vtkTypeInt64 numberOfTuples = 0;
+  bool hasName = false;
+  this->Header >> dataType >> numberOfComponents >> numberOfTuples >> hasName;
+
+  vtkSmartPointer<vtkAbstractArray> array;
+  if (dataType == VTK_STRING)
+  {
+    array = vtkSmartPointer<vtkStringArray>::New();
+  }
+  else
+  {
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  }
+  if (!array || numberOfComponents < 1 || numberOfTuples < 0)
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+
+  if (hasName)
+  {
+    std::string name;
+    this->Header >> name;
+    array->SetName(name.c_str());
+  }
+  array->SetNumberOfComponents(numberOfComponents);
+  int component = -1;
+  for (this->Header >> component; component >= 0; this->Header >> component)
+  {
+    std::string componentName;
+    this->Header >> componentName;
+    array->SetComponentName(component, componentName.c_str());
+  }
+  array->SetNumberOfTuples(static_cast<vtkIdType>(numberOfTuples));
+
+  const vtkIdType numberOfValues = array->GetNumberOfValues();
+  if (vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array))
+  {
+    std::string value;
+    for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+      this->Header >> value;
+      stringArray->SetValue(i, value);
+    }
+  }
+  else if (numberOfValues > 0)
+  {
+    if (vtkBitArray* bitArray = vtkBitArray::SafeDownCast(array))
+    {
+      this->AddBuffer(bitArray->GetPointer(0), (numberOfValues + 7) / 8, VTK_UNSIGNED_CHAR);
+    }
+    else
+    {
+      this->AddBuffer(array->GetVoidPointer(0), numberOfValues, dataType);
+    }
+  }
+  this->Arrays.push_back(array);
+  return array;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteFieldData(vtkFieldData* fieldData)
+{
+  vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+  const int numberOfArrays = fieldData ? fieldData->GetNumberOfArrays() : 0;
+  this->Header << numberOfArrays;
+  for (int i = 0; i < numberOfArrays; ++i)
+  {
+    this->Header << (attributes ? attributes->IsArrayAnAttribute(i) : -1);
+    if (!this->WriteArray(fieldData->GetAbstractArray(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadFieldData(vtkFieldData* fieldData)
+{
+  vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+  int numberOfArrays = 0;
+  this->Header >> numberOfArrays;
+  for (int i = 0; i < numberOfArrays && !this->Failed; ++i)
+  {
+    int attributeType = -1;
+    this->Header >> attributeType;
+    vtkSmartPointer<vtkAbstractArray> array = this->ReadArray();
+    if (!array)
+    {
+      continue;
+    }
+    const int index = fieldData->AddArray(array);
+    if (attributes && attributeType >= 0)
+    {
+      attributes->SetActiveAttribute(index, attributeType);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WritePoints(vtkPoints* points)
+{
+  return this->WriteArray(points ? points->GetData() : nullptr);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> vtkDataObjectSerializer::vtkInternals::ReadPoints()
+{
+  vtkDataArray* data = vtkDataArray::SafeDownCast(this->ReadArray());
+  if (!data)
+  {
+    return nullptr;
+  }
+  if (data->GetNumberOfComponents() != 3)
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  vtkNew<vtkPoints> points;
+  points->SetData(data);
+  return points.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::WriteCellArray(vtkCellArray* cells)
+{
+  if (!cells || cells->GetNumberOfCells() == 0)
+  {
+    this->Header << 0;
+    return;
+  }
+
+  vtkDataArray* offsets = cells->GetOffsetsArray();
+  vtkDataArray* connectivity = cells->GetConnectivityArray();
+  this->Header << 1 << cells->IsStorage64Bit()
+               << static_cast<vtkTypeInt64>(offsets->GetNumberOfValues())
+               << static_cast<vtkTypeInt64>(connectivity->GetNumberOfValues());
+  this->AddBuffer(
+    offsets->GetVoidPointer(0), offsets->GetNumberOfValues(), offsets->GetDataType());
+  this->AddBuffer(connectivity->GetVoidPointer(0), connectivity->GetNumberOfValues(),
+    connectivity->GetDataType());
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> vtkDataObjectSerializer::vtkInternals::ReadCellArray()
+{
+  int present = 0;
+  this->Header >> present;
+  if (!present)
+  {
+    return nullptr;
+  }
+
+  bool storage64Bit = false;
+  vtkTypeInt64 numberOfOffsets = 0;
+  vtkTypeInt64 connectivitySize = 0;
+  this->Header >> storage64Bit >> numberOfOffsets >> connectivitySize;
+
+  // Allocate the storage of the cell array directly so that it does not have
+  // to be converted once received.
+  vtkNew<vtkCellArray> cells;
+  if (storage64Bit)
+  {
+    cells->Use64BitStorage();
+  }
+  else
+  {
+    cells->Use32BitStorage();
+  }
+  vtkDataArray* offsets = cells->GetOffsetsArray();
+  vtkDataArray* connectivity = cells->GetConnectivityArray();
+  offsets->SetNumberOfValues(static_cast<vtkIdType>(numberOfOffsets));
+  connectivity->SetNumberOfValues(static_cast<vtkIdType>(connectivitySize));
+  this->AddBuffer(
+    offsets->GetVoidPointer(0), offsets->GetNumberOfValues(), offsets->GetDataType());
+  this->AddBuffer(connectivity->GetVoidPointer(0), connectivity->GetNumberOfValues(),
+    connectivity->GetDataType());
+  return cells.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteDataSetAttributes(vtkDataSet* dataSet)
+{
+  return this->WriteFieldData(dataSet->GetPointData()) &&
+    this->WriteFieldData(dataSet->GetCellData());
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadDataSetAttributes(vtkDataSet* dataSet)
+{
+  this->ReadFieldData(dataSet->GetPointData());
+  this->ReadFieldData(dataSet->GetCellData());
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteChild(
+  vtkDataObject* child, vtkInformation* metaData)
+{
+  const bool hasName = metaData && metaData->Has(vtkCompositeDataSet::NAME());
+  this->Header << hasName;
+  if (hasName)
+  {
+    this->Header << std::string(metaData->Get(vtkCompositeDataSet::NAME()));
+  }
+  return this->WriteDataObject(child);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectSerializer::vtkInternals::ReadChild(
+  std::string& name, bool& hasName)
+{
+  this->Header >> hasName;
+  if (hasName)
+  {
+    this->Header >> name;
+  }
+  return this->ReadDataObject();
+}
+
+//============================================================================
+bool vtkDataObjectSerializer::vtkInternals::WriteImageData(vtkImageData* image)
+{
+  const int* extent = image->GetExtent();
+  const double* origin = image->GetOrigin();
+  const double* spacing = image->GetSpacing();
+  const double* direction = image->GetDirectionMatrix()->GetData();
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header << extent[i];
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    this->Header << origin[i] << spacing[i];
+  }
+  for (int i = 0; i < 9; ++i)
+  {
+    this->Header << direction[i];
+  }
+  return this->WriteDataSetAttributes(image);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadImageData(vtkImageData* image)
+{
+  int extent[6];
+  double origin[3];
+  double spacing[3];
+  double direction[9];
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header >> extent[i];
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    this->Header >> origin[i] >> spacing[i];
+  }
+  for (int i = 0; i < 9; ++i)
+  {
+    this->Header >> direction[i];
+  }
+  image->SetExtent(extent);
+  image->SetOrigin(origin);
+  image->SetSpacing(spacing);
+  image->SetDirectionMatrix(direction);
+  this->ReadDataSetAttributes(image);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteRectilinearGrid(vtkRectilinearGrid* grid)
+{
+  const int* extent = grid->GetExtent();
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header << extent[i];
+  }
+  return this->WriteArray(grid->GetXCoordinates()) && this->WriteArray(grid->GetYCoordinates()) &&
+    this->WriteArray(grid->GetZCoordinates()) && this->WriteDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadRectilinearGrid(vtkRectilinearGrid* grid)
+{
+  int extent[6];
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header >> extent[i];
+  }
+  grid->SetExtent(extent);
+  vtkSmartPointer<vtkAbstractArray> x = this->ReadArray();
+  vtkSmartPointer<vtkAbstractArray> y = this->ReadArray();
+  vtkSmartPointer<vtkAbstractArray> z = this->ReadArray();
+  vtkDataArray* coordinates[3] = { vtkDataArray::SafeDownCast(x), vtkDataArray::SafeDownCast(y),
+    vtkDataArray::SafeDownCast(z) };
+  if (coordinates[0])
+  {
+    grid->SetXCoordinates(coordinates[0]);
+  }
+  if (coordinates[1])
+  {
+    grid->SetYCoordinates(coordinates[1]);
+  }
+  if (coordinates[2])
+  {
+    grid->SetZCoordinates(coordinates[2]);
+  }
+  this->ReadDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteStructuredGrid(vtkStructuredGrid* grid)
+{
+  const int* extent = grid->GetExtent();
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header << extent[i];
+  }
+  return this->WritePoints(grid->GetPoints()) && this->WriteDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadStructuredGrid(vtkStructuredGrid* grid)
+{
+  int extent[6];
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header >> extent[i];
+  }
+  grid->SetExtent(extent);
+  grid->SetPoints(this->ReadPoints());
+  this->ReadDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteExplicitStructuredGrid(
+  vtkExplicitStructuredGrid* grid)
+{
+  const int* extent = grid->GetExtent();
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header << extent[i];
+  }
+  const char* flagsName = grid->GetFacesConnectivityFlagsArrayName();
+  this->Header << (flagsName != nullptr);
+  if (flagsName)
+  {
+    this->Header << std::string(flagsName);
+  }
+  if (!this->WritePoints(grid->GetPoints()))
+  {
+    return false;
+  }
+  this->WriteCellArray(grid->GetCells());
+  return this->WriteDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadExplicitStructuredGrid(
+  vtkExplicitStructuredGrid* grid)
+{
+  int extent[6];
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Header >> extent[i];
+  }
+  grid->SetExtent(extent);
+  bool hasFlagsName = false;
+  this->Header >> hasFlagsName;
+  if (hasFlagsName)
+  {
+    std::string flagsName;
+    this->Header >> flagsName;
+    grid->SetFacesConnectivityFlagsArrayName(flagsName.c_str());
+  }
+  grid->SetPoints(this->ReadPoints());
+  grid->SetCells(this->ReadCellArray());
+  this->ReadDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WritePolyData(vtkPolyData* polyData)
+{
+  if (!this->WritePoints(polyData->GetPoints()))
+  {
+    return false;
+  }
+  this->WriteCellArray(polyData->GetVerts());
+  this->WriteCellArray(polyData->GetLines());
+  this->WriteCellArray(polyData->GetPolys());
+  this->WriteCellArray(polyData->GetStrips());
+  return this->WriteDataSetAttributes(polyData);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadPolyData(vtkPolyData* polyData)
+{
+  polyData->SetPoints(this->ReadPoints());
+  polyData->SetVerts(this->ReadCellArray());
+  polyData->SetLines(this->ReadCellArray());
+  polyData->SetPolys(this->ReadCellArray());
+  polyData->SetStrips(this->ReadCellArray());
+  this->ReadDataSetAttributes(polyData);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteUnstructuredGrid(vtkUnstructuredGrid* grid)
+{
+  if (!this->WritePoints(grid->GetPoints()) || !this->WriteArray(grid->GetCellTypesArray()))
+  {
+    return false;
+  }
+  this->WriteCellArray(grid->GetCells());
+  return this->WriteArray(grid->GetFaceLocations()) && this->WriteArray(grid->GetFaces()) &&
+    this->WriteDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadUnstructuredGrid(vtkUnstructuredGrid* grid)
+{
+  grid->SetPoints(this->ReadPoints());
+  vtkSmartPointer<vtkAbstractArray> types = this->ReadArray();
+  vtkSmartPointer<vtkCellArray> cells = this->ReadCellArray();
+  vtkSmartPointer<vtkAbstractArray> faceLocations = this->ReadArray();
+  vtkSmartPointer<vtkAbstractArray> faces = this->ReadArray();
+  if (types && cells)
+  {
+    vtkUnsignedCharArray* typesArray = vtkUnsignedCharArray::SafeDownCast(types);
+    if (!typesArray || (faceLocations && !vtkIdTypeArray::SafeDownCast(faceLocations)) ||
+      (faces && !vtkIdTypeArray::SafeDownCast(faces)))
+    {
+      this->Failed = true;
+      return;
+    }
+    grid->SetCells(typesArray, cells, vtkIdTypeArray::SafeDownCast(faceLocations),
+      vtkIdTypeArray::SafeDownCast(faces));
+  }
+  this->ReadDataSetAttributes(grid);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WritePointSet(vtkPointSet* pointSet)
+{
+  return this->WritePoints(pointSet->GetPoints()) && this->WriteDataSetAttributes(pointSet);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadPointSet(vtkPointSet* pointSet)
+{
+  pointSet->SetPoints(this->ReadPoints());
+  this->ReadDataSetAttributes(pointSet);
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteGraph(vtkGraph* graph)
+{
+  if (graph->GetDistributedGraphHelper())
+  {
+    return false;
+  }
+
+  // vtkGraph does not store its edges contiguously: gather them in a
+  // (source, target) array, along with the edge points if there are any.
+  const vtkIdType numberOfEdges = graph->GetNumberOfEdges();
+  vtkNew<vtkIdTypeArray> edges;
+  edges->SetNumberOfComponents(2);
+  edges->SetNumberOfTuples(numberOfEdges);
+  vtkNew<vtkIdTypeArray> edgePointCounts;
+  edgePointCounts->SetNumberOfTuples(numberOfEdges);
+  vtkNew<vtkDoubleArray> edgePoints;
+  edgePoints->SetNumberOfComponents(3);
+  for (vtkIdType e = 0; e < numberOfEdges; ++e)
+  {
+    edges->SetTypedComponent(e, 0, graph->GetSourceVertex(e));
+    edges->SetTypedComponent(e, 1, graph->GetTargetVertex(e));
+    vtkIdType count = 0;
+    double* coordinates = nullptr;
+    graph->GetEdgePoints(e, count, coordinates);
+    edgePointCounts->SetValue(e, count);
+    for (vtkIdType p = 0; p < count; ++p)
+    {
+      edgePoints->InsertNextTuple(coordinates + 3 * p);
+    }
+  }
+  this->Arrays.push_back(edges.GetPointer());
+  this->Arrays.push_back(edgePointCounts.GetPointer());
+  this->Arrays.push_back(edgePoints.GetPointer());
+
+  const bool hasEdgePoints = edgePoints->GetNumberOfTuples() > 0;
+  this->Header << static_cast<vtkTypeInt64>(graph->GetNumberOfVertices()) << hasEdgePoints;
+  return this->WriteArray(edges) && this->WritePoints(graph->GetPoints()) &&
+    (!hasEdgePoints || (this->WriteArray(edgePointCounts) && this->WriteArray(edgePoints))) &&
+    this->WriteFieldData(graph->GetVertexData()) && this->WriteFieldData(graph->GetEdgeData());
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadGraph(vtkGraph* graph)
+{
+  vtkTypeInt64 numberOfVertices = 0;
+  bool hasEdgePoints = false;
+  this->Header >> numberOfVertices >> hasEdgePoints;
+  vtkSmartPointer<vtkIdTypeArray> edges = vtkIdTypeArray::SafeDownCast(this->ReadArray());
+  vtkSmartPointer<vtkPoints> points = this->ReadPoints();
+  vtkSmartPointer<vtkIdTypeArray> edgePointCounts;
+  vtkSmartPointer<vtkDoubleArray> edgePoints;
+  if (hasEdgePoints)
+  {
+    edgePointCounts = vtkIdTypeArray::SafeDownCast(this->ReadArray());
+    edgePoints = vtkDoubleArray::SafeDownCast(this->ReadArray());
+  }
+  vtkSmartPointer<vtkDataSetAttributes> vertexData = vtkSmartPointer<vtkDataSetAttributes>::New();
+  vtkSmartPointer<vtkDataSetAttributes> edgeData = vtkSmartPointer<vtkDataSetAttributes>::New();
+  this->ReadFieldData(vertexData);
+  this->ReadFieldData(edgeData);
+  if (this->Failed || (edges && edges->GetNumberOfComponents() != 2))
+  {
+    this->Failed = true;
+    return;
+  }
+
+  // The topology can only be rebuilt once the edges are received.
+  const vtkIdType numberOfGraphVertices = static_cast<vtkIdType>(numberOfVertices);
+  vtkSmartPointer<vtkGraph> target = graph;
+  if (vtkDirectedGraph::SafeDownCast(graph))
+  {
+    this->Finalizers.push_back([=]() {
+      return BuildGraph<vtkMutableDirectedGraph>(target, numberOfGraphVertices, edges, points,
+        edgePointCounts, edgePoints, vertexData, edgeData);
+    });
+  }
+  else
+  {
+    this->Finalizers.push_back([=]() {
+      return BuildGraph<vtkMutableUndirectedGraph>(target, numberOfGraphVertices, edges, points,
+        edgePointCounts, edgePoints, vertexData, edgeData);
+    });
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteMultiBlock(vtkMultiBlockDataSet* multiBlock)
+{
+  const unsigned int numberOfBlocks = multiBlock->GetNumberOfBlocks();
+  this->Header << numberOfBlocks;
+  for (unsigned int i = 0; i < numberOfBlocks; ++i)
+  {
+    vtkInformation* metaData = multiBlock->HasMetaData(i) ? multiBlock->GetMetaData(i) : nullptr;
+    if (!this->WriteChild(multiBlock->GetBlock(i), metaData))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadMultiBlock(vtkMultiBlockDataSet* multiBlock)
+{
+  unsigned int numberOfBlocks = 0;
+  this->Header >> numberOfBlocks;
+  multiBlock->SetNumberOfBlocks(numberOfBlocks);
+  for (unsigned int i = 0; i < numberOfBlocks && !this->Failed; ++i)
+  {
+    std::string name;
+    bool hasName = false;
+    multiBlock->SetBlock(i, this->ReadChild(name, hasName));
+    if (hasName)
+    {
+      multiBlock->GetMetaData(i)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WritePartitioned(vtkPartitionedDataSet* partitioned)
+{
+  const unsigned int numberOfPartitions = partitioned->GetNumberOfPartitions();
+  this->Header << numberOfPartitions;
+  for (unsigned int i = 0; i < numberOfPartitions; ++i)
+  {
+    vtkInformation* metaData =
+      partitioned->HasMetaData(i) ? partitioned->GetMetaData(i) : nullptr;
+    if (!this->WriteChild(partitioned->GetPartitionAsDataObject(i), metaData))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadPartitioned(vtkPartitionedDataSet* partitioned)
+{
+  unsigned int numberOfPartitions = 0;
+  this->Header >> numberOfPartitions;
+  partitioned->SetNumberOfPartitions(numberOfPartitions);
+  for (unsigned int i = 0; i < numberOfPartitions && !this->Failed; ++i)
+  {
+    std::string name;
+    bool hasName = false;
+    partitioned->SetPartition(i, this->ReadChild(name, hasName));
+    if (hasName)
+    {
+      partitioned->GetMetaData(i)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WritePartitionedCollection(
+  vtkPartitionedDataSetCollection* collection)
+{
+  const unsigned int numberOfDataSets = collection->GetNumberOfPartitionedDataSets();
+  this->Header << numberOfDataSets;
+  for (unsigned int i = 0; i < numberOfDataSets; ++i)
+  {
+    vtkInformation* metaData = collection->HasMetaData(i) ? collection->GetMetaData(i) : nullptr;
+    if (!this->WriteChild(collection->GetPartitionedDataSet(i), metaData))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadPartitionedCollection(
+  vtkPartitionedDataSetCollection* collection)
+{
+  unsigned int numberOfDataSets = 0;
+  this->Header >> numberOfDataSets;
+  collection->SetNumberOfPartitionedDataSets(numberOfDataSets);
+  for (unsigned int i = 0; i < numberOfDataSets && !this->Failed; ++i)
+  {
+    std::string name;
+    bool hasName = false;
+    vtkSmartPointer<vtkDataObject> child = this->ReadChild(name, hasName);
+    vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(child);
+    if (child && !partitioned)
+    {
+      this->Failed = true;
+      return;
+    }
+    collection->SetPartitionedDataSet(i, partitioned);
+    if (hasName)
+    {
+      collection->GetMetaData(i)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::vtkInternals::WriteAMR(vtkUniformGridAMR* amr)
+{
+  const unsigned int numberOfLevels = amr->GetNumberOfLevels();
+  this->Header << numberOfLevels;
+  if (numberOfLevels == 0)
+  {
+    return true;
+  }
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    this->Header << amr->GetNumberOfDataSets(level);
+  }
+  this->Header << amr->GetGridDescription();
+
+  // Same meta-data as vtkCompositeDataWriter, plus the refinement ratios.
+  if (vtkOverlappingAMR* overlapping = vtkOverlappingAMR::SafeDownCast(amr))
+  {
+    vtkAMRInformation* amrInfo = overlapping->GetAMRInfo();
+    const double* origin = overlapping->GetOrigin();
+    this->Header << origin[0] << origin[1] << origin[2];
+    const bool hasRefinementRatio = amrInfo->HasRefinementRatio();
+    this->Header << hasRefinementRatio;
+    for (unsigned int level = 0; level < numberOfLevels; ++level)
+    {
+      double spacing[3];
+      amrInfo->GetSpacing(level, spacing);
+      this->Header << spacing[0] << spacing[1] << spacing[2];
+      if (hasRefinementRatio)
+      {
+        this->Header << amrInfo->GetRefinementRatio(level);
+      }
+      const unsigned int numberOfDataSets = overlapping->GetNumberOfDataSets(level);
+      for (unsigned int index = 0; index < numberOfDataSets; ++index)
+      {
+        int box[6];
+        overlapping->GetAMRBox(level, index).Serialize(box);
+        for (int i = 0; i < 6; ++i)
+        {
+          this->Header << box[i];
+        }
+      }
+    }
+  }
+
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    const unsigned int numberOfDataSets = amr->GetNumberOfDataSets(level);
+    for (unsigned int index = 0; index < numberOfDataSets; ++index)
+    {
+      if (!this->WriteDataObject(amr->GetDataSet(level, index)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::vtkInternals::ReadAMR(vtkUniformGridAMR* amr)
+{
+  unsigned int numberOfLevels = 0;
+  this->Header >> numberOfLevels;
+  if (numberOfLevels == 0)
+  {
+    return;
+  }
+  std::vector<int> blocksPerLevel(numberOfLevels);
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    unsigned int numberOfDataSets = 0;
+    this->Header >> numberOfDataSets;
+    blocksPerLevel[level] = static_cast<int>(numberOfDataSets);
+  }
+  int description = 0;
+  this->Header >> description;
+  amr->Initialize(static_cast<int>(numberOfLevels), blocksPerLevel.data());
+  amr->SetGridDescription(description);
+
+  if (vtkOverlappingAMR* overlapping = vtkOverlappingAMR::SafeDownCast(amr))
+  {
+    double origin[3];
+    bool hasRefinementRatio = false;
+    this->Header >> origin[0] >> origin[1] >> origin[2] >> hasRefinementRatio;
+    overlapping->SetOrigin(origin);
+    for (unsigned int level = 0; level < numberOfLevels; ++level)
+    {
+      double spacing[3];
+      this->Header >> spacing[0] >> spacing[1] >> spacing[2];
+      overlapping->SetSpacing(level, spacing);
+      if (hasRefinementRatio)
+      {
+        int ratio = 0;
+        this->Header >> ratio;
+        overlapping->SetRefinementRatio(level, ratio);
+      }
+      for (int index = 0; index < blocksPerLevel[level]; ++index)
+      {
+        int box[6];
+        for (int i = 0; i < 6; ++i)
+        {
+          this->Header >> box[i];
+        }
+        vtkAMRBox amrBox;
+        amrBox.SetDimensions(&box[0], &box[3], description);
+        overlapping->SetAMRBox(level, index, amrBox);
+      }
+    }
+  }
+
+  for (unsigned int level = 0; level < numberOfLevels && !this->Failed; ++level)
+  {
+    for (int index = 0; index < blocksPerLevel[level] && !this->Failed; ++index)
+    {
+      vtkSmartPointer<vtkDataObject> child = this->ReadDataObject();
+      vtkUniformGrid* grid = vtkUniformGrid::SafeDownCast(child);
+      if (child && !grid)
+      {
+        this->Failed = true;
+        return;
+      }
+      amr->SetDataSet(level, index, grid);
+    }
+  }
+}
+
+//============================================================================
+bool vtkDataObjectSerializer::vtkInternals::WriteDataObject(vtkDataObject* object)
+{
+  const int type = object ? object->GetDataObjectType() : -1;
+  if (object && !vtkDataObjectSerializer::IsTypeSupported(type))
+  {
+    return false;
+  }
+  this->Header << type;
+  if (!object)
+  {
+    return true;
+  }
+
+  bool status = false;
+  switch (type)
+  {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_UNIFORM_GRID:
+      status = this->WriteImageData(vtkImageData::SafeDownCast(object));
+      break;
+    case VTK_RECTILINEAR_GRID:
+      status = this->WriteRectilinearGrid(vtkRectilinearGrid::SafeDownCast(object));
+      break;
+    case VTK_STRUCTURED_GRID:
+      status = this->WriteStructuredGrid(vtkStructuredGrid::SafeDownCast(object));
+      break;
+    case VTK_EXPLICIT_STRUCTURED_GRID:
+      status = this->WriteExplicitStructuredGrid(vtkExplicitStructuredGrid::SafeDownCast(object));
+      break;
+    case VTK_POLY_DATA:
+      status = this->WritePolyData(vtkPolyData::SafeDownCast(object));
+      break;
+    case VTK_UNSTRUCTURED_GRID:
+      status = this->WriteUnstructuredGrid(vtkUnstructuredGrid::SafeDownCast(object));
+      break;
+    case VTK_PATH:
+      status = this->WritePointSet(vtkPointSet::SafeDownCast(object));
+      break;
+    case VTK_TABLE:
+      status = this->WriteFieldData(vtkTable::SafeDownCast(object)->GetRowData());
+      break;
+    case VTK_DIRECTED_GRAPH:
+    case VTK_UNDIRECTED_GRAPH:
+    case VTK_TREE:
+    case VTK_DIRECTED_ACYCLIC_GRAPH:
+      status = this->WriteGraph(vtkGraph::SafeDownCast(object));
+      break;
+    case VTK_MULTIBLOCK_DATA_SET:
+      status = this->WriteMultiBlock(vtkMultiBlockDataSet::SafeDownCast(object));
+      break;
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+      status = this->WritePartitioned(vtkPartitionedDataSet::SafeDownCast(object));
+      break;
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+      status = this->WritePartitionedCollection(
+        vtkPartitionedDataSetCollection::SafeDownCast(object));
+      break;
+    case VTK_UNIFORM_GRID_AMR:
+    case VTK_NON_OVERLAPPING_AMR:
+    case VTK_OVERLAPPING_AMR:
+      status = this->WriteAMR(vtkUniformGridAMR::SafeDownCast(object));
+      break;
+  }
+  return status && this->WriteFieldData(object->GetFieldData());
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectSerializer::vtkInternals::ReadDataObject()
+{
+  int type = -1;
+  this->Header >> type;
+  if (type < 0)
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataObject> object;
+  if (vtkDataObjectSerializer::IsTypeSupported(type))
+  {
+    object.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+  }
+  if (!object)
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+
+  switch (type)
+  {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_UNIFORM_GRID:
+      this->ReadImageData(vtkImageData::SafeDownCast(object));
+      break;
+    case VTK_RECTILINEAR_GRID:
+      this->ReadRectilinearGrid(vtkRectilinearGrid::SafeDownCast(object));
+      break;
+    case VTK_STRUCTURED_GRID:
+      this->ReadStructuredGrid(vtkStructuredGrid::SafeDownCast(object));
+      break;
+    case VTK_EXPLICIT_STRUCTURED_GRID:
+      this->ReadExplicitStructuredGrid(vtkExplicitStructuredGrid::SafeDownCast(object));
+      break;
+    case VTK_POLY_DATA:
+      this->ReadPolyData(vtkPolyData::SafeDownCast(object));
+      break;
+    case VTK_UNSTRUCTURED_GRID:
+      this->ReadUnstructuredGrid(vtkUnstructuredGrid::SafeDownCast(object));
+      break;
+    case VTK_PATH:
+      this->ReadPointSet(vtkPointSet::SafeDownCast(object));
+      break;
+    case VTK_TABLE:
+      this->ReadFieldData(vtkTable::SafeDownCast(object)->GetRowData());
+      break;
+    case VTK_DIRECTED_GRAPH:
+    case VTK_UNDIRECTED_GRAPH:
+    case VTK_TREE:
+    case VTK_DIRECTED_ACYCLIC_GRAPH:
+      this->ReadGraph(vtkGraph::SafeDownCast(object));
+      break;
+    case VTK_MULTIBLOCK_DATA_SET:
+      this->ReadMultiBlock(vtkMultiBlockDataSet::SafeDownCast(object));
+      break;
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+      this->ReadPartitioned(vtkPartitionedDataSet::SafeDownCast(object));
+      break;
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+      this->ReadPartitionedCollection(vtkPartitionedDataSetCollection::SafeDownCast(object));
+      break;
+    case VTK_UNIFORM_GRID_AMR:
+    case VTK_NON_OVERLAPPING_AMR:
+    case VTK_OVERLAPPING_AMR:
+      this->ReadAMR(vtkUniformGridAMR::SafeDownCast(object));
+      break;
+  }
+  if (!this->Failed)
+  {
+    this->ReadFieldData(object->GetFieldData());
+  }
+  return this->Failed ? nullptr : object;
+}
+
+//============================================================================
+vtkStandardNewMacro(vtkDataObjectSerializer);
+
+//----------------------------------------------------------------------------
+vtkDataObjectSerializer::vtkDataObjectSerializer()
+  : Internals(new vtkInternals)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDataObjectSerializer::~vtkDataObjectSerializer()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectSerializer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "HeaderSize: " << this->Internals->Header.RawSize() << "\n";
+  os << indent << "NumberOfBuffers: " << this->Internals->Buffers.size() << "\n";
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::IsTypeSupported(int dataObjectType)
+{
+  switch (dataObjectType)
+  {
+    case VTK_POLY_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_STRUCTURED_GRID:
+    case VTK_RECTILINEAR_GRID:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_IMAGE_DATA:
+    case VTK_UNIFORM_GRID:
+    case VTK_MULTIBLOCK_DATA_SET:
+    case VTK_TABLE:
+    case VTK_TREE:
+    case VTK_DIRECTED_GRAPH:
+    case VTK_UNDIRECTED_GRAPH:
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_DIRECTED_ACYCLIC_GRAPH:
+    case VTK_UNIFORM_GRID_AMR:
+    case VTK_NON_OVERLAPPING_AMR:
+    case VTK_OVERLAPPING_AMR:
+    case VTK_PATH:
+    case VTK_PARTITIONED_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+    case VTK_EXPLICIT_STRUCTURED_GRID:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::Serialize(vtkDataObject* object)
+{
+  this->Internals->Reset();
+  this->Internals->Header << HeaderVersion;
+  if (!this->Internals->WriteDataObject(object))
+  {
+    this->Internals->Reset();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::BeginDeserialize(vtkMultiProcessStream& header)
+{
+  this->Internals->Reset();
+  this->Internals->Header = header;
+
+  int version = 0;
+  this->Internals->Header >> version;
+  if (version != HeaderVersion)
+  {
+    vtkErrorMacro("Unsupported data object header version: " << version);
+    this->Internals->Reset();
+    return false;
+  }
+
+  this->Internals->Output = this->Internals->ReadDataObject();
+  if (this->Internals->Failed)
+  {
+    vtkErrorMacro("Invalid data object header.");
+    this->Internals->Reset();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectSerializer::EndDeserialize()
+{
+  for (const auto& finalizer : this->Internals->Finalizers)
+  {
+    if (!finalizer())
+    {
+      vtkErrorMacro("Failed to rebuild the deserialized data object.");
+      this->Internals->Reset();
+      return nullptr;
+    }
+  }
+  vtkSmartPointer<vtkDataObject> output = this->Internals->Output;
+  this->Internals->Reset();
+  return output;
+}
+
+//----------------------------------------------------------------------------
+vtkMultiProcessStream& vtkDataObjectSerializer::GetHeader()
+{
+  return this->Internals->Header;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataObjectSerializer::GetNumberOfBuffers()
+{
+  return static_cast<int>(this->Internals->Buffers.size());
+}
+
+//----------------------------------------------------------------------------
+void* vtkDataObjectSerializer::GetBufferPointer(int index)
+{
+  return this->Internals->Buffers[index].Pointer;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDataObjectSerializer::GetBufferLength(int index)
+{
+  return this->Internals->Buffers[index].Length;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataObjectSerializer::GetBufferType(int index)
+{
+  return this->Internals->Buffers[index].Type;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::Marshal(vtkDataObject* object, vtkCharArray* buffer)
+{
+  buffer->Initialize();
+  buffer->SetNumberOfComponents(1);
+
+  vtkNew<vtkDataObjectSerializer> serializer;
+  if (!serializer->Serialize(object))
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> header;
+  serializer->GetHeader().GetRawData(header);
+  size_t size = MarshalPreambleSize + PadToAlignment(header.size());
+  const int numberOfBuffers = serializer->GetNumberOfBuffers();
+  for (int i = 0; i < numberOfBuffers; ++i)
+  {
+    size += PadToAlignment(static_cast<size_t>(serializer->GetBufferLength(i)) *
+      vtkAbstractArray::GetDataTypeSize(serializer->GetBufferType(i)));
+  }
+
+  buffer->SetNumberOfValues(static_cast<vtkIdType>(size));
+  char* data = buffer->GetPointer(0);
+  memset(data, 0, MarshalPreambleSize);
+  memcpy(data, MarshalMagic, sizeof(MarshalMagic));
+#ifdef VTK_WORDS_BIGENDIAN
+  data[8] = 1;
+#endif
+  data[9] = static_cast<char>(sizeof(vtkIdType));
+  const vtkTypeUInt64 headerSize = header.size();
+  memcpy(data + 16, &headerSize, sizeof(headerSize));
+  size_t offset = MarshalPreambleSize;
+  memcpy(data + offset, header.data(), header.size());
+  memset(data + offset + header.size(), 0, PadToAlignment(header.size()) - header.size());
+  offset += PadToAlignment(header.size());
+  for (int i = 0; i < numberOfBuffers; ++i)
+  {
+    const size_t bytes = static_cast<size_t>(serializer->GetBufferLength(i)) *
+      vtkAbstractArray::GetDataTypeSize(serializer->GetBufferType(i));
+    memcpy(data + offset, serializer->GetBufferPointer(i), bytes);
+    memset(data + offset + bytes, 0, PadToAlignment(bytes) - bytes);
+    offset += PadToAlignment(bytes);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectSerializer::IsMarshalled(vtkCharArray* buffer)
+{
+  return buffer && static_cast<size_t>(buffer->GetNumberOfValues()) >= MarshalPreambleSize &&
+    memcmp(buffer->GetPointer(0), MarshalMagic, sizeof(MarshalMagic)) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectSerializer::UnMarshal(vtkCharArray* buffer)
+{
+  if (!vtkDataObjectSerializer::IsMarshalled(buffer))
+  {
+    vtkGenericWarningMacro("Buffer does not hold a marshalled data object.");
+    return nullptr;
+  }
+
+  const char* data = buffer->GetPointer(0);
+  const size_t size = static_cast<size_t>(buffer->GetNumberOfValues());
+#ifdef VTK_WORDS_BIGENDIAN
+  const bool swap = data[8] == 0;
+#else
+  const bool swap = data[8] != 0;
+#endif
+  const bool sameIdTypeSize = data[9] == static_cast<char>(sizeof(vtkIdType));
+  vtkTypeUInt64 headerSize = 0;
+  memcpy(&headerSize, data + 16, sizeof(headerSize));
+  if (swap)
+  {
+    vtkByteSwap::SwapVoidRange(&headerSize, 1, sizeof(headerSize));
+  }
+  size_t offset = MarshalPreambleSize;
+  if (headerSize > size - offset)
+  {
+    vtkGenericWarningMacro("Truncated data object buffer.");
+    return nullptr;
+  }
+
+  vtkMultiProcessStream header;
+  header.SetRawData(
+    reinterpret_cast<const unsigned char*>(data + offset), static_cast<unsigned int>(headerSize));
+  offset += PadToAlignment(static_cast<size_t>(headerSize));
+
+  vtkNew<vtkDataObjectSerializer> serializer;
+  if (!serializer->BeginDeserialize(header))
+  {
+    return nullptr;
+  }
+  const int numberOfBuffers = serializer->GetNumberOfBuffers();
+  for (int i = 0; i < numberOfBuffers; ++i)
+  {
+    const int type = serializer->GetBufferType(i);
+    const size_t typeSize = static_cast<size_t>(vtkAbstractArray::GetDataTypeSize(type));
+    const size_t count = static_cast<size_t>(serializer->GetBufferLength(i));
+    if (type == VTK_ID_TYPE && !sameIdTypeSize)
+    {
+      vtkGenericWarningMacro("Cannot unmarshal vtkIdType arrays of a different size.");
+      return nullptr;
+    }
+    if (offset > size || count * typeSize > size - offset)
+    {
+      vtkGenericWarningMacro("Truncated data object buffer.");
+      return nullptr;
+    }
+    void* pointer = serializer->GetBufferPointer(i);
+    memcpy(pointer, data + offset, count * typeSize);
+    if (swap && typeSize > 1)
+    {
+      vtkByteSwap::SwapVoidRange(pointer, count, typeSize);
+    }
+    offset += PadToAlignment(count * typeSize);
+  }
+  return serializer->EndDeserialize();
+}
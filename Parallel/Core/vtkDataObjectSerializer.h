@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataObjectSerializer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDataObjectSerializer
+ * @brief   binary serialization of data objects for communicators
+ *
+ * vtkDataObjectSerializer splits a data object into a small header, stored
+ * in a vtkMultiProcessStream, and a list of raw buffers that point directly
+ * at the memory of the object's arrays. The header describes the structure
+ * (type, extents, array names, types and sizes, composite hierarchy, ...)
+ * while the buffers carry the bulk data, unconverted. A communicator can
+ * therefore send the header followed by each buffer in turn (scatter) and
+ * receive each buffer straight into freshly allocated arrays (gather),
+ * without going through an intermediate file format.
+ *
+ * Serialization:
+ * @code
+ * vtkNew<vtkDataObjectSerializer> serializer;
+ * if (serializer->Serialize(object))
+ * {
+ *   send(serializer->GetHeader());
+ *   for (int i = 0; i < serializer->GetNumberOfBuffers(); ++i)
+ *   {
+ *     send(serializer->GetBufferPointer(i), serializer->GetBufferLength(i),
+ *       serializer->GetBufferType(i));
+ *   }
+ * }
+ * @endcode
+ *
+ * Deserialization mirrors it: BeginDeserialize() builds the object from the
+ * header and allocates its arrays, the caller fills each buffer, then
+ * EndDeserialize() completes the object and returns it.
+ *
+ * Supported types are polydata, unstructured grids, explicit structured
+ * grids, structured and rectilinear grids, image data (including structured
+ * points and uniform grids), paths, tables, directed and undirected graphs,
+ * trees, directed acyclic graphs, multiblock, multipiece and partitioned
+ * datasets, partitioned dataset collections and AMR datasets. Numeric, bit
+ * and string arrays are supported; an object holding any other kind of array
+ * (e.g. vtkVariantArray) or of any other type is rejected, and callers are
+ * expected to fall back to another marshalling scheme.
+ *
+ * Marshal() and UnMarshal() pack the header and buffers in a single
+ * vtkCharArray for code paths that need one contiguous message.
+ *
+ * @sa
+ * vtkCommunicator vtkMultiProcessStream vtkFieldDataSerializer
+ */
+
+#ifndef vtkDataObjectSerializer_h
+#define vtkDataObjectSerializer_h
+
+#include "vtkObject.h"
+#include "vtkParallelCoreModule.h" // For export macro
+#include "vtkSmartPointer.h"       // For vtkSmartPointer
+
+class vtkCharArray;
+class vtkDataObject;
+class vtkMultiProcessStream;
+
+class VTKPARALLELCORE_EXPORT vtkDataObjectSerializer : public vtkObject
+{
+public:
+  static vtkDataObjectSerializer* New();
+  vtkTypeMacro(vtkDataObjectSerializer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns true if data objects of the given type (e.g. VTK_POLY_DATA) can
+   * be serialized. Serialize() may still fail for an object of a supported
+   * type if it holds unsupported arrays or children.
+   */
+  static bool IsTypeSupported(int dataObjectType);
+
+  /**
+   * Serializes `object` into the header and collects its buffers. A nullptr
+   * object is valid and serializes to an empty object. Returns false if the
+   * object cannot be serialized. The buffers reference the memory of
+   * `object`, which must therefore be kept unchanged until they are used.
+   */
+  bool Serialize(vtkDataObject* object);
+
+  /**
+   * Creates the data object described by `header` and allocates the arrays
+   * backing each of the buffers. The caller must then fill every buffer
+   * before calling EndDeserialize(). Returns false if the header is invalid.
+   */
+  bool BeginDeserialize(vtkMultiProcessStream& header);
+
+  /**
+   * Completes the object started by BeginDeserialize() once its buffers are
+   * filled and returns it. May return nullptr, e.g. if a nullptr object was
+   * serialized.
+   */
+  vtkSmartPointer<vtkDataObject> EndDeserialize();
+
+  /**
+   * Returns the header filled by Serialize().
+   */
+  vtkMultiProcessStream& GetHeader();
+
+  //@{
+  /**
+   * Access the buffers collected by Serialize() or allocated by
+   * BeginDeserialize(). The length is expressed in number of values of the
+   * buffer type, which is one of the VTK scalar types (e.g. VTK_FLOAT). Bit
+   * arrays are exposed as VTK_UNSIGNED_CHAR buffers.
+   */
+  int GetNumberOfBuffers();
+  void* GetBufferPointer(int index);
+  vtkIdType GetBufferLength(int index);
+  int GetBufferType(int index);
+  //@}
+
+  /**
+   * Serializes `object` and packs the header and the buffers into `buffer`.
+   * Returns false, leaving `buffer` empty, if the object cannot be
+   * serialized.
+   */
+  static bool Marshal(vtkDataObject* object, vtkCharArray* buffer);
+
+  /**
+   * Returns true if `buffer` was filled by Marshal().
+   */
+  static bool IsMarshalled(vtkCharArray* buffer);
+
+  /**
+   * Rebuilds the data object packed in `buffer` by Marshal(), swapping bytes
+   * if the buffer was produced on a machine of different endianness. Returns
+   * nullptr on error or if a nullptr object was marshalled.
+   */
+  static vtkSmartPointer<vtkDataObject> UnMarshal(vtkCharArray* buffer);
+
+protected:
+  vtkDataObjectSerializer();
+  ~vtkDataObjectSerializer() override;
+
+private:
+  vtkDataObjectSerializer(const vtkDataObjectSerializer&) = delete;
+  void operator=(const vtkDataObjectSerializer&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
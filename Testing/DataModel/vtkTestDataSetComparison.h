@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTestDataSetComparison.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * Functions comparing data sets value by value, used by the tests checking
+ * that two code paths of a filter, e.g. its serial and threaded ones,
+ * produce identical outputs. The values are compared exactly.
+ */
+
+#ifndef vtkTestDataSetComparison_h
+#define vtkTestDataSetComparison_h
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm> // Needed for std::equal
+#include <iostream>  // Needed for std::cerr
+
+namespace vtkTest
+{
+/**
+ * Whether the arrays have the same tuples, or are both null.
+ */
+inline bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Whether the attributes have the same data arrays, matched by name.
+ */
+inline bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    if (!SameValues(a->GetArray(i), b->GetArray(a->GetArrayName(i))))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Whether the data sets have the same cells, in the same order.
+ */
+inline bool SameCells(vtkDataSet* a, vtkDataSet* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> ptsA;
+  vtkNew<vtkIdList> ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, ptsA);
+    b->GetCellPoints(cellId, ptsB);
+    if (a->GetCellType(cellId) != b->GetCellType(cellId) ||
+      ptsA->GetNumberOfIds() != ptsB->GetNumberOfIds() ||
+      !std::equal(ptsA->begin(), ptsA->end(), ptsB->begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Whether the data sets have the same points, cells, point data and cell
+ * data. The first difference found is reported on std::cerr.
+ */
+inline bool SameDataSets(vtkDataSet* a, vtkDataSet* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints())
+  {
+    std::cerr << "The data sets have different numbers of points" << std::endl;
+    return false;
+  }
+  double xA[3], xB[3];
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    a->GetPoint(ptId, xA);
+    b->GetPoint(ptId, xB);
+    if (!std::equal(xA, xA + 3, xB))
+    {
+      std::cerr << "The data sets have different points" << std::endl;
+      return false;
+    }
+  }
+  if (!SameCells(a, b))
+  {
+    std::cerr << "The data sets have different cells" << std::endl;
+    return false;
+  }
+  if (!SameAttributes(a->GetPointData(), b->GetPointData()))
+  {
+    std::cerr << "The data sets have different point data" << std::endl;
+    return false;
+  }
+  if (!SameAttributes(a->GetCellData(), b->GetCellData()))
+  {
+    std::cerr << "The data sets have different cell data" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkTestDataSetComparison.h
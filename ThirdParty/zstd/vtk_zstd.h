@@ -0,0 +1,21 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtk_zstd.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef vtk_zstd_h
+#define vtk_zstd_h
+
+/* Use the zstd library found for VTK.  */
+#include <zstd.h>
+
+#endif
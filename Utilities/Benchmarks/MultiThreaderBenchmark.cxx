@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    MultiThreaderBenchmark.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Measure the latency of vtkMultiThreader::SingleMethodExecute(), and of the
+update of a small vtkImageReslice request, with and without the persistent
+thread pool. The mean, median, 99th percentile and standard deviation of the
+time per call are printed, the last two giving the jitter.
+
+Usage: MultiThreaderBenchmark [numberOfThreads] [numberOfCalls]
+*/
+
+#include "vtkImageData.h"
+#include "vtkImageReslice.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkRTAnalyticSource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Give access to the threader of the filter, which uses the pool by default.
+class vtkBenchmarkReslice : public vtkImageReslice
+{
+public:
+  static vtkBenchmarkReslice* New();
+  vtkTypeMacro(vtkBenchmarkReslice, vtkImageReslice);
+
+  void SetUseThreadPool(bool usePool) { this->Threader->SetUseThreadPool(usePool); }
+};
+
+vtkStandardNewMacro(vtkBenchmarkReslice);
+
+namespace
+{
+std::atomic<int> Counter(0);
+
+VTK_THREAD_RETURN_TYPE EmptyMethod(void*)
+{
+  ++Counter;
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+void PrintStatistics(const char* name, std::vector<double>& times)
+{
+  std::sort(times.begin(), times.end());
+  double mean = 0.0;
+  for (double time : times)
+  {
+    mean += time;
+  }
+  mean /= times.size();
+  double variance = 0.0;
+  for (double time : times)
+  {
+    variance += (time - mean) * (time - mean);
+  }
+  variance /= times.size();
+
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+            << std::setprecision(2) << " mean " << std::setw(9) << mean << " us, median "
+            << std::setw(9) << times[times.size() / 2] << " us, p99 " << std::setw(9)
+            << times[times.size() * 99 / 100] << " us, stddev " << std::setw(9)
+            << std::sqrt(variance) << " us\n";
+}
+
+// Time the calls in microseconds, after a few warm up calls.
+std::vector<double> TimeCalls(int numCalls, const std::function<void()>& call)
+{
+  for (int i = 0; i < 10; ++i)
+  {
+    call();
+  }
+  std::vector<double> times(numCalls);
+  for (int i = 0; i < numCalls; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    call();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    times[i] = elapsed.count();
+  }
+  return times;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  int numThreads =
+    argc > 1 ? std::atoi(argv[1]) : vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  int numCalls = argc > 2 ? std::atoi(argv[2]) : 1000;
+  if (numThreads < 1 || numCalls < 1)
+  {
+    std::cerr << "Usage: " << argv[0] << " [numberOfThreads] [numberOfCalls]\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "Threads: " << numThreads << ", calls: " << numCalls << "\n";
+
+  // A 16x16 slice of a 64^3 volume, small enough for the thread startup to
+  // dominate the update.
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 63, 0, 63, 0, 63);
+  source->Update();
+
+  for (bool usePool : { false, true })
+  {
+    vtkNew<vtkMultiThreader> threader;
+    threader->SetNumberOfThreads(numThreads);
+    threader->SetUseThreadPool(usePool);
+    threader->SetSingleMethod(EmptyMethod, nullptr);
+    std::vector<double> times = TimeCalls(numCalls, [&]() { threader->SingleMethodExecute(); });
+    PrintStatistics(usePool ? "Execute (pool)" : "Execute (threads)", times);
+
+    vtkNew<vtkBenchmarkReslice> reslice;
+    reslice->SetInputData(source->GetOutput());
+    reslice->SetOutputExtent(0, 15, 0, 15, 0, 0);
+    reslice->SetNumberOfThreads(numThreads);
+    reslice->SetEnableSMP(false);
+    reslice->SetUseThreadPool(usePool);
+    int slice = 0;
+    times = TimeCalls(numCalls, [&]() {
+      reslice->SetOutputOrigin(0.0, 0.0, (slice++ % 64) * 1.0);
+      reslice->Update();
+    });
+    PrintStatistics(usePool ? "Reslice (pool)" : "Reslice (threads)", times);
+  }
+
+  return Counter > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}